@@ -47,6 +47,7 @@
 #include "CommonLib/CodingStatistics.h"
 #endif
 #include "CommonLib/dtrace_codingstruct.h"
+#include "CommonLib/KLTMatrixFile.h"
 
 
 //! \ingroup DecoderApp
@@ -271,8 +272,15 @@ UInt DecApp::decode()
 Void DecApp::xCreateDecLib()
 {
   initROM();
+#if SEPARABLE_KLT
+  if( !m_kltMatrixFileName.empty() && loadKLTMatrixFile( m_kltMatrixFileName ) )
+  {
+    EXIT( "failed to load KLT matrix file " << m_kltMatrixFileName.c_str() );
+  }
+#endif
 
   // create decoder class
+  m_cDecLib.setNumThreads( m_numThreads );
   m_cDecLib.create();
 
   // initialize decoder class
@@ -83,6 +83,7 @@ Bool DecAppCfg::parseCfg( Int argc, TChar* argv[] )
 
   ("WarnUnknowParameter,w",     warnUnknowParameter,                   0,          "warn for unknown configuration parameters instead of failing")
   ("SkipFrames,s",              m_iSkipFrame,                          0,          "number of frames to skip before random access")
+  ("Threads",                   m_numThreads,                          1,          "number of threads decoding the CTU lines of a slice concurrently (0: number of cores)")
   ("OutputBitDepth,d",          m_outputBitDepth[CHANNEL_TYPE_LUMA],   0,          "bit depth of YUV output luma component (default: use 0 for native depth)")
   ("OutputBitDepthC,d",         m_outputBitDepth[CHANNEL_TYPE_CHROMA], 0,          "bit depth of YUV output chroma component (default: use luma output bit-depth)")
   ("OutputColourSpaceConvert",  outputColourSpaceConvert,              string(""), "Colour space conversion to apply to input 444 video. Permitted values are (empty string=UNCHANGED) " + getListOfColourSpaceConverts(false))
@@ -96,6 +97,9 @@ Bool DecAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("SEIColourRemappingInfoFilename",  m_colourRemapSEIFileName,        string(""), "Colour Remapping YUV output file name. If empty, no remapping is applied (ignore SEI message)\n")
   ("OutputDecodedSEIMessagesFilename",  m_outputDecodedSEIMessagesFilename,    string(""), "When non empty, output decoded SEI messages to the indicated file. If file is '-', then output to stdout\n")
   ("ClipOutputVideoToRec709Range",      m_bClipOutputVideoToRec709Range,  false,   "If true then clip output video to the Rec. 709 Range on saving")
+#if SEPARABLE_KLT
+  ("KLTMatrixFile",             m_kltMatrixFileName,                   string(""), "KLT matrix file replacing the built-in KLT matrices, has to match the file used by the encoder")
+#endif
 #if ENABLE_TRACING
   ("TraceChannelsList",         bTracingChannelsList,                        false, "List all available tracing channels" )
   ("TraceRule",                 sTracingRule,                         string( "" ), "Tracing rule (ex: \"D_CABAC:poc==8\" or \"D_REC_CB_LUMA:poc==8\")" )
@@ -156,6 +160,12 @@ Bool DecAppCfg::parseCfg( Int argc, TChar* argv[] )
     return false;
   }
 
+  if (m_numThreads < 0)
+  {
+    msg( ERROR, "The number of threads cannot be negative\n");
+    return false;
+  }
+
   if ( !cfg_TargetDecLayerIdSetFile.empty() )
   {
     FILE* targetDecLayerIdSetFile = fopen ( cfg_TargetDecLayerIdSetFile.c_str(), "r" );
@@ -207,6 +217,7 @@ DecAppCfg::DecAppCfg()
 : m_bitstreamFileName()
 , m_reconFileName()
 , m_iSkipFrame(0)
+, m_numThreads(1)
 // m_outputBitDepth array initialised below
 , m_outputColourSpaceConvert(IPCOLOURSPACE_UNCHANGED)
 , m_iMaxTemporalLayer(-1)
@@ -217,6 +228,9 @@ DecAppCfg::DecAppCfg()
 , m_respectDefDispWindow(0)
 , m_outputDecodedSEIMessagesFilename()
 , m_bClipOutputVideoToRec709Range(false)
+#if SEPARABLE_KLT
+, m_kltMatrixFileName()
+#endif
 {
   for (UInt channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
   {
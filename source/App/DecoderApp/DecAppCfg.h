@@ -59,6 +59,7 @@ protected:
   std::string   m_bitstreamFileName;                    ///< input bitstream file name
   std::string   m_reconFileName;                        ///< output reconstruction file name
   Int           m_iSkipFrame;                           ///< counter for frames prior to the random access point to skip
+  Int           m_numThreads;                           ///< number of threads decoding a picture, 0: number of cores
   Int           m_outputBitDepth[MAX_NUM_CHANNEL_TYPE]; ///< bit depth used for writing output
   InputColourSpaceConversion m_outputColourSpaceConvert;
 
@@ -70,6 +71,9 @@ protected:
   Int           m_respectDefDispWindow;               ///< Only output content inside the default display window
   std::string   m_outputDecodedSEIMessagesFilename;   ///< filename to output decoded SEI messages to. If '-', then use stdout. If empty, do not output details.
   Bool          m_bClipOutputVideoToRec709Range;      ///< If true, clip the output video to the Rec 709 range on saving.
+#if SEPARABLE_KLT
+  std::string   m_kltMatrixFileName;                  ///< KLT matrix file replacing the built-in KLT matrices
+#endif
 
 public:
   DecAppCfg();
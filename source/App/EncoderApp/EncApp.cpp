@@ -204,6 +204,7 @@ Void EncApp::xInitLibCfg()
 #if T0196_SELECTIVE_RDOQ
   m_cEncLib.setUseSelectiveRDOQ                                  ( m_useSelectiveRDOQ );
 #endif
+  m_cEncLib.setUseRDOQSkipZeroCG                                 ( m_useRDOQSkipZeroCG );
   m_cEncLib.setRDpenalty                                         ( m_rdPenalty );
   m_cEncLib.setQTBT                                              ( m_QTBT );
   m_cEncLib.setCTUSize                                           ( m_uiCTUSize );
@@ -219,6 +220,8 @@ Void EncApp::xInitLibCfg()
 #if SEPARABLE_KLT
   m_cEncLib.setIntraKLT                                          ( m_KLT & 1 );
   m_cEncLib.setInterKLT                                          ( ( m_KLT >> 1 ) & 1 );
+  m_cEncLib.setKLTMatrixFileName                                 ( m_kltMatrixFileName );
+  m_cEncLib.setUseFastIntraKLT                                   ( m_useFastIntraKLT );
 #endif
   // ADD_NEW_TOOL : (encoder app) add setting of tool enabling flags and associated parameters here
 
@@ -473,6 +476,8 @@ Void EncApp::xInitLibCfg()
   m_cEncLib.setSummaryOutFilename                                ( m_summaryOutFilename );
   m_cEncLib.setSummaryPicFilenameBase                            ( m_summaryPicFilenameBase );
   m_cEncLib.setSummaryVerboseness                                ( m_summaryVerboseness );
+  m_cEncLib.setResidualCapture                                   ( m_residualCapture );
+  m_cEncLib.setResidualCaptureFileName                           ( m_residualCaptureFileName );
   m_cEncLib.setDecodeBitstream                                   ( 0, m_decodeBitstreams[0] );
   m_cEncLib.setDecodeBitstream                                   ( 1, m_decodeBitstreams[1] );
   m_cEncLib.setSwitchPOC                                         ( m_switchPOC );
@@ -481,6 +486,7 @@ Void EncApp::xInitLibCfg()
   m_cEncLib.setForceDecodeBitstream1                             ( m_forceDecodeBitstream1 );
   m_cEncLib.setStopAfterFFtoPOC                                  ( m_stopAfterFFtoPOC );
   m_cEncLib.setBs2ModPOCAndType                                  ( m_bs2ModPOCAndType );
+  m_cEncLib.setNumThreads                                        ( m_numThreads );
 #if ENABLE_SPLIT_PARALLELISM
   m_cEncLib.setNumSplitThreads                                   ( m_numSplitThreads );
   m_cEncLib.setForceSingleSplitThread                            ( m_forceSplitSequential );
@@ -491,6 +497,12 @@ Void EncApp::xInitLibCfg()
   m_cEncLib.setEnsureWppBitEqual                                 ( m_ensureWppBitEqual );
 
 #endif
+#if ENABLE_KLT_PARALLELISM
+  m_cEncLib.setNumKltThreads                                     ( m_numKltThreads );
+#endif
+#if ENABLE_FRAME_PARALLELISM
+  m_cEncLib.setNumFrameThreads                                   ( m_numFrameThreads );
+#endif
 }
 
 Void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList
@@ -542,19 +554,8 @@ Void EncApp::xInitLib(Bool isFieldCoding)
  - destroy internal class
  .
  */
-#if INTRA_RESI_OUTPUT | INTER_RESI_OUTPUT
-std::string statLogFileName;
-ofstream fout;
-#endif
 Void EncApp::encode()
 {
-#if INTRA_RESI_OUTPUT | INTER_RESI_OUTPUT
-  statLogFileName = m_bitstreamFileName;
-  std::string::size_type pos = statLogFileName.find('.');
-  std::string nameSuffix = statLogFileName.substr(pos + 1);
-  statLogFileName.replace(pos+1, nameSuffix.length(), "log");
-  fout.open(statLogFileName);
-#endif
   m_bitstream.open(m_bitstreamFileName.c_str(), fstream::binary | fstream::out);
   if (!m_bitstream)
   {
@@ -763,6 +763,8 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
+  ("ResidualCapture",                                 m_residualCapture,                                   0u, "Capture the residual blocks of the RD search for transform training (0:off, 1:intra, 2:inter, 3:both)")
+  ("ResidualCaptureFile",                             m_residualCaptureFileName,                     string(), "Output file of the residual capture")
   ("Verbosity,v",                                     m_verbosity,                               (Int)VERBOSE, "Specifies the level of the verboseness")
 
   //Field coding parameters
@@ -809,6 +811,7 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
     "\t1:  Enable only Intra KLT\n"
     "\t2:  Enable only Inter KLT\n"
     "\t3:  Enable both Intra & Inter KLT\n")
+  ("KLTMatrixFile",                                   m_kltMatrixFileName,                         string(""), "KLT matrix file replacing the built-in KLT matrices, the decoder has to use the same file")
 #endif
 
   // ADD_NEW_TOOL : (encoder app) add parsing parameters here
@@ -816,6 +819,9 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("LCTUFast",                                        m_useFastLCTU,                                    false, "Fast methods for large CTU")
   ("FastMrg",                                         m_useFastMrg,                                     false, "Fast methods for inter merge")
   ("PBIntraFast",                                     m_usePbIntraFast,                                 false, "Fast assertion if the intra mode is probable")
+#if SEPARABLE_KLT
+  ("FastIntraKLT",                                    m_useFastIntraKLT,                                false, "Skip the intra KLT pass of a CU when the DCT-II pass and the neighbourhood indicate no gain")
+#endif
   ("AMaxBT",                                          m_useAMaxBT,                                      false, "Adaptive maximal BT-size")
   ("SaveLoadEncInfo",                                 m_useSaveLoadEncInfo,                             false, "Reuse of previous encoder decision for same block generated by different partition methods")
   ("SaveLoadSplitDecision",                           m_useSaveLoadSplitDecision,                       false, "Reuse of previous split decision for same block generated by different partition methods")
@@ -920,6 +926,7 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
 #if T0196_SELECTIVE_RDOQ
   ("SelectiveRDOQ",                                   m_useSelectiveRDOQ,                               false, "Enable selective RDOQ")
 #endif
+  ("RDOQSkipZeroCG",                                  m_useRDOQSkipZeroCG,                              false, "Skip the RDOQ level estimation of coefficient groups quantised to all zero (not bit-exact)")
   ("RDpenalty",                                       m_rdPenalty,                                          0, "RD-penalty for 32x32 TU for intra in non-intra slices. 0:disabled  1:RD-penalty  2:maximum RD-penalty")
 
   // Deblocking filter parameters
@@ -1209,15 +1216,14 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("StopAfterFFtoPOC",                                m_stopAfterFFtoPOC,                       false, "If using fast forward to POC, after the POC of interest has been hit, stop further encoding.")
   ("ForceDecodeBitstream1",                           m_forceDecodeBitstream1,                  false, "force decoding of bitstream 1 - use this only if you are realy sure about what you are doing ")
   ("DecodeBitstream2ModPOCAndType",                   m_bs2ModPOCAndType,                       false, "Modify POC and NALU-type of second input bitstream, to use second BS as closing I-slice")
+  ("Threads",                                         m_numThreads,                                 0, "Total number of threads shared by the concurrently compressed pictures, WPP rows, split jobs and KLT candidates (0: derive from their thread counts, limited to the number of cores)")
   ("NumSplitThreads",                                 m_numSplitThreads,                            1, "Number of threads used to parallelize splitting")
   ("ForceSingleSplitThread",                          m_forceSplitSequential,                   false, "Force single thread execution even if taking the parallelized path")
   ("NumWppThreads",                                   m_numWppThreads,                              1, "Number of threads used to run WPP-style parallelization")
   ("NumWppExtraLines",                                m_numWppExtraLines,                           0, "Number of additional wpp lines to switch when threads are blocked")
-#if ENABLE_WPP_PARALLELISM
-  ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                       true, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
-#else
+  ("NumKltThreads",                                   m_numKltThreads,                              1, "Number of threads used to evaluate the intra and inter KLT transform candidates of a TU concurrently")
+  ("NumFrameThreads",                                 m_numFrameThreads,                            1, "Number of independent pictures of a GOP compressed concurrently (1: off)")
   ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                      false, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
-#endif
     ;
 
   for(Int i=1; i<MAX_GOP+1; i++)
@@ -1841,7 +1847,13 @@ Bool EncAppCfg::xCheckParameter()
   else
   {
 #if ENABLE_WPP_PARALLELISM
+#if HEVC_TILES_WPP
+    // tiles without entropy coding sync are encoded concurrently as a whole, the QP prediction does not cross them
+    const bool concurrentTiles = ( m_numTileColumnsMinus1 > 0 || m_numTileRowsMinus1 > 0 ) && !m_entropyCodingSyncEnabledFlag;
+    xConfirmPara( !m_AltDQPCoding && !concurrentTiles && ( m_numWppThreads + m_numWppExtraLines ) > 1, "Wavefront parallel encoding only supported with AltDQPCoding" );
+#else
     xConfirmPara( !m_AltDQPCoding && ( m_numWppThreads + m_numWppExtraLines ) > 1, "Wavefront parallel encoding only supported with AltDQPCoding" );
+#endif
 #endif
     xConfirmPara( m_useSaveLoadEncInfo && !m_QTBT,       "Encoder decision saving can only be applied with QTBT" );
     xConfirmPara( !m_QTBT && m_MTT,                      "Multi type tree is an extension of QTBT, thus QTBT has to be enabled for MTT" );
@@ -1854,20 +1866,17 @@ Bool EncAppCfg::xCheckParameter()
 
   }
 
+  xConfirmPara( m_numThreads < 0, "Number of threads cannot be negative" );
+
 #if ENABLE_SPLIT_PARALLELISM
   xConfirmPara( m_numSplitThreads < 1, "Number of used threads cannot be smaller than 1" );
   xConfirmPara( m_numSplitThreads > PARL_SPLIT_MAX_NUM_THREADS, "Number of used threads cannot be higher than the number of actual jobs" );
-#if _MSC_VER && ENABLE_WPP_PARALLELISM
-  xConfirmPara( m_numSplitThreads > 1 && m_numSplitThreads != NUM_SPLIT_THREADS_IF_MSVC, "Due to poor implementation by Microsoft, NumSplitThreads cannot be set dynamically on runtime!" );
-#endif
 #else
   xConfirmPara( m_numSplitThreads != 1, "ENABLE_SPLIT_PARALLELISM is disabled, numSplitThreads has to be 1" );
 #endif
 
 #if ENABLE_WPP_PARALLELISM
   xConfirmPara( m_numWppThreads < 1, "Number of threads used for WPP-style parallelization cannot be smaller than 1" );
-  xConfirmPara( m_numWppThreads > PARL_WPP_MAX_NUM_THREADS, "Number of threads used for WPP-style parallelization cannot be bigger than PARL_WPP_MAX_NUM_THREADS" );
-  xConfirmPara( !m_ensureWppBitEqual && m_numWppThreads > 1, "WPP bit equality is implied when using WPP-style parallelism" );
 #if ENABLE_WPP_STATIC_LINK
   xConfirmPara( m_numWppExtraLines != 0, "WPP-style extra lines out of range" );
 #else
@@ -1878,6 +1887,29 @@ Bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_ensureWppBitEqual, "ENABLE_WPP_PARALLELISM is disabled, cannot ensure being WPP bit-equal" );
 #endif
 
+#if ENABLE_KLT_PARALLELISM
+  xConfirmPara( m_numKltThreads < 1, "Number of threads used for KLT candidate evaluation cannot be smaller than 1" );
+  xConfirmPara( m_numKltThreads > PARL_KLT_MAX_NUM_JOBS, "Number of threads used for KLT candidate evaluation cannot be bigger than PARL_KLT_MAX_NUM_JOBS" );
+#else
+  xConfirmPara( m_numKltThreads != 1, "ENABLE_KLT_PARALLELISM is disabled, numKltThreads has to be 1" );
+#endif
+
+#if ENABLE_FRAME_PARALLELISM
+  xConfirmPara( m_numFrameThreads < 1, "Number of concurrently compressed pictures cannot be smaller than 1" );
+  xConfirmPara( m_numFrameThreads > PARL_FRAME_MAX_NUM_THREADS, "Number of concurrently compressed pictures cannot be bigger than PARL_FRAME_MAX_NUM_THREADS" );
+  if( m_numFrameThreads > 1 )
+  {
+    xConfirmPara( m_RCEnableRateControl, "Frame parallel compression cannot be used with rate control" );
+    xConfirmPara( m_isField, "Frame parallel compression cannot be used with field coding" );
+    xConfirmPara( !m_decodeBitstreams[0].empty() || !m_decodeBitstreams[1].empty() || m_fastForwardToPOC >= 0, "Frame parallel compression cannot be used when decoding pictures from a bitstream or fast forwarding" );
+  }
+#else
+  xConfirmPara( m_numFrameThreads != 1, "ENABLE_FRAME_PARALLELISM is disabled, numFrameThreads has to be 1" );
+#endif
+
+  xConfirmPara( m_residualCapture > 3, "ResidualCapture must be in the range 0 to 3" );
+  xConfirmPara( m_residualCapture && m_residualCaptureFileName.empty(), "ResidualCapture requires a ResidualCaptureFile" );
+
 
 #if SHARP_LUMA_DELTA_QP && ENABLE_QPA
   xConfirmPara( m_bUsePerceptQPA && m_lumaLevelToDeltaQPMapping.mode >= 2, "QPA and SharpDeltaQP mode 2 cannot be used together" );
@@ -2902,6 +2934,7 @@ Void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "HAD:%d ", m_bUseHADME                          );
   msg( VERBOSE, "RDQ:%d ", m_useRDOQ                            );
   msg( VERBOSE, "RDQTS:%d ", m_useRDOQTS                        );
+  msg( VERBOSE, "RDQZCG:%d ", m_useRDOQSkipZeroCG               );
   msg( VERBOSE, "RDpenalty:%d ", m_rdPenalty                    );
 #if SHARP_LUMA_DELTA_QP
   msg( VERBOSE, "LQP:%d ", m_lumaLevelToDeltaQPMapping.mode     );
@@ -2971,6 +3004,9 @@ Void EncAppCfg::xPrintParameter()
     msg( VERBOSE, "MTT:%d ", m_MTT );
 #if ENABLE_WPP_PARALLELISM
     msg( VERBOSE, "AltDQPCoding:%d ", m_AltDQPCoding );
+#endif
+#if SEPARABLE_KLT
+    if( m_KLT && !m_kltMatrixFileName.empty() ) msg( VERBOSE, "KLTMatrixFile:%s ", m_kltMatrixFileName.c_str() );
 #endif
   }
   // ADD_NEW_TOOL (add some output indicating the usage of tools)
@@ -2987,10 +3023,14 @@ Void EncAppCfg::xPrintParameter()
   }
   msg( VERBOSE, "FastMrg:%d ", m_useFastMrg );
   msg( VERBOSE, "PBIntraFast:%d ", m_usePbIntraFast );
+#if SEPARABLE_KLT
+  if( m_KLT & 1 ) msg( VERBOSE, "FastIntraKLT:%d ", m_useFastIntraKLT );
+#endif
   if( m_QTBT ) msg( VERBOSE, "AMaxBT:%d ", m_useAMaxBT );
   if( m_QTBT ) msg( VERBOSE, "E0023FastEnc:%d ", m_e0023FastEnc );
   if( m_QTBT ) msg( VERBOSE, "ContentBasedFastQtbt:%d ", m_contentBasedFastQtbt );
 
+  msg( VERBOSE, "Threads:%d ", m_numThreads );
   msg( VERBOSE, "NumSplitThreads:%d ", m_numSplitThreads );
   if( m_numSplitThreads > 1 )
   {
@@ -2998,6 +3038,8 @@ Void EncAppCfg::xPrintParameter()
   }
   msg( VERBOSE, "NumWppThreads:%d+%d ", m_numWppThreads, m_numWppExtraLines );
   msg( VERBOSE, "EnsureWppBitEqual:%d ", m_ensureWppBitEqual );
+  if( m_KLT & 1 ) msg( VERBOSE, "NumKltThreads:%d ", m_numKltThreads );
+  msg( VERBOSE, "NumFrameThreads:%d ", m_numFrameThreads );
 
   msg( VERBOSE, "\n\n");
 
@@ -201,6 +201,8 @@ protected:
 #endif
 #if SEPARABLE_KLT
   int       m_KLT;
+  std::string m_kltMatrixFileName;
+  bool      m_useFastIntraKLT;
 #endif
   // ADD_NEW_TOOL : (encoder app) add tool enabling flags and associated parameters here
 
@@ -219,12 +221,14 @@ protected:
   bool      m_e0023FastEnc;
   bool      m_contentBasedFastQtbt;
 
-
+  int       m_numThreads;
   int       m_numSplitThreads;
   bool      m_forceSplitSequential;
   int       m_numWppThreads;
   int       m_numWppExtraLines;
   bool      m_ensureWppBitEqual;
+  int       m_numKltThreads;
+  int       m_numFrameThreads;
 
   // transfom unit (TU) definition
   Int       m_quadtreeTULog2MaxSize;
@@ -280,6 +284,7 @@ protected:
 #if T0196_SELECTIVE_RDOQ
   Bool      m_useSelectiveRDOQ;                               ///< flag for using selective RDOQ
 #endif
+  Bool      m_useRDOQSkipZeroCG;                              ///< flag for skipping the RDOQ level estimation of all-zero coefficient groups
   Int       m_rdPenalty;                                      ///< RD-penalty for 32x32 TU for intra in non-intra slices (0: no RD-penalty, 1: RD-penalty, 2: maximum RD-penalty)
   Bool      m_bDisableIntraPUsInInterSlices;                  ///< Flag for disabling intra predicted PUs in inter slices.
   MESearchMethod m_motionEstimationSearchMethod;
@@ -467,6 +472,8 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  UInt        m_residualCapture;                              ///< residual capture for transform training, 1: intra, 2: inter
+  std::string m_residualCaptureFileName;                      ///< output file of the residual capture
 
   Int         m_verbosity;
 
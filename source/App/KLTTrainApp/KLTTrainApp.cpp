@@ -0,0 +1,495 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KLTTrainApp.cpp
+    \brief    KLT training application class
+*/
+
+#include <algorithm>
+#include <math.h>
+#include <thread>
+
+#include "KLTTrainApp.h"
+#include "CommonLib/KLTMatrixFile.h"
+#include "CommonLib/Rom.h"
+
+//! \ingroup KLTTrainApp
+//! \{
+
+static const size_t KLT_TRAIN_BATCH_SAMPLES = 1 << 24;
+
+static inline Int getSizeIdx( const UInt size )
+{
+  for( Int idx = 0; idx < KLT_TRAIN_NUM_SIZES; idx++ )
+  {
+    if( size == ( 4u << idx ) )
+    {
+      return idx;
+    }
+  }
+  return -1;
+}
+
+// ====================================================================================================================
+// KLTCovariance
+// ====================================================================================================================
+
+KLTCovariance::KLTCovariance()
+{
+  for( UInt set = 0; set < KLT_TRAIN_NUM_SETS; set++ )
+  {
+    for( UInt idx = 0; idx < KLT_TRAIN_NUM_SIZES; idx++ )
+    {
+      const UInt size = 4 << idx;
+      cov       [set][idx].assign( size * size, 0 );
+      numVectors[set][idx] = 0;
+    }
+  }
+}
+
+Void KLTCovariance::addBlock( const UInt set, const Pel *resi, const UInt width, const UInt height )
+{
+  Int vec[MAX_TU_SIZE];
+
+  // rows train the matrix of the block width
+  const Int widthIdx = getSizeIdx( width );
+  if( widthIdx >= 0 )
+  {
+    Int64 *c = &cov[set][widthIdx][0];
+
+    for( UInt y = 0; y < height; y++ )
+    {
+      const Pel *row = resi + y * width;
+      for( UInt i = 0; i < width; i++ )
+      {
+        for( UInt j = i; j < width; j++ )
+        {
+          c[i * width + j] += row[i] * row[j];
+        }
+      }
+    }
+    numVectors[set][widthIdx] += height;
+  }
+
+  // columns train the matrix of the block height
+  const Int heightIdx = getSizeIdx( height );
+  if( heightIdx >= 0 )
+  {
+    Int64 *c = &cov[set][heightIdx][0];
+
+    for( UInt x = 0; x < width; x++ )
+    {
+      for( UInt y = 0; y < height; y++ )
+      {
+        vec[y] = resi[y * width + x];
+      }
+      for( UInt i = 0; i < height; i++ )
+      {
+        for( UInt j = i; j < height; j++ )
+        {
+          c[i * height + j] += vec[i] * vec[j];
+        }
+      }
+    }
+    numVectors[set][heightIdx] += width;
+  }
+}
+
+Void KLTCovariance::merge( const KLTCovariance &other )
+{
+  for( UInt set = 0; set < KLT_TRAIN_NUM_SETS; set++ )
+  {
+    for( UInt idx = 0; idx < KLT_TRAIN_NUM_SIZES; idx++ )
+    {
+      for( size_t i = 0; i < cov[set][idx].size(); i++ )
+      {
+        cov[set][idx][i] += other.cov[set][idx][i];
+      }
+      numVectors[set][idx] += other.numVectors[set][idx];
+    }
+  }
+}
+
+// ====================================================================================================================
+// Matrix derivation
+// ====================================================================================================================
+
+/// cyclic Jacobi eigenvalue decomposition of the symmetric matrix a (destroyed), eigenvectors are the columns of v
+static Void eigenJacobi( std::vector<Double> &a, std::vector<Double> &v, std::vector<Double> &eigVal, const UInt n )
+{
+  v.assign( n * n, 0.0 );
+  for( UInt i = 0; i < n; i++ )
+  {
+    v[i * n + i] = 1.0;
+  }
+
+  for( Int sweep = 0; sweep < 100; sweep++ )
+  {
+    Double offDiag = 0.0, diag = 0.0;
+    for( UInt i = 0; i < n; i++ )
+    {
+      diag += a[i * n + i] * a[i * n + i];
+      for( UInt j = i + 1; j < n; j++ )
+      {
+        offDiag += a[i * n + j] * a[i * n + j];
+      }
+    }
+    if( offDiag <= 1e-22 * diag )
+    {
+      break;
+    }
+
+    for( UInt p = 0; p < n; p++ )
+    {
+      for( UInt q = p + 1; q < n; q++ )
+      {
+        const Double apq = a[p * n + q];
+        if( fabs( apq ) < 1e-300 )
+        {
+          continue;
+        }
+
+        const Double theta = ( a[q * n + q] - a[p * n + p] ) / ( 2.0 * apq );
+        const Double t     = ( theta >= 0 ? 1.0 : -1.0 ) / ( fabs( theta ) + sqrt( theta * theta + 1.0 ) );
+        const Double c     = 1.0 / sqrt( t * t + 1.0 );
+        const Double s     = t * c;
+
+        for( UInt k = 0; k < n; k++ )
+        {
+          const Double akp = a[k * n + p], akq = a[k * n + q];
+          a[k * n + p] = c * akp - s * akq;
+          a[k * n + q] = s * akp + c * akq;
+        }
+        for( UInt k = 0; k < n; k++ )
+        {
+          const Double apk = a[p * n + k], aqk = a[q * n + k];
+          a[p * n + k] = c * apk - s * aqk;
+          a[q * n + k] = s * apk + c * aqk;
+        }
+        for( UInt k = 0; k < n; k++ )
+        {
+          const Double vkp = v[k * n + p], vkq = v[k * n + q];
+          v[k * n + p] = c * vkp - s * vkq;
+          v[k * n + q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+
+  eigVal.resize( n );
+  for( UInt i = 0; i < n; i++ )
+  {
+    eigVal[i] = a[i * n + i];
+  }
+}
+
+/// rounds the basis vector to integers with the norm of the scaled orthonormal vector, as done for the built-in matrices
+static Void integerizeBasis( const Double *basis, const Double scale, TMatrixCoeff *coeff, const UInt n )
+{
+  Int64 norm2 = 0;
+  for( UInt i = 0; i < n; i++ )
+  {
+    coeff[i] = TMatrixCoeff( floor( basis[i] * scale + 0.5 ) );
+    norm2   += Int64( coeff[i] ) * coeff[i];
+  }
+
+  const Double target = scale * scale;
+
+  // move the coefficient with the largest rounding error towards its real value while this brings the norm closer
+  for( UInt iter = 0; iter < n; iter++ )
+  {
+    const Bool grow = norm2 < target;
+    Int    best     = -1;
+    Double bestErr  = 0.0;
+
+    for( UInt i = 0; i < n; i++ )
+    {
+      const Double err = ( fabs( basis[i] * scale ) - abs( Int( coeff[i] ) ) ) * ( grow ? 1.0 : -1.0 );
+      if( err > bestErr )
+      {
+        best    = i;
+        bestErr = err;
+      }
+    }
+    if( best < 0 )
+    {
+      break;
+    }
+
+    const Int   step     = ( basis[best] >= 0 ) == grow ? 1 : -1;
+    const Int64 newNorm2 = norm2 + 2 * step * Int64( coeff[best] ) + 1;
+    if( fabs( Double( newNorm2 ) - target ) >= fabs( Double( norm2 ) - target ) )
+    {
+      break;
+    }
+    coeff[best] = TMatrixCoeff( coeff[best] + step );
+    norm2       = newNorm2;
+  }
+}
+
+/// fraction of the energy compacted into the first quarter of the coefficients by the rows of the given matrix
+static Double getCompaction( const std::vector<Double> &cov, const TMatrixCoeff *matrix, const UInt n )
+{
+  Double total = 0.0, compacted = 0.0;
+  for( UInt i = 0; i < n; i++ )
+  {
+    total += cov[i * n + i];
+  }
+
+  for( UInt k = 0; k < n / 4; k++ )
+  {
+    const TMatrixCoeff *b = matrix + k * n;
+    Double energy = 0.0, norm2 = 0.0;
+    for( UInt i = 0; i < n; i++ )
+    {
+      Double sum = 0.0;
+      for( UInt j = 0; j < n; j++ )
+      {
+        sum += cov[i * n + j] * b[j];
+      }
+      energy += b[i] * sum;
+      norm2  += Double( b[i] ) * b[i];
+    }
+    compacted += energy / norm2;
+  }
+
+  return total > 0.0 ? compacted / total : 0.0;
+}
+
+Void KLTTrainApp::xDeriveMatrices( const KLTCovariance &covariance )
+{
+  static const TChar* setName[KLT_TRAIN_NUM_SETS] = { "inter", "intra" };
+
+  TMatrixCoeff* matrices[2][KLT_TRAIN_NUM_SETS][KLT_TRAIN_NUM_SIZES] =
+  {
+    {
+      { g_aiKLT4  [0][0], g_aiKLT8  [0][0], g_aiKLT16  [0][0], g_aiKLT32  [0][0], g_aiKLT64  [0][0] },
+      { g_aiKLT4  [1][0], g_aiKLT8  [1][0], g_aiKLT16  [1][0], g_aiKLT32  [1][0], g_aiKLT64  [1][0] },
+    },
+    {
+      { g_aiKLT4HP[0][0], g_aiKLT8HP[0][0], g_aiKLT16HP[0][0], g_aiKLT32HP[0][0], g_aiKLT64HP[0][0] },
+      { g_aiKLT4HP[1][0], g_aiKLT8HP[1][0], g_aiKLT16HP[1][0], g_aiKLT32HP[1][0], g_aiKLT64HP[1][0] },
+    },
+  };
+
+  printf( "\n  set    size      vectors   compaction (previous -> trained)\n" );
+
+  for( UInt set = 0; set < KLT_TRAIN_NUM_SETS; set++ )
+  {
+    for( UInt idx = 0; idx < KLT_TRAIN_NUM_SIZES; idx++ )
+    {
+      const UInt   n          = 4 << idx;
+      const UInt64 numVectors = covariance.numVectors[set][idx];
+
+      if( numVectors < m_minNumVectors )
+      {
+        printf( "  %-5s  %2dx%-2d  %11llu   not trained, matrix kept\n", setName[set], n, n, ( unsigned long long ) numVectors );
+        continue;
+      }
+
+      std::vector<Double> cov( n * n ), a, v, eigVal;
+      for( UInt i = 0; i < n; i++ )
+      {
+        for( UInt j = i; j < n; j++ )
+        {
+          cov[i * n + j] = cov[j * n + i] = Double( covariance.cov[set][idx][i * n + j] ) / Double( numVectors );
+        }
+      }
+
+      const Double prevCompaction = getCompaction( cov, matrices[0][set][idx], n );
+
+      a = cov;
+      eigenJacobi( a, v, eigVal, n );
+
+      std::vector<UInt> order( n );
+      for( UInt i = 0; i < n; i++ )
+      {
+        order[i] = i;
+      }
+      std::stable_sort( order.begin(), order.end(), [&eigVal]( UInt l, UInt r ) { return eigVal[l] > eigVal[r]; } );
+
+      std::vector<Double> basis( n );
+      for( UInt k = 0; k < n; k++ )
+      {
+        // basis vector k is the eigenvector of the k-th largest eigenvalue, with a non-negative sum of its elements
+        Double sum = 0.0;
+        for( UInt i = 0; i < n; i++ )
+        {
+          basis[i] = v[i * n + order[k]];
+          sum     += basis[i];
+        }
+        if( sum < 0.0 )
+        {
+          for( UInt i = 0; i < n; i++ )
+          {
+            basis[i] = -basis[i];
+          }
+        }
+
+        integerizeBasis( &basis[0],  64.0 * sqrt( Double( n ) ), matrices[0][set][idx] + k * n, n );
+        integerizeBasis( &basis[0], 256.0 * sqrt( Double( n ) ), matrices[1][set][idx] + k * n, n );
+      }
+
+      printf( "  %-5s  %2dx%-2d  %11llu   %.4f -> %.4f\n", setName[set], n, n, ( unsigned long long ) numVectors, prevCompaction, getCompaction( cov, matrices[0][set][idx], n ) );
+    }
+  }
+}
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+KLTTrainApp::KLTTrainApp()
+  : m_numBlocks( 0 )
+{
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/**
+ - read the residual capture files in batches of blocks
+ - accumulate the row and column second moments of each batch with the worker threads, while the next batch is read
+ - derive the integer KLT matrices from the eigenvectors and write them as KLT matrix file
+ */
+UInt KLTTrainApp::train()
+{
+  if( !m_initKltMatrixFileName.empty() && loadKLTMatrixFile( m_initKltMatrixFileName ) )
+  {
+    return 1;
+  }
+
+  m_currFile = m_residualFileNames.begin();
+  if( m_reader.open( *m_currFile ) )
+  {
+    return 1;
+  }
+
+  std::vector<KLTCovariance> threadCov( m_numThreads );
+  KLTTrainBatch              batches[2];
+  Int                        currBatch = 0;
+
+  Bool more = xReadBatch( batches[currBatch] );
+
+  while( more )
+  {
+    const KLTTrainBatch &batch = batches[currBatch];
+
+    std::vector<std::thread> workers;
+    for( Int t = 0; t < m_numThreads; t++ )
+    {
+      workers.push_back( std::thread( [&batch, &threadCov, t, this]()
+      {
+        for( size_t b = t; b < batch.blocks.size(); b += m_numThreads )
+        {
+          const KLTTrainBatch::Block &blk = batch.blocks[b];
+          threadCov[t].addBlock( blk.set, &batch.samples[blk.offset], blk.width, blk.height );
+        }
+      } ) );
+    }
+
+    currBatch = 1 - currBatch;
+    more      = xReadBatch( batches[currBatch] );
+
+    for( auto &worker : workers )
+    {
+      worker.join();
+    }
+  }
+
+  m_reader.close();
+
+  for( Int t = 1; t < m_numThreads; t++ )
+  {
+    threadCov[0].merge( threadCov[t] );
+  }
+
+  printf( "%llu residual blocks read from %d file(s)\n", ( unsigned long long ) m_numBlocks, Int( m_residualFileNames.size() ) );
+
+  xDeriveMatrices( threadCov[0] );
+
+  return writeKLTMatrixFile( m_kltMatrixFileName ) ? 1 : 0;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/// fills the batch with the next blocks of the capture files, returns false if no block is left
+Bool KLTTrainApp::xReadBatch( KLTTrainBatch &batch )
+{
+  batch.blocks.clear();
+  batch.samples.resize( KLT_TRAIN_BATCH_SAMPLES + MAX_TU_SIZE * MAX_TU_SIZE );
+
+  size_t numSamples = 0;
+
+  while( numSamples < KLT_TRAIN_BATCH_SAMPLES && m_currFile != m_residualFileNames.end() )
+  {
+    ComponentID compID;
+    PredMode    predMode;
+    UInt        dir, width, height;
+    Int         qp;
+
+    if( !m_reader.read( compID, predMode, dir, qp, width, height, &batch.samples[numSamples] ) )
+    {
+      m_reader.close();
+      if( ++m_currFile != m_residualFileNames.end() && m_reader.open( *m_currFile ) )
+      {
+        THROW( "cannot read residual capture file " << *m_currFile );
+      }
+      continue;
+    }
+
+    m_numBlocks++;
+
+    // the KLT is only applied to luma
+    if( compID != COMPONENT_Y && !m_useChroma )
+    {
+      continue;
+    }
+
+    KLTTrainBatch::Block blk;
+    blk.set    = predMode == MODE_INTRA ? 1 : 0;
+    blk.width  = width;
+    blk.height = height;
+    blk.offset = numSamples;
+    batch.blocks.push_back( blk );
+
+    numSamples += width * height;
+  }
+
+  return !batch.blocks.empty();
+}
+
+//! \}
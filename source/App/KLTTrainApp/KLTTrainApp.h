@@ -0,0 +1,109 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KLTTrainApp.h
+    \brief    KLT training application class (header)
+*/
+
+#ifndef __KLTTRAINAPP__
+#define __KLTTRAINAPP__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stdio.h>
+#include <vector>
+#include "CommonLib/CommonDef.h"
+#include "EncoderLib/ResidualCapture.h"
+
+#include "KLTTrainAppCfg.h"
+
+//! \ingroup KLTTrainApp
+//! \{
+
+static const UInt KLT_TRAIN_NUM_SETS  = 2;           ///< 0: inter, 1: intra, as in g_aiKLT*
+static const UInt KLT_TRAIN_NUM_SIZES = 5;           ///< 4, 8, 16, 32, 64
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// second moments of the row and column vectors of the residual blocks, per matrix set and size
+struct KLTCovariance
+{
+  std::vector<Int64> cov       [KLT_TRAIN_NUM_SETS][KLT_TRAIN_NUM_SIZES];   ///< upper triangle of the N x N matrix
+  UInt64             numVectors[KLT_TRAIN_NUM_SETS][KLT_TRAIN_NUM_SIZES];
+
+  KLTCovariance();
+
+  Void addBlock ( const UInt set, const Pel *resi, const UInt width, const UInt height );
+  Void merge    ( const KLTCovariance &other );
+};
+
+/// residual blocks decoded from the capture files, processed by the worker threads as a whole
+struct KLTTrainBatch
+{
+  struct Block
+  {
+    UChar  set;
+    UInt   width;
+    UInt   height;
+    size_t offset;
+  };
+
+  std::vector<Block> blocks;
+  std::vector<Pel>   samples;
+};
+
+/// KLT training application class
+class KLTTrainApp : public KLTTrainAppCfg
+{
+public:
+  KLTTrainApp();
+  virtual ~KLTTrainApp           ()  {}
+
+  UInt  train             (); ///< main training function, returns 0 on success
+
+private:
+  Bool  xReadBatch        ( KLTTrainBatch &batch );
+  Void  xDeriveMatrices   ( const KLTCovariance &covariance );
+
+  ResidualCaptureReader                    m_reader;
+  std::vector<std::string>::const_iterator m_currFile;
+  UInt64                                   m_numBlocks;
+};
+
+//! \}
+
+#endif // __KLTTRAINAPP__
@@ -0,0 +1,152 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KLTTrainAppCfg.cpp
+    \brief    KLT training application configuration class
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "KLTTrainAppCfg.h"
+#include "Utilities/program_options_lite.h"
+
+using namespace std;
+namespace po = df::program_options_lite;
+
+//! \ingroup KLTTrainApp
+//! \{
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param argc number of arguments
+    \param argv array of arguments
+ */
+Bool KLTTrainAppCfg::parseCfg( Int argc, TChar* argv[] )
+{
+  Bool do_help = false;
+  Int warnUnknowParameter = 0;
+  string residualFileList;
+  po::Options opts;
+  opts.addOptions()
+
+  ("help",                      do_help,                               false,      "this help text")
+  ("ResidualFiles,i",           residualFileList,                      string(""), "comma separated list of residual capture files (written by the encoder with ResidualCapture)")
+  ("KLTMatrixFile,o",           m_kltMatrixFileName,                   string(""), "output KLT matrix file")
+  ("InitKLTMatrixFile",         m_initKltMatrixFileName,               string(""), "KLT matrix file used for sizes without enough training data (default: built-in matrices)")
+  ("NumThreads,t",              m_numThreads,                          0,          "number of threads accumulating the covariances, 0: number of hardware threads")
+  ("MinVectors",                m_minNumVectors,                       1000u,      "minimum number of row/column vectors required to train the matrix of a size")
+  ("Chroma",                    m_useChroma,                           false,      "also train on chroma residuals")
+
+  ("WarnUnknowParameter,w",     warnUnknowParameter,                   0,          "warn for unknown configuration parameters instead of failing")
+  ;
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  const list<const TChar*>& argv_unhandled = po::scanArgv(opts, argc, (const TChar**) argv, err);
+
+  for (list<const TChar*>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++)
+  {
+    std::cerr << "Unhandled argument ignored: "<< *it << std::endl;
+  }
+
+  if (argc == 1 || do_help)
+  {
+    po::doHelp(cout, opts);
+    return false;
+  }
+
+  if (err.is_errored)
+  {
+    if (!warnUnknowParameter)
+    {
+      /* errors have already been reported to stderr */
+      return false;
+    }
+  }
+
+  for( size_t start = 0; start < residualFileList.size(); )
+  {
+    size_t end = residualFileList.find( ',', start );
+    if( end == string::npos )
+    {
+      end = residualFileList.size();
+    }
+    if( end > start )
+    {
+      m_residualFileNames.push_back( residualFileList.substr( start, end - start ) );
+    }
+    start = end + 1;
+  }
+
+  if (m_residualFileNames.empty())
+  {
+    std::cerr << "No input file specified, aborting" << std::endl;
+    return false;
+  }
+  if (m_kltMatrixFileName.empty())
+  {
+    std::cerr << "No output file specified, aborting" << std::endl;
+    return false;
+  }
+  if (m_numThreads < 0)
+  {
+    std::cerr << "NumThreads cannot be negative, aborting" << std::endl;
+    return false;
+  }
+  if (m_numThreads == 0)
+  {
+    m_numThreads = std::max<Int>( 1, std::thread::hardware_concurrency() );
+  }
+
+  return true;
+}
+
+KLTTrainAppCfg::KLTTrainAppCfg()
+: m_residualFileNames()
+, m_kltMatrixFileName()
+, m_initKltMatrixFileName()
+, m_numThreads( 0 )
+, m_minNumVectors( 0 )
+, m_useChroma( false )
+{
+}
+
+KLTTrainAppCfg::~KLTTrainAppCfg()
+{
+}
+
+//! \}
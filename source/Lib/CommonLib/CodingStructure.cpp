@@ -43,8 +43,13 @@
 #include "UnitTools.h"
 #include "UnitPartitioner.h"
 
+#if ENABLE_WPP_PARALLELISM
+#include <mutex>
+
+// serializes the concurrent WPP rows adding their CTUs to the picture level structure
+static std::mutex s_picLevelMutex;
+#endif
 
-XUCache g_globalUnitCache = XUCache();
 
 const UnitScale UnitScaleArray[NUM_CHROMA_FORMAT][MAX_NUM_COMPONENT] =
 {
@@ -163,6 +168,18 @@ bool CodingStructure::isDecomp( const Position &pos, const ChannelType effChType
   }
 }
 
+bool CodingStructure::isDecompRestricted( const Position &pos, const CodingUnit& curCu, const ChannelType effChType ) const
+{
+#if HEVC_TILES_WPP
+  if( isInOtherTile( pos, curCu.tileIdx, effChType ) )
+  {
+    return false;
+  }
+
+#endif
+  return isDecomp( pos, effChType );
+}
+
 void CodingStructure::setDecomp(const CompArea &_area, const bool _isCoded /*= true*/)
 {
   const UnitScale& scale = unitScale[_area.compID];
@@ -780,8 +797,9 @@ void CodingStructure::useSubStructure( const CodingStructure& subStruct, const C
 
   if( nullptr == parent )
   {
-#pragma omp critical
     {
+      std::lock_guard<std::mutex> lock( s_picLevelMutex );
+
       fracBits += subStruct.fracBits;
       dist     += subStruct.dist;
       cost     += subStruct.cost;
@@ -1174,7 +1192,7 @@ PelBuf CodingStructure::getBuf( const CompArea &blk, const PictureType &type )
   cFinal.relativeTo( area.blocks[compID] );
 
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( !parent && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
+  if( !parent && picture && picture->ctuSizedTempBuffers() && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
   {
     cFinal.x &= ( pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     cFinal.y &= ( pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
@@ -1208,7 +1226,7 @@ const CPelBuf CodingStructure::getBuf( const CompArea &blk, const PictureType &t
   cFinal.relativeTo( area.blocks[compID] );
 
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( !parent && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
+  if( !parent && picture && picture->ctuSizedTempBuffers() && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
   {
     cFinal.x &= ( pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     cFinal.y &= ( pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
@@ -1244,8 +1262,30 @@ const CPelUnitBuf CodingStructure::getBuf( const UnitArea &unit, const PictureTy
   }
 }
 
+#if HEVC_TILES_WPP
+bool CodingStructure::isInOtherTile( const Position &pos, const unsigned curTileIdx, const ChannelType _chType ) const
+{
+  // the tiles of a picture may be coded concurrently, the units of another tile can be incomplete and are not looked at
+  if( !picture || !picture->tileMap || picture->tileMap->numTiles == 1 )
+  {
+    return false;
+  }
+
+  const Position lumaPos = recalcPosition( area.chromaFormat, _chType, CHANNEL_TYPE_LUMA, pos );
+
+  return picture->Y().contains( lumaPos ) && picture->tileMap->getTileIdxMap( lumaPos ) != curTileIdx;
+}
+
+#endif
 const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const CodingUnit& curCu, const ChannelType _chType ) const
 {
+#if HEVC_TILES_WPP
+  if( isInOtherTile( pos, curCu.tileIdx, _chType ) )
+  {
+    return nullptr;
+  }
+
+#endif
   const CodingUnit* cu = getCU( pos, _chType );
 #if HEVC_TILES_WPP
   // exists       same slice and tile                  cu precedes curCu in encoding order
@@ -1268,6 +1308,11 @@ const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const C
 #if HEVC_TILES_WPP
 const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const unsigned curSliceIdx, const unsigned curTileIdx, const ChannelType _chType ) const
 {
+  if( isInOtherTile( pos, curTileIdx, _chType ) )
+  {
+    return nullptr;
+  }
+
   const CodingUnit* cu = getCU( pos, _chType );
   return ( cu && cu->slice->getIndependentSliceIdx() == curSliceIdx && cu->tileIdx == curTileIdx ) ? cu : nullptr;
 }
@@ -1281,6 +1326,13 @@ const CodingUnit* CodingStructure::getCURestricted(const Position &pos, const un
 
 const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, const PredictionUnit& curPu, const ChannelType _chType ) const
 {
+#if HEVC_TILES_WPP
+  if( isInOtherTile( pos, curPu.cu->tileIdx, _chType ) )
+  {
+    return nullptr;
+  }
+
+#endif
   const PredictionUnit* pu = getPU( pos, _chType );
 #if HEVC_TILES_WPP
   // exists       same slice and tile                  pu precedes curPu in encoding order
@@ -1302,6 +1354,13 @@ const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, con
 
 const TransformUnit* CodingStructure::getTURestricted( const Position &pos, const TransformUnit& curTu, const ChannelType _chType ) const
 {
+#if HEVC_TILES_WPP
+  if( isInOtherTile( pos, curTu.cu->tileIdx, _chType ) )
+  {
+    return nullptr;
+  }
+
+#endif
   const TransformUnit* tu = getTU( pos, _chType );
 #if HEVC_TILES_WPP
   // exists       same slice and tile                  tu precedes curTu in encoding order
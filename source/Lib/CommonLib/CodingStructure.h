@@ -59,8 +59,6 @@ enum PictureType
   NUM_PIC_TYPES
 };
 
-extern XUCache g_globalUnitCache;
-
 // ---------------------------------------------------------------------------
 // coding structure
 // ---------------------------------------------------------------------------
@@ -108,6 +106,7 @@ public:
 
   bool isDecomp (const Position &pos, const ChannelType _chType) const;
   bool isDecomp (const Position &pos, const ChannelType _chType);
+  bool isDecompRestricted(const Position &pos, const CodingUnit& curCu, const ChannelType _chType) const;
   void setDecomp(const CompArea &area, const bool _isCoded = true);
   void setDecomp(const UnitArea &area, const bool _isCoded = true);
 
@@ -173,6 +172,9 @@ public:
 
 private:
   void createInternals(const UnitArea& _unit, const bool isTopLayer);
+#if HEVC_TILES_WPP
+  bool isInOtherTile  (const Position &pos, const unsigned curTileIdx, const ChannelType _chType) const;
+#endif
 
 public:
 
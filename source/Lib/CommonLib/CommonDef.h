@@ -203,6 +203,12 @@ static const UInt  KLT_INTRA_MAX_CU_WITH_QTBT =                    64; ///< Max
 static const UInt  KLT_INTER_MAX_CU_WITH_QTBT =                    64; ///< Max Inter CU size applying KLT, supported values: 8, 16, 32, 64, 128
 static const UInt  KLTSPLIT_INTRA_MIN_CU =                          8; ///< Min Intra CU size applying KLT, supported values: 8, 16, 32, 64, 128
 static const UInt  KLTSPLIT_INTER_MIN_CU =                          8; ///< Min Intra CU size applying KLT, supported values: 8, 16, 32, 64, 128
+static const double KLT_FAST_COST_RATIO =                         1.1; ///< FastIntraKLT: skip the intra KLT pass if the DCT-II pass costs more than this times the best cost
+static const Int   KLT_FAST_MIN_AREA_PASSES =                       2; ///< FastIntraKLT: min number of KLT passes of an area before its KLT hit rate is used
+static const double KLT_FAST_MIN_AREA_HIT_RATE =                 0.25; ///< FastIntraKLT: skip the intra KLT pass of an area where the KLT won less often than this
+static const Int   KLT_FAST_SMOOTH_SAMPLES_PER_LEVEL =             16; ///< FastIntraKLT: skip the intra KLT pass if planar/DC was chosen with at most one luma level per this many samples
+static const Int   KLT_NUM_RD_MODES =                               3; ///< max number of intra modes full-RD checked in the KLT pass, taken in DCT-II cost order
+static const double KLT_RD_MODE_COST_RATIO =                      1.1; ///< intra modes whose DCT-II cost exceeds this times the best one are not checked in the KLT pass
 #endif
 static const Int NUM_MOST_PROBABLE_MODES =                          3;
 static const Int NUM_MOST_PROBABLE_MODES_67 =                       6;
@@ -491,8 +497,6 @@ template <typename ValueType> inline ValueType rightShift_round(const ValueType
 #endif
 
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-#include <omp.h>
-
 #define PARL_PARAM(DEF) , DEF
 #define PARL_PARAM0(DEF) DEF
 #else
@@ -113,6 +113,13 @@ InterpolationFilter::InterpolationFilter()
   m_filterCopy[1][0]   = filterCopy<true, false>;
   m_filterCopy[1][1]   = filterCopy<true, true>;
 
+  m_filter2D[0][0]     = filter2D<8, false>;
+  m_filter2D[0][1]     = filter2D<8, true>;
+  m_filter2D[1][0]     = filter2D<4, false>;
+  m_filter2D[1][1]     = filter2D<4, true>;
+  m_filter2D[2][0]     = filter2D<2, false>;
+  m_filter2D[2][1]     = filter2D<2, true>;
+
 #if ENABLE_SIMD_OPT_MCIF
 #ifdef TARGET_SIMD_X86
   initInterpolationFilterX86();
@@ -303,6 +310,34 @@ Void InterpolationFilter::filter(const ClpRng& clpRng, Pel const *src, Int srcSt
   }
 }
 
+/**
+ * \brief Filter a block of samples (horizontal and vertical)
+ *
+ * The horizontal pass covers the N - 1 additional rows needed by the vertical pass.
+ *
+ * \tparam N          Number of taps
+ * \tparam isLast     Flag indicating whether it is the last filtering operation
+ * \param  clpRng     Clipping range
+ * \param  src        Pointer to source samples
+ * \param  srcStride  Stride of source samples
+ * \param  dst        Pointer to destination samples
+ * \param  dstStride  Stride of destination samples
+ * \param  width      Width of block
+ * \param  height     Height of block
+ * \param  coeffH     Pointer to horizontal filter taps
+ * \param  coeffV     Pointer to vertical filter taps
+ */
+template<Int N, Bool isLast>
+Void InterpolationFilter::filter2D( const ClpRng& clpRng, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, TFilterCoeff const *coeffH, TFilterCoeff const *coeffV )
+{
+  CHECK( width > MAX_CU_SIZE || height > MAX_CU_SIZE, "Block too large for the intermediate buffer" );
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, Pel tmp[( MAX_CU_SIZE + N - 1 ) * MAX_CU_SIZE] );
+
+  filter<N, false, true,  false >( clpRng, src - ( N / 2 - 1 ) * srcStride, srcStride, tmp, width, width, height + N - 1, coeffH );
+  filter<N, true,  false, isLast>( clpRng, tmp + ( N / 2 - 1 ) * width,     width,     dst, dstStride, width, height,   coeffV );
+}
+
 /**
  * \brief Filter a block of samples (horizontal)
  *
@@ -453,4 +488,38 @@ Void InterpolationFilter::filterVer( const ComponentID compID, Pel const *src, I
   }
 }
 
+/**
+ * \brief Filter a block of Luma/Chroma samples at a fractional position in both directions
+ *
+ * \param  compID     Colour component ID
+ * \param  src        Pointer to source samples
+ * \param  srcStride  Stride of source samples
+ * \param  dst        Pointer to destination samples
+ * \param  dstStride  Stride of destination samples
+ * \param  width      Width of block
+ * \param  height     Height of block
+ * \param  fracX      Horizontal fractional sample offset, not zero
+ * \param  fracY      Vertical fractional sample offset, not zero
+ * \param  isLast     Flag indicating whether it is the last filtering operation
+ * \param  fmt        Chroma format
+ * \param  clpRng     Clipping range
+ */
+Void InterpolationFilter::filter2D( const ComponentID compID, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Int fracX, Int fracY, Bool isLast, const ChromaFormat fmt, const ClpRng& clpRng )
+{
+  if( isLuma( compID ) )
+  {
+    CHECK( fracX <= 0 || fracX >= ( LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS ), "Invalid fraction" );
+    CHECK( fracY <= 0 || fracY >= ( LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS ), "Invalid fraction" );
+    m_filter2D[0][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, m_lumaFilter[fracX], m_lumaFilter[fracY] );
+  }
+  else
+  {
+    const UInt csx = getComponentScaleX( compID, fmt );
+    const UInt csy = getComponentScaleY( compID, fmt );
+    CHECK( fracX <= 0 || csx >= 2 || ( fracX << ( 1 - csx ) ) >= ( CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS ), "Invalid fraction" );
+    CHECK( fracY <= 0 || csy >= 2 || ( fracY << ( 1 - csy ) ) >= ( CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS ), "Invalid fraction" );
+    m_filter2D[1][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, m_chromaFilter[fracX << ( 1 - csx )], m_chromaFilter[fracY << ( 1 - csy )] );
+  }
+}
+
 //! \}
@@ -102,6 +102,17 @@ IntraPrediction::IntraPrediction()
   }
 
   m_piTemp = nullptr;
+
+  m_predIntraAngRows   = xPredIntraAngRows;
+  m_predIntraPlanar    = xPredIntraPlanarCore;
+  m_predIntraDc        = xPredIntraDcCore;
+  m_filterRefSamplesRow = xFilterRefSamplesRow;
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+#ifdef TARGET_SIMD_X86
+  initIntraPredictionX86();
+#endif
+#endif
 }
 
 IntraPrediction::~IntraPrediction()
@@ -235,8 +246,13 @@ Void IntraPrediction::xFilterGroup(Pel* pMulDst[], Int i, Pel const * const piSr
 /** Function for deriving planar intra prediction. This function derives the prediction samples for planar mode (intra coding).
  */
 
-//NOTE: Bit-Limit - 24-bit source
 Void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst, const SPS& sps )
+{
+  m_predIntraPlanar( pSrc, pDst );
+}
+
+//NOTE: Bit-Limit - 24-bit source
+Void IntraPrediction::xPredIntraPlanarCore( const CPelBuf &pSrc, PelBuf &pDst )
 {
   const UInt width  = pDst.width;
   const UInt height = pDst.height;
@@ -296,8 +312,7 @@ Void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst, const
 
 Void IntraPrediction::xPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const bool enableBoundaryFilter )
 {
-  const Pel dcval = xGetPredValDc( pSrc, pDst );
-  pDst.fill( dcval );
+  m_predIntraDc( pSrc, pDst );
 
 #if HEVC_USE_DC_PREDFILTERING
   if( enableBoundaryFilter )
@@ -307,6 +322,12 @@ Void IntraPrediction::xPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const Cha
 #endif
 }
 
+Void IntraPrediction::xPredIntraDcCore( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const Pel dcval = xGetPredValDc( pSrc, pDst );
+  pDst.fill( dcval );
+}
+
 #if HEVC_USE_DC_PREDFILTERING
 /** Function for filtering intra DC predictor. This function performs filtering left and top edges of the prediction samples for DC mode (intra coding).
  */
@@ -429,15 +450,10 @@ Void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   }
 
 
+  m_predIntraAngRows( pDstBuf, dstStride, refMain, width, height, intraPredAngle );
+
   if( intraPredAngle == 0 )  // pure vertical or pure horizontal
   {
-    for( Int y = 0; y < height; y++ )
-    {
-      for( Int x = 0; x < width; x++ )
-      {
-        pDstBuf[y*dstStride + x] = refMain[x + 1];
-      }
-    }
 #if HEVC_USE_HOR_VER_PREDFILTERING
     if (edgeFilter)
     {
@@ -450,36 +466,6 @@ Void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   }
   else
   {
-    Pel *pDsty=pDstBuf;
-
-    for (Int y=0, deltaPos=intraPredAngle; y<height; y++, deltaPos+=intraPredAngle, pDsty+=dstStride)
-    {
-      const Int deltaInt   = deltaPos >> 5;
-      const Int deltaFract = deltaPos & (32 - 1);
-
-      if( absAng < 32 )
-      {
-        {
-          // Do linear filtering
-          const Pel *pRM = refMain + deltaInt + 1;
-          Int lastRefMainPel = *pRM++;
-          for( Int x = 0; x < width; pRM++, x++ )
-          {
-            Int thisRefMainPel = *pRM;
-            pDsty[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
-            lastRefMainPel = thisRefMainPel;
-          }
-        }
-      }
-      else
-      {
-        // Just copy the integer samples
-        for( Int x = 0; x < width; x++ )
-        {
-          pDsty[x] = refMain[x + deltaInt + 1];
-        }
-      }
-    }
 #if HEVC_USE_HOR_VER_PREDFILTERING
     if( edgeFilter && absAng <= 1 )
     {
@@ -505,6 +491,46 @@ Void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   }
 }
 
+/** Angular prediction of the rows of a vertical mode, horizontal modes are predicted transposed.
+*
+* Row y is projected onto the main reference with the displacement (y + 1) * intraPredAngle at 1/32 sample accuracy.
+* A zero angle copies the reference row, an angle of +-32 copies the integer samples.
+*/
+Void IntraPrediction::xPredIntraAngRows( Pel* pDst, const Int dstStride, const Pel* refMain, const Int width, const Int height, const Int intraPredAngle )
+{
+  const Int absAng = abs( intraPredAngle );
+  Pel *pDsty = pDst;
+
+  for (Int y=0, deltaPos=intraPredAngle; y<height; y++, deltaPos+=intraPredAngle, pDsty+=dstStride)
+  {
+    const Int deltaInt   = deltaPos >> 5;
+    const Int deltaFract = deltaPos & (32 - 1);
+
+    if( absAng < 32 )
+    {
+      {
+        // Do linear filtering
+        const Pel *pRM = refMain + deltaInt + 1;
+        Int lastRefMainPel = *pRM++;
+        for( Int x = 0; x < width; pRM++, x++ )
+        {
+          Int thisRefMainPel = *pRM;
+          pDsty[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
+          lastRefMainPel = thisRefMainPel;
+        }
+      }
+    }
+    else
+    {
+      // Just copy the integer samples
+      for( Int x = 0; x < width; x++ )
+      {
+        pDsty[x] = refMain[x + deltaInt + 1];
+      }
+    }
+  }
+}
+
 void IntraPrediction::xReferenceFilter( const int doubleSize, const int origWeight, const int filterOrder, Pel *piRefVector, Pel *piLowPassRef )
 {
   const int imCoeff[3][4] =
@@ -836,14 +862,21 @@ void IntraPrediction::xFilterReferenceSamples( const Pel* refBufUnfiltered, Pel*
   piDestPtr++;
   piSrcPtr++;
   //top row (left-to-right)
-  for( UInt i=1; i < predSize; i++, piDestPtr++, piSrcPtr++ )
-  {
-    *piDestPtr = (piSrcPtr[1] + 2 * piSrcPtr[0] + piSrcPtr[-1] + 2) >> 2;
-  }
+  m_filterRefSamplesRow( piSrcPtr, piDestPtr, predSize - 1 );
+  piDestPtr += predSize - 1;
+  piSrcPtr  += predSize - 1;
   // top right (not filtered)
   *piDestPtr=*piSrcPtr;
 }
 
+Void IntraPrediction::xFilterRefSamplesRow( const Pel* pSrc, Pel* pDst, const Int num )
+{
+  for( Int i = 0; i < num; i++ )
+  {
+    pDst[i] = (pSrc[i + 1] + 2 * pSrc[i] + pSrc[i - 1] + 2) >> 2;
+  }
+}
+
 bool IntraPrediction::useFilteredIntraRefSamples( const ComponentID &compID, const PredictionUnit &pu, bool modeSpecific, const UnitArea &tuArea )
 {
   const SPS         &sps    = *pu.cs->sps;
@@ -871,7 +904,7 @@ Bool isAboveLeftAvailable(const CodingUnit &cu, const ChannelType &chType, const
 {
   const CodingStructure& cs = *cu.cs;
   const Position refPos = posLT.offset(-1, -1);
-  const CodingUnit* pcCUAboveLeft = cs.isDecomp( refPos, chType ) ? cs.getCURestricted( refPos, cu, chType ) : nullptr;
+  const CodingUnit* pcCUAboveLeft = cs.isDecompRestricted( refPos, cu, chType ) ? cs.getCURestricted( refPos, cu, chType ) : nullptr;
   const Bool isConstrained = cs.pps->getConstrainedIntraPred();
   Bool bAboveLeftFlag;
 
@@ -899,7 +932,7 @@ Int isAboveAvailable(const CodingUnit &cu, const ChannelType &chType, const Posi
   {
     const Position refPos = posLT.offset(dx, -1);
 
-    const CodingUnit* pcCUAbove = cs.isDecomp(refPos, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
+    const CodingUnit* pcCUAbove = cs.isDecompRestricted(refPos, cu, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
 
     if( pcCUAbove && ( ( isConstrained && CU::isIntra( *pcCUAbove ) ) || !isConstrained ) )
     {
@@ -928,7 +961,7 @@ Int isLeftAvailable(const CodingUnit &cu, const ChannelType &chType, const Posit
   {
     const Position refPos = posLT.offset(-1, dy);
 
-    const CodingUnit* pcCULeft = cs.isDecomp(refPos, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
+    const CodingUnit* pcCULeft = cs.isDecompRestricted(refPos, cu, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
 
     if( pcCULeft && ( ( isConstrained && CU::isIntra( *pcCULeft ) ) || !isConstrained ) )
     {
@@ -959,7 +992,7 @@ Int isAboveRightAvailable(const CodingUnit &cu, const ChannelType &chType, const
   {
     const Position refPos = posRT.offset(unitWidth + dx, -1);
 
-    const CodingUnit* pcCUAbove = cs.isDecomp(refPos, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
+    const CodingUnit* pcCUAbove = cs.isDecompRestricted(refPos, cu, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
 
     if( pcCUAbove && ( ( isConstrained && CU::isIntra( *pcCUAbove ) ) || !isConstrained ) )
     {
@@ -989,7 +1022,7 @@ Int isBelowLeftAvailable(const CodingUnit &cu, const ChannelType &chType, const
   {
     const Position refPos = posLB.offset(-1, unitHeight + dy);
 
-    const CodingUnit* pcCULeft = cs.isDecomp(refPos, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
+    const CodingUnit* pcCULeft = cs.isDecompRestricted(refPos, cu, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
 
     if( pcCULeft && ( ( isConstrained && CU::isIntra( *pcCULeft ) ) || !isConstrained ) )
     {
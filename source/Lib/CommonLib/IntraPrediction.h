@@ -86,7 +86,7 @@ protected:
 #else
   Void xPredIntraAng              ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const UInt dirMode, const ClpRng& clpRng, const SPS& sps, const bool enableBoundaryFilter = true );
 #endif
-  Pel  xGetPredValDc              ( const CPelBuf &pSrc, const Size &dstSize );
+  static Pel xGetPredValDc        ( const CPelBuf &pSrc, const Size &dstSize );
 
   void xFillReferenceSamples      ( const CPelBuf &recoBuf,      Pel* refBufUnfiltered, const CompArea &area, const CodingUnit &cu );
   void xFilterReferenceSamples    ( const Pel* refBufUnfiltered, Pel* refBufFiltered, const CompArea &area, const SPS &sps );
@@ -100,7 +100,34 @@ protected:
   Void destroy                    ();
 
   Void xFilterGroup               ( Pel* pMulDst[], Int i, Pel const* const piSrc, Int iRecStride, Bool bAboveAvaillable, Bool bLeftAvaillable);
+
 public:
+  // prediction kernels, the scalar versions are replaced by SIMD ones in initIntraPredictionX86
+  static Void xPredIntraAngRows    ( Pel* pDst, const Int dstStride, const Pel* refMain, const Int width, const Int height, const Int intraPredAngle );
+  static Void xPredIntraPlanarCore ( const CPelBuf &pSrc, PelBuf &pDst );
+  static Void xPredIntraDcCore     ( const CPelBuf &pSrc, PelBuf &pDst );
+  static Void xFilterRefSamplesRow ( const Pel* pSrc, Pel* pDst, const Int num );
+
+  Void ( *m_predIntraAngRows )     ( Pel* pDst, const Int dstStride, const Pel* refMain, const Int width, const Int height, const Int intraPredAngle );
+  Void ( *m_predIntraPlanar )      ( const CPelBuf &pSrc, PelBuf &pDst );
+  Void ( *m_predIntraDc )          ( const CPelBuf &pSrc, PelBuf &pDst );
+  Void ( *m_filterRefSamplesRow )  ( const Pel* pSrc, Pel* pDst, const Int num );
+
+#ifdef TARGET_SIMD_X86
+  template< X86_VEXT vext >
+  static Void xPredIntraAngRows_SIMD    ( Pel* pDst, const Int dstStride, const Pel* refMain, const Int width, const Int height, const Int intraPredAngle );
+  template< X86_VEXT vext >
+  static Void xPredIntraPlanar_SIMD     ( const CPelBuf &pSrc, PelBuf &pDst );
+  template< X86_VEXT vext >
+  static Void xPredIntraDc_SIMD         ( const CPelBuf &pSrc, PelBuf &pDst );
+  template< X86_VEXT vext >
+  static Void xFilterRefSamplesRow_SIMD ( const Pel* pSrc, Pel* pDst, const Int num );
+
+  Void initIntraPredictionX86();
+  template <X86_VEXT vext>
+  Void _initIntraPredictionX86();
+#endif
+
   IntraPrediction();
   virtual ~IntraPrediction();
 
@@ -0,0 +1,241 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KLTMatrixFile.cpp
+    \brief    loading / writing of the separable KLT matrix sets from / to a binary file
+*/
+
+#include "KLTMatrixFile.h"
+#include "Rom.h"
+#include "libmd5/MD5.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#if !_WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//! \ingroup CommonLib
+//! \{
+
+#if SEPARABLE_KLT
+static const UChar  KLT_MATRIX_FILE_MAGIC[4]    = { 'K', 'L', 'T', 'M' };
+static const UInt   KLT_MATRIX_FILE_HDR_SIZE    = 16 + MD5_DIGEST_STRING_LENGTH;
+static const UInt   KLT_MATRIX_FILE_NUM_SIZES   = 5;
+static const UInt   KLT_MATRIX_FILE_NUM_COEFFS  = 2 * 2 * ( 4 * 4 + 8 * 8 + 16 * 16 + 32 * 32 + 64 * 64 );
+static const UInt   KLT_MATRIX_FILE_PAYLOAD     = KLT_MATRIX_FILE_NUM_COEFFS * 2;
+
+/// table order of the payload
+static Void getKLTMatrixTables( TMatrixCoeff* tables[2 * KLT_MATRIX_FILE_NUM_SIZES], UInt sizes[2 * KLT_MATRIX_FILE_NUM_SIZES] )
+{
+  TMatrixCoeff* tab[2 * KLT_MATRIX_FILE_NUM_SIZES] =
+  {
+    g_aiKLT4  [0][0], g_aiKLT8  [0][0], g_aiKLT16  [0][0], g_aiKLT32  [0][0], g_aiKLT64  [0][0],
+    g_aiKLT4HP[0][0], g_aiKLT8HP[0][0], g_aiKLT16HP[0][0], g_aiKLT32HP[0][0], g_aiKLT64HP[0][0],
+  };
+
+  for( UInt i = 0; i < 2 * KLT_MATRIX_FILE_NUM_SIZES; i++ )
+  {
+    tables[i] = tab[i];
+    sizes [i] = 4 << ( i % KLT_MATRIX_FILE_NUM_SIZES );
+  }
+}
+
+static inline UInt readUInt32( const UChar* p )
+{
+  return UInt( p[0] ) | ( UInt( p[1] ) << 8 ) | ( UInt( p[2] ) << 16 ) | ( UInt( p[3] ) << 24 );
+}
+
+static inline Void writeUInt32( UChar* p, UInt val )
+{
+  p[0] = UChar( val ); p[1] = UChar( val >> 8 ); p[2] = UChar( val >> 16 ); p[3] = UChar( val >> 24 );
+}
+
+/// validates the header and the checksum of the file content and copies the matrices into the KLT tables
+static Bool parseKLTMatrixFile( const UChar* data, size_t size, const std::string &fileName )
+{
+  if( size < KLT_MATRIX_FILE_HDR_SIZE || memcmp( data, KLT_MATRIX_FILE_MAGIC, 4 ) )
+  {
+    msg( ERROR, "Error: %s is not a KLT matrix file\n", fileName.c_str() );
+    return true;
+  }
+
+  const UInt version     = readUInt32( data +  4 );
+  const UInt numSizes    = readUInt32( data +  8 );
+  const UInt payloadSize = readUInt32( data + 12 );
+
+  if( version != KLT_MATRIX_FILE_VERSION || numSizes != KLT_MATRIX_FILE_NUM_SIZES || payloadSize != KLT_MATRIX_FILE_PAYLOAD )
+  {
+    msg( ERROR, "Error: KLT matrix file %s has an unsupported format (version %u, %u sizes, %u bytes)\n", fileName.c_str(), version, numSizes, payloadSize );
+    return true;
+  }
+  if( size != KLT_MATRIX_FILE_HDR_SIZE + payloadSize )
+  {
+    msg( ERROR, "Error: KLT matrix file %s is truncated or has trailing data\n", fileName.c_str() );
+    return true;
+  }
+
+  const UChar* payload = data + KLT_MATRIX_FILE_HDR_SIZE;
+  UChar digest[MD5_DIGEST_STRING_LENGTH];
+  MD5 md5;
+  md5.update( const_cast<UChar*>( payload ), payloadSize );
+  md5.finalize( digest );
+
+  if( memcmp( digest, data + 16, MD5_DIGEST_STRING_LENGTH ) )
+  {
+    msg( ERROR, "Error: checksum mismatch in KLT matrix file %s\n", fileName.c_str() );
+    return true;
+  }
+
+  TMatrixCoeff* tables[2 * KLT_MATRIX_FILE_NUM_SIZES];
+  UInt          sizes [2 * KLT_MATRIX_FILE_NUM_SIZES];
+  getKLTMatrixTables( tables, sizes );
+
+  for( UInt t = 0; t < 2 * KLT_MATRIX_FILE_NUM_SIZES; t++ )
+  {
+    const UInt numCoeffs = 2 * sizes[t] * sizes[t];
+
+    for( UInt i = 0; i < numCoeffs; i++, payload += 2 )
+    {
+      tables[t][i] = TMatrixCoeff( Short( UInt( payload[0] ) | ( UInt( payload[1] ) << 8 ) ) );
+    }
+  }
+
+  return false;
+}
+
+Bool loadKLTMatrixFile( const std::string &fileName )
+{
+#if _WIN32
+  FILE* file = fopen( fileName.c_str(), "rb" );
+  if( file == NULL )
+  {
+    msg( ERROR, "Error: cannot open KLT matrix file %s\n", fileName.c_str() );
+    return true;
+  }
+
+  std::vector<UChar> data( KLT_MATRIX_FILE_HDR_SIZE + KLT_MATRIX_FILE_PAYLOAD + 1 );
+  const size_t size = fread( data.data(), 1, data.size(), file );
+  fclose( file );
+
+  return parseKLTMatrixFile( data.data(), size, fileName );
+#else
+  const Int fd = open( fileName.c_str(), O_RDONLY );
+  if( fd < 0 )
+  {
+    msg( ERROR, "Error: cannot open KLT matrix file %s\n", fileName.c_str() );
+    return true;
+  }
+
+  struct stat st;
+  if( fstat( fd, &st ) || st.st_size <= 0 )
+  {
+    close( fd );
+    msg( ERROR, "Error: cannot read KLT matrix file %s\n", fileName.c_str() );
+    return true;
+  }
+
+  const size_t size = size_t( st.st_size );
+  Void* data        = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  close( fd );
+
+  if( data == MAP_FAILED )
+  {
+    msg( ERROR, "Error: cannot map KLT matrix file %s\n", fileName.c_str() );
+    return true;
+  }
+
+  const Bool error = parseKLTMatrixFile( ( const UChar* ) data, size, fileName );
+  munmap( data, size );
+
+  return error;
+#endif
+}
+
+Bool writeKLTMatrixFile( const std::string &fileName )
+{
+  std::vector<UChar> data( KLT_MATRIX_FILE_HDR_SIZE + KLT_MATRIX_FILE_PAYLOAD );
+
+  TMatrixCoeff* tables[2 * KLT_MATRIX_FILE_NUM_SIZES];
+  UInt          sizes [2 * KLT_MATRIX_FILE_NUM_SIZES];
+  getKLTMatrixTables( tables, sizes );
+
+  UChar* payload = &data[KLT_MATRIX_FILE_HDR_SIZE];
+
+  for( UInt t = 0; t < 2 * KLT_MATRIX_FILE_NUM_SIZES; t++ )
+  {
+    const UInt numCoeffs = 2 * sizes[t] * sizes[t];
+
+    for( UInt i = 0; i < numCoeffs; i++, payload += 2 )
+    {
+      const Int coeff = tables[t][i];
+      CHECK( coeff < -32768 || coeff > 32767, "KLT matrix coefficient exceeds 16 bit" );
+      payload[0] = UChar( coeff );
+      payload[1] = UChar( coeff >> 8 );
+    }
+  }
+
+  memcpy( &data[0], KLT_MATRIX_FILE_MAGIC, 4 );
+  writeUInt32( &data[ 4], KLT_MATRIX_FILE_VERSION );
+  writeUInt32( &data[ 8], KLT_MATRIX_FILE_NUM_SIZES );
+  writeUInt32( &data[12], KLT_MATRIX_FILE_PAYLOAD );
+
+  MD5 md5;
+  md5.update( &data[KLT_MATRIX_FILE_HDR_SIZE], KLT_MATRIX_FILE_PAYLOAD );
+  md5.finalize( &data[16] );
+
+  FILE* file = fopen( fileName.c_str(), "wb" );
+  if( file == NULL )
+  {
+    msg( ERROR, "Error: cannot create KLT matrix file %s\n", fileName.c_str() );
+    return true;
+  }
+
+  const Bool error = fwrite( data.data(), 1, data.size(), file ) != data.size();
+  fclose( file );
+
+  if( error )
+  {
+    msg( ERROR, "Error: cannot write KLT matrix file %s\n", fileName.c_str() );
+  }
+
+  return error;
+}
+#endif
+
+//! \}
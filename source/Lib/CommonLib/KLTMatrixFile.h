@@ -0,0 +1,71 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KLTMatrixFile.h
+    \brief    loading / writing of the separable KLT matrix sets from / to a binary file (header)
+*/
+
+#ifndef __KLTMATRIXFILE__
+#define __KLTMATRIXFILE__
+
+#include "CommonDef.h"
+
+#include <string>
+
+//! \ingroup CommonLib
+//! \{
+
+#if SEPARABLE_KLT
+// ====================================================================================================================
+// KLT matrix file
+// ====================================================================================================================
+
+/**
+ * Layout of a KLT matrix file (all fields little-endian):
+ *   header  : magic "KLTM", UInt32 version, UInt32 number of matrix sizes, UInt32 payload size in bytes,
+ *             16 byte MD5 digest of the payload
+ *   payload : Int16 coefficients of g_aiKLT4..g_aiKLT64, followed by g_aiKLT4HP..g_aiKLT64HP,
+ *             each table stored as [inter, intra][row][column]
+ * The encoder and the decoder have to use the same file, the matrices are not signalled in the bitstream.
+ */
+static const UInt KLT_MATRIX_FILE_VERSION = 1;
+
+/// replaces the built-in KLT matrices by the ones of the given file, returns true on error
+Bool loadKLTMatrixFile ( const std::string &fileName );
+/// writes the currently active KLT matrices to the given file, returns true on error
+Bool writeKLTMatrixFile( const std::string &fileName );
+#endif
+
+//! \}
+
+#endif
@@ -106,6 +106,14 @@ static bool isAvailable( const CodingUnit& cu, const CodingUnit& cu2, const bool
 
 LoopFilter::LoopFilter()
 {
+  m_edgeFilterLumaSegs   = xEdgeFilterLumaSegs;
+  m_edgeFilterChromaSegs = xEdgeFilterChromaSegs;
+
+#if ENABLE_SIMD_OPT_DBLF
+#ifdef TARGET_SIMD_X86
+  initLoopFilterX86();
+#endif
+#endif
 }
 
 LoopFilter::~LoopFilter()
@@ -160,59 +168,13 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
 
   for( int y = 0; y < pcv.heightInCtus; y++ )
   {
-    for( int x = 0; x < pcv.widthInCtus; x++ )
-    {
-      memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
-      {
-        xDeblockCU( currCU, EDGE_VER );
-      }
-
-      if( CS::isDualITree( cs ) )
-      {
-        memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_VER );
-        }
-      }
-    }
+    xDeblockCtuLine( cs, y, EDGE_VER );
   }
 
   // Vertical filtering
   for( int y = 0; y < pcv.heightInCtus; y++ )
   {
-    for( int x = 0; x < pcv.widthInCtus; x++ )
-    {
-      memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
-      {
-        xDeblockCU( currCU, EDGE_HOR );
-      }
-
-      if( CS::isDualITree( cs ) )
-      {
-        memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_HOR );
-        }
-      }
-    }
+    xDeblockCtuLine( cs, y, EDGE_HOR );
   }
 
   DTRACE_PIC_COMP(D_REC_CB_LUMA_LF,   cs, cs.getRecoBuf(), COMPONENT_Y);
@@ -223,6 +185,49 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
   DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
 }
 
+/**
+ - deblock a CTU line of the picture, which reads and modifies the samples of the CTU line above
+ - the horizontal edges of the CTU line above have to be filtered, the edges of the lines below must not be
+ .
+ \param cs        the picture level coding structure
+ \param ctuYPos   the CTU line
+ */
+void LoopFilter::loopFilterCtuLine( CodingStructure& cs, const int ctuYPos )
+{
+  xDeblockCtuLine( cs, ctuYPos, EDGE_VER );
+  xDeblockCtuLine( cs, ctuYPos, EDGE_HOR );
+}
+
+void LoopFilter::xDeblockCtuLine( CodingStructure& cs, const int ctuYPos, const DeblockEdgeDir edgeDir )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+
+  for( int x = 0; x < pcv.widthInCtus; x++ )
+  {
+    memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+    memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+
+    const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, ctuYPos << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
+
+    // CU-based deblocking
+    for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+    {
+      xDeblockCU( currCU, edgeDir );
+    }
+
+    if( CS::isDualITree( cs ) )
+    {
+      memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+      memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+
+      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
+      {
+        xDeblockCU( currCU, edgeDir );
+      }
+    }
+  }
+}
+
 
 // ====================================================================================================================
 // Protected member functions
@@ -505,6 +510,13 @@ Void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
   }
 
   const int iBitdepthScale = 1 << (bitDepthLuma - 8);
+  const unsigned uiBlocksInPart = pelsInPart / 4 ? pelsInPart / 4 : 1;
+
+  // the parameters of the four line segments of the edge, collected to filter them in one batch
+  LFSegParam aSegParams[MAX_CU_SIZE / 4];
+  int        iNumSegs = 0;
+
+  CHECKD( uiNumParts * uiBlocksInPart > MAX_CU_SIZE / 4, "Too many edge segments" );
 
   // dec pos since within the loop we first calc the pos
   for( int iIdx = 0; iIdx < uiNumParts; iIdx++ )
@@ -544,54 +556,36 @@ Void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
 
       const int iTc       = sm_tcTable  [iIndexTC] * iBitdepthScale;
       const int iBeta     = sm_betaTable[iIndexB ] * iBitdepthScale;
-      const int iSideThreshold = ( iBeta + ( iBeta >> 1 ) ) >> 3;
-      const int iThrCut   = iTc * 10;
 
-      const unsigned uiBlocksInPart = pelsInPart / 4 ? pelsInPart / 4 : 1;
+      bPartPNoFilter = bPartQNoFilter = false;
+      if( bPCMFilter )
+      {
+        // Check if each of PUs is I_PCM with LF disabling
+        bPartPNoFilter = cuP.ipcm;
+        bPartQNoFilter = cuQ.ipcm;
+      }
+      if( ppsTransquantBypassEnabledFlag )
+      {
+        // check if each of PUs is lossless coded
+        bPartPNoFilter = bPartPNoFilter || cuP.transQuantBypass;
+        bPartQNoFilter = bPartQNoFilter || cuQ.transQuantBypass;
+      }
 
       for( int iBlkIdx = 0; iBlkIdx < uiBlocksInPart; iBlkIdx++ )
       {
-        const int dp0 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dq0 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dp3 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        const int dq3 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        const int d0 = dp0 + dq0;
-        const int d3 = dp3 + dq3;
-
-        const int dp = dp0 + dp3;
-        const int dq = dq0 + dq3;
-        const int d  = d0  + d3;
-
-        bPartPNoFilter = bPartQNoFilter = false;
-        if( bPCMFilter )
-        {
-          // Check if each of PUs is I_PCM with LF disabling
-          bPartPNoFilter = cuP.ipcm;
-          bPartQNoFilter = cuQ.ipcm;
-        }
-        if( ppsTransquantBypassEnabledFlag )
-        {
-          // check if each of PUs is lossless coded
-          bPartPNoFilter = bPartPNoFilter || cuP.transQuantBypass;
-          bPartQNoFilter = bPartQNoFilter || cuQ.transQuantBypass;
-        }
-
-        if( d < iBeta )
-        {
-          const bool bFilterP = (dp < iSideThreshold);
-          const bool bFilterQ = (dq < iSideThreshold);
-
-          const bool sw = xUseStrongFiltering( piTmpSrc + iSrcStep * ( iIdx*pelsInPart + iBlkIdx * 4 + 0 ), iOffset, 2 * d0, iBeta, iTc )
-                       && xUseStrongFiltering( piTmpSrc + iSrcStep * ( iIdx*pelsInPart + iBlkIdx * 4 + 3 ), iOffset, 2 * d3, iBeta, iTc );
-
-          for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
-          {
-            xPelFilterLuma( piTmpSrc + iSrcStep*( iIdx*pelsInPart + iBlkIdx * 4 + i ), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
-          }
-        }
+        aSegParams[iNumSegs++] = LFSegParam{ iBeta, iTc, bPartPNoFilter, bPartQNoFilter };
+      }
+    }
+    else
+    {
+      for( int iBlkIdx = 0; iBlkIdx < uiBlocksInPart; iBlkIdx++ )
+      {
+        aSegParams[iNumSegs++] = LFSegParam{ 0, 0, false, false };
       }
     }
   }
+
+  m_edgeFilterLumaSegs( piTmpSrc, iSrcStep, iOffset, aSegParams, iNumSegs, clpRng );
 }
 
 
@@ -672,6 +666,11 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
 
   const int iBitdepthScale = 1 << (sps.getBitDepth(CHANNEL_TYPE_CHROMA) - 8);
 
+  // the parameters of the segments of the edge per chroma component, collected to filter them in one batch
+  LFSegParam aSegParams[2][MAX_CU_SIZE / 4];
+
+  CHECKD( uiNumParts > MAX_CU_SIZE / 4, "Too many edge segments" );
+
   for( int iIdx = 0; iIdx < uiNumParts; iIdx++ )
   {
     pos.x += xoffset;
@@ -718,9 +717,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
 
       for( int chromaIdx = 0; chromaIdx < 2; chromaIdx++ )
       {
-        const ClpRng& clpRng( cu.cs->slice->clpRng( ComponentID( chromaIdx + 1 )) );
         const int chromaQPOffset = pps.getQpOffset( ComponentID( chromaIdx + 1 ) );
-        Pel* piTmpSrcChroma = (chromaIdx == 0) ? piTmpSrcCb : piTmpSrcCr;
 
         int iQP = ( ( cuP.qp + cuQ.qp + 1 ) >> 1 ) + chromaQPOffset;
         if (iQP >= chromaQPMappingTableSize)
@@ -742,12 +739,21 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
         const int iIndexTC = Clip3<int>( 0, MAX_QP + DEFAULT_INTRA_TC_OFFSET, iQP + DEFAULT_INTRA_TC_OFFSET*( ucBs - 1 ) + ( tcOffsetDiv2 << 1 ) );
         const int iTc      = sm_tcTable[iIndexTC] * iBitdepthScale;
 
-        for( unsigned uiStep = 0; uiStep < uiLoopLength; uiStep++ )
-        {
-          xPelFilterChroma( piTmpSrcChroma + iSrcStep*( uiStep + iIdx*uiLoopLength ), iOffset, iTc, bPartPNoFilter, bPartQNoFilter, clpRng );
-        }
+        aSegParams[chromaIdx][iIdx] = LFSegParam{ 0, iTc, bPartPNoFilter, bPartQNoFilter };
       }
     }
+    else
+    {
+      aSegParams[0][iIdx] = aSegParams[1][iIdx] = LFSegParam{ 0, 0, false, false };
+    }
+  }
+
+  for( int chromaIdx = 0; chromaIdx < 2; chromaIdx++ )
+  {
+    const ClpRng& clpRng( cu.cs->slice->clpRng( ComponentID( chromaIdx + 1 ) ) );
+    Pel* piTmpSrcChroma = ( chromaIdx == 0 ) ? piTmpSrcCb : piTmpSrcCr;
+
+    m_edgeFilterChromaSegs( piTmpSrcChroma, iSrcStep, iOffset, uiLoopLength, aSegParams[chromaIdx], uiNumParts, clpRng );
   }
 }
 
@@ -767,7 +773,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
  \param bFilterSecondQ  decision weak filter/no filter for partQ
  \param bitDepthLuma    luma bit depth
 */
-inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng ) const
+inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng )
 {
   int delta;
 
@@ -839,7 +845,7 @@ inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int
  \param bPartQNoFilter  indicator to disable filtering on partQ
  \param bitDepthChroma  chroma bit depth
  */
-inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const int tc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng ) const
+inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const int tc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng )
 {
   int delta;
 
@@ -871,7 +877,7 @@ inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const i
  \param tc              tc value
  \param piSrc           pointer to picture data
  */
-inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc ) const
+inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc )
 {
   const Pel m4 = piSrc[ 0          ];
   const Pel m3 = piSrc[-iOffset    ];
@@ -883,14 +889,120 @@ inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, cons
   return ( ( d_strong < ( beta >> 3 ) ) && ( d < ( beta >> 2 ) ) && ( abs( m3 - m4 ) < ( ( tc * 5 + 1 ) >> 1 ) ) );
 }
 
-inline int LoopFilter::xCalcDP( Pel* piSrc, const int iOffset ) const
+inline int LoopFilter::xCalcDP( Pel* piSrc, const int iOffset )
 {
   return abs( piSrc[-iOffset * 3] - 2 * piSrc[-iOffset * 2] + piSrc[-iOffset] );
 }
 
-inline int LoopFilter::xCalcDQ( Pel* piSrc, const int iOffset ) const
+inline int LoopFilter::xCalcDQ( Pel* piSrc, const int iOffset )
 {
   return abs( piSrc[0] - 2 * piSrc[iOffset] + piSrc[iOffset * 2] );
 }
 
+/**
+ - Deblocking decision and filtering of one luma edge segment of four lines
+ .
+ \param piSrc           pointer to the first line of the segment (first sample of partQ)
+ \param iSrcStep        step between the lines of the segment
+ \param iOffset         offset value across the edge
+ \param iBeta           beta value
+ \param iTc             tc value
+ \param bPartPNoFilter  indicator to disable filtering on partP
+ \param bPartQNoFilter  indicator to disable filtering on partQ
+ */
+void LoopFilter::xEdgeFilterLumaSeg( Pel* piSrc, const int iSrcStep, const int iOffset, const int iBeta, const int iTc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng )
+{
+  const int dp0 = xCalcDP( piSrc,                iOffset );
+  const int dq0 = xCalcDQ( piSrc,                iOffset );
+  const int dp3 = xCalcDP( piSrc + iSrcStep * 3, iOffset );
+  const int dq3 = xCalcDQ( piSrc + iSrcStep * 3, iOffset );
+  const int d0  = dp0 + dq0;
+  const int d3  = dp3 + dq3;
+
+  const int dp  = dp0 + dp3;
+  const int dq  = dq0 + dq3;
+  const int d   = d0  + d3;
+
+  if( d < iBeta )
+  {
+    const int iSideThreshold = ( iBeta + ( iBeta >> 1 ) ) >> 3;
+    const int iThrCut        = iTc * 10;
+
+    const bool bFilterP = (dp < iSideThreshold);
+    const bool bFilterQ = (dq < iSideThreshold);
+
+    const bool sw = xUseStrongFiltering( piSrc,                iOffset, 2 * d0, iBeta, iTc )
+                 && xUseStrongFiltering( piSrc + iSrcStep * 3, iOffset, 2 * d3, iBeta, iTc );
+
+    for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
+    {
+      xPelFilterLuma( piSrc + iSrcStep * i, iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
+    }
+  }
+}
+
+/**
+ - Deblocking of one chroma edge segment
+ .
+ \param piSrc           pointer to the first line of the segment (first sample of partQ)
+ \param iSrcStep        step between the lines of the segment
+ \param iOffset         offset value across the edge
+ \param iNumLines       number of lines in the segment
+ \param iTc             tc value
+ \param bPartPNoFilter  indicator to disable filtering on partP
+ \param bPartQNoFilter  indicator to disable filtering on partQ
+ */
+void LoopFilter::xEdgeFilterChromaSeg( Pel* piSrc, const int iSrcStep, const int iOffset, const int iNumLines, const int iTc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng )
+{
+  for( int i = 0; i < iNumLines; i++ )
+  {
+    xPelFilterChroma( piSrc + iSrcStep * i, iOffset, iTc, bPartPNoFilter, bPartQNoFilter, clpRng );
+  }
+}
+
+/**
+ - Deblocking of the consecutive luma edge segments of one edge
+ .
+ \param piSrc           pointer to the first line of the first segment (first sample of partQ)
+ \param iSrcStep        step between the lines of the segments
+ \param iOffset         offset value across the edge
+ \param pSegs           parameters of the segments, a segment with tc 0 is left unchanged
+ \param iNumSegs        number of segments of four lines
+ */
+void LoopFilter::xEdgeFilterLumaSegs( Pel* piSrc, const int iSrcStep, const int iOffset, const LFSegParam* pSegs, const int iNumSegs, const ClpRng& clpRng )
+{
+  for( int i = 0; i < iNumSegs; i++ )
+  {
+    const LFSegParam& seg = pSegs[i];
+
+    if( seg.iTc )
+    {
+      xEdgeFilterLumaSeg( piSrc + iSrcStep * 4 * i, iSrcStep, iOffset, seg.iBeta, seg.iTc, seg.bPartPNoFilter, seg.bPartQNoFilter, clpRng );
+    }
+  }
+}
+
+/**
+ - Deblocking of the consecutive chroma edge segments of one edge
+ .
+ \param piSrc           pointer to the first line of the first segment (first sample of partQ)
+ \param iSrcStep        step between the lines of the segments
+ \param iOffset         offset value across the edge
+ \param iNumLines       number of lines per segment
+ \param pSegs           parameters of the segments, a segment with tc 0 is left unchanged
+ \param iNumSegs        number of segments
+ */
+void LoopFilter::xEdgeFilterChromaSegs( Pel* piSrc, const int iSrcStep, const int iOffset, const int iNumLines, const LFSegParam* pSegs, const int iNumSegs, const ClpRng& clpRng )
+{
+  for( int i = 0; i < iNumSegs; i++ )
+  {
+    const LFSegParam& seg = pSegs[i];
+
+    if( seg.iTc )
+    {
+      xEdgeFilterChromaSeg( piSrc + iSrcStep * iNumLines * i, iSrcStep, iOffset, iNumLines, seg.iTc, seg.bPartPNoFilter, seg.bPartQNoFilter, clpRng );
+    }
+  }
+}
+
 //! \}
@@ -62,6 +62,8 @@ private:
 private:
   /// CU-level deblocking function
   void xDeblockCU                 (       CodingUnit& cu, const DeblockEdgeDir edgeDir );
+  /// deblocking of the edges of one direction in a CTU line
+  void xDeblockCtuLine            ( CodingStructure& cs, const int ctuYPos, const DeblockEdgeDir edgeDir );
 
   // set / get functions
   void xSetLoopfilterParam        ( const CodingUnit& cu );
@@ -79,18 +81,40 @@ private:
   void xEdgeFilterLuma            ( const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge );
   void xEdgeFilterChroma          ( const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge );
 
-  inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng ) const;
-  inline void xPelFilterChroma    ( Pel* piSrc, const int iOffset, const int tc,                const bool bPartPNoFilter, const bool bPartQNoFilter,                                                                          const ClpRng& clpRng ) const;
+  static inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng );
+  static inline void xPelFilterChroma    ( Pel* piSrc, const int iOffset, const int tc,                const bool bPartPNoFilter, const bool bPartQNoFilter,                                                                          const ClpRng& clpRng );
 
-  inline bool xUseStrongFiltering ( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc ) const;
-  inline int xCalcDP              ( Pel* piSrc, const int iOffset ) const;
-  inline int xCalcDQ              ( Pel* piSrc, const int iOffset ) const;
+  static inline bool xUseStrongFiltering ( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc );
+  static inline int xCalcDP              ( Pel* piSrc, const int iOffset );
+  static inline int xCalcDQ              ( Pel* piSrc, const int iOffset );
+
+public:
+  // edge segment kernels, the segments of one edge are filtered in a batch, the scalar versions are replaced by SIMD
+  // ones in initLoopFilterX86
+  static void xEdgeFilterLumaSeg         ( Pel* piSrc, const int iSrcStep, const int iOffset, const int iBeta, const int iTc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng );
+  static void xEdgeFilterChromaSeg       ( Pel* piSrc, const int iSrcStep, const int iOffset, const int iNumLines, const int iTc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng );
+  static void xEdgeFilterLumaSegs        ( Pel* piSrc, const int iSrcStep, const int iOffset,                      const LFSegParam* pSegs, const int iNumSegs, const ClpRng& clpRng );
+  static void xEdgeFilterChromaSegs      ( Pel* piSrc, const int iSrcStep, const int iOffset, const int iNumLines, const LFSegParam* pSegs, const int iNumSegs, const ClpRng& clpRng );
+
+  void ( *m_edgeFilterLumaSegs )         ( Pel* piSrc, const int iSrcStep, const int iOffset,                      const LFSegParam* pSegs, const int iNumSegs, const ClpRng& clpRng );
+  void ( *m_edgeFilterChromaSegs )       ( Pel* piSrc, const int iSrcStep, const int iOffset, const int iNumLines, const LFSegParam* pSegs, const int iNumSegs, const ClpRng& clpRng );
+
+#ifdef TARGET_SIMD_X86
+  template< X86_VEXT vext >
+  static void xEdgeFilterLumaSeg_SIMD    ( Pel* piSrc, const int iSrcStep, const int iOffset, const int iBeta, const int iTc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng );
+  template< X86_VEXT vext >
+  static void xEdgeFilterLumaSegs_SIMD   ( Pel* piSrc, const int iSrcStep, const int iOffset,                      const LFSegParam* pSegs, const int iNumSegs, const ClpRng& clpRng );
+  template< X86_VEXT vext >
+  static void xEdgeFilterChromaSegs_SIMD ( Pel* piSrc, const int iSrcStep, const int iOffset, const int iNumLines, const LFSegParam* pSegs, const int iNumSegs, const ClpRng& clpRng );
+
+  void initLoopFilterX86();
+  template< X86_VEXT vext >
+  void _initLoopFilterX86();
+#endif
 
   static const UChar sm_tcTable[54];
   static const UChar sm_betaTable[52];
 
-public:
-
   LoopFilter();
   ~LoopFilter();
 
@@ -100,6 +124,8 @@ public:
   /// picture-level deblocking filter
   void loopFilterPic              ( CodingStructure& cs
                                     );
+  /// CTU line deblocking filter, the lines have to be filtered top to bottom
+  void loopFilterCtuLine          ( CodingStructure& cs, const int ctuYPos );
 
   static int getBeta              ( const int qp )
   {
@@ -126,28 +126,25 @@ private:
 #endif
 #endif
 
-int g_wppThreadId( 0 );
-#pragma omp threadprivate(g_wppThreadId)
+// the ids of the row / split task the calling thread works on, set by the task before it starts encoding
+thread_local int g_wppThreadId( 0 );
 
 #if ENABLE_SPLIT_PARALLELISM
-int g_splitThreadId( 0 );
-#pragma omp threadprivate(g_splitThreadId)
+thread_local int g_splitThreadId( 0 );
 
-int g_splitJobId( 0 );
-#pragma omp threadprivate(g_splitJobId)
+thread_local int g_splitJobId( 0 );
 #endif
 
 Scheduler::Scheduler() :
 #if ENABLE_WPP_PARALLELISM
   m_numWppThreads( 1 ),
-  m_numWppDataInstances( 1 )
-#endif
-#if ENABLE_SPLIT_PARALLELISM && ENABLE_WPP_PARALLELISM
-  ,
+  m_numWppDataInstances( 1 ),
 #endif
 #if ENABLE_SPLIT_PARALLELISM
-  m_numSplitThreads( 1 )
+  m_numSplitThreads( 1 ),
+  m_hasParallelBuffer( false ),
 #endif
+  m_firstDataId( 0 )
 {
 }
 
@@ -169,11 +166,11 @@ unsigned Scheduler::getSplitDataId( int jobId ) const
   {
     int splitJobId = jobId == CURR_THREAD_ID ? g_splitJobId : jobId;
 
-    return ( g_wppThreadId * NUM_RESERVERD_SPLIT_JOBS ) + splitJobId;
+    return m_firstDataId + ( g_wppThreadId * NUM_RESERVERD_SPLIT_JOBS ) + splitJobId;
   }
   else
   {
-    return 0;
+    return m_firstDataId;
   }
 }
 
@@ -221,7 +218,7 @@ void Scheduler::finishParallel()
 
 void Scheduler::setSplitThreadId( const int tId )
 {
-  g_splitThreadId = tId == CURR_THREAD_ID ? omp_get_thread_num() : tId;
+  g_splitThreadId = tId;
 }
 
 #endif
@@ -235,14 +232,14 @@ unsigned Scheduler::getWppDataId( int lID ) const
 #if ENABLE_SPLIT_PARALLELISM
   if( m_numSplitThreads > 1 )
   {
-    return tId * NUM_RESERVERD_SPLIT_JOBS;
+    return m_firstDataId + tId * NUM_RESERVERD_SPLIT_JOBS;
   }
   else
   {
-    return tId;
+    return m_firstDataId + tId;
   }
 #else
-  return tId;
+  return m_firstDataId + tId;
 #endif
 }
 
@@ -253,9 +250,9 @@ unsigned Scheduler::getWppThreadId() const
 
 void Scheduler::setWppThreadId( const int tId )
 {
-  g_wppThreadId = tId == CURR_THREAD_ID ? omp_get_thread_num() : tId;
+  CHECK( tId < 0 || tId >= m_numWppDataInstances, "The WPP thread ID " << tId << " is invalid!" );
 
-  CHECK( g_wppThreadId >= PARL_WPP_MAX_NUM_THREADS, "The WPP thread ID " << g_wppThreadId << " is invalid!" );
+  g_wppThreadId = tId;
 }
 #endif
 
@@ -273,7 +270,7 @@ unsigned Scheduler::getDataId() const
     return getWppDataId();
   }
 #endif
-  return 0;
+  return m_firstDataId;
 }
 
 bool Scheduler::init( const int ctuYsize, const int ctuXsize, const int numWppThreadsRunning, const int numWppExtraLines, const int numSplitThreads )
@@ -724,6 +721,16 @@ Picture::Picture()
   layer                = std::numeric_limits<UInt>::max();
   fieldPic             = false;
   topField             = false;
+#if !KEEP_PRED_AND_RESI_SIGNALS
+  m_ctuSizedTempBufs   = true;
+#endif
+#if ENABLE_SPLIT_PARALLELISM
+  m_bufs.resize( 1 );
+#endif
+#if ENABLE_FRAME_PARALLELISM
+  encCodingIdx         = -1;
+  encCABACTableIdx     = I_SLICE;
+#endif
   for( int i = 0; i < MAX_NUM_CHANNEL_TYPE; i++ )
   {
     m_prevQP[i] = -1;
@@ -750,11 +757,7 @@ Void Picture::create(const ChromaFormat &_chromaFormat, const Size &size, const
 Void Picture::destroy()
 {
 #if ENABLE_SPLIT_PARALLELISM
-#if ENABLE_WPP_PARALLELISM
-  for( int jId = 0; jId < ( PARL_SPLIT_MAX_NUM_THREADS * PARL_WPP_MAX_NUM_THREADS ); jId++ )
-#else
-  for( int jId = 0; jId < PARL_SPLIT_MAX_NUM_THREADS; jId++ )
-#endif
+  for( int jId = 0; jId < (int)m_bufs.size(); jId++ )
 #endif
   for (UInt t = 0; t < NUM_PIC_TYPES; t++)
   {
@@ -790,17 +793,25 @@ Void Picture::destroy()
 #endif
 }
 
-Void Picture::createTempBuffers( const unsigned _maxCUSize )
+Void Picture::createTempBuffers( const unsigned _maxCUSize, const bool _fullPicture )
 {
 #if KEEP_PRED_AND_RESI_SIGNALS
   const Area a( Position{ 0, 0 }, lumaSize() );
 #else
-  const Area a = m_ctuArea.Y();
+  // CTUs reconstructed concurrently need their own prediction and residual samples
+  m_ctuSizedTempBufs = !_fullPicture;
+
+  const Area a = _fullPicture ? Area( Position{ 0, 0 }, lumaSize() ) : m_ctuArea.Y();
 #endif
 
 #if ENABLE_SPLIT_PARALLELISM
   scheduler.startParallel();
 
+  if( (int)m_bufs.size() < scheduler.getNumPicInstances() )
+  {
+    m_bufs.resize( scheduler.getNumPicInstances() );
+  }
+
   for( int jId = 0; jId < scheduler.getNumPicInstances(); jId++ )
 #endif
   {
@@ -886,7 +897,7 @@ Void Picture::finalInit( const SPS& sps, const PPS& pps )
   }
   else
   {
-    cs = new CodingStructure( g_globalUnitCache.cuCache, g_globalUnitCache.puCache, g_globalUnitCache.tuCache );
+    cs = new CodingStructure( unitCache.cuCache, unitCache.puCache, unitCache.tuCache );
     cs->sps = &sps;
     cs->create( chromaFormatIDC, Area( 0, 0, iWidth, iHeight ), true );
   }
@@ -1043,7 +1054,7 @@ PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
 
 #endif
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( type == PIC_RESIDUAL || type == PIC_PREDICTION )
+  if( ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) && m_ctuSizedTempBufs )
   {
     CompArea localBlk = blk;
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
@@ -1068,7 +1079,7 @@ const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) co
 
 #endif
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( type == PIC_RESIDUAL || type == PIC_PREDICTION )
+  if( ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) && m_ctuSizedTempBufs )
   {
     CompArea localBlk = blk;
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
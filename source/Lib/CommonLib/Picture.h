@@ -47,6 +47,7 @@
 #include "Slice.h"
 #include "CodingStructure.h"
 
+#include <array>
 #include <deque>
 
 #if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
@@ -70,17 +71,18 @@ public:
   void     setSplitJobId ( const int jobId );
   void     startParallel ();
   void     finishParallel();
-  void     setSplitThreadId( const int tId = CURR_THREAD_ID );
+  void     setSplitThreadId( const int tId );
   unsigned getNumSplitThreads() const { return m_numSplitThreads; };
 #endif
 #if ENABLE_WPP_PARALLELISM
   unsigned getWppDataId  ( int lId = CURR_THREAD_ID ) const;
   unsigned getWppThreadId() const;
-  void     setWppThreadId( const int tId = CURR_THREAD_ID );
+  void     setWppThreadId( const int tId );
 #endif
   unsigned getDataId     () const;
   bool init              ( const int ctuYsize, const int ctuXsize, const int numWppThreadsRunning, const int numWppExtraLines, const int numSplitThreads );
   int  getNumPicInstances() const;
+  void setFirstDataId    ( const int dataId ) { m_firstDataId = dataId; }
 #if ENABLE_WPP_PARALLELISM
   void setReady          ( const int ctuPosX, const int ctuPosY );
   void wait              ( const int ctuPosX, const int ctuPosY );
@@ -106,6 +108,7 @@ private:
   int   m_numSplitThreads;
   bool  m_hasParallelBuffer;
 #endif
+  int   m_firstDataId;    // first data structure of the picture, the pictures compressed concurrently use separate ranges
 };
 #endif
 
@@ -183,8 +186,11 @@ struct Picture : public UnitArea
   Void create(const ChromaFormat &_chromaFormat, const Size &size, const unsigned _maxCUSize, const unsigned margin, const bool bDecoder);
   Void destroy();
 
-  Void createTempBuffers( const unsigned _maxCUSize );
+  Void createTempBuffers( const unsigned _maxCUSize, const bool _fullPicture = false );
   Void destroyTempBuffers();
+#if !KEEP_PRED_AND_RESI_SIGNALS
+  bool ctuSizedTempBuffers() const { return m_ctuSizedTempBufs; }
+#endif
 
          PelBuf     getOrigBuf(const CompArea &blk);
   const CPelBuf     getOrigBuf(const CompArea &blk) const;
@@ -235,21 +241,22 @@ public:
   bool topField;
   bool fieldPic;
   int  m_prevQP[MAX_NUM_CHANNEL_TYPE];
+#if ENABLE_FRAME_PARALLELISM
+  Int       encCodingIdx;       ///< position of the picture in the coding order of the encoder
+  SliceType encCABACTableIdx;   ///< CABAC table chosen when the picture was written, used by the pictures predicting from it
+#endif
 
   Int  poc;
   UInt layer;
   UInt depth;
 
 #if ENABLE_SPLIT_PARALLELISM
-#if ENABLE_WPP_PARALLELISM
-  PelStorage m_bufs[( PARL_SPLIT_MAX_NUM_JOBS * PARL_WPP_MAX_NUM_THREADS )][NUM_PIC_TYPES];
-#else
-  PelStorage m_bufs[PARL_SPLIT_MAX_NUM_JOBS][NUM_PIC_TYPES];
-#endif
+  std::deque<std::array<PelStorage, NUM_PIC_TYPES>> m_bufs;   ///< one set per picture instance, grows with the number of instances but never moves
 #else
   PelStorage m_bufs[NUM_PIC_TYPES];
 #endif
 
+  XUCache            unitCache;   ///< units of the picture level coding structure, not shared so that pictures can be coded concurrently
   CodingStructure*   cs;
   std::deque<Slice*> slices;
   SEIMessages        SEIs;
@@ -266,6 +273,7 @@ public:
 #if !KEEP_PRED_AND_RESI_SIGNALS
 private:
   UnitArea m_ctuArea;
+  bool     m_ctuSizedTempBufs;
 #endif
 
 #if ENABLE_SPLIT_PARALLELISM
@@ -126,6 +126,16 @@ Quant::Quant( const Quant* other )
 {
 #if HEVC_USE_SCALING_LISTS
   xInitScalingList( other );
+#endif
+
+  m_quantCore     = xQuantCore;
+  m_dequantCore   = xDeQuantCore;
+  m_rdoqLevelCore = xRdoqLevelCore;
+
+#if ENABLE_SIMD_OPT_QUANT
+#ifdef TARGET_SIMD_X86
+  initQuantX86();
+#endif
 #endif
 }
 
@@ -340,38 +350,11 @@ Void Quant::dequant(const TransformUnit &tu,
     const UInt uiLog2TrHeight = g_aucLog2[uiHeight];
     Int *piDequantCoef        = getDequantCoeff(scalingListType, QP_rem, uiLog2TrWidth - 1, uiLog2TrHeight - 1);
 
-    if(rightShift > 0)
-    {
-      const Intermediate_Int iAdd = 1 << (rightShift - 1);
-
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
 #if HM_QTBT_AS_IN_JEM_QUANT
-        const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * piDequantCoef[n] * NEScale) + iAdd ) >> rightShift;
+    m_dequantCore( piQCoef, piCoef, numSamplesInBlock, piDequantCoef, NEScale, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
 #else
-        const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * piDequantCoef[n]) + iAdd ) >> rightShift;
+    m_dequantCore( piQCoef, piCoef, numSamplesInBlock, piDequantCoef, 1,       rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
 #endif
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
-    {
-      const Int leftShift = -rightShift;
-
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-#if HM_QTBT_AS_IN_JEM_QUANT
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * piDequantCoef[n] * NEScale) << leftShift;
-#else
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * piDequantCoef[n]) << leftShift;
-#endif
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
   }
   else
   {
@@ -390,30 +373,7 @@ Void Quant::dequant(const TransformUnit &tu,
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
-    if (rightShift > 0)
-    {
-      const Intermediate_Int iAdd = 1 << (rightShift - 1);
-
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale + iAdd) >> rightShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
-    {
-      const Int leftShift = -rightShift;
-
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale) << leftShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
+    m_dequantCore( piQCoef, piCoef, numSamplesInBlock, nullptr, scale, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
 #if HEVC_USE_SCALING_LISTS
   }
 #endif
@@ -423,8 +383,9 @@ Void Quant::init( UInt uiMaxTrSize,
                   Bool bUseRDOQ,
                   Bool bUseRDOQTS,
 #if T0196_SELECTIVE_RDOQ
-                  Bool useSelectiveRDOQ
+                  Bool useSelectiveRDOQ,
 #endif
+                  Bool useRDOQSkipZeroCG
                   )
 {
 
@@ -437,9 +398,10 @@ Void Quant::init( UInt uiMaxTrSize,
 #if T0196_SELECTIVE_RDOQ
   m_useSelectiveRDOQ     = useSelectiveRDOQ;
 #endif
+  m_useRDOQSkipZeroCG    = useRDOQSkipZeroCG;
 }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_KLT_PARALLELISM
 void Quant::copyState( const Quant& other )
 {
   m_dLambda = other.m_dLambda;
@@ -735,6 +697,8 @@ Void Quant::quant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf
 
 #if HEVC_USE_SIGN_HIDING
     TCoeff deltaU[MAX_TU_SIZE * MAX_TU_SIZE];
+#else
+    TCoeff* const deltaU = nullptr;
 #endif
 #if HEVC_USE_SCALING_LISTS
     Int scalingListType = getScalingListType(tu.cu->predMode, compID);
@@ -773,31 +737,16 @@ Void Quant::quant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf
     // QBits will be OK for any internal bit depth as the reduction in transform shift is balanced by an increase in Qp_per due to QpBDOffset
 
     const Int64 iAdd = Int64(tu.cs->slice->getSliceType() == I_SLICE ? 171 : 85) << Int64(iQBits - 9);
-#if HEVC_USE_SIGN_HIDING
-    const Int qBits8 = iQBits - 8;
-#endif
 
-    for (Int uiBlockPos = 0; uiBlockPos < piQCoef.area(); uiBlockPos++)
-    {
-      const TCoeff iLevel   = piCoef.buf[uiBlockPos];
-      const TCoeff iSign    = (iLevel < 0 ? -1: 1);
+    // the inverse KLT bounds its region with the last significant position, sign data hiding never moves it further
+    const UInt *piScanPos = g_scanOrderInv[cctx.scanType()][gp_sizeIdxInfo->idxFrom( rect.width )][gp_sizeIdxInfo->idxFrom( rect.height )];
+    tu.lastPos[compID]    = -1;
 
 #if HEVC_USE_SCALING_LISTS
-      const Int64  tmpLevel = (Int64)abs(iLevel) * (enableScalingLists ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
+    m_quantCore( piCoef.buf, piQCoef.buf, deltaU, piQCoef.area(), enableScalingLists ? piQuantCoeff : nullptr, defaultQuantisationCoefficient, iWHScale, iQBits, iAdd, entropyCodingMinimum, entropyCodingMaximum, piScanPos, uiAbsSum, tu.lastPos[compID] );
 #else
-      const Int64  tmpLevel = (Int64)abs(iLevel) * defaultQuantisationCoefficient;
+    m_quantCore( piCoef.buf, piQCoef.buf, deltaU, piQCoef.area(), nullptr, defaultQuantisationCoefficient, iWHScale, iQBits, iAdd, entropyCodingMinimum, entropyCodingMaximum, piScanPos, uiAbsSum, tu.lastPos[compID] );
 #endif
-
-      const TCoeff quantisedMagnitude = TCoeff((tmpLevel * iWHScale + iAdd ) >> iQBits);
-#if HEVC_USE_SIGN_HIDING
-      deltaU[uiBlockPos] = (TCoeff)((tmpLevel * iWHScale - ((Int64)quantisedMagnitude<<iQBits) )>> qBits8);
-#endif
-
-      uiAbsSum += quantisedMagnitude;
-      const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
-
-      piQCoef.buf[uiBlockPos] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedCoefficient );
-    } // for n
 #if HEVC_USE_SIGN_HIDING
     if( cctx.signHiding() && uiWidth>=4 && uiHeight>=4 )
     {
@@ -811,6 +760,92 @@ Void Quant::quant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf
   //return;
 }
 
+/** quantisation of numCoeff coefficients, the quantisation coefficient is piQuantCoeff[n] or quantScale when no
+ *  scaling list is given, deltaU receives the rounding residuals used by sign data hiding, it is null without,
+ *  iLastScanPos is raised to the scan position piScanPos[n] of each non-zero level
+ */
+Void Quant::xQuantCore( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* deltaU, const Int numCoeff, const Int* piQuantCoeff, const Int quantScale, const Int iWHScale, const Int iQBits, const Int64 iAdd, const TCoeff clipMin, const TCoeff clipMax, const UInt* piScanPos, TCoeff& uiAbsSum, Int& iLastScanPos )
+{
+  const Int qBits8 = iQBits - 8;
+
+  for( Int uiBlockPos = 0; uiBlockPos < numCoeff; uiBlockPos++ )
+  {
+    const TCoeff iLevel   = piCoef[uiBlockPos];
+    const TCoeff iSign    = (iLevel < 0 ? -1: 1);
+
+    const Int64  tmpLevel = (Int64)abs(iLevel) * (piQuantCoeff ? piQuantCoeff[uiBlockPos] : quantScale);
+
+    const TCoeff quantisedMagnitude = TCoeff((tmpLevel * iWHScale + iAdd ) >> iQBits);
+    if( deltaU )
+    {
+      deltaU[uiBlockPos] = (TCoeff)((tmpLevel * iWHScale - ((Int64)quantisedMagnitude<<iQBits) )>> qBits8);
+    }
+
+    uiAbsSum += quantisedMagnitude;
+    const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
+
+    if( quantisedMagnitude )
+    {
+      iLastScanPos = std::max<Int>( iLastScanPos, piScanPos[uiBlockPos] );
+    }
+
+    piQCoef[uiBlockPos] = Clip3<TCoeff>( clipMin, clipMax, quantisedCoefficient );
+  }
+}
+
+/** de-quantisation of numCoeff coefficients, the scaling factor is piDequantCoeff[n] * scale or scale when no
+ *  scaling list is given
+ */
+Void Quant::xDeQuantCore( const TCoeff* piQCoef, TCoeff* piCoef, const Int numCoeff, const Int* piDequantCoeff, const Int scale, const Int rightShift, const Intermediate_Int inputMin, const Intermediate_Int inputMax, const TCoeff clipMin, const TCoeff clipMax )
+{
+  if( rightShift > 0 )
+  {
+    const Intermediate_Int iAdd = 1 << (rightShift - 1);
+
+    for( Int n = 0; n < numCoeff; n++ )
+    {
+      const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMin, inputMax, piQCoef[n]));
+      const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * (piDequantCoeff ? piDequantCoeff[n] * scale : scale) + iAdd) >> rightShift;
+
+      piCoef[n] = TCoeff(Clip3<Intermediate_Int>(clipMin, clipMax, iCoeffQ));
+    }
+  }
+  else
+  {
+    const Int leftShift = -rightShift;
+
+    for( Int n = 0; n < numCoeff; n++ )
+    {
+      const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMin, inputMax, piQCoef[n]));
+      const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * (piDequantCoeff ? piDequantCoeff[n] * scale : scale)) << leftShift;
+
+      piCoef[n] = TCoeff(Clip3<Intermediate_Int>(clipMin, clipMax, iCoeffQ));
+    }
+  }
+}
+
+/** RDOQ level estimation of numCoeff coefficients, returns the scaled levels, the rounded levels clipped to maxLevel and
+ *  the distortion of coding the coefficients as zero, the error scale is pdErrScale[n] * errScale or errScale when no
+ *  scaling list is given
+ */
+Void Quant::xRdoqLevelCore( const TCoeff* piCoef, Intermediate_Int* piLevelDouble, UInt* piMaxAbsLevel, Double* pdCostCoeff0, const Int numCoeff, const Int* piQuantCoeff, const Int quantScale, const Double* pdErrScale, const Double errScale, const Int iQBits, const UInt maxLevel )
+{
+  const Intermediate_Int iAdd           = Intermediate_Int( 1 ) << ( iQBits - 1 );
+  const Int64            maxLevelDouble = std::numeric_limits<Intermediate_Int>::max() - iAdd;
+
+  for( Int n = 0; n < numCoeff; n++ )
+  {
+    const Int64            tmpLevel     = Int64( abs( piCoef[n] ) ) * ( piQuantCoeff ? piQuantCoeff[n] : quantScale );
+    const Intermediate_Int lLevelDouble = ( Intermediate_Int ) std::min<Int64>( tmpLevel, maxLevelDouble );
+
+    piLevelDouble[n] = lLevelDouble;
+    piMaxAbsLevel[n] = std::min<UInt>( maxLevel, UInt( ( lLevelDouble + iAdd ) >> iQBits ) );
+
+    const Double dErr = Double( lLevelDouble );
+    pdCostCoeff0[n]   = dErr * dErr * ( pdErrScale ? pdErrScale[n] * errScale : errScale );
+  }
+}
+
 Bool Quant::xNeedRDOQ(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, const QpParam &cQP)
 {
   const SPS &sps            = *tu.cs->sps;
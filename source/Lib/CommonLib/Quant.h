@@ -93,8 +93,9 @@ public:
                      Bool useRDOQ = false,
                      Bool useRDOQTS = false,
 #if T0196_SELECTIVE_RDOQ
-                     Bool useSelectiveRDOQ = false
+                     Bool useSelectiveRDOQ = false,
 #endif
+                     Bool useRDOQSkipZeroCG = false
                      );
 
 public:
@@ -130,7 +131,7 @@ public:
   // de-quantization
   virtual Void dequant           ( const TransformUnit &tu, CoeffBuf &dstCoeff, const ComponentID &compID, const QpParam &cQP );
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_KLT_PARALLELISM
   virtual void copyState         ( const Quant& other );
 #endif
 
@@ -147,6 +148,7 @@ protected:
 #if T0196_SELECTIVE_RDOQ
   Bool     m_useSelectiveRDOQ;
 #endif
+  Bool     m_useRDOQSkipZeroCG;
 #if HEVC_USE_SCALING_LISTS
 private:
   Void xInitScalingList   ( const Quant* other );
@@ -160,6 +162,40 @@ private:
   Void xSignBitHidingHDQ  (TCoeff* pQCoef, const TCoeff* pCoef, TCoeff* deltaU, const CoeffCodingContext& cctx, const Int maxLog2TrDynamicRange);
 #endif
 
+public:
+  // per coefficient quantisation and de-quantisation, the scalar versions are replaced by SIMD ones in initQuantX86
+  static Void xQuantCore  ( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* deltaU, const Int numCoeff, const Int* piQuantCoeff, const Int quantScale, const Int iWHScale, const Int iQBits, const Int64 iAdd, const TCoeff clipMin, const TCoeff clipMax, const UInt* piScanPos, TCoeff& uiAbsSum, Int& iLastScanPos );
+  static Void xDeQuantCore( const TCoeff* piQCoef, TCoeff* piCoef, const Int numCoeff, const Int* piDequantCoeff, const Int scale, const Int rightShift, const Intermediate_Int inputMin, const Intermediate_Int inputMax, const TCoeff clipMin, const TCoeff clipMax );
+
+  Void ( *m_quantCore   ) ( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* deltaU, const Int numCoeff, const Int* piQuantCoeff, const Int quantScale, const Int iWHScale, const Int iQBits, const Int64 iAdd, const TCoeff clipMin, const TCoeff clipMax, const UInt* piScanPos, TCoeff& uiAbsSum, Int& iLastScanPos );
+  Void ( *m_dequantCore ) ( const TCoeff* piQCoef, TCoeff* piCoef, const Int numCoeff, const Int* piDequantCoeff, const Int scale, const Int rightShift, const Intermediate_Int inputMin, const Intermediate_Int inputMax, const TCoeff clipMin, const TCoeff clipMax );
+
+#if ENABLE_SIMD_OPT_QUANT
+#ifdef TARGET_SIMD_X86
+  Void initQuantX86();
+  template< X86_VEXT vext >
+  Void _initQuantX86();
+#endif
+#endif
+
+protected:
+  // per coefficient level estimation of the RDOQ, the scalar version is replaced by a SIMD one in initQuantX86
+  static Void xRdoqLevelCore( const TCoeff* piCoef, Intermediate_Int* piLevelDouble, UInt* piMaxAbsLevel, Double* pdCostCoeff0, const Int numCoeff, const Int* piQuantCoeff, const Int quantScale, const Double* pdErrScale, const Double errScale, const Int iQBits, const UInt maxLevel );
+
+  Void ( *m_rdoqLevelCore ) ( const TCoeff* piCoef, Intermediate_Int* piLevelDouble, UInt* piMaxAbsLevel, Double* pdCostCoeff0, const Int numCoeff, const Int* piQuantCoeff, const Int quantScale, const Double* pdErrScale, const Double errScale, const Int iQBits, const UInt maxLevel );
+
+private:
+#if ENABLE_SIMD_OPT_QUANT
+#ifdef TARGET_SIMD_X86
+  template< X86_VEXT vext >
+  static Void xQuantCore_SIMD  ( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* deltaU, const Int numCoeff, const Int* piQuantCoeff, const Int quantScale, const Int iWHScale, const Int iQBits, const Int64 iAdd, const TCoeff clipMin, const TCoeff clipMax, const UInt* piScanPos, TCoeff& uiAbsSum, Int& iLastScanPos );
+  template< X86_VEXT vext >
+  static Void xDeQuantCore_SIMD( const TCoeff* piQCoef, TCoeff* piCoef, const Int numCoeff, const Int* piDequantCoeff, const Int scale, const Int rightShift, const Intermediate_Int inputMin, const Intermediate_Int inputMax, const TCoeff clipMin, const TCoeff clipMax );
+  template< X86_VEXT vext >
+  static Void xRdoqLevelCore_SIMD( const TCoeff* piCoef, Intermediate_Int* piLevelDouble, UInt* piMaxAbsLevel, Double* pdCostCoeff0, const Int numCoeff, const Int* piQuantCoeff, const Int quantScale, const Double* pdErrScale, const Double errScale, const Int iQBits, const UInt maxLevel );
+#endif
+#endif
+
 private:
 #if RDOQ_CHROMA_LAMBDA
   Double   m_lambdas[MAX_NUM_COMPONENT];
@@ -101,11 +101,13 @@ QuantRDOQ::~QuantRDOQ()
  *
  * \returns best quantized transform level for given scan position
  *
- * This method calculates the best quantized transform level for a given scan position.
+ * This method calculates the best quantized transform level for a given scan position. The level rate of the chosen
+ * level is returned in riCodedRate, it is reused by the sign data hiding.
  */
 inline UInt QuantRDOQ::xGetCodedLevel  ( Double&            rd64CodedCost,
                                        Double&            rd64CodedCost0,
                                        Double&            rd64CodedCostSig,
+                                       Int&               riCodedRate,
                                        Intermediate_Int   lLevelDouble,
                                        UInt               uiMaxAbsLevel,
                                        const BinFracBits* fracBitsSig,
@@ -124,6 +126,8 @@ inline UInt QuantRDOQ::xGetCodedLevel  ( Double&            rd64CodedCost,
   Double dCurrCostSig   = 0;
   UInt   uiBestAbsLevel = 0;
 
+  riCodedRate           = 0;
+
   if( !bLast && uiMaxAbsLevel < 3 )
   {
     rd64CodedCostSig    = xGetRateSigCoef( *fracBitsSig, 0 );
@@ -147,7 +151,8 @@ inline UInt QuantRDOQ::xGetCodedLevel  ( Double&            rd64CodedCost,
   for( Int uiAbsLevel  = uiMaxAbsLevel; uiAbsLevel >= uiMinAbsLevel ; uiAbsLevel-- )
   {
     Double dErr         = Double( lLevelDouble  - ( Intermediate_Int(uiAbsLevel) << iQBits ) );
-    Double dCurrCost    = dErr * dErr * errorScale + xGetICost( xGetICRate( uiAbsLevel, fracBitsOne, fracBitsAbs, ui16AbsGoRice, c1Idx, c2Idx, useLimitedPrefixLength, maxLog2TrDynamicRange ) );
+    Int    iRate        = xGetICRate( uiAbsLevel, fracBitsOne, fracBitsAbs, ui16AbsGoRice, c1Idx, c2Idx, useLimitedPrefixLength, maxLog2TrDynamicRange );
+    Double dCurrCost    = dErr * dErr * errorScale + xGetICost( iRate );
     dCurrCost          += dCurrCostSig;
 
     if( dCurrCost < rd64CodedCost )
@@ -155,6 +160,7 @@ inline UInt QuantRDOQ::xGetCodedLevel  ( Double&            rd64CodedCost,
       uiBestAbsLevel    = uiAbsLevel;
       rd64CodedCost     = dCurrCost;
       rd64CodedCostSig  = dCurrCostSig;
+      riCodedRate       = iRate;
     }
   }
 
@@ -517,6 +523,7 @@ Void QuantRDOQ::quant(TransformUnit &tu, const ComponentID &compID, const CCoeff
     {
       piQCoef.fill(0);
       uiAbsSum = 0;
+      tu.lastPos[compID] = -1;
     }
 #endif
   }
@@ -590,16 +597,6 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
   TCoeff *deltaU       = m_deltaU;
 #endif
 
-  memset( m_pdCostCoeff,  0, sizeof( Double ) *  uiMaxNumCoeff );
-  memset( m_pdCostSig,    0, sizeof( Double ) *  uiMaxNumCoeff );
-#if HEVC_USE_SIGN_HIDING
-  memset( m_rateIncUp,    0, sizeof( Int    ) *  uiMaxNumCoeff );
-  memset( m_rateIncDown,  0, sizeof( Int    ) *  uiMaxNumCoeff );
-  memset( m_sigRateDelta, 0, sizeof( Int    ) *  uiMaxNumCoeff );
-  memset( m_deltaU,       0, sizeof( TCoeff ) *  uiMaxNumCoeff );
-#endif
-
-
   const Int iQBits = QUANT_SHIFT + cQP.per + iTransformShift;                   // Right shift of non-RDOQ quantizer;  level = (coeff*uiQ + offset)>>q_bits
 
 #if HEVC_USE_SCALING_LISTS
@@ -632,6 +629,43 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
 #endif
   const TCoeff entropyCodingMaximum =  (1 << maxLog2TrDynamicRange) - 1;
 
+  // quantise all coefficients upfront, the scaled levels, the maximal levels and the uncoded costs are kept in block order
+#if HEVC_USE_SCALING_LISTS
+#if HM_QTBT_AS_IN_JEM_QUANT
+  m_rdoqLevelCore( plSrcCoeff, m_levelDouble, m_maxAbsLevel, m_pdCostCoeff0Blk, uiMaxNumCoeff, enableScalingLists ? piQCoef : nullptr, defaultQuantisationCoefficient,
+                   enableScalingLists ? pdErrScale : nullptr, enableScalingLists ? 1.0 : defaultErrorScale, iQBits, UInt( entropyCodingMaximum ) );
+#else
+  m_rdoqLevelCore( plSrcCoeff, m_levelDouble, m_maxAbsLevel, m_pdCostCoeff0Blk, uiMaxNumCoeff, enableScalingLists ? piQCoef : nullptr, defaultQuantisationCoefficient,
+                   enableScalingLists ? pdErrScale : nullptr, enableScalingLists ? blkErrScale : defaultErrorScale, iQBits, UInt( entropyCodingMaximum ) );
+#endif
+#else
+  m_rdoqLevelCore( plSrcCoeff, m_levelDouble, m_maxAbsLevel, m_pdCostCoeff0Blk, uiMaxNumCoeff, nullptr, quantisationCoefficient, nullptr, errorScale, iQBits, UInt( entropyCodingMaximum ) );
+#endif
+
+  {
+    UInt uiMaxLevelOr = 0;
+    for( UInt n = 0; n < uiMaxNumCoeff; n++ )
+    {
+      uiMaxLevelOr |= m_maxAbsLevel[n];
+    }
+    if( uiMaxLevelOr == 0 )
+    {
+      // all coefficients are quantised to zero, there is no last position to optimise
+      memset( piDstCoeff, 0, sizeof( TCoeff ) * uiMaxNumCoeff );
+      tu.lastPos[compID] = -1;
+      return;
+    }
+  }
+
+  memset( m_pdCostCoeff,  0, sizeof( Double ) *  uiMaxNumCoeff );
+  memset( m_pdCostSig,    0, sizeof( Double ) *  uiMaxNumCoeff );
+#if HEVC_USE_SIGN_HIDING
+  memset( m_rateIncUp,    0, sizeof( Int    ) *  uiMaxNumCoeff );
+  memset( m_rateIncDown,  0, sizeof( Int    ) *  uiMaxNumCoeff );
+  memset( m_sigRateDelta, 0, sizeof( Int    ) *  uiMaxNumCoeff );
+  memset( m_deltaU,       0, sizeof( TCoeff ) *  uiMaxNumCoeff );
+#endif
+
 #if HEVC_USE_SIGN_HIDING
   CoeffCodingContext cctx(tu, compID, pps.getSignDataHidingEnabledFlag());
 #else
@@ -666,6 +700,49 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
   {
     cctx.initSubblock( subSetId );
 
+    if( m_useRDOQSkipZeroCG && iLastScanPos >= 0 && cctx.subSetId() > 0 )
+    {
+      Bool bZeroCG = true;
+      for( Int iScanPosinCG = iCGSizeM1; iScanPosinCG >= 0 && bZeroCG; iScanPosinCG-- )
+      {
+        bZeroCG = m_maxAbsLevel[cctx.blockPos( cctx.minSubPos() + iScanPosinCG )] == 0;
+      }
+
+      if( bZeroCG )
+      {
+        // the coefficient group is coded as all-zero without estimating the significance of each coefficient,
+        // this omits the significance costs that cancel out otherwise (not bit-exact due to the rounding)
+        for( Int iScanPosinCG = iCGSizeM1; iScanPosinCG >= 0; iScanPosinCG-- )
+        {
+          iScanPos                = cctx.minSubPos() + iScanPosinCG;
+          const UInt uiBlkPos     = cctx.blockPos( iScanPos );
+          pdCostCoeff0[ iScanPos ] = m_pdCostCoeff0Blk[ uiBlkPos ];
+          pdCostCoeff [ iScanPos ] = pdCostCoeff0[ iScanPos ];
+          d64BlockUncodedCost     += pdCostCoeff0[ iScanPos ];
+          d64BaseCost             += pdCostCoeff0[ iScanPos ];
+          piDstCoeff  [ uiBlkPos ] = 0;
+        }
+
+        //===== context set update =====
+        cctx.setGt2Flag( c1 == 0 );
+        c1                = 1;
+        c2                = 0;
+        c1Idx             = 0;
+        c2Idx             = 0;
+        uiGoRiceParam     = initialGolombRiceParameter;
+
+        const BinFracBits fracBitsSigGroup = fracBits.getFracBitsArray( cctx.sigGroupCtxId() );
+        d64BaseCost += xGetRateSigCoeffGroup( fracBitsSigGroup, 0 );
+        pdCostCoeffGroupSig[ cctx.subSetId() ] = xGetRateSigCoeffGroup( fracBitsSigGroup, 0 );
+        continue;
+      }
+    }
+
+    // the greater1 context set and the greater2 context are fixed within the coefficient group
+    const BinFracBits fracBitsOneCG[4] = { fracBits.getFracBitsArray( cctx.greater1CtxId( 0 ) ), fracBits.getFracBitsArray( cctx.greater1CtxId( 1 ) ),
+                                           fracBits.getFracBitsArray( cctx.greater1CtxId( 2 ) ), fracBits.getFracBitsArray( cctx.greater1CtxId( 3 ) ) };
+    const BinFracBits fracBitsAbs      = fracBits.getFracBitsArray( cctx.greater2CtxId() );
+
     memset( &rdStats, 0, sizeof (coeffGroupRDStats));
 
     for (Int iScanPosinCG = iCGSizeM1; iScanPosinCG >= 0; iScanPosinCG--)
@@ -676,21 +753,17 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
 
       // set coeff
 #if HEVC_USE_SCALING_LISTS
-      const Int    quantisationCoefficient = (enableScalingLists) ? piQCoef   [uiBlkPos]               : defaultQuantisationCoefficient;
 #if HM_QTBT_AS_IN_JEM_QUANT
       const Double errorScale              = (enableScalingLists) ? pdErrScale[uiBlkPos]               : defaultErrorScale;
 #else
       const Double errorScale              = (enableScalingLists) ? pdErrScale[uiBlkPos] * blkErrScale : defaultErrorScale;
 #endif
 #endif
-      const Int64  tmpLevel                = Int64(abs(plSrcCoeff[ uiBlkPos ])) * quantisationCoefficient;
-
-      const Intermediate_Int lLevelDouble  = (Intermediate_Int)std::min<Int64>(tmpLevel, std::numeric_limits<Intermediate_Int>::max() - (Intermediate_Int(1) << (iQBits - 1)));
+      const Intermediate_Int lLevelDouble  = m_levelDouble[ uiBlkPos ];
 
-      UInt uiMaxAbsLevel        = std::min<UInt>(UInt(entropyCodingMaximum), UInt((lLevelDouble + (Intermediate_Int(1) << (iQBits - 1))) >> iQBits));
+      UInt uiMaxAbsLevel        = m_maxAbsLevel[ uiBlkPos ];
 
-      const Double dErr         = Double( lLevelDouble );
-      pdCostCoeff0[ iScanPos ]  = dErr * dErr * errorScale;
+      pdCostCoeff0[ iScanPos ]  = m_pdCostCoeff0Blk[ uiBlkPos ];
       d64BlockUncodedCost      += pdCostCoeff0[ iScanPos ];
       piDstCoeff[ uiBlkPos ]    = uiMaxAbsLevel;
 
@@ -722,14 +795,14 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
         UInt uiOneCtx = cctx.greater1CtxId( c1 );
         UInt uiAbsCtx = cctx.greater2CtxId();
 #endif
-        const BinFracBits fracBitsOne = fracBits.getFracBitsArray( cctx.greater1CtxId( c1 ) );
-        const BinFracBits fracBitsAbs = fracBits.getFracBitsArray( cctx.greater2CtxId()     );
+        const BinFracBits& fracBitsOne = fracBitsOneCG[ c1 ];
+        Int                iCodedRate  = 0;
 
         DTRACE_COND( ( uiMaxAbsLevel != 0 ), g_trace_ctx, D_RDOQ_MORE, " One=%d Abs=%d", uiOneCtx, uiAbsCtx );
 
         if( iScanPos == iLastScanPos )
         {
-          uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
+          uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ], iCodedRate,
                                                  lLevelDouble, uiMaxAbsLevel, nullptr, fracBitsOne, fracBitsAbs, 
                                                  uiGoRiceParam, c1Idx, c2Idx, iQBits, errorScale, 1, extendedPrecision, maxLog2TrDynamicRange );
         }
@@ -739,7 +812,7 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
 
           const BinFracBits fracBitsSig = fracBits.getFracBitsArray( ctxIdSig );
 
-          uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
+          uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ], iCodedRate,
                                                 lLevelDouble, uiMaxAbsLevel, &fracBitsSig, fracBitsOne, fracBitsAbs, 
                                                 uiGoRiceParam, c1Idx, c2Idx, iQBits, errorScale, 0, extendedPrecision, maxLog2TrDynamicRange );
 #if HEVC_USE_SIGN_HIDING
@@ -756,7 +829,7 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
 
         if( uiLevel > 0 )
         {
-          Int rateNow              = xGetICRate( uiLevel,   fracBitsOne, fracBitsAbs, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange );
+          Int rateNow              = iCodedRate;
           rateIncUp   [ uiBlkPos ] = xGetICRate( uiLevel+1, fracBitsOne, fracBitsAbs, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange ) - rateNow;
           rateIncDown [ uiBlkPos ] = xGetICRate( uiLevel-1, fracBitsOne, fracBitsAbs, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange ) - rateNow;
         }
@@ -898,6 +971,7 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
   //===== estimate last position =====
   if ( iLastScanPos < 0 )
   {
+    tu.lastPos[compID] = -1;
     return;
   }
 
@@ -1030,6 +1104,8 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
   {
     piDstCoeff[ cctx.blockPos( scanPos ) ] = 0;
   }
+  // sign hiding does not change coefficients after the last one, so this stays an upper bound
+  tu.lastPos[compID] = iBestLastIdxP1 - 1;
 #if SEPARATE_KLT_DEBUG
   if (tu.kltIdx != 0)
   {
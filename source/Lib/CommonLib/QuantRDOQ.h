@@ -85,6 +85,7 @@ private:
   inline UInt xGetCodedLevel  ( Double&             rd64CodedCost,
                                 Double&             rd64CodedCost0,
                                 Double&             rd64CodedCostSig,
+                                Int&                riCodedRate,
                                 Intermediate_Int    lLevelDouble,
                                 UInt                uiMaxAbsLevel,
                                 const BinFracBits*  fracBitsSig,
@@ -130,6 +131,9 @@ private:
   Double m_pdCostSig          [MAX_TU_SIZE * MAX_TU_SIZE];
   Double m_pdCostCoeff0       [MAX_TU_SIZE * MAX_TU_SIZE];
   Double m_pdCostCoeffGroupSig[(MAX_TU_SIZE * MAX_TU_SIZE) >> MLS_CG_SIZE]; // even if CG size is 2 (if one of the sides is 2) instead of 4, there should be enough space
+  Double m_pdCostCoeff0Blk    [MAX_TU_SIZE * MAX_TU_SIZE]; // in block order, as delivered by the level estimation kernel
+  Intermediate_Int m_levelDouble[MAX_TU_SIZE * MAX_TU_SIZE];
+  UInt   m_maxAbsLevel        [MAX_TU_SIZE * MAX_TU_SIZE];
 #if HEVC_USE_SIGN_HIDING
   Int    m_rateIncUp          [MAX_TU_SIZE * MAX_TU_SIZE];
   Int    m_rateIncDown        [MAX_TU_SIZE * MAX_TU_SIZE];
@@ -49,6 +49,7 @@
 
 
 FpDistFunc RdCost::m_afpDistortFunc[DF_TOTAL_FUNCTIONS] = { nullptr, };
+FpDistBatchFunc RdCost::m_fpDistortBatchFunc = nullptr;
 
 RdCost::RdCost()
 {
@@ -162,6 +163,8 @@ Void RdCost::init()
   m_afpDistortFunc[DF_MRHAD64  ] = RdCost::xGetMRHADs;
   m_afpDistortFunc[DF_MRHAD16N ] = RdCost::xGetMRHADs;
 
+  m_fpDistortBatchFunc = RdCost::xGetSADBatch;
+
   m_afpDistortFunc[DF_SAD_FULL_NBIT   ] = RdCost::xGetSAD_full;
   m_afpDistortFunc[DF_SAD_FULL_NBIT2  ] = RdCost::xGetSAD_full;
   m_afpDistortFunc[DF_SAD_FULL_NBIT4  ] = RdCost::xGetSAD_full;
@@ -262,6 +265,8 @@ Void RdCost::setDistParam( DistParam &rcDP, const CPelBuf &org, const Pel* piRef
     rcDP.distFunc = m_afpDistortFunc[ DF_HAD + DFOffset ];
   }
 
+  rcDP.distBatchFunc = ( useHadamard || rcDP.useMR ) ? nullptr : m_fpDistortBatchFunc;
+
   // initialize
   rcDP.subShift  = 0;
 
@@ -333,6 +338,8 @@ Void RdCost::setDistParam( DistParam &rcDP, const CPelBuf &org, const CPelBuf &c
     rcDP.distFunc = m_afpDistortFunc[ DF_HAD + DFOffset + g_aucLog2[ org.width ] ];
   }
 
+  rcDP.distBatchFunc = ( useHadamard || rcDP.useMR ) ? nullptr : m_fpDistortBatchFunc;
+
   rcDP.maximumDistortionForEarlyExit = std::numeric_limits<Distortion>::max();
 }
 
@@ -373,6 +380,8 @@ Void RdCost::setDistParam( DistParam &rcDP, const Pel* pOrg, const Pel* piRefY,
   {
     rcDP.distFunc = m_afpDistortFunc[ DF_SAD + g_aucLog2[ width ] ];
   }
+
+  rcDP.distBatchFunc = m_fpDistortBatchFunc;
 }
 
 #if WCG_EXT
@@ -457,6 +466,18 @@ Distortion RdCost::xGetSAD_full( const DistParam& rcDtParam )
   return uiSum;
 }
 
+Void RdCost::xGetSADBatch( const DistParam& rcDtParam, const Pel* const* ppCur, const Int iNum, Distortion* puiDist )
+{
+  // generic version, evaluates the candidates one by one with the regular SAD function
+  DistParam cDtParam = rcDtParam;
+
+  for( Int i = 0; i < iNum; i++ )
+  {
+    cDtParam.cur.buf = ppCur[i];
+    puiDist[i]       = cDtParam.distFunc( cDtParam );
+  }
+}
+
 Distortion RdCost::xGetSAD( const DistParam& rcDtParam )
 {
   if ( rcDtParam.applyWeight )
@@ -3290,11 +3311,10 @@ Distortion RdCost::xGetSSE64_WTD( const DistParam &rcDtParam )
 #endif
 
 
-Pel orgCopy[MAX_CU_SIZE * MAX_CU_SIZE];
-
-#if _OPENMP
-#pragma omp threadprivate(orgCopy)
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM || ENABLE_KLT_PARALLELISM
+thread_local
 #endif
+Pel orgCopy[MAX_CU_SIZE * MAX_CU_SIZE];
 
 Distortion RdCost::xGetMRHADs( const DistParam &rcDtParam )
 {
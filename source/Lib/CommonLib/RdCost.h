@@ -58,6 +58,7 @@ class EncCfg;
 
 // for function pointer
 typedef Distortion (*FpDistFunc) (const DistParam&);
+typedef Void       (*FpDistBatchFunc) (const DistParam&, const Pel* const*, const Int, Distortion*);
 
 // ====================================================================================================================
 // Class definition
@@ -74,6 +75,7 @@ public:
 #endif
   int                   step;
   FpDistFunc            distFunc;
+  FpDistBatchFunc       distBatchFunc;   // evaluates org against several cur positions at once, nullptr if not supported by distFunc
   int                   bitDepth;
 
   bool                  useMR;
@@ -89,16 +91,20 @@ public:
   // - 0 = no subsampling, 1 = even rows, 2 = every 4th, etc.
   Int                   subShift;
 
-  DistParam() : org(), cur(), step( 1 ), bitDepth( 0 ), useMR( false ), applyWeight( false ), isBiPred( false ), wpCur( nullptr ), compID( MAX_NUM_COMPONENT ), maximumDistortionForEarlyExit( std::numeric_limits<Distortion>::max() ), subShift( 0 ) { }
+  DistParam() : org(), cur(), step( 1 ), distBatchFunc( nullptr ), bitDepth( 0 ), useMR( false ), applyWeight( false ), isBiPred( false ), wpCur( nullptr ), compID( MAX_NUM_COMPONENT ), maximumDistortionForEarlyExit( std::numeric_limits<Distortion>::max() ), subShift( 0 ) { }
 };
 
 /// RD cost computation class
 class RdCost
 {
+public:
+  // distortion functions, the scalar ones of init() are replaced by SIMD ones in initRdCostX86
+  static FpDistFunc       m_afpDistortFunc[DF_TOTAL_FUNCTIONS]; // [eDFunc]
+
 private:
   // for distortion
 
-  static FpDistFunc       m_afpDistortFunc[DF_TOTAL_FUNCTIONS]; // [eDFunc]
+  static FpDistBatchFunc  m_fpDistortBatchFunc;                 // SAD only
   CostMode                m_costMode;
   double                  m_distortionWeight[MAX_NUM_COMPONENT]; // only chroma values are used.
   double                  m_dLambda;
@@ -193,8 +199,7 @@ public:
   inline Double  getWPSNRLumaLevelWeight    (Int val) { return m_lumaLevelToWeightPLUT[val]; }
 #endif
 
-private:
-
+  // the scalar distortion functions, also the references of the SIMD ones
   static Distortion xGetSSE           ( const DistParam& pcDtParam );
   static Distortion xGetSSE4          ( const DistParam& pcDtParam );
   static Distortion xGetSSE8          ( const DistParam& pcDtParam );
@@ -228,6 +233,7 @@ private:
   static Distortion xGetSAD48         ( const DistParam& pcDtParam );
 
   static Distortion xGetSAD_full      ( const DistParam& pcDtParam );
+  static Void       xGetSADBatch      ( const DistParam& pcDtParam, const Pel* const* ppCur, const Int iNum, Distortion* puiDist );
 
   static Distortion xGetMRSAD         ( const DistParam& pcDtParam );
   static Distortion xGetMRSAD4        ( const DistParam& pcDtParam );
@@ -242,6 +248,8 @@ private:
   static Distortion xGetMRHADs        ( const DistParam& pcDtParam );
 
   static Distortion xGetHADs          ( const DistParam& pcDtParam );
+
+private:
   static Distortion xCalcHADs2x2      ( const Pel *piOrg, const Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
   static Distortion xCalcHADs4x4      ( const Pel *piOrg, const Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
   static Distortion xCalcHADs8x8      ( const Pel *piOrg, const Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
@@ -261,9 +269,18 @@ private:
   static Distortion xGetSAD_SIMD    ( const DistParam& pcDtParam );
   template< Int iWidth, X86_VEXT vext >
   static Distortion xGetSAD_NxN_SIMD( const DistParam& pcDtParam );
+  template< X86_VEXT vext >
+  static Void       xGetSADBatch_SIMD( const DistParam& pcDtParam, const Pel* const* ppCur, const Int iNum, Distortion* puiDist );
+
+  template< X86_VEXT vext >
+  static Distortion xGetMRSAD_SIMD    ( const DistParam& pcDtParam );
+  template< Int iWidth, X86_VEXT vext >
+  static Distortion xGetMRSAD_NxN_SIMD( const DistParam& pcDtParam );
 
   template< typename Torg, typename Tcur, X86_VEXT vext >
   static Distortion xGetHADs_SIMD   ( const DistParam& pcDtParam );
+  template< typename Torg, typename Tcur, Int iWidth, X86_VEXT vext >
+  static Distortion xGetHADs_NxM_SIMD( const DistParam& pcDtParam );
 #endif
 
 public:
@@ -338,7 +338,7 @@ Void initROM()
           g_scanOrder     [SCAN_GROUPED_4x4][scanTypeIndex][blockWidthIdx][blockHeightIdx]    = nullptr;
           g_scanOrderPosXY[SCAN_GROUPED_4x4][scanTypeIndex][blockWidthIdx][blockHeightIdx][0] = nullptr;
           g_scanOrderPosXY[SCAN_GROUPED_4x4][scanTypeIndex][blockWidthIdx][blockHeightIdx][1] = nullptr;
-
+          g_scanOrderInv  [scanTypeIndex][blockWidthIdx][blockHeightIdx]                      = nullptr;
         }
 
         continue;
@@ -365,7 +365,7 @@ Void initROM()
         g_scanOrder     [SCAN_GROUPED_4x4][scanType][blockWidthIdx][blockHeightIdx]    = new UInt[totalValues];
         g_scanOrderPosXY[SCAN_GROUPED_4x4][scanType][blockWidthIdx][blockHeightIdx][0] = new UInt[totalValues];
         g_scanOrderPosXY[SCAN_GROUPED_4x4][scanType][blockWidthIdx][blockHeightIdx][1] = new UInt[totalValues];
-
+        g_scanOrderInv  [scanType][blockWidthIdx][blockHeightIdx]                      = new UInt[totalValues];
 
         ScanGenerator fullBlockScan(widthInGroups, heightInGroups, groupWidth, scanType);
 
@@ -388,6 +388,7 @@ Void initROM()
             g_scanOrder     [SCAN_GROUPED_4x4][scanType][blockWidthIdx][blockHeightIdx]   [groupOffsetScan + scanPosition] = rasterPos;
             g_scanOrderPosXY[SCAN_GROUPED_4x4][scanType][blockWidthIdx][blockHeightIdx][0][groupOffsetScan + scanPosition] = posX;
             g_scanOrderPosXY[SCAN_GROUPED_4x4][scanType][blockWidthIdx][blockHeightIdx][1][groupOffsetScan + scanPosition] = posY;
+            g_scanOrderInv  [scanType][blockWidthIdx][blockHeightIdx][rasterPos]                                             = groupOffsetScan + scanPosition;
           }
 
           fullBlockScan.GetNextIndex(0, 0);
@@ -426,6 +427,18 @@ Void destroyROM()
     }
   }
 
+  for (UInt scanOrderIndex = 0; scanOrderIndex < SCAN_NUMBER_OF_TYPES; scanOrderIndex++)
+  {
+    for (UInt blockWidthIdx = 0; blockWidthIdx <= numWidths; blockWidthIdx++)
+    {
+      for (UInt blockHeightIdx = 0; blockHeightIdx <= numHeights; blockHeightIdx++)
+      {
+        delete[] g_scanOrderInv[scanOrderIndex][blockWidthIdx][blockHeightIdx];
+        g_scanOrderInv[scanOrderIndex][blockWidthIdx][blockHeightIdx] = nullptr;
+      }
+    }
+  }
+
   delete gp_sizeIdxInfo;
   gp_sizeIdxInfo = nullptr;
 }
@@ -1170,6 +1183,7 @@ UnitScale g_miScaling( MIN_CU_LOG2, MIN_CU_LOG2 );
 // scanning order table
 UInt* g_scanOrder     [SCAN_NUMBER_OF_GROUP_TYPES][SCAN_NUMBER_OF_TYPES][MAX_CU_SIZE / 2 + 1][MAX_CU_SIZE / 2 + 1];
 UInt* g_scanOrderPosXY[SCAN_NUMBER_OF_GROUP_TYPES][SCAN_NUMBER_OF_TYPES][MAX_CU_SIZE / 2 + 1][MAX_CU_SIZE / 2 + 1][2];
+UInt* g_scanOrderInv  [SCAN_NUMBER_OF_TYPES][MAX_CU_SIZE / 2 + 1][MAX_CU_SIZE / 2 + 1];
 
 const UInt ctxIndMap4x4[4 * 4] =
 {
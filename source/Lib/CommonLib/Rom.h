@@ -66,6 +66,8 @@ void         generateTrafoBlockSizeScaling( SizeIndexInfo& sizeIdxInfo );
 // flexible conversion from relative to absolute index
 extern       UInt*  g_scanOrder     [SCAN_NUMBER_OF_GROUP_TYPES][SCAN_NUMBER_OF_TYPES][MAX_CU_SIZE / 2 + 1][MAX_CU_SIZE / 2 + 1];
 extern       UInt*  g_scanOrderPosXY[SCAN_NUMBER_OF_GROUP_TYPES][SCAN_NUMBER_OF_TYPES][MAX_CU_SIZE / 2 + 1][MAX_CU_SIZE / 2 + 1][2];
+// grouped scan position of each raster position
+extern       UInt*  g_scanOrderInv  [SCAN_NUMBER_OF_TYPES][MAX_CU_SIZE / 2 + 1][MAX_CU_SIZE / 2 + 1];
 
 extern const Int g_quantScales   [SCALING_LIST_REM_NUM];          // Q(QP%6)
 extern const Int g_invQuantScales[SCALING_LIST_REM_NUM];          // IQ(QP%6)
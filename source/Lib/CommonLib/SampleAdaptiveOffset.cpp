@@ -110,6 +110,63 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 
 
 
+// ====================================================================================================================
+// SAO kernels
+// ====================================================================================================================
+
+static void offsetEOCore( const Pel* src, Int srcStride, Pel* res, Int resStride, Int width, Int height, Int nbOffset, const Int* offset, const ClpRng& clpRng )
+{
+  for( Int y = 0; y < height; y++ )
+  {
+    for( Int x = 0; x < width; x++ )
+    {
+      const Int edgeType = sgn( src[x] - src[x + nbOffset] ) + sgn( src[x] - src[x - nbOffset] ) + 2;
+
+      res[x] = ClipPel<int>( src[x] + offset[edgeType], clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+static void offsetBOCore( const Pel* src, Int srcStride, Pel* res, Int resStride, Int width, Int height, Int shiftBits, const Int* offset, const ClpRng& clpRng )
+{
+  for( Int y = 0; y < height; y++ )
+  {
+    for( Int x = 0; x < width; x++ )
+    {
+      res[x] = ClipPel<int>( src[x] + offset[src[x] >> shiftBits], clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+static void statsEOCore( const Pel* src, Int srcStride, const Pel* org, Int orgStride, Int width, Int height, Int nbOffset, Int64* diff, Int64* count )
+{
+  for( Int y = 0; y < height; y++ )
+  {
+    for( Int x = 0; x < width; x++ )
+    {
+      const Int edgeType = sgn( src[x] - src[x + nbOffset] ) + sgn( src[x] - src[x - nbOffset] ) + 2;
+
+      diff [edgeType] += ( org[x] - src[x] );
+      count[edgeType] ++;
+    }
+    src += srcStride;
+    org += orgStride;
+  }
+}
+
+SaoOps::SaoOps()
+{
+  offsetEO = offsetEOCore;
+  offsetBO = offsetBOCore;
+  statsEO  = statsEOCore;
+}
+
+SaoOps g_saoOP = SaoOps();
+
 SampleAdaptiveOffset::SampleAdaptiveOffset()
 {
 }
@@ -118,9 +175,6 @@ SampleAdaptiveOffset::SampleAdaptiveOffset()
 SampleAdaptiveOffset::~SampleAdaptiveOffset()
 {
   destroy();
-
-  m_signLineBuf1.clear();
-  m_signLineBuf2.clear();
 }
 
 Void SampleAdaptiveOffset::create( Int picWidth, Int picHeight, ChromaFormat format, UInt maxCUWidth, UInt maxCUHeight, UInt maxCUDepth, UInt lumaBitShift, UInt chromaBitShift )
@@ -293,211 +347,73 @@ Void SampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, const ClpRng&
                                           , const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride,  Int width, Int height
                                           , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail)
 {
-  Int x,y, startX, startY, endX, endY, edgeType;
+  Int startX, startY, endX, endY;
   Int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
-  SChar signLeft, signRight, signDown;
 
-  const Pel* srcLine = srcBlk;
-        Pel* resLine = resBlk;
+  const Pel* srcLastLine = srcBlk + ( height - 1 ) * srcStride;
+        Pel* resLastLine = resBlk + ( height - 1 ) * resStride;
 
   switch(typeIdx)
   {
   case SAO_TYPE_EO_0:
     {
-      offset += 2;
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
-      for (y=0; y< height; y++)
-      {
-        signLeft = (SChar)sgn(srcLine[startX] - srcLine[startX-1]);
-        for (x=startX; x< endX; x++)
-        {
-          signRight = (SChar)sgn(srcLine[x] - srcLine[x+1]);
-          edgeType =  signRight + signLeft;
-          signLeft  = -signRight;
-
-          resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-        }
-        srcLine  += srcStride;
-        resLine += resStride;
-      }
 
+      g_saoOP.offsetEO( srcBlk + startX, srcStride, resBlk + startX, resStride, endX - startX, height, 1, offset, clpRng );
     }
     break;
   case SAO_TYPE_EO_90:
     {
-      offset += 2;
-      SChar *signUpLine = &m_signLineBuf1[0];
-
       startY = isAboveAvail ? 0 : 1;
       endY   = isBelowAvail ? height : height-1;
-      if (!isAboveAvail)
-      {
-        srcLine += srcStride;
-        resLine += resStride;
-      }
-
-      const Pel* srcLineAbove= srcLine- srcStride;
-      for (x=0; x< width; x++)
-      {
-        signUpLine[x] = (SChar)sgn(srcLine[x] - srcLineAbove[x]);
-      }
-
-      const Pel* srcLineBelow;
-      for (y=startY; y<endY; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=0; x< width; x++)
-        {
-          signDown  = (SChar)sgn(srcLine[x] - srcLineBelow[x]);
-          edgeType = signDown + signUpLine[x];
-          signUpLine[x]= -signDown;
-
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
 
+      g_saoOP.offsetEO( srcBlk + startY * srcStride, srcStride, resBlk + startY * resStride, resStride, width, endY - startY, srcStride, offset, clpRng );
     }
     break;
   case SAO_TYPE_EO_135:
     {
-      offset += 2;
-      SChar *signUpLine, *signDownLine, *signTmpLine;
-
-      signUpLine  = &m_signLineBuf1[0];
-      signDownLine= &m_signLineBuf2[0];
-
       startX = isLeftAvail ? 0 : 1 ;
       endX   = isRightAvail ? width : (width-1);
 
-      //prepare 2nd line's upper sign
-      const Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX; x< endX+1; x++)
-      {
-        signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x- 1]);
-      }
-
       //1st line
-      const Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveLeftAvail ? 0 : 1;
       firstLineEndX   = isAboveAvail? endX: 1;
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        edgeType  =  sgn(srcLine[x] - srcLineAbove[x- 1]) - signUpLine[x+1];
-
-        resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-      }
-      srcLine  += srcStride;
-      resLine  += resStride;
-
+      g_saoOP.offsetEO( srcBlk + firstLineStartX, srcStride, resBlk + firstLineStartX, resStride, firstLineEndX - firstLineStartX, 1, srcStride + 1, offset, clpRng );
 
       //middle lines
-      for (y= 1; y< height-1; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=startX; x<endX; x++)
-        {
-          signDown =  (SChar)sgn(srcLine[x] - srcLineBelow[x+ 1]);
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-
-          signDownLine[x+1] = -signDown;
-        }
-        signDownLine[startX] = (SChar)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-        signTmpLine  = signUpLine;
-        signUpLine   = signDownLine;
-        signDownLine = signTmpLine;
-
-        srcLine += srcStride;
-        resLine += resStride;
-      }
+      g_saoOP.offsetEO( srcBlk + srcStride + startX, srcStride, resBlk + resStride + startX, resStride, endX - startX, height - 2, srcStride + 1, offset, clpRng );
 
       //last line
-      srcLineBelow= srcLine+ srcStride;
       lastLineStartX = isBelowAvail ? startX : (width -1);
       lastLineEndX   = isBelowRightAvail ? width : (width -1);
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        edgeType =  sgn(srcLine[x] - srcLineBelow[x+ 1]) + signUpLine[x];
-        resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-
-      }
+      g_saoOP.offsetEO( srcLastLine + lastLineStartX, srcStride, resLastLine + lastLineStartX, resStride, lastLineEndX - lastLineStartX, 1, srcStride + 1, offset, clpRng );
     }
     break;
   case SAO_TYPE_EO_45:
     {
-      offset += 2;
-      SChar *signUpLine = &m_signLineBuf1[1];
-
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
 
-      //prepare 2nd line upper sign
-      const Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX-1; x< endX; x++)
-      {
-        signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x+1]);
-      }
-
-
       //first line
-      const Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveAvail ? startX : (width -1 );
       firstLineEndX   = isAboveRightAvail ? width : (width-1);
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) -signUpLine[x-1];
-        resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-      }
-      srcLine += srcStride;
-      resLine += resStride;
+      g_saoOP.offsetEO( srcBlk + firstLineStartX, srcStride, resBlk + firstLineStartX, resStride, firstLineEndX - firstLineStartX, 1, srcStride - 1, offset, clpRng );
 
       //middle lines
-      for (y= 1; y< height-1; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for(x= startX; x< endX; x++)
-        {
-          signDown =  (SChar)sgn(srcLine[x] - srcLineBelow[x-1]);
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-          signUpLine[x-1] = -signDown;
-        }
-        signUpLine[endX-1] = (SChar)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-        srcLine  += srcStride;
-        resLine += resStride;
-      }
+      g_saoOP.offsetEO( srcBlk + srcStride + startX, srcStride, resBlk + resStride + startX, resStride, endX - startX, height - 2, srcStride - 1, offset, clpRng );
 
       //last line
-      srcLineBelow= srcLine+ srcStride;
       lastLineStartX = isBelowLeftAvail ? 0 : 1;
       lastLineEndX   = isBelowAvail ? endX : 1;
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + signUpLine[x];
-        resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-
-      }
+      g_saoOP.offsetEO( srcLastLine + lastLineStartX, srcStride, resLastLine + lastLineStartX, resStride, lastLineEndX - lastLineStartX, 1, srcStride - 1, offset, clpRng );
     }
     break;
   case SAO_TYPE_BO:
     {
       const Int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
-      for (y=0; y< height; y++)
-      {
-        for (x=0; x< width; x++)
-        {
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
+
+      g_saoOP.offsetBO( srcBlk, srcStride, resBlk, resStride, width, height, shiftBits, offset, clpRng );
     }
     break;
   default:
@@ -528,13 +444,6 @@ Void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
   //block boundary availability
   deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail);
 
-  const size_t lineBufferSize = area.Y().width + 1;
-  if (m_signLineBuf1.size() < lineBufferSize)
-  {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
-
   for(Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
   {
     const ComponentID compID = ComponentID(compIdx);
@@ -611,6 +520,64 @@ Void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkP
   xPCMLFDisableProcess(cs);
 }
 
+// SAO of a CTU line, the lines have to be processed top to bottom and the line below has to be deblocked
+Void SampleAdaptiveOffset::SAOProcessCtuLine( CodingStructure& cs, SAOBlkParam* saoBlkParams, const Int ctuYPos )
+{
+  CHECK(!saoBlkParams, "No parameters present");
+
+  const PreCalcValues& pcv = *cs.pcv;
+  const UInt numberOfComponents = getNumberValidComponents(cs.area.chromaFormat);
+  const Int  firstCtuRsAddr     = ctuYPos * pcv.widthInCtus;
+  Bool bAllDisabled = true;
+
+  for( Int ctuRsAddr = firstCtuRsAddr; ctuRsAddr < firstCtuRsAddr + pcv.widthInCtus; ctuRsAddr++ )
+  {
+    SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES] = { NULL };
+    getMergeList(cs, ctuRsAddr, saoBlkParams, mergeList);
+
+    reconstructBlkSAOParam(saoBlkParams[ctuRsAddr], mergeList);
+
+    for( UInt compIdx = 0; compIdx < numberOfComponents; compIdx++ )
+    {
+      if( saoBlkParams[ctuRsAddr][compIdx].modeIdc != SAO_MODE_OFF )
+      {
+        bAllDisabled = false;
+      }
+    }
+  }
+
+  // keep the deblocked samples of this line and of the first sample lines below, the samples above were kept with the line above
+  const UInt yPos       = ctuYPos * pcv.maxCUHeight;
+  const UInt lineHeight = std::min( pcv.maxCUHeight, pcv.lumaHeight - yPos );
+  const UnitArea keptArea( cs.area.chromaFormat, Area( 0, yPos, pcv.lumaWidth, lineHeight + std::min<UInt>( 2, pcv.lumaHeight - yPos - lineHeight ) ) );
+  m_tempBuf.getBuf( keptArea ).copyFrom( cs.getRecoBuf( keptArea ) );
+
+  if (bAllDisabled)
+  {
+    return;
+  }
+
+  PelUnitBuf rec = cs.getRecoBuf();
+
+  for( UInt xPos = 0, ctuRsAddr = firstCtuRsAddr; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth, ctuRsAddr++ )
+  {
+    const UInt width = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
+    const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, lineHeight) );
+
+    offsetCTU( area, m_tempBuf, rec, saoBlkParams[ctuRsAddr], cs);
+  }
+
+  const Bool bPCMFilter = (cs.sps->getUsePCM() && cs.sps->getPCMFilterDisableFlag()) ? true : false;
+
+  if( bPCMFilter || cs.pps->getTransquantBypassEnabledFlag() )
+  {
+    for( UInt xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
+    {
+      xPCMCURestoration(cs, UnitArea( cs.area.chromaFormat, Area( xPos, yPos, pcv.maxCUWidth, pcv.maxCUHeight ) ));
+    }
+  }
+}
+
 Void SampleAdaptiveOffset::xPCMLFDisableProcess(CodingStructure& cs)
 {
   const PreCalcValues& pcv = *cs.pcv;
@@ -60,6 +60,27 @@ template <typename T> Int sgn(T val)
   return (T(0) < val) - (val < T(0));
 }
 
+/// SAO kernels working on a rectangle of samples, the edge offset kernels compare each sample
+/// with its neighbours at +nbOffset and -nbOffset and use the classes -2..2 at offset[0..4]
+struct SaoOps
+{
+  SaoOps();
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+  void initSaoOpsX86();
+  template<X86_VEXT vext>
+  void _initSaoOpsX86();
+#endif
+#endif
+
+  void ( *offsetEO )( const Pel* src, Int srcStride, Pel* res, Int resStride, Int width, Int height, Int nbOffset,  const Int* offset, const ClpRng& clpRng );
+  void ( *offsetBO )( const Pel* src, Int srcStride, Pel* res, Int resStride, Int width, Int height, Int shiftBits, const Int* offset, const ClpRng& clpRng );
+  void ( *statsEO  )( const Pel* src, Int srcStride, const Pel* org, Int orgStride, Int width, Int height, Int nbOffset, Int64* diff, Int64* count );
+};
+
+extern SaoOps g_saoOP;
+
 class SampleAdaptiveOffset
 {
 public:
@@ -67,6 +88,7 @@ public:
   virtual ~SampleAdaptiveOffset();
   Void SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                    );
+  Void SAOProcessCtuLine( CodingStructure& cs, SAOBlkParam* saoBlkParams, const Int ctuYPos );
   Void create( Int picWidth, Int picHeight, ChromaFormat format, UInt maxCUWidth, UInt maxCUHeight, UInt maxCUDepth, UInt lumaBitShift, UInt chromaBitShift );
   Void destroy();
   static Int getMaxOffsetQVal(const Int channelBitDepth) { return (1<<(std::min<Int>(channelBitDepth,MAX_SAO_TRUNCATED_BITDEPTH)-5))-1; } //Table 9-32, inclusive
@@ -99,8 +121,6 @@ protected:
   PelStorage m_tempBuf;
   UInt m_numberOfComponents;
 
-  std::vector<SChar> m_signLineBuf1;
-  std::vector<SChar> m_signLineBuf2;
 private:
   Bool m_picSAOEnabled[MAX_NUM_COMPONENT];
 };
@@ -0,0 +1,174 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.cpp
+    \brief    thread pool running the parallel parts of the encoder and decoder
+*/
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+//! \ingroup CommonLib
+//! \{
+
+ThreadPool::ThreadPool()
+  : m_exit( false )
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+  destroy();
+}
+
+void ThreadPool::init( const int numWorkers )
+{
+  destroy();
+
+  m_exit = false;
+
+  for( int i = 0; i < numWorkers; i++ )
+  {
+    m_workers.push_back( std::thread( &ThreadPool::xWorkerLoop, this ) );
+  }
+}
+
+void ThreadPool::destroy()
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_exit = true;
+  }
+  m_taskAvailable.notify_all();
+
+  for( auto& worker : m_workers )
+  {
+    worker.join();
+  }
+  m_workers.clear();
+}
+
+void ThreadPool::run( const int numTasks, const std::function<void( int )>& task )
+{
+  if( numTasks <= 0 )
+  {
+    return;
+  }
+
+  if( numTasks == 1 || m_workers.empty() )
+  {
+    for( int i = 0; i < numTasks; i++ )
+    {
+      task( i );
+    }
+    return;
+  }
+
+  TaskGroup group;
+  group.task          = &task;
+  group.numTasks      = numTasks;
+  group.nextTask      = 0;
+  group.numUnfinished = numTasks;
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  m_groups.push_back( &group );
+  m_taskAvailable.notify_all();
+
+  while( group.nextTask < group.numTasks )
+  {
+    xRunTask( group, lock );
+  }
+
+  group.finished.wait( lock, [&group] { return group.numUnfinished == 0; } );
+  lock.unlock();
+
+  if( group.error )
+  {
+    std::rethrow_exception( group.error );
+  }
+}
+
+void ThreadPool::xRunTask( TaskGroup& group, std::unique_lock<std::mutex>& lock )
+{
+  const int taskIdx = group.nextTask++;
+
+  if( group.nextTask == group.numTasks )
+  {
+    m_groups.erase( std::find( m_groups.begin(), m_groups.end(), &group ) );
+  }
+
+  lock.unlock();
+
+  std::exception_ptr error;
+  try
+  {
+    ( *group.task )( taskIdx );
+  }
+  catch( ... )
+  {
+    error = std::current_exception();
+  }
+
+  lock.lock();
+
+  if( error && !group.error )
+  {
+    group.error = error;
+  }
+
+  if( --group.numUnfinished == 0 )
+  {
+    group.finished.notify_all();
+  }
+}
+
+void ThreadPool::xWorkerLoop()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  while( true )
+  {
+    m_taskAvailable.wait( lock, [this] { return m_exit || !m_groups.empty(); } );
+
+    if( m_exit )
+    {
+      return;
+    }
+
+    xRunTask( *m_groups.front(), lock );
+  }
+}
+
+//! \}
@@ -0,0 +1,103 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.h
+    \brief    thread pool running the parallel parts of the encoder and decoder (header)
+*/
+
+#ifndef __THREADPOOL__
+#define __THREADPOOL__
+
+#include "CommonDef.h"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/**
+ * Pool of worker threads shared by all parallel parts of an encoder (WPP rows, split jobs, KLT candidates) or a decoder
+ * (WPP rows).
+ * run() hands out the task indices of a group one by one. The calling thread works on its own group until
+ * all indices are handed out and then waits for the group, idle workers take tasks from the oldest group
+ * first. Groups can be nested, a task may start a group on its own. Since the caller never waits for tasks
+ * of other groups, a group whose tasks do not wait for each other always finishes, groups with tasks waiting
+ * for each other (WPP rows) need one worker less than tasks.
+ */
+class ThreadPool
+{
+public:
+  ThreadPool();
+  ~ThreadPool();
+
+  void init         ( const int numWorkers );
+  void destroy      ();
+  int  getNumWorkers() const { return (int)m_workers.size(); }
+
+  /// executes task( 0 ) .. task( numTasks - 1 ), returns when all of them are finished
+  void run          ( const int numTasks, const std::function<void( int )>& task );
+
+private:
+  struct TaskGroup
+  {
+    const std::function<void( int )>* task;
+    int                               numTasks;
+    int                               nextTask;
+    int                               numUnfinished;
+    std::exception_ptr                error;
+    std::condition_variable           finished;
+  };
+
+  void xWorkerLoop();
+  void xRunTask   ( TaskGroup& group, std::unique_lock<std::mutex>& lock );
+
+  std::vector<std::thread>  m_workers;
+  std::list<TaskGroup*>     m_groups;           ///< groups with task indices left to hand out, oldest first
+  std::mutex                m_mutex;
+  std::condition_variable   m_taskAvailable;
+  bool                      m_exit;
+};
+
+//! \}
+
+#endif // __THREADPOOL__
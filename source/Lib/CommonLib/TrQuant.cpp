@@ -62,19 +62,61 @@ struct coeffGroupRDStats
   Double d64SigCost_0;
 };
 
-#if SEPARABLE_KLT
-FwdTrans *fastFwdTrans[2][7] =
+TrafoOps::TrafoOps()
 {
-  { NULL,               fastForwardKLT_B4, fastForwardKLT_B8, fastForwardKLT_B16, fastForwardKLT_B32, fastForwardKLT_B64, NULL },
-  { fastForwardDCT2_B2, fastForwardDCT2_B4, fastForwardDCT2_B8, fastForwardDCT2_B16, fastForwardDCT2_B32, fastForwardDCT2_B64, fastForwardDCT2_B128 },
-};
+  ::memset( fastFwdTrans, 0, sizeof( fastFwdTrans ) );
+  ::memset( fastInvTrans, 0, sizeof( fastInvTrans ) );
+
+#if SEPARABLE_KLT
+  fastFwdTrans[TRAFO_KLT ][1] = fastForwardKLT_B4;
+  fastFwdTrans[TRAFO_KLT ][2] = fastForwardKLT_B8;
+  fastFwdTrans[TRAFO_KLT ][3] = fastForwardKLT_B16;
+  fastFwdTrans[TRAFO_KLT ][4] = fastForwardKLT_B32;
+  fastFwdTrans[TRAFO_KLT ][5] = fastForwardKLT_B64;
+
+  fastInvTrans[TRAFO_KLT ][1] = fastInverseKLT_B4;
+  fastInvTrans[TRAFO_KLT ][2] = fastInverseKLT_B8;
+  fastInvTrans[TRAFO_KLT ][3] = fastInverseKLT_B16;
+  fastInvTrans[TRAFO_KLT ][4] = fastInverseKLT_B32;
+  fastInvTrans[TRAFO_KLT ][5] = fastInverseKLT_B64;
+
+  ::memset( fastFwdKLTPel, 0, sizeof( fastFwdKLTPel ) );
+  ::memset( fastInvKLTPel, 0, sizeof( fastInvKLTPel ) );
+
+  fastFwdKLTPel[1] = fastForwardKLTPel_B4;
+  fastFwdKLTPel[2] = fastForwardKLTPel_B8;
+  fastFwdKLTPel[3] = fastForwardKLTPel_B16;
+  fastFwdKLTPel[4] = fastForwardKLTPel_B32;
+  fastFwdKLTPel[5] = fastForwardKLTPel_B64;
+
+  fastInvKLTPel[1] = fastInverseKLTPel_B4;
+  fastInvKLTPel[2] = fastInverseKLTPel_B8;
+  fastInvKLTPel[3] = fastInverseKLTPel_B16;
+  fastInvKLTPel[4] = fastInverseKLTPel_B32;
+  fastInvKLTPel[5] = fastInverseKLTPel_B64;
 
-InvTrans *fastInvTrans[2][7] =
-{
-  { NULL,               fastInverseKLT_B4, fastInverseKLT_B8, fastInverseKLT_B16, fastInverseKLT_B32, fastInverseKLT_B64, NULL },
-  { fastInverseDCT2_B2, fastInverseDCT2_B4, fastInverseDCT2_B8, fastInverseDCT2_B16, fastInverseDCT2_B32, fastInverseDCT2_B64, fastInverseDCT2_B128 },
-};
 #endif
+  fastFwdTrans[TRAFO_DCT2][0] = fastForwardDCT2_B2;
+  fastFwdTrans[TRAFO_DCT2][1] = fastForwardDCT2_B4;
+  fastFwdTrans[TRAFO_DCT2][2] = fastForwardDCT2_B8;
+  fastFwdTrans[TRAFO_DCT2][3] = fastForwardDCT2_B16;
+  fastFwdTrans[TRAFO_DCT2][4] = fastForwardDCT2_B32;
+  fastFwdTrans[TRAFO_DCT2][5] = fastForwardDCT2_B64;
+  fastFwdTrans[TRAFO_DCT2][6] = fastForwardDCT2_B128;
+
+  fastInvTrans[TRAFO_DCT2][0] = fastInverseDCT2_B2;
+  fastInvTrans[TRAFO_DCT2][1] = fastInverseDCT2_B4;
+  fastInvTrans[TRAFO_DCT2][2] = fastInverseDCT2_B8;
+  fastInvTrans[TRAFO_DCT2][3] = fastInverseDCT2_B16;
+  fastInvTrans[TRAFO_DCT2][4] = fastInverseDCT2_B32;
+  fastInvTrans[TRAFO_DCT2][5] = fastInverseDCT2_B64;
+  fastInvTrans[TRAFO_DCT2][6] = fastInverseDCT2_B128;
+
+  fastFwdTrans[TRAFO_DST7][1] = fastForwardDST7_B4;
+  fastInvTrans[TRAFO_DST7][1] = fastInverseDST7_B4;
+}
+
+TrafoOps g_trafoOP = TrafoOps();
 
 //! \ingroup CommonLib
 //! \{
@@ -96,7 +138,9 @@ TrQuant::TrQuant() : m_quant( nullptr ), m_fTr( xTrMxN ), m_fITr( xITrMxN )
 {
   // allocate temporary buffers
   m_plTempCoeff   = (TCoeff*) xMalloc( TCoeff, MAX_CU_SIZE * MAX_CU_SIZE );
-
+#if SEPARABLE_KLT
+  m_plTempKLT     = (TCoeff*) xMalloc( TCoeff, 2 * MAX_TU_SIZE * MAX_TU_SIZE );
+#endif
 }
 
 TrQuant::~TrQuant()
@@ -113,9 +157,16 @@ TrQuant::~TrQuant()
     xFree( m_plTempCoeff );
     m_plTempCoeff = nullptr;
   }
+#if SEPARABLE_KLT
+  if ( m_plTempKLT )
+  {
+    xFree( m_plTempKLT );
+    m_plTempKLT = nullptr;
+  }
+#endif
 }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_KLT_PARALLELISM
 
 void TrQuant::copyState( const TrQuant& other )
 {
@@ -126,7 +177,7 @@ void TrQuant::copyState( const TrQuant& other )
 #if SEPARABLE_KLT
 void xTrMxN_KLT(const Int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, Int iWidth, Int iHeight, const int maxLog2TrDynamicRange,
   const PredMode pMode, const UChar ucTrIdx, const bool use65intraModes
-  , const bool useQTBT
+  , const bool useQTBT, TCoeff *scratch
 )
 {
   const Int TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_FORWARD];
@@ -142,30 +193,41 @@ void xTrMxN_KLT(const Int bitDepth, const Pel *residual, size_t stride, TCoeff *
   CHECK(shift_2nd < 0, "Negative shift");
   CHECK(ucTrIdx < 0 || ucTrIdx > 3, "Incorrect transform index");
 
-  ALIGN_DATA(MEMORY_ALIGN_DEF_SIZE, TCoeff block[MAX_TU_SIZE * MAX_TU_SIZE]);
-
 #if SEPARATE_KLT_DEBUG
   printf("\nresidual block:\n");
-#endif
   for (Int y = 0; y < iHeight; y++)
   {
     for (Int x = 0; x < iWidth; x++)
     {
-#if SEPARATE_KLT_DEBUG
       printf("%4d, ", residual[(y * stride) + x]);
-#endif
-      block[(y * iWidth) + x] = residual[(y * stride) + x];
     }
-#if SEPARATE_KLT_DEBUG
     printf("\n");
-#endif
   }
+#endif
 
   const Int bHighPrec = 1;
   Int iTransType = (pMode << 1) + bHighPrec;
-  TCoeff *tmp = (TCoeff *)alloca(iWidth * iHeight * sizeof(TCoeff));
-  fastFwdTrans[ucTrIdx & 1][transformWidthIndex](block, tmp, shift_1st, iHeight, 0, iSkipWidth, iTransType);
-  fastFwdTrans[ucTrIdx >> 1][transformHeightIndex](tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, iTransType);
+  TCoeff *tmp = scratch;
+
+  if( ( ucTrIdx & 1 ) == TRAFO_KLT )
+  {
+    // the row KLT reads the residual directly
+    g_trafoOP.fastFwdKLTPel[transformWidthIndex](residual, (Int)stride, tmp, shift_1st, iHeight, 0, iSkipWidth, iTransType);
+  }
+  else
+  {
+    TCoeff *block = scratch + MAX_TU_SIZE * MAX_TU_SIZE;
+
+    for (Int y = 0; y < iHeight; y++)
+    {
+      for (Int x = 0; x < iWidth; x++)
+      {
+        block[(y * iWidth) + x] = residual[(y * stride) + x];
+      }
+    }
+    g_trafoOP.fastFwdTrans[TRAFO_DCT2][transformWidthIndex](block, tmp, shift_1st, iHeight, 0, iSkipWidth, iTransType);
+  }
+  g_trafoOP.fastFwdTrans[ucTrIdx >> 1][transformHeightIndex](tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, iTransType);
 
 #if SEPARATE_KLT_DEBUG
   printf("\nCoefficient block after Row (1st) KLT:\n");
@@ -191,7 +253,47 @@ void xTrMxN_KLT(const Int bitDepth, const Pel *residual, size_t stride, TCoeff *
 #endif
 }
 
-void xITrMxN_KLT( const Int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, Int iWidth, Int iHeight, UInt uiSkipWidth, UInt uiSkipHeight, const Int maxLog2TrDynamicRange, const PredMode pMode, UChar ucTrIdx, bool use65intraModes )
+/** Get the number of trailing all-zero columns and rows of a coefficient block from the scan position of its last
+*  significant coefficient. The coefficient groups before the one of the last position are scanned completely, so the
+*  significant region is their bounding box extended by the scan positions up to the last one in its group.
+*  The inverse KLT is a full matrix multiplication, the kernels use these as their skip parameters so
+*  that only the region up to the last significant column and row is multiplied.
+*/
+static Void xGetKltZeroOut( const TransformUnit &tu, const ComponentID &compID, Int &iSkipWidth, Int &iSkipHeight )
+{
+  const CompArea &area       = tu.blocks[compID];
+  const Int       lastPos    = tu.lastPos[compID];
+  const Int       log2CGSize = ( area.width & 3 ) || ( area.height & 3 ) ? 2 : 4;
+  const Int       cgMask     = ( 1 << ( log2CGSize >> 1 ) ) - 1;
+#if HEVC_USE_MDCS
+  const UInt      scanIdx    = TU::getCoefScanIdx( tu, compID );
+#else
+  const UInt      scanIdx    = SCAN_DIAG;
+#endif
+  const UInt     *scanPosX   = g_scanOrderPosXY[SCAN_GROUPED_4x4][scanIdx][gp_sizeIdxInfo->idxFrom( area.width )][gp_sizeIdxInfo->idxFrom( area.height )][0];
+  const UInt     *scanPosY   = g_scanOrderPosXY[SCAN_GROUPED_4x4][scanIdx][gp_sizeIdxInfo->idxFrom( area.width )][gp_sizeIdxInfo->idxFrom( area.height )][1];
+  const Int       lastCGPos  = lastPos < 0 ? 0 : ( lastPos >> log2CGSize ) << log2CGSize;
+
+  Int iMaxX = 0;
+  Int iMaxY = 0;
+
+  for( Int scanPos = 0; scanPos < lastCGPos; scanPos += 1 << log2CGSize )
+  {
+    iMaxX = std::max<Int>( iMaxX, scanPosX[scanPos] | cgMask );
+    iMaxY = std::max<Int>( iMaxY, scanPosY[scanPos] | cgMask );
+  }
+
+  for( Int scanPos = lastCGPos; scanPos <= lastPos; scanPos++ )
+  {
+    iMaxX = std::max<Int>( iMaxX, scanPosX[scanPos] );
+    iMaxY = std::max<Int>( iMaxY, scanPosY[scanPos] );
+  }
+
+  iSkipWidth  = area.width  - 1 - iMaxX;
+  iSkipHeight = area.height - 1 - iMaxY;
+}
+
+void xITrMxN_KLT( const Int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, Int iWidth, Int iHeight, UInt uiSkipWidth, UInt uiSkipHeight, const Int maxLog2TrDynamicRange, const PredMode pMode, UChar ucTrIdx, bool use65intraModes, TCoeff *scratch )
 {
   const Int TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_INVERSE];
   const TCoeff clipMinimum         = -( 1 << maxLog2TrDynamicRange );
@@ -205,8 +307,11 @@ void xITrMxN_KLT( const Int bitDepth, const TCoeff *coeff, Pel *residual, size_t
   CHECK( shift_2nd < 0, "Negative shift" );
   CHECK( ucTrIdx < 0 || ucTrIdx > 3, "Incorrect transform index" );
 
-  TCoeff *tmp   = ( TCoeff * ) alloca( iWidth * iHeight * sizeof( TCoeff ) );
-  TCoeff *block = ( TCoeff * ) alloca( iWidth * iHeight * sizeof( TCoeff ) );
+  // the residual is clipped to the Pel range, which equals the dynamic range unless extended precision is used
+  const TCoeff resiMinimum         = std::max<TCoeff>( clipMinimum, std::numeric_limits<Pel>::min() );
+  const TCoeff resiMaximum         = std::min<TCoeff>( clipMaximum, std::numeric_limits<Pel>::max() );
+
+  TCoeff *tmp   = scratch;
 
 #if SEPARATE_KLT_DEBUG
   printf("\nCoefficient block after Quantization:\n");
@@ -221,8 +326,7 @@ void xITrMxN_KLT( const Int bitDepth, const TCoeff *coeff, Pel *residual, size_t
 #endif
   const Int bHighPrec = 1;
   Int iTransType = (pMode << 1) + bHighPrec;
-  fastInvTrans[ucTrIdx >> 1][transformHeightIndex](coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, iTransType, clipMinimum, clipMaximum);
-  fastInvTrans[ucTrIdx & 1][transformWidthIndex](tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, iTransType, clipMinimum, clipMaximum);
+  g_trafoOP.fastInvTrans[ucTrIdx >> 1][transformHeightIndex](coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, iTransType, clipMinimum, clipMaximum);
 
 #if SEPARATE_KLT_DEBUG
   printf("\nCoefficient block after inverse Column (1st) KLT :\n");
@@ -236,11 +340,23 @@ void xITrMxN_KLT( const Int bitDepth, const TCoeff *coeff, Pel *residual, size_t
   }
 #endif
 
-  for( Int y = 0; y < iHeight; y++ )
+  if( ( ucTrIdx & 1 ) == TRAFO_KLT )
   {
-    for( Int x = 0; x < iWidth; x++ )
+    // the row KLT writes the residual directly
+    g_trafoOP.fastInvKLTPel[transformWidthIndex](tmp, residual, (Int)stride, shift_2nd, iHeight, 0, uiSkipWidth, iTransType, resiMinimum, resiMaximum);
+  }
+  else
+  {
+    TCoeff *block = scratch + MAX_TU_SIZE * MAX_TU_SIZE;
+
+    g_trafoOP.fastInvTrans[TRAFO_DCT2][transformWidthIndex](tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, iTransType, resiMinimum, resiMaximum);
+
+    for( Int y = 0; y < iHeight; y++ )
     {
-      residual[( y * stride ) + x] = Pel( block[( y * iWidth ) + x] );
+      for( Int x = 0; x < iWidth; x++ )
+      {
+        residual[( y * stride ) + x] = Pel( block[( y * iWidth ) + x] );
+      }
     }
   }
 #if SEPARATE_KLT_DEBUG
@@ -300,63 +416,18 @@ void xTrMxN( const int bitDepth, const Pel *residual, size_t stride, TCoeff *coe
     }
   }
 
-  {
-    switch (iWidth)
-    {
-    case 2:     fastForwardDCT2_B2( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
-    case 4:
-      {
+  const UInt transformWidthIndex  = g_aucLog2[iWidth ] - 1;  //nLog2WidthMinus1, since transform start from 2-point
+  const UInt transformHeightIndex = g_aucLog2[iHeight] - 1;  //nLog2HeightMinus1, since transform start from 2-point
 #if HEVC_USE_4x4_DSTVII
-        if ((iHeight == 4) && useDST)    // Check for DCT or DST
-        {
-          fastForwardDST7_B4( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );
-        }
-        else
+  const Int  trafoKernel          = ( useDST && iWidth == 4 && iHeight == 4 ) ? TRAFO_DST7 : TRAFO_DCT2;
+#else
+  const Int  trafoKernel          = TRAFO_DCT2;
 #endif
-        {
-          fastForwardDCT2_B4( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );
-        }
-      }
-      break;
-
-    case 8:     fastForwardDCT2_B8  ( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
-    case 16:    fastForwardDCT2_B16 ( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
-    case 32:    fastForwardDCT2_B32 ( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
-    case 64:    fastForwardDCT2_B64 ( block, tmp, shift_1st + COM16_C806_TRANS_PREC, iHeight, 0, iSkipWidth, 0 );  break;
-    case 128:   fastForwardDCT2_B128( block, tmp, shift_1st + COM16_C806_TRANS_PREC, iHeight, 0, iSkipWidth, 0 );  break;
-    default:
-      THROW( "Unsupported transformation size" ); break;
-    }
-  }
 
-  {
-    switch (iHeight)
-    {
-    case 2:     fastForwardDCT2_B2( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
-    case 4:
-      {
-#if HEVC_USE_4x4_DSTVII
-        if ((iWidth == 4) && useDST)    // Check for DCT or DST
-        {
-          fastForwardDST7_B4( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );
-        }
-        else
-#endif
-        {
-          fastForwardDCT2_B4( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );
-        }
-      }
-      break;
-
-    case 8:     fastForwardDCT2_B8  ( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
-    case 16:    fastForwardDCT2_B16 ( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
-    case 32:    fastForwardDCT2_B32 ( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
-    case 64:    fastForwardDCT2_B64 ( tmp, coeff, shift_2nd + COM16_C806_TRANS_PREC, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
-    case 128:   fastForwardDCT2_B128( tmp, coeff, shift_2nd + COM16_C806_TRANS_PREC, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
-    default:
-      THROW( "Unsupported transformation size" ); break;
-    }
-  }
+  CHECK( transformWidthIndex >= NUM_TRAFO_SIZES || transformHeightIndex >= NUM_TRAFO_SIZES, "Unsupported transformation size" );
+
+  g_trafoOP.fastFwdTrans[trafoKernel][transformWidthIndex] ( block, tmp,   shift_1st + ( iWidth  > 32 ? COM16_C806_TRANS_PREC : 0 ), iHeight, 0,          iSkipWidth,  0 );
+  g_trafoOP.fastFwdTrans[trafoKernel][transformHeightIndex]( tmp,   coeff, shift_2nd + ( iHeight > 32 ? COM16_C806_TRANS_PREC : 0 ), iWidth,  iSkipWidth, iSkipHeight, 0 );
 }
 
 
@@ -395,65 +466,19 @@ void xITrMxN( const int bitDepth, const TCoeff *coeff, Pel *residual, size_t str
   ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff block[MAX_TU_SIZE * MAX_TU_SIZE] );
   ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff   tmp[MAX_TU_SIZE * MAX_TU_SIZE] );
 
-  {
-    switch (iHeight)
-    {
-    case 2: fastInverseDCT2_B2( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
-    case 4:
-      {
+  const UInt transformWidthIndex  = g_aucLog2[iWidth ] - 1;  //nLog2WidthMinus1, since transform start from 2-point
+  const UInt transformHeightIndex = g_aucLog2[iHeight] - 1;  //nLog2HeightMinus1, since transform start from 2-point
 #if HEVC_USE_4x4_DSTVII
-        if ((iWidth == 4) && useDST)    // Check for DCT or DST
-        {
-          fastInverseDST7_B4( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum );
-        }
-        else
+  const Int  trafoKernel          = ( useDST && iWidth == 4 && iHeight == 4 ) ? TRAFO_DST7 : TRAFO_DCT2;
+#else
+  const Int  trafoKernel          = TRAFO_DCT2;
 #endif
-        {
-          fastInverseDCT2_B4( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum );
-        }
-      }
-      break;
-
-    case   8: fastInverseDCT2_B8  ( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
-    case  16: fastInverseDCT2_B16 ( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
-    case  32: fastInverseDCT2_B32 ( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
-    case  64: fastInverseDCT2_B64 ( coeff, tmp, shift_1st + COM16_C806_TRANS_PREC, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
-    case 128: fastInverseDCT2_B128( coeff, tmp, shift_1st + COM16_C806_TRANS_PREC, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
-    default:
-      THROW( "Unsupported transformation size" ); break;
-    }
-  }
 
-  {
-    switch (iWidth)
-    {
-    case 2: fastInverseDCT2_B2( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
-    // Clipping here is not in the standard, but is used to protect the "Pel" data type into which the inverse-transformed samples will be copied
-    case 4:
-      {
-#if HEVC_USE_4x4_DSTVII
-        if ((iHeight == 4) && useDST)    // Check for DCT or DST
-        {
-          fastInverseDST7_B4( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() );
-        }
-        else
-#endif
-        {
-          fastInverseDCT2_B4( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() );
-        }
-      }
-      break;
-
-    case   8: fastInverseDCT2_B8  ( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
-    case  16: fastInverseDCT2_B16 ( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
-    case  32: fastInverseDCT2_B32 ( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
-    case  64: fastInverseDCT2_B64 ( tmp, block, shift_2nd + COM16_C806_TRANS_PREC, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
-    case 128: fastInverseDCT2_B128( tmp, block, shift_2nd + COM16_C806_TRANS_PREC, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
-    default:
-      THROW( "Unsupported transformation size" );
-      break;
-    }
-  }
+  CHECK( transformWidthIndex >= NUM_TRAFO_SIZES || transformHeightIndex >= NUM_TRAFO_SIZES, "Unsupported transformation size" );
+
+  g_trafoOP.fastInvTrans[trafoKernel][transformHeightIndex]( coeff, tmp,   shift_1st + ( iHeight > 32 ? COM16_C806_TRANS_PREC : 0 ), iWidth,  uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum );
+  // Clipping here is not in the standard, but is used to protect the "Pel" data type into which the inverse-transformed samples will be copied
+  g_trafoOP.fastInvTrans[trafoKernel][transformWidthIndex] ( tmp,   block, shift_2nd + ( iWidth  > 32 ? COM16_C806_TRANS_PREC : 0 ), iHeight, 0,           uiSkipWidth,  0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() );
 
   for (Int y = 0; y < iHeight; y++)
   {
@@ -483,7 +508,8 @@ Void TrQuant::init( const Quant* otherQuant,
 #endif
                     const bool bEnc,
                     const bool useTransformSkipFast,
-                    const bool rectTUs
+                    const bool rectTUs,
+                    const bool useRDOQSkipZeroCG
 )
 {
   m_uiMaxTrSize          = uiMaxTrSize;
@@ -504,7 +530,7 @@ Void TrQuant::init( const Quant* otherQuant,
 
   if( m_quant )
   {
-    m_quant->init( uiMaxTrSize, bUseRDOQ, bUseRDOQTS, useSelectiveRDOQ );
+    m_quant->init( uiMaxTrSize, bUseRDOQ, bUseRDOQTS, useSelectiveRDOQ, useRDOQSkipZeroCG );
   }
 }
 
@@ -632,7 +658,7 @@ void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPel
   //if( ucTrIdx != DCT2_HEVC )
   if (tu.cu->kltFlag && compID == COMPONENT_Y)
   {
-    xTrMxN_KLT(channelBitDepth, resi.buf, resi.stride, dstCoeff.buf, iWidth, iHeight, maxLog2TrDynamicRange, predMode, ucTrIdx, false, m_rectTUs);
+    xTrMxN_KLT(channelBitDepth, resi.buf, resi.stride, dstCoeff.buf, iWidth, iHeight, maxLog2TrDynamicRange, predMode, ucTrIdx, false, m_rectTUs, m_plTempKLT);
   }
   else
 #endif
@@ -675,7 +701,9 @@ void TrQuant::xIT( const TransformUnit &tu, const ComponentID &compID, const CCo
     {
       assert(tu.cs->sps->getSpsNext().getUseIntraKLT());
     }
-    xITrMxN_KLT(channelBitDepth, pCoeff.buf, pResidual.buf, pResidual.stride, pCoeff.width, pCoeff.height, iSkipWidth, iSkipHeight, maxLog2TrDynamicRange, predMode, ucTrIdx, false);
+    // restrict the multiplications to the region up to the last significant position known from parsing or quantization
+    xGetKltZeroOut( tu, compID, iSkipWidth, iSkipHeight );
+    xITrMxN_KLT(channelBitDepth, pCoeff.buf, pResidual.buf, pResidual.stride, pCoeff.width, pCoeff.height, iSkipWidth, iSkipHeight, maxLog2TrDynamicRange, predMode, ucTrIdx, false, m_plTempKLT);
   }
   else
 #endif
@@ -52,6 +52,42 @@
 
 typedef void FwdTrans(const TCoeff*, TCoeff*, Int, Int, Int, Int, Int);
 typedef void InvTrans(const TCoeff*, TCoeff*, Int, Int, Int, Int, Int, const TCoeff, const TCoeff);
+typedef void FwdTransPel(const Pel*, Int, TCoeff*, Int, Int, Int, Int, Int);
+typedef void InvTransPel(const TCoeff*, Pel*, Int, Int, Int, Int, Int, Int, const TCoeff, const TCoeff);
+
+/// 1D transform kernels held by TrafoOps, KLT and DCT-II keep the order of the bits in the KLT transform index
+enum TrafoKernel
+{
+  TRAFO_KLT  = 0,
+  TRAFO_DCT2 = 1,
+  TRAFO_DST7 = 2,
+  NUM_TRAFO_KERNELS
+};
+
+#define NUM_TRAFO_SIZES                                   7 ///< 1D transform sizes 2 to 128, indexed by log2( size ) - 1
+
+struct TrafoOps
+{
+  TrafoOps();
+
+#if ENABLE_SIMD_OPT_TRAFO
+#ifdef TARGET_SIMD_X86
+  void initTrafoOpsX86();
+  template<X86_VEXT vext>
+  void _initTrafoOpsX86();
+#endif
+#endif
+
+  FwdTrans* fastFwdTrans[NUM_TRAFO_KERNELS][NUM_TRAFO_SIZES];
+  InvTrans* fastInvTrans[NUM_TRAFO_KERNELS][NUM_TRAFO_SIZES];
+#if SEPARABLE_KLT
+  // KLT row transforms reading/writing the strided residual directly
+  FwdTransPel* fastFwdKLTPel[NUM_TRAFO_SIZES];
+  InvTransPel* fastInvKLTPel[NUM_TRAFO_SIZES];
+#endif
+};
+
+extern TrafoOps g_trafoOP;
 
 // ====================================================================================================================
 // Class definition
@@ -76,7 +112,8 @@ public:
 #endif
                     const bool bEnc                 = false,
                     const bool useTransformSkipFast = false,
-                    const bool rectTUs              = false
+                    const bool rectTUs              = false,
+                    const bool useRDOQSkipZeroCG    = false
   );
 
 #if SEPARABLE_KLT
@@ -108,12 +145,15 @@ public:
   Quant* getQuant() { return m_quant;  }
 
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_KLT_PARALLELISM
   void    copyState( const TrQuant& other );
 #endif
 
 protected:
   TCoeff*  m_plTempCoeff;
+#if SEPARABLE_KLT
+  TCoeff*  m_plTempKLT;
+#endif
   UInt     m_uiMaxTrSize;
   Bool     m_bEnc;
   Bool     m_useTransformSkipFast;
@@ -159,13 +199,6 @@ private:
                        PelBuf        &pResidual,
                  const TransformUnit &tu,
                  const ComponentID   &component);
-
-
-#ifdef TARGET_SIMD_X86
-  template<X86_VEXT vext>
-  Void _initTrQuantX86();
-  Void initTrQuantX86();
-#endif
 };// END CLASS DEFINITION TrQuant
 
 //! \}
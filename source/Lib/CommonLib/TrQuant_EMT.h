@@ -71,5 +71,15 @@ void fastForwardKLT_B32 (const TCoeff *src, TCoeff *dst, Int shift, Int line, In
 void fastInverseKLT_B32 (const TCoeff *src, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType, const TCoeff outputMinimum, const TCoeff outputMaximum);
 void fastForwardKLT_B64 (const TCoeff *src, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType);
 void fastInverseKLT_B64 (const TCoeff *src, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType, const TCoeff outputMinimum, const TCoeff outputMaximum);
+void fastForwardKLTPel_B4  (const Pel *src, Int srcStride, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType);
+void fastInverseKLTPel_B4  (const TCoeff *src, Pel *dst, Int dstStride, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType, const TCoeff outputMinimum, const TCoeff outputMaximum);
+void fastForwardKLTPel_B8  (const Pel *src, Int srcStride, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType);
+void fastInverseKLTPel_B8  (const TCoeff *src, Pel *dst, Int dstStride, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType, const TCoeff outputMinimum, const TCoeff outputMaximum);
+void fastForwardKLTPel_B16 (const Pel *src, Int srcStride, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType);
+void fastInverseKLTPel_B16 (const TCoeff *src, Pel *dst, Int dstStride, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType, const TCoeff outputMinimum, const TCoeff outputMaximum);
+void fastForwardKLTPel_B32 (const Pel *src, Int srcStride, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType);
+void fastInverseKLTPel_B32 (const TCoeff *src, Pel *dst, Int dstStride, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType, const TCoeff outputMinimum, const TCoeff outputMaximum);
+void fastForwardKLTPel_B64 (const Pel *src, Int srcStride, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType);
+void fastInverseKLTPel_B64 (const TCoeff *src, Pel *dst, Int dstStride, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType, const TCoeff outputMinimum, const TCoeff outputMaximum);
 #endif
 #endif // __TRQUANT__
@@ -62,23 +62,38 @@
 
 
 #ifndef ENABLE_WPP_PARALLELISM
-#define ENABLE_WPP_PARALLELISM                            0
+#define ENABLE_WPP_PARALLELISM                            1                             // CTU-row wavefront encoding, the number of rows is set with NumWppThreads
 #endif
 #if ENABLE_WPP_PARALLELISM
 #ifndef ENABLE_WPP_STATIC_LINK
 #define ENABLE_WPP_STATIC_LINK                            0 // bug fix static link
 #endif
-#define PARL_WPP_MAX_NUM_THREADS                         16
 
 #endif
 #ifndef ENABLE_SPLIT_PARALLELISM
-#define ENABLE_SPLIT_PARALLELISM                          0
+#define ENABLE_SPLIT_PARALLELISM                          1                             // split-level parallel RDO, the number of threads is set with NumSplitThreads
 #endif
 #if ENABLE_SPLIT_PARALLELISM
 #define PARL_SPLIT_MAX_NUM_JOBS                           6                             // number of parallel jobs that can be defined and need memory allocated
 #define NUM_RESERVERD_SPLIT_JOBS                        ( PARL_SPLIT_MAX_NUM_JOBS + 1 )  // number of all data structures including the merge thread (0)
 #define PARL_SPLIT_MAX_NUM_THREADS                        PARL_SPLIT_MAX_NUM_JOBS
-#define NUM_SPLIT_THREADS_IF_MSVC                         4
+
+#endif
+#ifndef ENABLE_KLT_PARALLELISM
+#define ENABLE_KLT_PARALLELISM                            1                             // concurrent intra and inter KLT candidate evaluation, compiled in by default, serial unless NumKltThreads > 1
+#endif
+#if ENABLE_KLT_PARALLELISM
+#define PARL_KLT_MAX_NUM_JOBS                             4                             // max. number of KLT transform candidates of a TU evaluated concurrently
+
+#endif
+#ifndef ENABLE_FRAME_PARALLELISM
+#define ENABLE_FRAME_PARALLELISM                          ( ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM ) // concurrent compression of independent pictures of a GOP, the number of pictures is set with NumFrameThreads
+#endif
+#if ENABLE_FRAME_PARALLELISM
+#if !( ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM )
+#error "ENABLE_FRAME_PARALLELISM needs the per-thread encoder stacks of ENABLE_WPP_PARALLELISM or ENABLE_SPLIT_PARALLELISM"
+#endif
+#define PARL_FRAME_MAX_NUM_THREADS                        8                             // max. number of pictures compressed concurrently
 
 #endif
 
@@ -86,21 +101,13 @@
 // NEXT software switches
 // ====================================================================================================================
 
-#define INTRA_RESI_OUTPUT                                 0
-#define INTER_RESI_OUTPUT                                 0
 #define SEPARABLE_KLT                                     1
 
-#if INTER_RESI_OUTPUT & SEPARABLE_KLT
-#error Incorrect Combination
-#endif
-
-#if SEPARABLE_KLT | INTRA_RESI_OUTPUT | INTER_RESI_OUTPUT
+#if SEPARABLE_KLT
 #define KLT_SIZE                                          64
 #define SEPARATE_KLT_DEBUG                                0
 #endif
 
-#define x86_SSE_128                                       1
-#define DEBUG_GSXU										  0 // TODO: delete after debug (debug by gsxu)
 #if SEPARABLE_KLT
 #define INTRA_KLT_SET_COMB                                1 // 1: combine the KLT and DCT-II matrices, 0: no combination
 #define STAT_KLT_IDX                                      0
@@ -215,6 +222,15 @@
 #define ENABLE_SIMD_OPT_MCIF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the interpolation filter, no impact on RD performance
 #define ENABLE_SIMD_OPT_BUFFER                          ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the buffer operations, no impact on RD performance
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
+#define ENABLE_SIMD_OPT_TRAFO                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the transform matrix multiplications, no impact on RD performance
+#define ENABLE_SIMD_OPT_INTRAPRED                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the intra prediction and reference sample filtering, no impact on RD performance
+#define ENABLE_SIMD_OPT_DBLF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the deblocking filter, no impact on RD performance
+#define ENABLE_SIMD_OPT_SAO                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the SAO offset application and statistics, no impact on RD performance
+#define ENABLE_SIMD_OPT_QUANT                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the quantization and de-quantization, no impact on RD performance
+// This can be set by the makefile
+#ifndef ENABLE_AVX512
+#define ENABLE_AVX512                                   ( 1 && ENABLE_SIMD_OPT )                            ///< run-time detection of AVX-512 and the kernels of the x86/avx512 tier, no impact on RD performance
+#endif
 // End of SIMD optimizations
 
 #define AMP_ENC_SPEEDUP                                   0 ///< encoder only speed-up by AMP mode skipping
@@ -1012,6 +1028,14 @@ struct LFCUParam
   Bool topEdge;                          ///< indicates top edge
 };
 
+struct LFSegParam
+{
+  Int  iBeta;                            ///< beta value, luma only
+  Int  iTc;                              ///< tc value, 0 for a segment that is not filtered
+  Bool bPartPNoFilter;                   ///< indicator to disable filtering on partP
+  Bool bPartQNoFilter;                   ///< indicator to disable filtering on partQ
+};
+
 
 
 struct PictureHash
@@ -440,6 +440,7 @@ Void TransformUnit::initData()
     rdpcm[i]         = NUMBER_OF_RDPCM_MODES;
     transformSkip[i] = false;
     compAlpha[i]     = 0;
+    lastPos[i]       = -1;
   }
 #if HEVC_USE_RQT || ENABLE_BMS
   depth              = 0;
@@ -479,6 +480,7 @@ TransformUnit& TransformUnit::operator=(const TransformUnit& other)
     rdpcm[i]         = other.rdpcm[i];
     transformSkip[i] = other.transformSkip[i];
     compAlpha[i]     = other.compAlpha[i];
+    lastPos[i]       = other.lastPos[i];
   }
 #if HEVC_USE_RQT || ENABLE_BMS
   depth              = other.depth;
@@ -504,6 +506,7 @@ Void TransformUnit::copyComponentFrom(const TransformUnit& other, const Componen
   rdpcm[i]         = other.rdpcm[i];
   transformSkip[i] = other.transformSkip[i];
   compAlpha[i]     = other.compAlpha[i];
+  lastPos[i]       = other.lastPos[i];
 
 #if HEVC_USE_RQT || ENABLE_BMS
   depth            = other.depth;
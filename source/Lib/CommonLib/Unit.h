@@ -408,6 +408,7 @@ struct TransformUnit : public UnitArea
   RDPCMMode    rdpcm        [ MAX_NUM_TBLOCKS ];
   Bool         transformSkip[ MAX_NUM_TBLOCKS ];
   SChar        compAlpha    [ MAX_NUM_TBLOCKS ];
+  Int          lastPos      [ MAX_NUM_TBLOCKS ]; // scan position of the last significant coefficient (upper bound), -1 if none
 
   TransformUnit() : chType( CH_L ) { }
   TransformUnit(const UnitArea& unit);
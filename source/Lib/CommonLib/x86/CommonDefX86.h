@@ -47,6 +47,9 @@
 
 #ifdef USE_AVX512
 #define SIMDX86 AVX512
+#ifndef USE_AVX2
+#define USE_AVX2  // the AVX-512 tier builds on the AVX2 code paths
+#endif
 #elif defined USE_AVX2
 #define SIMDX86 AVX2
 #elif defined USE_AVX
@@ -303,28 +306,6 @@ static inline void TRANSPOSE8x8_32b_AVX2(__m256i T[8])
 
 #endif
 
-#ifdef USE_AVX512
-
-ALWAYS_INLINE inline __m512i
-_mm512_set_epi16( int16_t x31, int16_t x30, int16_t x29, int16_t x28,
-                  int16_t x27, int16_t x26, int16_t x25, int16_t x24,
-                  int16_t x23, int16_t x22, int16_t x21, int16_t x20,
-                  int16_t x19, int16_t x18, int16_t x17, int16_t x16,
-                  int16_t x15, int16_t x14, int16_t x13, int16_t x12,
-                  int16_t x11, int16_t x10,  int16_t x9,  int16_t x8,
-                  int16_t  x7,  int16_t x6,  int16_t x5,  int16_t x4,
-                  int16_t  x3,  int16_t x2,  int16_t x1,  int16_t x0 )
-{
-  return _mm512_set_epi32( (x31<<16) + (0xffff & x30), (x29<<16) + (0xffff & x28),
-                           (x27<<16) + (0xffff & x26), (x25<<16) + (0xffff & x24),
-                           (x23<<16) + (0xffff & x22), (x21<<16) + (0xffff & x20),
-                           (x19<<16) + (0xffff & x18), (x17<<16) + (0xffff & x16),
-                           (x15<<16) + (0xffff & x14), (x13<<16) + (0xffff & x12),
-                           (x11<<16) + (0xffff & x10), ( x9<<16) + (0xffff &  x8),
-                           ( x7<<16) + (0xffff &  x6), ( x5<<16) + (0xffff &  x4),
-                           ( x3<<16) + (0xffff &  x2), ( x1<<16) + (0xffff &  x0) );
-}
-#endif
 
 #ifdef ENABLE_REGISTER_PRINTING
 /* note for gcc: this helper throws a compilation error
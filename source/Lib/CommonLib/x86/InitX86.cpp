@@ -43,6 +43,10 @@
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/RdCost.h"
 #include "CommonLib/Buffer.h"
+#include "CommonLib/IntraPrediction.h"
+#include "CommonLib/LoopFilter.h"
+#include "CommonLib/SampleAdaptiveOffset.h"
+#include "CommonLib/Quant.h"
 
 #ifdef TARGET_SIMD_X86
 
@@ -52,7 +56,13 @@ Void InterpolationFilter::initInterpolationFilterX86( /*Int iBitDepthY, Int iBit
 {
   auto vext = read_x86_extension_flags();
   switch (vext){
+#if ENABLE_AVX512
   case AVX512:
+    _initInterpolationFilterX86<AVX512>(/*iBitDepthY, iBitDepthC*/);
+    break;
+#else
+  case AVX512:
+#endif
   case AVX2:
     _initInterpolationFilterX86<AVX2>(/*iBitDepthY, iBitDepthC*/);
     break;
@@ -110,5 +120,110 @@ Void RdCost::initRdCostX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_INTRAPRED
+Void IntraPrediction::initIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initIntraPredictionX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initIntraPredictionX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
 #endif
 
+#if ENABLE_SIMD_OPT_DBLF
+Void LoopFilter::initLoopFilterX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initLoopFilterX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initLoopFilterX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_SAO
+Void SaoOps::initSaoOpsX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initSaoOpsX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initSaoOpsX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_QUANT
+Void Quant::initQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initQuantX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initQuantX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_TRAFO
+Void TrafoOps::initTrafoOpsX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+#if ENABLE_AVX512
+    case AVX512:
+      _initTrafoOpsX86<AVX512>();
+      break;
+#else
+    case AVX512:
+#endif
+    case AVX2:
+      _initTrafoOpsX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initTrafoOpsX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#endif
@@ -1122,6 +1122,312 @@ static Void simdFilter( const ClpRng& clpRng, Pel const *src, Int srcStride, Pel
   }
 }
 
+// Fused separable 2D interpolation: a column strip is filtered horizontally row by row, the last N horizontally
+// filtered rows are kept in registers and filtered vertically, so no intermediate block is written to memory.
+// The taps are applied with madd on interleaved sample pairs, the 128 bit lane layout of the unpack and pack
+// instructions keeps the samples in order for the wider vectors.
+
+template<Int N>
+static inline __m128i simdFilter2DHorM4( const Pel* src, const __m128i* vcoeff, const __m128i& voffset, const __m128i& vshift )
+{
+  __m128i vsum = _mm_setzero_si128();
+  for( Int i = 0; i < N; i += 2 )
+  {
+    const __m128i vsrc0 = _mm_loadl_epi64( ( const __m128i* )&src[i] );
+    const __m128i vsrc1 = _mm_loadl_epi64( ( const __m128i* )&src[i + 1] );
+    vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_unpacklo_epi16( vsrc0, vsrc1 ), vcoeff[i / 2] ) );
+  }
+  vsum = _mm_sra_epi32( _mm_add_epi32( vsum, voffset ), vshift );
+  return _mm_packs_epi32( vsum, vsum );
+}
+
+template<Int N>
+static inline __m128i simdFilter2DHorM8( const Pel* src, const __m128i* vcoeff, const __m128i& voffset, const __m128i& vshift )
+{
+  __m128i vsuma = _mm_setzero_si128();
+  __m128i vsumb = _mm_setzero_si128();
+  for( Int i = 0; i < N; i += 2 )
+  {
+    const __m128i vsrc0 = _mm_loadu_si128( ( const __m128i* )&src[i] );
+    const __m128i vsrc1 = _mm_loadu_si128( ( const __m128i* )&src[i + 1] );
+    vsuma = _mm_add_epi32( vsuma, _mm_madd_epi16( _mm_unpacklo_epi16( vsrc0, vsrc1 ), vcoeff[i / 2] ) );
+    vsumb = _mm_add_epi32( vsumb, _mm_madd_epi16( _mm_unpackhi_epi16( vsrc0, vsrc1 ), vcoeff[i / 2] ) );
+  }
+  vsuma = _mm_sra_epi32( _mm_add_epi32( vsuma, voffset ), vshift );
+  vsumb = _mm_sra_epi32( _mm_add_epi32( vsumb, voffset ), vshift );
+  return _mm_packs_epi32( vsuma, vsumb );
+}
+
+template<Int N, Bool isLast, Int W>
+static Void simdFilter2DStripM8( const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int height, const Short* coeffH, const Short* coeffV, Int shiftH, Int offsetH, Int shiftV, Int offsetV, const ClpRng& clpRng )
+{
+  static_assert( W == 4 || W == 8, "Unsupported strip width" );
+
+  const __m128i voffsetH = _mm_set1_epi32( offsetH );
+  const __m128i voffsetV = _mm_set1_epi32( offsetV );
+  const __m128i vshiftH  = _mm_cvtsi32_si128( shiftH );
+  const __m128i vshiftV  = _mm_cvtsi32_si128( shiftV );
+  const __m128i vibdimin = _mm_set1_epi16( clpRng.min );
+  const __m128i vibdimax = _mm_set1_epi16( clpRng.max );
+
+  __m128i vcoeffH[N / 2], vcoeffV[N / 2];
+  for( Int i = 0; i < N; i += 2 )
+  {
+    vcoeffH[i / 2] = _mm_unpacklo_epi16( _mm_set1_epi16( coeffH[i] ), _mm_set1_epi16( coeffH[i + 1] ) );
+    vcoeffV[i / 2] = _mm_unpacklo_epi16( _mm_set1_epi16( coeffV[i] ), _mm_set1_epi16( coeffV[i + 1] ) );
+  }
+
+  __m128i vrow[N];
+  for( Int i = 0; i < N - 1; i++ )
+  {
+    vrow[i] = W == 8 ? simdFilter2DHorM8<N>( src, vcoeffH, voffsetH, vshiftH ) : simdFilter2DHorM4<N>( src, vcoeffH, voffsetH, vshiftH );
+    src    += srcStride;
+  }
+
+  for( Int row = 0; row < height; row++ )
+  {
+    vrow[N - 1] = W == 8 ? simdFilter2DHorM8<N>( src, vcoeffH, voffsetH, vshiftH ) : simdFilter2DHorM4<N>( src, vcoeffH, voffsetH, vshiftH );
+
+    __m128i vsuma = _mm_setzero_si128();
+    __m128i vsumb = _mm_setzero_si128();
+    for( Int i = 0; i < N; i += 2 )
+    {
+      vsuma = _mm_add_epi32( vsuma, _mm_madd_epi16( _mm_unpacklo_epi16( vrow[i], vrow[i + 1] ), vcoeffV[i / 2] ) );
+      if( W == 8 )
+      {
+        vsumb = _mm_add_epi32( vsumb, _mm_madd_epi16( _mm_unpackhi_epi16( vrow[i], vrow[i + 1] ), vcoeffV[i / 2] ) );
+      }
+    }
+    for( Int i = 0; i < N - 1; i++ )
+    {
+      vrow[i] = vrow[i + 1];
+    }
+
+    vsuma = _mm_sra_epi32( _mm_add_epi32( vsuma, voffsetV ), vshiftV );
+    vsumb = _mm_sra_epi32( _mm_add_epi32( vsumb, voffsetV ), vshiftV );
+    __m128i vsum = _mm_packs_epi32( vsuma, vsumb );
+
+    if( isLast )
+    {
+      vsum = _mm_min_epi16( vibdimax, _mm_max_epi16( vibdimin, vsum ) );
+    }
+
+    if( W == 8 )
+    {
+      _mm_storeu_si128( ( __m128i* )dst, vsum );
+    }
+    else
+    {
+      _mm_storel_epi64( ( __m128i* )dst, vsum );
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+#ifdef USE_AVX2
+template<Int N>
+static inline __m256i simdFilter2DHorM16_AVX2( const Pel* src, const __m256i* vcoeff, const __m256i& voffset, const __m128i& vshift )
+{
+  __m256i vsuma = _mm256_setzero_si256();
+  __m256i vsumb = _mm256_setzero_si256();
+  for( Int i = 0; i < N; i += 2 )
+  {
+    const __m256i vsrc0 = _mm256_loadu_si256( ( const __m256i* )&src[i] );
+    const __m256i vsrc1 = _mm256_loadu_si256( ( const __m256i* )&src[i + 1] );
+    vsuma = _mm256_add_epi32( vsuma, _mm256_madd_epi16( _mm256_unpacklo_epi16( vsrc0, vsrc1 ), vcoeff[i / 2] ) );
+    vsumb = _mm256_add_epi32( vsumb, _mm256_madd_epi16( _mm256_unpackhi_epi16( vsrc0, vsrc1 ), vcoeff[i / 2] ) );
+  }
+  vsuma = _mm256_sra_epi32( _mm256_add_epi32( vsuma, voffset ), vshift );
+  vsumb = _mm256_sra_epi32( _mm256_add_epi32( vsumb, voffset ), vshift );
+  return _mm256_packs_epi32( vsuma, vsumb );
+}
+
+template<Int N, Bool isLast>
+static Void simdFilter2DStripM16_AVX2( const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int height, const Short* coeffH, const Short* coeffV, Int shiftH, Int offsetH, Int shiftV, Int offsetV, const ClpRng& clpRng )
+{
+  const __m256i voffsetH = _mm256_set1_epi32( offsetH );
+  const __m256i voffsetV = _mm256_set1_epi32( offsetV );
+  const __m128i vshiftH  = _mm_cvtsi32_si128( shiftH );
+  const __m128i vshiftV  = _mm_cvtsi32_si128( shiftV );
+  const __m256i vibdimin = _mm256_set1_epi16( clpRng.min );
+  const __m256i vibdimax = _mm256_set1_epi16( clpRng.max );
+
+  __m256i vcoeffH[N / 2], vcoeffV[N / 2];
+  for( Int i = 0; i < N; i += 2 )
+  {
+    vcoeffH[i / 2] = _mm256_unpacklo_epi16( _mm256_set1_epi16( coeffH[i] ), _mm256_set1_epi16( coeffH[i + 1] ) );
+    vcoeffV[i / 2] = _mm256_unpacklo_epi16( _mm256_set1_epi16( coeffV[i] ), _mm256_set1_epi16( coeffV[i + 1] ) );
+  }
+
+  __m256i vrow[N];
+  for( Int i = 0; i < N - 1; i++ )
+  {
+    vrow[i] = simdFilter2DHorM16_AVX2<N>( src, vcoeffH, voffsetH, vshiftH );
+    src    += srcStride;
+  }
+
+  for( Int row = 0; row < height; row++ )
+  {
+    vrow[N - 1] = simdFilter2DHorM16_AVX2<N>( src, vcoeffH, voffsetH, vshiftH );
+
+    __m256i vsuma = _mm256_setzero_si256();
+    __m256i vsumb = _mm256_setzero_si256();
+    for( Int i = 0; i < N; i += 2 )
+    {
+      vsuma = _mm256_add_epi32( vsuma, _mm256_madd_epi16( _mm256_unpacklo_epi16( vrow[i], vrow[i + 1] ), vcoeffV[i / 2] ) );
+      vsumb = _mm256_add_epi32( vsumb, _mm256_madd_epi16( _mm256_unpackhi_epi16( vrow[i], vrow[i + 1] ), vcoeffV[i / 2] ) );
+    }
+    for( Int i = 0; i < N - 1; i++ )
+    {
+      vrow[i] = vrow[i + 1];
+    }
+
+    vsuma = _mm256_sra_epi32( _mm256_add_epi32( vsuma, voffsetV ), vshiftV );
+    vsumb = _mm256_sra_epi32( _mm256_add_epi32( vsumb, voffsetV ), vshiftV );
+    __m256i vsum = _mm256_packs_epi32( vsuma, vsumb );
+
+    if( isLast )
+    {
+      vsum = _mm256_min_epi16( vibdimax, _mm256_max_epi16( vibdimin, vsum ) );
+    }
+    _mm256_storeu_si256( ( __m256i* )dst, vsum );
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+#endif
+
+#ifdef USE_AVX512
+// the zero-masked shift avoids the undefined pass-through operand of _mm512_sra_epi32, which trips -Wmaybe-uninitialized
+template<Int N>
+static inline __m512i simdFilter2DHorM32_AVX512( const Pel* src, const __m512i* vcoeff, const __m512i& voffset, const __m128i& vshift )
+{
+  __m512i vsuma = _mm512_setzero_si512();
+  __m512i vsumb = _mm512_setzero_si512();
+  for( Int i = 0; i < N; i += 2 )
+  {
+    const __m512i vsrc0 = _mm512_loadu_si512( ( const void* )&src[i] );
+    const __m512i vsrc1 = _mm512_loadu_si512( ( const void* )&src[i + 1] );
+    vsuma = _mm512_add_epi32( vsuma, _mm512_madd_epi16( _mm512_unpacklo_epi16( vsrc0, vsrc1 ), vcoeff[i / 2] ) );
+    vsumb = _mm512_add_epi32( vsumb, _mm512_madd_epi16( _mm512_unpackhi_epi16( vsrc0, vsrc1 ), vcoeff[i / 2] ) );
+  }
+  vsuma = _mm512_maskz_sra_epi32( 0xffff, _mm512_add_epi32( vsuma, voffset ), vshift );
+  vsumb = _mm512_maskz_sra_epi32( 0xffff, _mm512_add_epi32( vsumb, voffset ), vshift );
+  return _mm512_packs_epi32( vsuma, vsumb );
+}
+
+template<Int N, Bool isLast>
+static Void simdFilter2DStripM32_AVX512( const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int height, const Short* coeffH, const Short* coeffV, Int shiftH, Int offsetH, Int shiftV, Int offsetV, const ClpRng& clpRng )
+{
+  const __m512i voffsetH = _mm512_set1_epi32( offsetH );
+  const __m512i voffsetV = _mm512_set1_epi32( offsetV );
+  const __m128i vshiftH  = _mm_cvtsi32_si128( shiftH );
+  const __m128i vshiftV  = _mm_cvtsi32_si128( shiftV );
+  const __m512i vibdimin = _mm512_set1_epi16( clpRng.min );
+  const __m512i vibdimax = _mm512_set1_epi16( clpRng.max );
+
+  __m512i vcoeffH[N / 2], vcoeffV[N / 2];
+  for( Int i = 0; i < N; i += 2 )
+  {
+    vcoeffH[i / 2] = _mm512_unpacklo_epi16( _mm512_set1_epi16( coeffH[i] ), _mm512_set1_epi16( coeffH[i + 1] ) );
+    vcoeffV[i / 2] = _mm512_unpacklo_epi16( _mm512_set1_epi16( coeffV[i] ), _mm512_set1_epi16( coeffV[i + 1] ) );
+  }
+
+  __m512i vrow[N];
+  for( Int i = 0; i < N - 1; i++ )
+  {
+    vrow[i] = simdFilter2DHorM32_AVX512<N>( src, vcoeffH, voffsetH, vshiftH );
+    src    += srcStride;
+  }
+
+  for( Int row = 0; row < height; row++ )
+  {
+    vrow[N - 1] = simdFilter2DHorM32_AVX512<N>( src, vcoeffH, voffsetH, vshiftH );
+
+    __m512i vsuma = _mm512_setzero_si512();
+    __m512i vsumb = _mm512_setzero_si512();
+    for( Int i = 0; i < N; i += 2 )
+    {
+      vsuma = _mm512_add_epi32( vsuma, _mm512_madd_epi16( _mm512_unpacklo_epi16( vrow[i], vrow[i + 1] ), vcoeffV[i / 2] ) );
+      vsumb = _mm512_add_epi32( vsumb, _mm512_madd_epi16( _mm512_unpackhi_epi16( vrow[i], vrow[i + 1] ), vcoeffV[i / 2] ) );
+    }
+    for( Int i = 0; i < N - 1; i++ )
+    {
+      vrow[i] = vrow[i + 1];
+    }
+
+    vsuma = _mm512_maskz_sra_epi32( 0xffff, _mm512_add_epi32( vsuma, voffsetV ), vshiftV );
+    vsumb = _mm512_maskz_sra_epi32( 0xffff, _mm512_add_epi32( vsumb, voffsetV ), vshiftV );
+    __m512i vsum = _mm512_packs_epi32( vsuma, vsumb );
+
+    if( isLast )
+    {
+      vsum = _mm512_min_epi16( vibdimax, _mm512_max_epi16( vibdimin, vsum ) );
+    }
+    _mm512_storeu_si512( ( void* )dst, vsum );
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+#endif
+
+template<X86_VEXT vext, Int N, Bool isLast>
+static Void simdFilter2D( const ClpRng& clpRng, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, TFilterCoeff const *coeffH, TFilterCoeff const *coeffV )
+{
+  if( N == 2 || clpRng.bd > 10 || ( width & 0x03 ) )
+  {
+    CHECK( width > MAX_CU_SIZE || height > MAX_CU_SIZE, "Block too large for the intermediate buffer" );
+
+    ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, Pel tmp[( MAX_CU_SIZE + N - 1 ) * MAX_CU_SIZE] );
+
+    simdFilter<vext, N, false, true,  false >( clpRng, src - ( N / 2 - 1 ) * srcStride, srcStride, tmp, width, width, height + N - 1, coeffH );
+    simdFilter<vext, N, true,  false, isLast>( clpRng, tmp + ( N / 2 - 1 ) * width,     width,     dst, dstStride, width, height,   coeffV );
+    return;
+  }
+
+  // same rounding as the two pass filtering with simdFilter
+  const Int headRoom = std::max<Int>( 2, ( IF_INTERNAL_PREC - clpRng.bd ) );
+  const Int shiftH   = IF_FILTER_PREC - headRoom;
+  const Int offsetH  = -IF_INTERNAL_OFFS << shiftH;
+  const Int shiftV   = isLast ? IF_FILTER_PREC + headRoom : IF_FILTER_PREC;
+  const Int offsetV  = isLast ? ( 1 << ( shiftV - 1 ) ) + ( IF_INTERNAL_OFFS << IF_FILTER_PREC ) : 0;
+
+  src -= ( N / 2 - 1 ) * srcStride + ( N / 2 - 1 );
+
+  Int col = 0;
+
+#ifdef USE_AVX512
+  if( vext >= AVX512 )
+  {
+    for( ; col + 32 <= width; col += 32 )
+    {
+      simdFilter2DStripM32_AVX512<N, isLast>( src + col, srcStride, dst + col, dstStride, height, coeffH, coeffV, shiftH, offsetH, shiftV, offsetV, clpRng );
+    }
+  }
+#endif
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; col + 16 <= width; col += 16 )
+    {
+      simdFilter2DStripM16_AVX2<N, isLast>( src + col, srcStride, dst + col, dstStride, height, coeffH, coeffV, shiftH, offsetH, shiftV, offsetV, clpRng );
+    }
+  }
+#endif
+  for( ; col + 8 <= width; col += 8 )
+  {
+    simdFilter2DStripM8<N, isLast, 8>( src + col, srcStride, dst + col, dstStride, height, coeffH, coeffV, shiftH, offsetH, shiftV, offsetV, clpRng );
+  }
+  if( col < width )
+  {
+    simdFilter2DStripM8<N, isLast, 4>( src + col, srcStride, dst + col, dstStride, height, coeffH, coeffV, shiftH, offsetH, shiftV, offsetV, clpRng );
+  }
+}
+
 template <X86_VEXT vext>
 Void InterpolationFilter::_initInterpolationFilterX86()
 {
@@ -1160,6 +1466,13 @@ Void InterpolationFilter::_initInterpolationFilterX86()
   m_filterCopy[0][1]   = simdFilterCopy<vext, false, true>;
   m_filterCopy[1][0]   = simdFilterCopy<vext, true, false>;
   m_filterCopy[1][1]   = simdFilterCopy<vext, true, true>;
+
+  m_filter2D[0][0]     = simdFilter2D<vext, 8, false>;
+  m_filter2D[0][1]     = simdFilter2D<vext, 8, true>;
+  m_filter2D[1][0]     = simdFilter2D<vext, 4, false>;
+  m_filter2D[1][1]     = simdFilter2D<vext, 4, true>;
+  m_filter2D[2][0]     = simdFilter2D<vext, 2, false>;
+  m_filter2D[2][1]     = simdFilter2D<vext, 2, true>;
 }
 
 template Void InterpolationFilter::_initInterpolationFilterX86<SIMDX86>();
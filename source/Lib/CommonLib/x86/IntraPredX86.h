@@ -0,0 +1,313 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IntraPredX86.h
+    \brief    SIMD kernels for the intra prediction
+*/
+
+#include "CommonDefX86.h"
+#include "../Rom.h"
+#include "../IntraPrediction.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+
+// ====================================================================================================================
+// Angular prediction
+// ====================================================================================================================
+
+// ( ( 32 - deltaFract ) * refMain[x] + deltaFract * refMain[x + 1] + 16 ) >> 5 for W samples, the weights are
+// interleaved so that a single madd per four samples does the interpolation in 32 bits
+template< X86_VEXT vext, Int W >
+static inline Void xPredIntraAngRow_SIMD( Pel* pDst, const Pel* pRef, const Int width, const Int deltaFract )
+{
+  if( W == 4 )
+  {
+    const __m128i vweight = _mm_set1_epi32( ( deltaFract << 16 ) | ( 32 - deltaFract ) );
+    const __m128i voffset = _mm_set1_epi32( 16 );
+    __m128i vsrc = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* )pRef ), _mm_loadl_epi64( ( const __m128i* )( pRef + 1 ) ) );
+    __m128i vres = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( vsrc, vweight ), voffset ), 5 );
+    _mm_storel_epi64( ( __m128i* )pDst, _mm_packs_epi32( vres, vres ) );
+  }
+  else if( vext >= AVX2 && W >= 16 )
+  {
+#ifdef USE_AVX2
+    const __m256i vweight = _mm256_set1_epi32( ( deltaFract << 16 ) | ( 32 - deltaFract ) );
+    const __m256i voffset = _mm256_set1_epi32( 16 );
+    for( Int x = 0; x < width; x += 16 )
+    {
+      const __m256i va = _mm256_loadu_si256( ( const __m256i* )( pRef + x ) );
+      const __m256i vb = _mm256_loadu_si256( ( const __m256i* )( pRef + x + 1 ) );
+      __m256i vlo = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( va, vb ), vweight ), voffset ), 5 );
+      __m256i vhi = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( va, vb ), vweight ), voffset ), 5 );
+      _mm256_storeu_si256( ( __m256i* )( pDst + x ), _mm256_packs_epi32( vlo, vhi ) );
+    }
+#endif
+  }
+  else
+  {
+    const __m128i vweight = _mm_set1_epi32( ( deltaFract << 16 ) | ( 32 - deltaFract ) );
+    const __m128i voffset = _mm_set1_epi32( 16 );
+    for( Int x = 0; x < width; x += 8 )
+    {
+      const __m128i va = _mm_loadu_si128( ( const __m128i* )( pRef + x ) );
+      const __m128i vb = _mm_loadu_si128( ( const __m128i* )( pRef + x + 1 ) );
+      __m128i vlo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( va, vb ), vweight ), voffset ), 5 );
+      __m128i vhi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( va, vb ), vweight ), voffset ), 5 );
+      _mm_storeu_si128( ( __m128i* )( pDst + x ), _mm_packs_epi32( vlo, vhi ) );
+    }
+  }
+}
+
+template< X86_VEXT vext, Int W >
+static inline Void xPredIntraAngRowsW_SIMD( Pel* pDst, const Int dstStride, const Pel* refMain, const Int width, const Int height, const Int intraPredAngle )
+{
+  for( Int y = 0, deltaPos = intraPredAngle; y < height; y++, deltaPos += intraPredAngle, pDst += dstStride )
+  {
+    const Int deltaInt   = deltaPos >> 5;
+    const Int deltaFract = deltaPos & ( 32 - 1 );
+    const Pel* pRef      = refMain + deltaInt + 1;
+
+    if( deltaFract == 0 )
+    {
+      // integer displacement, the filter degenerates to a copy
+      ::memcpy( pDst, pRef, width * sizeof( Pel ) );
+    }
+    else
+    {
+      xPredIntraAngRow_SIMD<vext, W>( pDst, pRef, width, deltaFract );
+    }
+  }
+}
+
+template< X86_VEXT vext >
+Void IntraPrediction::xPredIntraAngRows_SIMD( Pel* pDst, const Int dstStride, const Pel* refMain, const Int width, const Int height, const Int intraPredAngle )
+{
+  switch( width )
+  {
+  case 4:
+    xPredIntraAngRowsW_SIMD<vext,  4>( pDst, dstStride, refMain, width, height, intraPredAngle );
+    break;
+  case 8:
+    xPredIntraAngRowsW_SIMD<vext,  8>( pDst, dstStride, refMain, width, height, intraPredAngle );
+    break;
+  default:
+    if( ( width & 15 ) == 0 )
+    {
+      xPredIntraAngRowsW_SIMD<vext, 16>( pDst, dstStride, refMain, width, height, intraPredAngle );
+    }
+    else
+    {
+      xPredIntraAngRows( pDst, dstStride, refMain, width, height, intraPredAngle );
+    }
+    break;
+  }
+}
+
+// ====================================================================================================================
+// Planar prediction
+// ====================================================================================================================
+
+template< X86_VEXT vext >
+Void IntraPrediction::xPredIntraPlanar_SIMD( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const Int width  = pDst.width;
+  const Int height = pDst.height;
+
+  if( width < 4 )
+  {
+    xPredIntraPlanarCore( pSrc, pDst );
+    return;
+  }
+
+  const Int log2W      = g_aucLog2[width];
+  const Int log2H      = g_aucLog2[height];
+  const Int finalShift = 1 + log2W + log2H;
+  const Int srcStride  = pSrc.stride;
+  const Pel* pTop      = pSrc.buf + 1;
+  const Pel* pLeft     = pSrc.buf + srcStride;
+
+  // vertical part of the interpolation kept per column, advanced by one row per iteration
+  ALIGN_DATA( 32, Int vertPred [MAX_CU_SIZE] );
+  ALIGN_DATA( 32, Int bottomRow[MAX_CU_SIZE] );
+
+  const Int bottomLeft = pLeft[height * srcStride];
+  const Int topRight   = pTop[width];
+
+  for( Int x = 0; x < width; x++ )
+  {
+    bottomRow[x] = bottomLeft - pTop[x];
+    vertPred [x] = Int( pTop[x] ) << log2H;
+  }
+
+  const __m128i voffset = _mm_set1_epi32( width * height );
+  const __m128i vramp   = _mm_setr_epi32( 1, 2, 3, 4 );
+  Pel* pred             = pDst.buf;
+
+  for( Int y = 0; y < height; y++, pred += pDst.stride )
+  {
+    const Int left        = pLeft[y * srcStride];
+    const __m128i vleft   = _mm_set1_epi32( left << log2W );
+    const __m128i vright  = _mm_set1_epi32( topRight - left );
+
+    for( Int x = 0; x < width; x += 4 )
+    {
+      // horPred = ( left << log2W ) + ( x + 1 ) * ( topRight - left )
+      __m128i vhor  = _mm_add_epi32( vleft, _mm_mullo_epi32( _mm_add_epi32( vramp, _mm_set1_epi32( x ) ), vright ) );
+      __m128i vvert = _mm_add_epi32( _mm_load_si128( ( const __m128i* )&vertPred[x] ), _mm_load_si128( ( const __m128i* )&bottomRow[x] ) );
+      _mm_store_si128( ( __m128i* )&vertPred[x], vvert );
+
+      __m128i vres  = _mm_add_epi32( _mm_add_epi32( _mm_sll_epi32( vhor, _mm_cvtsi32_si128( log2H ) ), _mm_sll_epi32( vvert, _mm_cvtsi32_si128( log2W ) ) ), voffset );
+      vres          = _mm_sra_epi32( vres, _mm_cvtsi32_si128( finalShift ) );
+      _mm_storel_epi64( ( __m128i* )&pred[x], _mm_packs_epi32( vres, vres ) );
+    }
+  }
+}
+
+// ====================================================================================================================
+// DC prediction
+// ====================================================================================================================
+
+template< X86_VEXT vext >
+Void IntraPrediction::xPredIntraDc_SIMD( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const Int width  = pDst.width;
+  const Int height = pDst.height;
+
+  if( width < 8 )
+  {
+    xPredIntraDcCore( pSrc, pDst );
+    return;
+  }
+
+  // the top row is contiguous, the left column is strided and summed in scalar code
+  const Pel* pTop = pSrc.buf + 1;
+  __m128i vsum    = _mm_setzero_si128();
+  for( Int x = 0; x < width; x += 8 )
+  {
+    vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* )&pTop[x] ), _mm_set1_epi16( 1 ) ) );
+  }
+  vsum = _mm_hadd_epi32( vsum, vsum );
+  vsum = _mm_hadd_epi32( vsum, vsum );
+
+  Int iSum = _mm_cvtsi128_si32( vsum );
+  for( Int y = 0; y < height; y++ )
+  {
+    iSum += pSrc.at( 0, 1 + y );
+  }
+
+  const Pel dcval = ( iSum + ( ( width + height ) >> 1 ) ) / ( width + height );
+  Pel* pDstBuf    = pDst.buf;
+
+  if( vext >= AVX2 && ( width & 15 ) == 0 )
+  {
+#ifdef USE_AVX2
+    const __m256i vdc = _mm256_set1_epi16( dcval );
+    for( Int y = 0; y < height; y++, pDstBuf += pDst.stride )
+    {
+      for( Int x = 0; x < width; x += 16 )
+      {
+        _mm256_storeu_si256( ( __m256i* )&pDstBuf[x], vdc );
+      }
+    }
+#endif
+  }
+  else
+  {
+    const __m128i vdc = _mm_set1_epi16( dcval );
+    for( Int y = 0; y < height; y++, pDstBuf += pDst.stride )
+    {
+      for( Int x = 0; x < width; x += 8 )
+      {
+        _mm_storeu_si128( ( __m128i* )&pDstBuf[x], vdc );
+      }
+    }
+  }
+}
+
+// ====================================================================================================================
+// Reference sample filtering
+// ====================================================================================================================
+
+// [1 2 1] / 4 smoothing of a contiguous run of reference samples, pSrc[-1] and pSrc[num] are read as neighbours
+template< X86_VEXT vext >
+Void IntraPrediction::xFilterRefSamplesRow_SIMD( const Pel* pSrc, Pel* pDst, const Int num )
+{
+  Int i = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vtwo = _mm256_set1_epi16( 2 );
+    for( ; i + 16 <= num; i += 16 )
+    {
+      const __m256i vl = _mm256_loadu_si256( ( const __m256i* )&pSrc[i - 1] );
+      const __m256i vc = _mm256_loadu_si256( ( const __m256i* )&pSrc[i] );
+      const __m256i vr = _mm256_loadu_si256( ( const __m256i* )&pSrc[i + 1] );
+      __m256i vres = _mm256_add_epi16( _mm256_add_epi16( vl, vr ), _mm256_add_epi16( _mm256_slli_epi16( vc, 1 ), vtwo ) );
+      _mm256_storeu_si256( ( __m256i* )&pDst[i], _mm256_srli_epi16( vres, 2 ) );
+    }
+  }
+#endif
+  const __m128i vtwo = _mm_set1_epi16( 2 );
+  for( ; i + 8 <= num; i += 8 )
+  {
+    const __m128i vl = _mm_loadu_si128( ( const __m128i* )&pSrc[i - 1] );
+    const __m128i vc = _mm_loadu_si128( ( const __m128i* )&pSrc[i] );
+    const __m128i vr = _mm_loadu_si128( ( const __m128i* )&pSrc[i + 1] );
+    __m128i vres = _mm_add_epi16( _mm_add_epi16( vl, vr ), _mm_add_epi16( _mm_slli_epi16( vc, 1 ), vtwo ) );
+    _mm_storeu_si128( ( __m128i* )&pDst[i], _mm_srli_epi16( vres, 2 ) );
+  }
+
+  xFilterRefSamplesRow( pSrc + i, pDst + i, num - i );
+}
+
+template< X86_VEXT vext >
+Void IntraPrediction::_initIntraPredictionX86()
+{
+  m_predIntraAngRows    = xPredIntraAngRows_SIMD<vext>;
+  m_predIntraPlanar     = xPredIntraPlanar_SIMD<vext>;
+  m_predIntraDc         = xPredIntraDc_SIMD<vext>;
+  m_filterRefSamplesRow = xFilterRefSamplesRow_SIMD<vext>;
+}
+
+template Void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+
+#endif // ENABLE_SIMD_OPT_INTRAPRED
+
+#endif // TARGET_SIMD_X86
+//! \}
@@ -0,0 +1,738 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     LoopFilterX86.h
+    \brief    SIMD kernels for the deblocking filter
+*/
+
+
+#include "CommonDefX86.h"
+#include "../LoopFilter.h"
+
+#include <cstring>
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if ENABLE_SIMD_OPT_DBLF
+
+// The edge segments are held transposed, one line across the edge per 32 bit lane: vm[0..3] are p3..p0, vm[4..7] are
+// q0..q3. Vertical edges are transposed on load and store, horizontal edges are loaded row by row. The filter sums do
+// not fit into 16 bits at high bit depths, so a 128 bit register holds four lines, i.e. one luma segment, while the
+// AVX2 kernels filter two luma segments or eight chroma lines per register. Every segment of an edge has its own beta,
+// tc and filter decisions, which are turned into per lane masks.
+
+static inline __m128i xClip3_SIMD( const __m128i vmin, const __m128i vmax, const __m128i v )
+{
+  return _mm_min_epi32( _mm_max_epi32( v, vmin ), vmax );
+}
+
+// two samples, i.e. one row of a chroma segment of two lines at a horizontal edge
+static inline __m128i xLoadPel2_SIMD( const Pel* pSrc )
+{
+  int iVal;
+  ::memcpy( &iVal, pSrc, sizeof( iVal ) );
+  return _mm_cvtsi32_si128( iVal );
+}
+
+static inline void xStorePel2_SIMD( Pel* pDst, const int iVal )
+{
+  ::memcpy( pDst, &iVal, sizeof( iVal ) );
+}
+
+#ifdef USE_AVX2
+static inline __m256i xClip3_AVX2( const __m256i vmin, const __m256i vmax, const __m256i v )
+{
+  return _mm256_min_epi32( _mm256_max_epi32( v, vmin ), vmax );
+}
+
+static inline __m128i xPack_AVX2( const __m256i v )
+{
+  return _mm_packs_epi32( _mm256_castsi256_si128( v ), _mm256_extracti128_si256( v, 1 ) );
+}
+
+// one value per segment of four lines
+static inline __m256i xSegSet_AVX2( const int iVal0, const int iVal1 )
+{
+  return _mm256_setr_epi32( iVal0, iVal0, iVal0, iVal0, iVal1, iVal1, iVal1, iVal1 );
+}
+
+static inline __m256i xSegMask_AVX2( const bool b0, const bool b1 )
+{
+  return xSegSet_AVX2( b0 ? -1 : 0, b1 ? -1 : 0 );
+}
+
+static inline void xTranspose8x8_SIMD( __m128i x[8] )
+{
+  const __m128i t0 = _mm_unpacklo_epi16( x[0], x[1] );
+  const __m128i t1 = _mm_unpacklo_epi16( x[2], x[3] );
+  const __m128i t2 = _mm_unpacklo_epi16( x[4], x[5] );
+  const __m128i t3 = _mm_unpacklo_epi16( x[6], x[7] );
+  const __m128i t4 = _mm_unpackhi_epi16( x[0], x[1] );
+  const __m128i t5 = _mm_unpackhi_epi16( x[2], x[3] );
+  const __m128i t6 = _mm_unpackhi_epi16( x[4], x[5] );
+  const __m128i t7 = _mm_unpackhi_epi16( x[6], x[7] );
+
+  const __m128i u0 = _mm_unpacklo_epi32( t0, t1 );
+  const __m128i u1 = _mm_unpackhi_epi32( t0, t1 );
+  const __m128i u2 = _mm_unpacklo_epi32( t2, t3 );
+  const __m128i u3 = _mm_unpackhi_epi32( t2, t3 );
+  const __m128i u4 = _mm_unpacklo_epi32( t4, t5 );
+  const __m128i u5 = _mm_unpackhi_epi32( t4, t5 );
+  const __m128i u6 = _mm_unpacklo_epi32( t6, t7 );
+  const __m128i u7 = _mm_unpackhi_epi32( t6, t7 );
+
+  x[0] = _mm_unpacklo_epi64( u0, u2 );
+  x[1] = _mm_unpackhi_epi64( u0, u2 );
+  x[2] = _mm_unpacklo_epi64( u1, u3 );
+  x[3] = _mm_unpackhi_epi64( u1, u3 );
+  x[4] = _mm_unpacklo_epi64( u4, u6 );
+  x[5] = _mm_unpackhi_epi64( u4, u6 );
+  x[6] = _mm_unpacklo_epi64( u5, u7 );
+  x[7] = _mm_unpackhi_epi64( u5, u7 );
+}
+
+// two consecutive luma segments, lanes 0..3 hold the first one and lanes 4..7 the second one
+static void xEdgeFilterLumaSeg2_AVX2( Pel* piSrc, const int iSrcStep, const int iOffset, const LFSegParam* pSegs, const ClpRng& clpRng )
+{
+  __m256i vm[8];
+
+  if( iOffset == 1 )
+  {
+    __m128i x[8];
+    for( int k = 0; k < 8; k++ )
+    {
+      x[k] = _mm_loadu_si128( ( const __m128i* )( piSrc - 4 + iSrcStep * k ) );
+    }
+    xTranspose8x8_SIMD( x );
+    for( int k = 0; k < 8; k++ )
+    {
+      vm[k] = _mm256_cvtepi16_epi32( x[k] );
+    }
+  }
+  else
+  {
+    for( int k = 0; k < 8; k++ )
+    {
+      vm[k] = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )( piSrc + ( k - 4 ) * iOffset ) ) );
+    }
+  }
+
+  // decisions per segment, taken from its first and its last line
+  int dp[8], dq[8], dStrong[8], dEdge[8];
+  _mm256_storeu_si256( ( __m256i* )dp,      _mm256_abs_epi32( _mm256_add_epi32( _mm256_sub_epi32( vm[1], _mm256_slli_epi32( vm[2], 1 ) ), vm[3] ) ) );
+  _mm256_storeu_si256( ( __m256i* )dq,      _mm256_abs_epi32( _mm256_add_epi32( _mm256_sub_epi32( vm[4], _mm256_slli_epi32( vm[5], 1 ) ), vm[6] ) ) );
+  _mm256_storeu_si256( ( __m256i* )dStrong, _mm256_add_epi32( _mm256_abs_epi32( _mm256_sub_epi32( vm[0], vm[3] ) ), _mm256_abs_epi32( _mm256_sub_epi32( vm[7], vm[4] ) ) ) );
+  _mm256_storeu_si256( ( __m256i* )dEdge,   _mm256_abs_epi32( _mm256_sub_epi32( vm[3], vm[4] ) ) );
+
+  bool bOn[2], bStrong[2], bWeak[2], bSideP[2], bSideQ[2];
+
+  for( int s = 0; s < 2; s++ )
+  {
+    const int iBeta          = pSegs[s].iBeta;
+    const int iTc            = pSegs[s].iTc;
+    const int l0             = 4 * s;
+    const int l3             = 4 * s + 3;
+    const int d0             = dp[l0] + dq[l0];
+    const int d3             = dp[l3] + dq[l3];
+    const int tcStrong       = ( iTc * 5 + 1 ) >> 1;
+    const int iSideThreshold = ( iBeta + ( iBeta >> 1 ) ) >> 3;
+
+    bOn    [s] = iTc != 0 && d0 + d3 < iBeta;
+    bStrong[s] = bOn[s] && ( dStrong[l0] < ( iBeta >> 3 ) ) && ( 2 * d0 < ( iBeta >> 2 ) ) && ( dEdge[l0] < tcStrong )
+                        && ( dStrong[l3] < ( iBeta >> 3 ) ) && ( 2 * d3 < ( iBeta >> 2 ) ) && ( dEdge[l3] < tcStrong );
+    bWeak  [s] = bOn[s] && !bStrong[s];
+    bSideP [s] = dp[l0] + dp[l3] < iSideThreshold;
+    bSideQ [s] = dq[l0] + dq[l3] < iSideThreshold;
+  }
+
+  if( !bOn[0] && !bOn[1] )
+  {
+    return;
+  }
+
+  const __m256i vtc = xSegSet_AVX2( pSegs[0].iTc, pSegs[1].iTc );
+
+  __m256i vf[8];
+  for( int k = 0; k < 8; k++ )
+  {
+    vf[k] = vm[k];
+  }
+
+  if( bStrong[0] || bStrong[1] )
+  {
+    const __m256i vmask = xSegMask_AVX2( bStrong[0], bStrong[1] );
+    const __m256i vtc2  = _mm256_slli_epi32( vtc, 1 );
+    const __m256i v2    = _mm256_set1_epi32( 2 );
+    const __m256i v4    = _mm256_set1_epi32( 4 );
+    const __m256i vp0q0 = _mm256_add_epi32( vm[3], vm[4] );
+
+    __m256i vs[8];
+    // ( p2 + 2 * p1 + 2 * p0 + 2 * q0 + q1 + 4 ) >> 3
+    __m256i vsum = _mm256_add_epi32( _mm256_add_epi32( vm[1], vm[5] ), _mm256_slli_epi32( _mm256_add_epi32( vm[2], vp0q0 ), 1 ) );
+    vs[3] = _mm256_srai_epi32( _mm256_add_epi32( vsum, v4 ), 3 );
+    // ( p1 + 2 * p0 + 2 * q0 + 2 * q1 + q2 + 4 ) >> 3
+    vsum  = _mm256_add_epi32( _mm256_add_epi32( vm[2], vm[6] ), _mm256_slli_epi32( _mm256_add_epi32( vm[5], vp0q0 ), 1 ) );
+    vs[4] = _mm256_srai_epi32( _mm256_add_epi32( vsum, v4 ), 3 );
+    // ( p2 + p1 + p0 + q0 + 2 ) >> 2
+    vsum  = _mm256_add_epi32( _mm256_add_epi32( vm[1], vm[2] ), vp0q0 );
+    vs[2] = _mm256_srai_epi32( _mm256_add_epi32( vsum, v2 ), 2 );
+    // ( p0 + q0 + q1 + q2 + 2 ) >> 2
+    vsum  = _mm256_add_epi32( _mm256_add_epi32( vm[5], vm[6] ), vp0q0 );
+    vs[5] = _mm256_srai_epi32( _mm256_add_epi32( vsum, v2 ), 2 );
+    // ( 2 * p3 + 3 * p2 + p1 + p0 + q0 + 4 ) >> 3
+    vsum  = _mm256_add_epi32( _mm256_add_epi32( _mm256_slli_epi32( _mm256_add_epi32( vm[0], vm[1] ), 1 ), vm[1] ), _mm256_add_epi32( vm[2], vp0q0 ) );
+    vs[1] = _mm256_srai_epi32( _mm256_add_epi32( vsum, v4 ), 3 );
+    // ( p0 + q0 + q1 + 3 * q2 + 2 * q3 + 4 ) >> 3
+    vsum  = _mm256_add_epi32( _mm256_add_epi32( _mm256_slli_epi32( _mm256_add_epi32( vm[7], vm[6] ), 1 ), vm[6] ), _mm256_add_epi32( vm[5], vp0q0 ) );
+    vs[6] = _mm256_srai_epi32( _mm256_add_epi32( vsum, v4 ), 3 );
+
+    for( int k = 1; k < 7; k++ )
+    {
+      vf[k] = _mm256_blendv_epi8( vf[k], xClip3_AVX2( _mm256_sub_epi32( vm[k], vtc2 ), _mm256_add_epi32( vm[k], vtc2 ), vs[k] ), vmask );
+    }
+  }
+
+  if( bWeak[0] || bWeak[1] )
+  {
+    __m256i vdelta = _mm256_sub_epi32( _mm256_mullo_epi32( _mm256_sub_epi32( vm[4], vm[3] ), _mm256_set1_epi32( 9 ) ), _mm256_mullo_epi32( _mm256_sub_epi32( vm[5], vm[2] ), _mm256_set1_epi32( 3 ) ) );
+    vdelta         = _mm256_srai_epi32( _mm256_add_epi32( vdelta, _mm256_set1_epi32( 8 ) ), 4 );
+
+    const __m256i vmask = _mm256_and_si256( xSegMask_AVX2( bWeak[0], bWeak[1] ), _mm256_cmpgt_epi32( _mm256_mullo_epi32( vtc, _mm256_set1_epi32( 10 ) ), _mm256_abs_epi32( vdelta ) ) );
+
+    const __m256i vtc2    = _mm256_srai_epi32( vtc, 1 );
+    const __m256i vone    = _mm256_set1_epi32( 1 );
+    const __m256i vclpMin = _mm256_set1_epi32( clpRng.min );
+    const __m256i vclpMax = _mm256_set1_epi32( clpRng.max );
+
+    vdelta = xClip3_AVX2( _mm256_sub_epi32( _mm256_setzero_si256(), vtc ), vtc, vdelta );
+    vf[3]  = _mm256_blendv_epi8( vf[3], xClip3_AVX2( vclpMin, vclpMax, _mm256_add_epi32( vm[3], vdelta ) ), vmask );
+    vf[4]  = _mm256_blendv_epi8( vf[4], xClip3_AVX2( vclpMin, vclpMax, _mm256_sub_epi32( vm[4], vdelta ) ), vmask );
+
+    if( bSideP[0] || bSideP[1] )
+    {
+      __m256i vdelta1 = _mm256_srai_epi32( _mm256_add_epi32( _mm256_add_epi32( vm[1], vm[3] ), vone ), 1 );
+      vdelta1         = _mm256_srai_epi32( _mm256_add_epi32( _mm256_sub_epi32( vdelta1, vm[2] ), vdelta ), 1 );
+      vdelta1         = xClip3_AVX2( _mm256_sub_epi32( _mm256_setzero_si256(), vtc2 ), vtc2, vdelta1 );
+      vf[2]           = _mm256_blendv_epi8( vf[2], xClip3_AVX2( vclpMin, vclpMax, _mm256_add_epi32( vm[2], vdelta1 ) ), _mm256_and_si256( vmask, xSegMask_AVX2( bSideP[0], bSideP[1] ) ) );
+    }
+    if( bSideQ[0] || bSideQ[1] )
+    {
+      __m256i vdelta2 = _mm256_srai_epi32( _mm256_add_epi32( _mm256_add_epi32( vm[6], vm[4] ), vone ), 1 );
+      vdelta2         = _mm256_srai_epi32( _mm256_sub_epi32( _mm256_sub_epi32( vdelta2, vm[5] ), vdelta ), 1 );
+      vdelta2         = xClip3_AVX2( _mm256_sub_epi32( _mm256_setzero_si256(), vtc2 ), vtc2, vdelta2 );
+      vf[5]           = _mm256_blendv_epi8( vf[5], xClip3_AVX2( vclpMin, vclpMax, _mm256_add_epi32( vm[5], vdelta2 ) ), _mm256_and_si256( vmask, xSegMask_AVX2( bSideQ[0], bSideQ[1] ) ) );
+    }
+  }
+
+  if( pSegs[0].bPartPNoFilter || pSegs[1].bPartPNoFilter )
+  {
+    const __m256i vmask = xSegMask_AVX2( pSegs[0].bPartPNoFilter, pSegs[1].bPartPNoFilter );
+    for( int k = 1; k < 4; k++ )
+    {
+      vf[k] = _mm256_blendv_epi8( vf[k], vm[k], vmask );
+    }
+  }
+  if( pSegs[0].bPartQNoFilter || pSegs[1].bPartQNoFilter )
+  {
+    const __m256i vmask = xSegMask_AVX2( pSegs[0].bPartQNoFilter, pSegs[1].bPartQNoFilter );
+    for( int k = 4; k < 7; k++ )
+    {
+      vf[k] = _mm256_blendv_epi8( vf[k], vm[k], vmask );
+    }
+  }
+
+  if( iOffset == 1 )
+  {
+    __m128i x[8];
+    for( int k = 0; k < 8; k++ )
+    {
+      x[k] = xPack_AVX2( vf[k] );
+    }
+    xTranspose8x8_SIMD( x );
+    for( int k = 0; k < 8; k++ )
+    {
+      _mm_storeu_si128( ( __m128i* )( piSrc - 4 + iSrcStep * k ), x[k] );
+    }
+  }
+  else
+  {
+    for( int k = 1; k < 7; k++ )
+    {
+      _mm_storeu_si128( ( __m128i* )( piSrc + ( k - 4 ) * iOffset ), xPack_AVX2( vf[k] ) );
+    }
+  }
+}
+
+// eight chroma lines, vm[0..3] are p1, p0, q0, q1
+static void xEdgeFilterChromaLines8_AVX2( Pel* piSrc, const int iSrcStep, const int iOffset, const int* piTc, const int* piFilterP, const int* piFilterQ, const ClpRng& clpRng )
+{
+  const __m256i vfilterP = _mm256_loadu_si256( ( const __m256i* )piFilterP );
+  const __m256i vfilterQ = _mm256_loadu_si256( ( const __m256i* )piFilterQ );
+  const __m256i vfilter  = _mm256_or_si256( vfilterP, vfilterQ );
+
+  if( _mm256_testz_si256( vfilter, vfilter ) )
+  {
+    return;
+  }
+
+  __m256i vm[4];
+
+  if( iOffset == 1 )
+  {
+    __m128i r[8];
+    for( int k = 0; k < 8; k++ )
+    {
+      r[k] = _mm_loadl_epi64( ( const __m128i* )( piSrc - 2 + iSrcStep * k ) );
+    }
+
+    const __m128i t0 = _mm_unpacklo_epi16( r[0], r[1] );
+    const __m128i t1 = _mm_unpacklo_epi16( r[2], r[3] );
+    const __m128i t2 = _mm_unpacklo_epi16( r[4], r[5] );
+    const __m128i t3 = _mm_unpacklo_epi16( r[6], r[7] );
+    const __m128i u0 = _mm_unpacklo_epi32( t0, t1 );
+    const __m128i u1 = _mm_unpackhi_epi32( t0, t1 );
+    const __m128i u2 = _mm_unpacklo_epi32( t2, t3 );
+    const __m128i u3 = _mm_unpackhi_epi32( t2, t3 );
+
+    vm[0] = _mm256_cvtepi16_epi32( _mm_unpacklo_epi64( u0, u2 ) );
+    vm[1] = _mm256_cvtepi16_epi32( _mm_unpackhi_epi64( u0, u2 ) );
+    vm[2] = _mm256_cvtepi16_epi32( _mm_unpacklo_epi64( u1, u3 ) );
+    vm[3] = _mm256_cvtepi16_epi32( _mm_unpackhi_epi64( u1, u3 ) );
+  }
+  else
+  {
+    for( int k = 0; k < 4; k++ )
+    {
+      vm[k] = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )( piSrc + ( k - 2 ) * iOffset ) ) );
+    }
+  }
+
+  const __m256i vtc     = _mm256_loadu_si256( ( const __m256i* )piTc );
+  const __m256i vclpMin = _mm256_set1_epi32( clpRng.min );
+  const __m256i vclpMax = _mm256_set1_epi32( clpRng.max );
+
+  // Clip3( -tc, tc, ( ( ( q0 - p0 ) << 2 ) + p1 - q1 + 4 ) >> 3 )
+  __m256i vdelta = _mm256_add_epi32( _mm256_slli_epi32( _mm256_sub_epi32( vm[2], vm[1] ), 2 ), _mm256_sub_epi32( vm[0], vm[3] ) );
+  vdelta         = _mm256_srai_epi32( _mm256_add_epi32( vdelta, _mm256_set1_epi32( 4 ) ), 3 );
+  vdelta         = xClip3_AVX2( _mm256_sub_epi32( _mm256_setzero_si256(), vtc ), vtc, vdelta );
+
+  const __m256i vp0 = _mm256_blendv_epi8( vm[1], xClip3_AVX2( vclpMin, vclpMax, _mm256_add_epi32( vm[1], vdelta ) ), vfilterP );
+  const __m256i vq0 = _mm256_blendv_epi8( vm[2], xClip3_AVX2( vclpMin, vclpMax, _mm256_sub_epi32( vm[2], vdelta ) ), vfilterQ );
+
+  if( iOffset == 1 )
+  {
+    const __m128i c0 = xPack_AVX2( vm[0] );
+    const __m128i c1 = xPack_AVX2( vp0 );
+    const __m128i c2 = xPack_AVX2( vq0 );
+    const __m128i c3 = xPack_AVX2( vm[3] );
+
+    const __m128i t0  = _mm_unpacklo_epi16( c0, c1 );
+    const __m128i t1  = _mm_unpacklo_epi16( c2, c3 );
+    const __m128i t2  = _mm_unpackhi_epi16( c0, c1 );
+    const __m128i t3  = _mm_unpackhi_epi16( c2, c3 );
+    const __m128i r01 = _mm_unpacklo_epi32( t0, t1 );
+    const __m128i r23 = _mm_unpackhi_epi32( t0, t1 );
+    const __m128i r45 = _mm_unpacklo_epi32( t2, t3 );
+    const __m128i r67 = _mm_unpackhi_epi32( t2, t3 );
+
+    _mm_storel_epi64( ( __m128i* )( piSrc - 2                ), r01 );
+    _mm_storel_epi64( ( __m128i* )( piSrc - 2 + iSrcStep     ), _mm_unpackhi_epi64( r01, r01 ) );
+    _mm_storel_epi64( ( __m128i* )( piSrc - 2 + iSrcStep * 2 ), r23 );
+    _mm_storel_epi64( ( __m128i* )( piSrc - 2 + iSrcStep * 3 ), _mm_unpackhi_epi64( r23, r23 ) );
+    _mm_storel_epi64( ( __m128i* )( piSrc - 2 + iSrcStep * 4 ), r45 );
+    _mm_storel_epi64( ( __m128i* )( piSrc - 2 + iSrcStep * 5 ), _mm_unpackhi_epi64( r45, r45 ) );
+    _mm_storel_epi64( ( __m128i* )( piSrc - 2 + iSrcStep * 6 ), r67 );
+    _mm_storel_epi64( ( __m128i* )( piSrc - 2 + iSrcStep * 7 ), _mm_unpackhi_epi64( r67, r67 ) );
+  }
+  else
+  {
+    _mm_storeu_si128( ( __m128i* )( piSrc - iOffset ), xPack_AVX2( vp0 ) );
+    _mm_storeu_si128( ( __m128i* )( piSrc           ), xPack_AVX2( vq0 ) );
+  }
+}
+#endif
+
+// two or four chroma lines, vm[0..3] are p1, p0, q0, q1
+static void xEdgeFilterChromaLines_SIMD( Pel* piSrc, const int iSrcStep, const int iOffset, const int n, const int* piTc, const int* piFilterP, const int* piFilterQ, const ClpRng& clpRng )
+{
+  const __m128i vfilterP = n == 4 ? _mm_loadu_si128( ( const __m128i* )piFilterP ) : _mm_loadl_epi64( ( const __m128i* )piFilterP );
+  const __m128i vfilterQ = n == 4 ? _mm_loadu_si128( ( const __m128i* )piFilterQ ) : _mm_loadl_epi64( ( const __m128i* )piFilterQ );
+  const __m128i vfilter  = _mm_or_si128( vfilterP, vfilterQ );
+
+  if( _mm_testz_si128( vfilter, vfilter ) )
+  {
+    return;
+  }
+
+  __m128i vm[4];
+
+  if( iOffset == 1 )
+  {
+    const __m128i r0 = _mm_loadl_epi64( ( const __m128i* )( piSrc - 2            ) );
+    const __m128i r1 = _mm_loadl_epi64( ( const __m128i* )( piSrc - 2 + iSrcStep ) );
+    const __m128i r2 = n == 4 ? _mm_loadl_epi64( ( const __m128i* )( piSrc - 2 + iSrcStep * 2 ) ) : _mm_setzero_si128();
+    const __m128i r3 = n == 4 ? _mm_loadl_epi64( ( const __m128i* )( piSrc - 2 + iSrcStep * 3 ) ) : _mm_setzero_si128();
+
+    const __m128i t0 = _mm_unpacklo_epi16( r0, r1 );
+    const __m128i t1 = _mm_unpacklo_epi16( r2, r3 );
+    const __m128i u0 = _mm_unpacklo_epi32( t0, t1 );
+    const __m128i u1 = _mm_unpackhi_epi32( t0, t1 );
+
+    vm[0] = _mm_cvtepi16_epi32( u0 );
+    vm[1] = _mm_cvtepi16_epi32( _mm_srli_si128( u0, 8 ) );
+    vm[2] = _mm_cvtepi16_epi32( u1 );
+    vm[3] = _mm_cvtepi16_epi32( _mm_srli_si128( u1, 8 ) );
+  }
+  else
+  {
+    for( int k = 0; k < 4; k++ )
+    {
+      const Pel* pRow = piSrc + ( k - 2 ) * iOffset;
+      vm[k] = _mm_cvtepi16_epi32( n == 4 ? _mm_loadl_epi64( ( const __m128i* )pRow ) : xLoadPel2_SIMD( pRow ) );
+    }
+  }
+
+  const __m128i vtc     = n == 4 ? _mm_loadu_si128( ( const __m128i* )piTc ) : _mm_loadl_epi64( ( const __m128i* )piTc );
+  const __m128i vclpMin = _mm_set1_epi32( clpRng.min );
+  const __m128i vclpMax = _mm_set1_epi32( clpRng.max );
+
+  // Clip3( -tc, tc, ( ( ( q0 - p0 ) << 2 ) + p1 - q1 + 4 ) >> 3 )
+  __m128i vdelta = _mm_add_epi32( _mm_slli_epi32( _mm_sub_epi32( vm[2], vm[1] ), 2 ), _mm_sub_epi32( vm[0], vm[3] ) );
+  vdelta         = _mm_srai_epi32( _mm_add_epi32( vdelta, _mm_set1_epi32( 4 ) ), 3 );
+  vdelta         = xClip3_SIMD( _mm_sub_epi32( _mm_setzero_si128(), vtc ), vtc, vdelta );
+
+  const __m128i vp0 = _mm_blendv_epi8( vm[1], xClip3_SIMD( vclpMin, vclpMax, _mm_add_epi32( vm[1], vdelta ) ), vfilterP );
+  const __m128i vq0 = _mm_blendv_epi8( vm[2], xClip3_SIMD( vclpMin, vclpMax, _mm_sub_epi32( vm[2], vdelta ) ), vfilterQ );
+
+  if( iOffset == 1 )
+  {
+    const __m128i s01 = _mm_unpacklo_epi16( _mm_packs_epi32( vm[0], vm[0] ), _mm_packs_epi32( vp0, vp0 ) );
+    const __m128i s23 = _mm_unpacklo_epi16( _mm_packs_epi32( vq0, vq0 ), _mm_packs_epi32( vm[3], vm[3] ) );
+    const __m128i r01 = _mm_unpacklo_epi32( s01, s23 );
+    const __m128i r23 = _mm_unpackhi_epi32( s01, s23 );
+
+    _mm_storel_epi64( ( __m128i* )( piSrc - 2            ), r01 );
+    _mm_storel_epi64( ( __m128i* )( piSrc - 2 + iSrcStep ), _mm_unpackhi_epi64( r01, r01 ) );
+    if( n == 4 )
+    {
+      _mm_storel_epi64( ( __m128i* )( piSrc - 2 + iSrcStep * 2 ), r23 );
+      _mm_storel_epi64( ( __m128i* )( piSrc - 2 + iSrcStep * 3 ), _mm_unpackhi_epi64( r23, r23 ) );
+    }
+  }
+  else
+  {
+    const __m128i vp0q0 = _mm_packs_epi32( vp0, vq0 );
+    if( n == 4 )
+    {
+      _mm_storel_epi64( ( __m128i* )( piSrc - iOffset ), vp0q0 );
+      _mm_storel_epi64( ( __m128i* )( piSrc           ), _mm_unpackhi_epi64( vp0q0, vp0q0 ) );
+    }
+    else
+    {
+      xStorePel2_SIMD( piSrc - iOffset, _mm_cvtsi128_si32( vp0q0 ) );
+      xStorePel2_SIMD( piSrc,           _mm_extract_epi32( vp0q0, 2 ) );
+    }
+  }
+}
+
+template< X86_VEXT vext >
+void LoopFilter::xEdgeFilterLumaSeg_SIMD( Pel* piSrc, const int iSrcStep, const int iOffset, const int iBeta, const int iTc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng )
+{
+  __m128i vm[8];
+
+  if( iOffset == 1 )
+  {
+    const __m128i r0 = _mm_loadu_si128( ( const __m128i* )( piSrc - 4                ) );
+    const __m128i r1 = _mm_loadu_si128( ( const __m128i* )( piSrc - 4 + iSrcStep     ) );
+    const __m128i r2 = _mm_loadu_si128( ( const __m128i* )( piSrc - 4 + iSrcStep * 2 ) );
+    const __m128i r3 = _mm_loadu_si128( ( const __m128i* )( piSrc - 4 + iSrcStep * 3 ) );
+
+    const __m128i t0 = _mm_unpacklo_epi16( r0, r1 );
+    const __m128i t1 = _mm_unpacklo_epi16( r2, r3 );
+    const __m128i t2 = _mm_unpackhi_epi16( r0, r1 );
+    const __m128i t3 = _mm_unpackhi_epi16( r2, r3 );
+
+    const __m128i u0 = _mm_unpacklo_epi32( t0, t1 );
+    const __m128i u1 = _mm_unpackhi_epi32( t0, t1 );
+    const __m128i u2 = _mm_unpacklo_epi32( t2, t3 );
+    const __m128i u3 = _mm_unpackhi_epi32( t2, t3 );
+
+    vm[0] = _mm_cvtepi16_epi32( u0 );
+    vm[1] = _mm_cvtepi16_epi32( _mm_srli_si128( u0, 8 ) );
+    vm[2] = _mm_cvtepi16_epi32( u1 );
+    vm[3] = _mm_cvtepi16_epi32( _mm_srli_si128( u1, 8 ) );
+    vm[4] = _mm_cvtepi16_epi32( u2 );
+    vm[5] = _mm_cvtepi16_epi32( _mm_srli_si128( u2, 8 ) );
+    vm[6] = _mm_cvtepi16_epi32( u3 );
+    vm[7] = _mm_cvtepi16_epi32( _mm_srli_si128( u3, 8 ) );
+  }
+  else
+  {
+    for( int k = 0; k < 8; k++ )
+    {
+      vm[k] = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( piSrc + ( k - 4 ) * iOffset ) ) );
+    }
+  }
+
+  // decisions, taken from the first and the last line of the segment
+  const __m128i vdp = _mm_abs_epi32( _mm_add_epi32( _mm_sub_epi32( vm[1], _mm_slli_epi32( vm[2], 1 ) ), vm[3] ) );
+  const __m128i vdq = _mm_abs_epi32( _mm_add_epi32( _mm_sub_epi32( vm[4], _mm_slli_epi32( vm[5], 1 ) ), vm[6] ) );
+
+  const int dp0 = _mm_extract_epi32( vdp, 0 );
+  const int dp3 = _mm_extract_epi32( vdp, 3 );
+  const int dq0 = _mm_extract_epi32( vdq, 0 );
+  const int dq3 = _mm_extract_epi32( vdq, 3 );
+  const int d0  = dp0 + dq0;
+  const int d3  = dp3 + dq3;
+
+  if( d0 + d3 >= iBeta )
+  {
+    return;
+  }
+
+  const __m128i vdStrong = _mm_add_epi32( _mm_abs_epi32( _mm_sub_epi32( vm[0], vm[3] ) ), _mm_abs_epi32( _mm_sub_epi32( vm[7], vm[4] ) ) );
+  const __m128i vdEdge   = _mm_abs_epi32( _mm_sub_epi32( vm[3], vm[4] ) );
+  const int     tcStrong = ( iTc * 5 + 1 ) >> 1;
+
+  const bool sw = ( _mm_extract_epi32( vdStrong, 0 ) < ( iBeta >> 3 ) ) && ( 2 * d0 < ( iBeta >> 2 ) ) && ( _mm_extract_epi32( vdEdge, 0 ) < tcStrong )
+               && ( _mm_extract_epi32( vdStrong, 3 ) < ( iBeta >> 3 ) ) && ( 2 * d3 < ( iBeta >> 2 ) ) && ( _mm_extract_epi32( vdEdge, 3 ) < tcStrong );
+
+  __m128i vf[8];
+  for( int k = 0; k < 8; k++ )
+  {
+    vf[k] = vm[k];
+  }
+
+  if( sw )
+  {
+    const __m128i vtc2 = _mm_set1_epi32( 2 * iTc );
+    const __m128i v2   = _mm_set1_epi32( 2 );
+    const __m128i v4   = _mm_set1_epi32( 4 );
+    const __m128i vp0q0 = _mm_add_epi32( vm[3], vm[4] );
+
+    // ( p2 + 2 * p1 + 2 * p0 + 2 * q0 + q1 + 4 ) >> 3
+    __m128i vsum = _mm_add_epi32( _mm_add_epi32( vm[1], vm[5] ), _mm_slli_epi32( _mm_add_epi32( vm[2], vp0q0 ), 1 ) );
+    vf[3] = _mm_srai_epi32( _mm_add_epi32( vsum, v4 ), 3 );
+    // ( p1 + 2 * p0 + 2 * q0 + 2 * q1 + q2 + 4 ) >> 3
+    vsum  = _mm_add_epi32( _mm_add_epi32( vm[2], vm[6] ), _mm_slli_epi32( _mm_add_epi32( vm[5], vp0q0 ), 1 ) );
+    vf[4] = _mm_srai_epi32( _mm_add_epi32( vsum, v4 ), 3 );
+    // ( p2 + p1 + p0 + q0 + 2 ) >> 2
+    vsum  = _mm_add_epi32( _mm_add_epi32( vm[1], vm[2] ), vp0q0 );
+    vf[2] = _mm_srai_epi32( _mm_add_epi32( vsum, v2 ), 2 );
+    // ( p0 + q0 + q1 + q2 + 2 ) >> 2
+    vsum  = _mm_add_epi32( _mm_add_epi32( vm[5], vm[6] ), vp0q0 );
+    vf[5] = _mm_srai_epi32( _mm_add_epi32( vsum, v2 ), 2 );
+    // ( 2 * p3 + 3 * p2 + p1 + p0 + q0 + 4 ) >> 3
+    vsum  = _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( vm[0], vm[1] ), 1 ), vm[1] ), _mm_add_epi32( vm[2], vp0q0 ) );
+    vf[1] = _mm_srai_epi32( _mm_add_epi32( vsum, v4 ), 3 );
+    // ( p0 + q0 + q1 + 3 * q2 + 2 * q3 + 4 ) >> 3
+    vsum  = _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( vm[7], vm[6] ), 1 ), vm[6] ), _mm_add_epi32( vm[5], vp0q0 ) );
+    vf[6] = _mm_srai_epi32( _mm_add_epi32( vsum, v4 ), 3 );
+
+    for( int k = 1; k < 7; k++ )
+    {
+      vf[k] = xClip3_SIMD( _mm_sub_epi32( vm[k], vtc2 ), _mm_add_epi32( vm[k], vtc2 ), vf[k] );
+    }
+  }
+  else
+  {
+    // weak filter
+    __m128i vdelta = _mm_sub_epi32( _mm_mullo_epi32( _mm_sub_epi32( vm[4], vm[3] ), _mm_set1_epi32( 9 ) ), _mm_mullo_epi32( _mm_sub_epi32( vm[5], vm[2] ), _mm_set1_epi32( 3 ) ) );
+    vdelta         = _mm_srai_epi32( _mm_add_epi32( vdelta, _mm_set1_epi32( 8 ) ), 4 );
+
+    const __m128i vmask = _mm_cmplt_epi32( _mm_abs_epi32( vdelta ), _mm_set1_epi32( iTc * 10 ) );
+
+    if( _mm_movemask_epi8( vmask ) == 0 )
+    {
+      return;
+    }
+
+    const __m128i vtc     = _mm_set1_epi32( iTc );
+    const __m128i vtc2    = _mm_set1_epi32( iTc >> 1 );
+    const __m128i vone    = _mm_set1_epi32( 1 );
+    const __m128i vclpMin = _mm_set1_epi32( clpRng.min );
+    const __m128i vclpMax = _mm_set1_epi32( clpRng.max );
+
+    vdelta = xClip3_SIMD( _mm_sub_epi32( _mm_setzero_si128(), vtc ), vtc, vdelta );
+    vf[3]  = _mm_blendv_epi8( vm[3], xClip3_SIMD( vclpMin, vclpMax, _mm_add_epi32( vm[3], vdelta ) ), vmask );
+    vf[4]  = _mm_blendv_epi8( vm[4], xClip3_SIMD( vclpMin, vclpMax, _mm_sub_epi32( vm[4], vdelta ) ), vmask );
+
+    const int iSideThreshold = ( iBeta + ( iBeta >> 1 ) ) >> 3;
+
+    if( dp0 + dp3 < iSideThreshold )
+    {
+      __m128i vdelta1 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( vm[1], vm[3] ), vone ), 1 );
+      vdelta1         = _mm_srai_epi32( _mm_add_epi32( _mm_sub_epi32( vdelta1, vm[2] ), vdelta ), 1 );
+      vdelta1         = xClip3_SIMD( _mm_sub_epi32( _mm_setzero_si128(), vtc2 ), vtc2, vdelta1 );
+      vf[2]           = _mm_blendv_epi8( vm[2], xClip3_SIMD( vclpMin, vclpMax, _mm_add_epi32( vm[2], vdelta1 ) ), vmask );
+    }
+    if( dq0 + dq3 < iSideThreshold )
+    {
+      __m128i vdelta2 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( vm[6], vm[4] ), vone ), 1 );
+      vdelta2         = _mm_srai_epi32( _mm_sub_epi32( _mm_sub_epi32( vdelta2, vm[5] ), vdelta ), 1 );
+      vdelta2         = xClip3_SIMD( _mm_sub_epi32( _mm_setzero_si128(), vtc2 ), vtc2, vdelta2 );
+      vf[5]           = _mm_blendv_epi8( vm[5], xClip3_SIMD( vclpMin, vclpMax, _mm_add_epi32( vm[5], vdelta2 ) ), vmask );
+    }
+  }
+
+  if( bPartPNoFilter )
+  {
+    vf[1] = vm[1];
+    vf[2] = vm[2];
+    vf[3] = vm[3];
+  }
+  if( bPartQNoFilter )
+  {
+    vf[4] = vm[4];
+    vf[5] = vm[5];
+    vf[6] = vm[6];
+  }
+
+  if( iOffset == 1 )
+  {
+    const __m128i s01 = _mm_unpacklo_epi16( _mm_packs_epi32( vf[0], vf[0] ), _mm_packs_epi32( vf[1], vf[1] ) );
+    const __m128i s23 = _mm_unpacklo_epi16( _mm_packs_epi32( vf[2], vf[2] ), _mm_packs_epi32( vf[3], vf[3] ) );
+    const __m128i s45 = _mm_unpacklo_epi16( _mm_packs_epi32( vf[4], vf[4] ), _mm_packs_epi32( vf[5], vf[5] ) );
+    const __m128i s67 = _mm_unpacklo_epi16( _mm_packs_epi32( vf[6], vf[6] ), _mm_packs_epi32( vf[7], vf[7] ) );
+
+    const __m128i r01lo = _mm_unpacklo_epi32( s01, s23 );
+    const __m128i r23lo = _mm_unpackhi_epi32( s01, s23 );
+    const __m128i r01hi = _mm_unpacklo_epi32( s45, s67 );
+    const __m128i r23hi = _mm_unpackhi_epi32( s45, s67 );
+
+    _mm_storeu_si128( ( __m128i* )( piSrc - 4                ), _mm_unpacklo_epi64( r01lo, r01hi ) );
+    _mm_storeu_si128( ( __m128i* )( piSrc - 4 + iSrcStep     ), _mm_unpackhi_epi64( r01lo, r01hi ) );
+    _mm_storeu_si128( ( __m128i* )( piSrc - 4 + iSrcStep * 2 ), _mm_unpacklo_epi64( r23lo, r23hi ) );
+    _mm_storeu_si128( ( __m128i* )( piSrc - 4 + iSrcStep * 3 ), _mm_unpackhi_epi64( r23lo, r23hi ) );
+  }
+  else
+  {
+    for( int k = 1; k < 7; k++ )
+    {
+      _mm_storel_epi64( ( __m128i* )( piSrc + ( k - 4 ) * iOffset ), _mm_packs_epi32( vf[k], vf[k] ) );
+    }
+  }
+}
+
+template< X86_VEXT vext >
+void LoopFilter::xEdgeFilterLumaSegs_SIMD( Pel* piSrc, const int iSrcStep, const int iOffset, const LFSegParam* pSegs, const int iNumSegs, const ClpRng& clpRng )
+{
+  int i = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; i + 1 < iNumSegs; i += 2 )
+    {
+      if( pSegs[i].iTc || pSegs[i + 1].iTc )
+      {
+        xEdgeFilterLumaSeg2_AVX2( piSrc + iSrcStep * 4 * i, iSrcStep, iOffset, pSegs + i, clpRng );
+      }
+    }
+  }
+#endif
+
+  for( ; i < iNumSegs; i++ )
+  {
+    const LFSegParam& seg = pSegs[i];
+
+    if( seg.iTc )
+    {
+      xEdgeFilterLumaSeg_SIMD<vext>( piSrc + iSrcStep * 4 * i, iSrcStep, iOffset, seg.iBeta, seg.iTc, seg.bPartPNoFilter, seg.bPartQNoFilter, clpRng );
+    }
+  }
+}
+
+template< X86_VEXT vext >
+void LoopFilter::xEdgeFilterChromaSegs_SIMD( Pel* piSrc, const int iSrcStep, const int iOffset, const int iNumLines, const LFSegParam* pSegs, const int iNumSegs, const ClpRng& clpRng )
+{
+  if( iNumLines & 1 )
+  {
+    xEdgeFilterChromaSegs( piSrc, iSrcStep, iOffset, iNumLines, pSegs, iNumSegs, clpRng );
+    return;
+  }
+
+  // the segment parameters per line, the masks select the lines whose p0 and q0 are filtered
+  const int iTotalLines = iNumLines * iNumSegs;
+  int       aiTc     [MAX_CU_SIZE];
+  int       aiFilterP[MAX_CU_SIZE];
+  int       aiFilterQ[MAX_CU_SIZE];
+
+  CHECKD( iTotalLines > MAX_CU_SIZE, "Too many lines" );
+
+  for( int i = 0, iLine = 0; i < iNumSegs; i++ )
+  {
+    const LFSegParam& seg = pSegs[i];
+
+    for( int k = 0; k < iNumLines; k++, iLine++ )
+    {
+      aiTc     [iLine] = seg.iTc;
+      aiFilterP[iLine] = seg.iTc && !seg.bPartPNoFilter ? -1 : 0;
+      aiFilterQ[iLine] = seg.iTc && !seg.bPartQNoFilter ? -1 : 0;
+    }
+  }
+
+  int iLine = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; iLine + 8 <= iTotalLines; iLine += 8 )
+    {
+      xEdgeFilterChromaLines8_AVX2( piSrc + iSrcStep * iLine, iSrcStep, iOffset, aiTc + iLine, aiFilterP + iLine, aiFilterQ + iLine, clpRng );
+    }
+  }
+#endif
+
+  for( ; iLine < iTotalLines; iLine += 4 )
+  {
+    xEdgeFilterChromaLines_SIMD( piSrc + iSrcStep * iLine, iSrcStep, iOffset, std::min( 4, iTotalLines - iLine ), aiTc + iLine, aiFilterP + iLine, aiFilterQ + iLine, clpRng );
+  }
+}
+
+template< X86_VEXT vext >
+void LoopFilter::_initLoopFilterX86()
+{
+  m_edgeFilterLumaSegs   = xEdgeFilterLumaSegs_SIMD<vext>;
+  m_edgeFilterChromaSegs = xEdgeFilterChromaSegs_SIMD<vext>;
+}
+
+template void LoopFilter::_initLoopFilterX86<SIMDX86>();
+
+#endif // ENABLE_SIMD_OPT_DBLF
+
+#endif // TARGET_SIMD_X86
+//! \}
@@ -0,0 +1,300 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     QuantX86.h
+    \brief    SIMD kernels for the quantization and de-quantization
+*/
+
+#include "CommonDefX86.h"
+#include "../Quant.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if ENABLE_SIMD_OPT_QUANT
+
+// The quantization products need up to 43 bits. They are formed with 32x32->64 bit multiplications of the even and
+// odd coefficients, the results are merged back into 32 bit lanes. The rounding residual for sign data hiding may be
+// negative, it is shifted with a bias of 1 << iQBits to allow for the logical 64 bit shifts. It is only computed when
+// deltaU is given. The scan positions of the zero levels are replaced by -1, the maximum over the lanes is the last
+// significant scan position.
+
+template< X86_VEXT vext >
+Void Quant::xQuantCore_SIMD( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* deltaU, const Int numCoeff, const Int* piQuantCoeff, const Int quantScale, const Int iWHScale, const Int iQBits, const Int64 iAdd, const TCoeff clipMin, const TCoeff clipMax, const UInt* piScanPos, TCoeff& uiAbsSum, Int& iLastScanPos )
+{
+  const __m128i vqbits  = _mm_cvtsi32_si128( iQBits );
+  const __m128i vqbits8 = _mm_cvtsi32_si128( iQBits - 8 );
+
+  Int n = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vadd    = _mm256_set1_epi64x( iAdd );
+    const __m256i vbias   = _mm256_set1_epi64x( Int64( 1 ) << iQBits );
+    const __m256i v256    = _mm256_set1_epi64x( Int64( 1 ) << 8 );
+    const __m256i vwh     = _mm256_set1_epi32( iWHScale );
+    const __m256i vclpMin = _mm256_set1_epi32( clipMin );
+    const __m256i vclpMax = _mm256_set1_epi32( clipMax );
+    __m256i vabsSum       = _mm256_setzero_si256();
+    __m256i vlast         = _mm256_set1_epi32( -1 );
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      const __m256i vlevel = _mm256_loadu_si256( ( const __m256i* )&piCoef[n] );
+      const __m256i vabs   = _mm256_abs_epi32( vlevel );
+      const __m256i vscale = _mm256_mullo_epi32( piQuantCoeff ? _mm256_loadu_si256( ( const __m256i* )&piQuantCoeff[n] ) : _mm256_set1_epi32( quantScale ), vwh );
+
+      const __m256i vprod0 = _mm256_mul_epu32( vabs, vscale );
+      const __m256i vprod1 = _mm256_mul_epu32( _mm256_srli_epi64( vabs, 32 ), _mm256_srli_epi64( vscale, 32 ) );
+      const __m256i vq0    = _mm256_srl_epi64( _mm256_add_epi64( vprod0, vadd ), vqbits );
+      const __m256i vq1    = _mm256_srl_epi64( _mm256_add_epi64( vprod1, vadd ), vqbits );
+
+      const __m256i vq = _mm256_blend_epi16( vq0, _mm256_slli_epi64( vq1, 32 ), 0xCC );
+
+      if( deltaU )
+      {
+        // ( prod - ( q << iQBits ) ) >> ( iQBits - 8 ), evaluated as ( ( prod - ( q << iQBits ) + ( 1 << iQBits ) ) >> ( iQBits - 8 ) ) - 256
+        const __m256i vd0 = _mm256_sub_epi64( _mm256_srl_epi64( _mm256_add_epi64( _mm256_sub_epi64( vprod0, _mm256_sll_epi64( vq0, vqbits ) ), vbias ), vqbits8 ), v256 );
+        const __m256i vd1 = _mm256_sub_epi64( _mm256_srl_epi64( _mm256_add_epi64( _mm256_sub_epi64( vprod1, _mm256_sll_epi64( vq1, vqbits ) ), vbias ), vqbits8 ), v256 );
+        _mm256_storeu_si256( ( __m256i* )&deltaU[n], _mm256_blend_epi16( vd0, _mm256_slli_epi64( vd1, 32 ), 0xCC ) );
+      }
+
+      vabsSum = _mm256_add_epi32( vabsSum, vq );
+      vlast   = _mm256_max_epi32( vlast, _mm256_or_si256( _mm256_loadu_si256( ( const __m256i* )&piScanPos[n] ), _mm256_cmpeq_epi32( vq, _mm256_setzero_si256() ) ) );
+      _mm256_storeu_si256( ( __m256i* )&piQCoef[n], _mm256_min_epi32( _mm256_max_epi32( _mm256_sign_epi32( vq, vlevel ), vclpMin ), vclpMax ) );
+    }
+
+    __m128i vsum = _mm_add_epi32( _mm256_castsi256_si128( vabsSum ), _mm256_extracti128_si256( vabsSum, 1 ) );
+    vsum         = _mm_hadd_epi32( vsum, vsum );
+    vsum         = _mm_hadd_epi32( vsum, vsum );
+    uiAbsSum    += _mm_cvtsi128_si32( vsum );
+
+    __m128i vmax = _mm_max_epi32( _mm256_castsi256_si128( vlast ), _mm256_extracti128_si256( vlast, 1 ) );
+    vmax         = _mm_max_epi32( vmax, _mm_shuffle_epi32( vmax, 0x4e ) );
+    vmax         = _mm_max_epi32( vmax, _mm_shuffle_epi32( vmax, 0xb1 ) );
+    iLastScanPos = std::max<Int>( iLastScanPos, _mm_cvtsi128_si32( vmax ) );
+  }
+#endif
+  {
+    const __m128i vadd    = _mm_set1_epi64x( iAdd );
+    const __m128i vbias   = _mm_set1_epi64x( Int64( 1 ) << iQBits );
+    const __m128i v256    = _mm_set1_epi64x( Int64( 1 ) << 8 );
+    const __m128i vwh     = _mm_set1_epi32( iWHScale );
+    const __m128i vclpMin = _mm_set1_epi32( clipMin );
+    const __m128i vclpMax = _mm_set1_epi32( clipMax );
+    __m128i vabsSum       = _mm_setzero_si128();
+    __m128i vlast         = _mm_set1_epi32( -1 );
+
+    for( ; n + 4 <= numCoeff; n += 4 )
+    {
+      const __m128i vlevel = _mm_loadu_si128( ( const __m128i* )&piCoef[n] );
+      const __m128i vabs   = _mm_abs_epi32( vlevel );
+      const __m128i vscale = _mm_mullo_epi32( piQuantCoeff ? _mm_loadu_si128( ( const __m128i* )&piQuantCoeff[n] ) : _mm_set1_epi32( quantScale ), vwh );
+
+      const __m128i vprod0 = _mm_mul_epu32( vabs, vscale );
+      const __m128i vprod1 = _mm_mul_epu32( _mm_srli_epi64( vabs, 32 ), _mm_srli_epi64( vscale, 32 ) );
+      const __m128i vq0    = _mm_srl_epi64( _mm_add_epi64( vprod0, vadd ), vqbits );
+      const __m128i vq1    = _mm_srl_epi64( _mm_add_epi64( vprod1, vadd ), vqbits );
+
+      const __m128i vq = _mm_blend_epi16( vq0, _mm_slli_epi64( vq1, 32 ), 0xCC );
+
+      if( deltaU )
+      {
+        const __m128i vd0 = _mm_sub_epi64( _mm_srl_epi64( _mm_add_epi64( _mm_sub_epi64( vprod0, _mm_sll_epi64( vq0, vqbits ) ), vbias ), vqbits8 ), v256 );
+        const __m128i vd1 = _mm_sub_epi64( _mm_srl_epi64( _mm_add_epi64( _mm_sub_epi64( vprod1, _mm_sll_epi64( vq1, vqbits ) ), vbias ), vqbits8 ), v256 );
+        _mm_storeu_si128( ( __m128i* )&deltaU[n], _mm_blend_epi16( vd0, _mm_slli_epi64( vd1, 32 ), 0xCC ) );
+      }
+
+      vabsSum = _mm_add_epi32( vabsSum, vq );
+      vlast   = _mm_max_epi32( vlast, _mm_or_si128( _mm_loadu_si128( ( const __m128i* )&piScanPos[n] ), _mm_cmpeq_epi32( vq, _mm_setzero_si128() ) ) );
+      _mm_storeu_si128( ( __m128i* )&piQCoef[n], _mm_min_epi32( _mm_max_epi32( _mm_sign_epi32( vq, vlevel ), vclpMin ), vclpMax ) );
+    }
+
+    vabsSum   = _mm_hadd_epi32( vabsSum, vabsSum );
+    vabsSum   = _mm_hadd_epi32( vabsSum, vabsSum );
+    uiAbsSum += _mm_cvtsi128_si32( vabsSum );
+
+    vlast        = _mm_max_epi32( vlast, _mm_shuffle_epi32( vlast, 0x4e ) );
+    vlast        = _mm_max_epi32( vlast, _mm_shuffle_epi32( vlast, 0xb1 ) );
+    iLastScanPos = std::max<Int>( iLastScanPos, _mm_cvtsi128_si32( vlast ) );
+  }
+
+  if( n < numCoeff )
+  {
+    xQuantCore( piCoef + n, piQCoef + n, deltaU ? deltaU + n : nullptr, numCoeff - n, piQuantCoeff ? piQuantCoeff + n : nullptr, quantScale, iWHScale, iQBits, iAdd, clipMin, clipMax, piScanPos + n, uiAbsSum, iLastScanPos );
+  }
+}
+
+template< X86_VEXT vext >
+Void Quant::xDeQuantCore_SIMD( const TCoeff* piQCoef, TCoeff* piCoef, const Int numCoeff, const Int* piDequantCoeff, const Int scale, const Int rightShift, const Intermediate_Int inputMin, const Intermediate_Int inputMax, const TCoeff clipMin, const TCoeff clipMax )
+{
+  const Int     iAdd   = rightShift > 0 ? 1 << ( rightShift - 1 ) : 0;
+  const __m128i vshift = _mm_cvtsi32_si128( rightShift > 0 ? rightShift : -rightShift );
+
+  Int n = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vadd    = _mm256_set1_epi32( iAdd );
+    const __m256i vscale  = _mm256_set1_epi32( scale );
+    const __m256i vinMin  = _mm256_set1_epi32( inputMin );
+    const __m256i vinMax  = _mm256_set1_epi32( inputMax );
+    const __m256i vclpMin = _mm256_set1_epi32( clipMin );
+    const __m256i vclpMax = _mm256_set1_epi32( clipMax );
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      const __m256i vlevel = _mm256_min_epi32( _mm256_max_epi32( _mm256_loadu_si256( ( const __m256i* )&piQCoef[n] ), vinMin ), vinMax );
+      const __m256i vmul   = piDequantCoeff ? _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i* )&piDequantCoeff[n] ), vscale ) : vscale;
+      __m256i       vcoeff = _mm256_mullo_epi32( vlevel, vmul );
+
+      vcoeff = rightShift > 0 ? _mm256_sra_epi32( _mm256_add_epi32( vcoeff, vadd ), vshift ) : _mm256_sll_epi32( vcoeff, vshift );
+      _mm256_storeu_si256( ( __m256i* )&piCoef[n], _mm256_min_epi32( _mm256_max_epi32( vcoeff, vclpMin ), vclpMax ) );
+    }
+  }
+#endif
+  {
+    const __m128i vadd    = _mm_set1_epi32( iAdd );
+    const __m128i vscale  = _mm_set1_epi32( scale );
+    const __m128i vinMin  = _mm_set1_epi32( inputMin );
+    const __m128i vinMax  = _mm_set1_epi32( inputMax );
+    const __m128i vclpMin = _mm_set1_epi32( clipMin );
+    const __m128i vclpMax = _mm_set1_epi32( clipMax );
+
+    for( ; n + 4 <= numCoeff; n += 4 )
+    {
+      const __m128i vlevel = _mm_min_epi32( _mm_max_epi32( _mm_loadu_si128( ( const __m128i* )&piQCoef[n] ), vinMin ), vinMax );
+      const __m128i vmul   = piDequantCoeff ? _mm_mullo_epi32( _mm_loadu_si128( ( const __m128i* )&piDequantCoeff[n] ), vscale ) : vscale;
+      __m128i       vcoeff = _mm_mullo_epi32( vlevel, vmul );
+
+      vcoeff = rightShift > 0 ? _mm_sra_epi32( _mm_add_epi32( vcoeff, vadd ), vshift ) : _mm_sll_epi32( vcoeff, vshift );
+      _mm_storeu_si128( ( __m128i* )&piCoef[n], _mm_min_epi32( _mm_max_epi32( vcoeff, vclpMin ), vclpMax ) );
+    }
+  }
+
+  if( n < numCoeff )
+  {
+    xDeQuantCore( piQCoef + n, piCoef + n, numCoeff - n, piDequantCoeff ? piDequantCoeff + n : nullptr, scale, rightShift, inputMin, inputMax, clipMin, clipMax );
+  }
+}
+
+// The RDOQ level products are below 2^53, they are formed exactly in double precision, which also serves the squared
+// error of the zero level. The clipped scaled levels fit into 32 bits, as Intermediate_Int is Int with SIMD enabled.
+
+template< X86_VEXT vext >
+Void Quant::xRdoqLevelCore_SIMD( const TCoeff* piCoef, Intermediate_Int* piLevelDouble, UInt* piMaxAbsLevel, Double* pdCostCoeff0, const Int numCoeff, const Int* piQuantCoeff, const Int quantScale, const Double* pdErrScale, const Double errScale, const Int iQBits, const UInt maxLevel )
+{
+  const Int     iAdd           = 1 << ( iQBits - 1 );
+  const Double  maxLevelDouble = Double( std::numeric_limits<Int>::max() - iAdd );
+  const __m128i vqbits         = _mm_cvtsi32_si128( iQBits );
+
+  Int n = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256d vmaxLevelDbl = _mm256_set1_pd( maxLevelDouble );
+    const __m256d verrScale    = _mm256_set1_pd( errScale );
+    const __m256i vadd         = _mm256_set1_epi32( iAdd );
+    const __m256i vmaxLevel    = _mm256_set1_epi32( maxLevel );
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      const __m256i vabs   = _mm256_abs_epi32( _mm256_loadu_si256( ( const __m256i* )&piCoef[n] ) );
+      const __m256i vscale = piQuantCoeff ? _mm256_loadu_si256( ( const __m256i* )&piQuantCoeff[n] ) : _mm256_set1_epi32( quantScale );
+
+      const __m256d vlev0  = _mm256_min_pd( _mm256_mul_pd( _mm256_cvtepi32_pd( _mm256_castsi256_si128( vabs ) ),      _mm256_cvtepi32_pd( _mm256_castsi256_si128( vscale ) ) ),      vmaxLevelDbl );
+      const __m256d vlev1  = _mm256_min_pd( _mm256_mul_pd( _mm256_cvtepi32_pd( _mm256_extracti128_si256( vabs, 1 ) ), _mm256_cvtepi32_pd( _mm256_extracti128_si256( vscale, 1 ) ) ), vmaxLevelDbl );
+      const __m256i vlevel = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm256_cvttpd_epi32( vlev0 ) ), _mm256_cvttpd_epi32( vlev1 ), 1 );
+
+      _mm256_storeu_si256( ( __m256i* )&piLevelDouble[n], vlevel );
+      _mm256_storeu_si256( ( __m256i* )&piMaxAbsLevel[n], _mm256_min_epi32( _mm256_sra_epi32( _mm256_add_epi32( vlevel, vadd ), vqbits ), vmaxLevel ) );
+
+      const __m256d verr0  = pdErrScale ? _mm256_mul_pd( _mm256_loadu_pd( &pdErrScale[n]     ), verrScale ) : verrScale;
+      const __m256d verr1  = pdErrScale ? _mm256_mul_pd( _mm256_loadu_pd( &pdErrScale[n + 4] ), verrScale ) : verrScale;
+
+      _mm256_storeu_pd( &pdCostCoeff0[n],     _mm256_mul_pd( _mm256_mul_pd( vlev0, vlev0 ), verr0 ) );
+      _mm256_storeu_pd( &pdCostCoeff0[n + 4], _mm256_mul_pd( _mm256_mul_pd( vlev1, vlev1 ), verr1 ) );
+    }
+  }
+#endif
+  {
+    const __m128d vmaxLevelDbl = _mm_set1_pd( maxLevelDouble );
+    const __m128d verrScale    = _mm_set1_pd( errScale );
+    const __m128i vadd         = _mm_set1_epi32( iAdd );
+    const __m128i vmaxLevel    = _mm_set1_epi32( maxLevel );
+
+    for( ; n + 4 <= numCoeff; n += 4 )
+    {
+      const __m128i vabs   = _mm_abs_epi32( _mm_loadu_si128( ( const __m128i* )&piCoef[n] ) );
+      const __m128i vscale = piQuantCoeff ? _mm_loadu_si128( ( const __m128i* )&piQuantCoeff[n] ) : _mm_set1_epi32( quantScale );
+
+      const __m128d vlev0  = _mm_min_pd( _mm_mul_pd( _mm_cvtepi32_pd( vabs ),                          _mm_cvtepi32_pd( vscale ) ),                            vmaxLevelDbl );
+      const __m128d vlev1  = _mm_min_pd( _mm_mul_pd( _mm_cvtepi32_pd( _mm_unpackhi_epi64( vabs, vabs ) ), _mm_cvtepi32_pd( _mm_unpackhi_epi64( vscale, vscale ) ) ), vmaxLevelDbl );
+      const __m128i vlevel = _mm_unpacklo_epi64( _mm_cvttpd_epi32( vlev0 ), _mm_cvttpd_epi32( vlev1 ) );
+
+      _mm_storeu_si128( ( __m128i* )&piLevelDouble[n], vlevel );
+      _mm_storeu_si128( ( __m128i* )&piMaxAbsLevel[n], _mm_min_epi32( _mm_sra_epi32( _mm_add_epi32( vlevel, vadd ), vqbits ), vmaxLevel ) );
+
+      const __m128d verr0  = pdErrScale ? _mm_mul_pd( _mm_loadu_pd( &pdErrScale[n]     ), verrScale ) : verrScale;
+      const __m128d verr1  = pdErrScale ? _mm_mul_pd( _mm_loadu_pd( &pdErrScale[n + 2] ), verrScale ) : verrScale;
+
+      _mm_storeu_pd( &pdCostCoeff0[n],     _mm_mul_pd( _mm_mul_pd( vlev0, vlev0 ), verr0 ) );
+      _mm_storeu_pd( &pdCostCoeff0[n + 2], _mm_mul_pd( _mm_mul_pd( vlev1, vlev1 ), verr1 ) );
+    }
+  }
+
+  if( n < numCoeff )
+  {
+    xRdoqLevelCore( piCoef + n, piLevelDouble + n, piMaxAbsLevel + n, pdCostCoeff0 + n, numCoeff - n, piQuantCoeff ? piQuantCoeff + n : nullptr, quantScale, pdErrScale ? pdErrScale + n : nullptr, errScale, iQBits, maxLevel );
+  }
+}
+
+template< X86_VEXT vext >
+Void Quant::_initQuantX86()
+{
+  m_quantCore     = xQuantCore_SIMD<vext>;
+  m_dequantCore   = xDeQuantCore_SIMD<vext>;
+  m_rdoqLevelCore = xRdoqLevelCore_SIMD<vext>;
+}
+
+template Void Quant::_initQuantX86<SIMDX86>();
+
+#endif // ENABLE_SIMD_OPT_QUANT
+
+#endif // TARGET_SIMD_X86
+//! \}
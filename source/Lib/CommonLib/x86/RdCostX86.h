@@ -43,86 +43,144 @@
 
 #ifdef TARGET_SIMD_X86
 
-template< typename Torg, typename Tcur, X86_VEXT vext >
-Distortion RdCost::xGetSSE_SIMD( const DistParam &rcDtParam )
+// The scalar SSE shifts every squared difference by the distortion precision adjustment before accumulating it,
+// so the kernels below do the same per lane instead of shifting the final sum. Partial sums are flushed into
+// 64-bit lanes once per row, which keeps the result identical to the scalar accumulation for either Distortion type.
+static inline __m128i xSquaredDiff_SSE( const __m128i& diff, const UInt shift )
 {
-  if( rcDtParam.bitDepth > 10 )
-    return RdCost::xGetSSE( rcDtParam );
+  if( shift == 0 )
+  {
+    return _mm_madd_epi16( diff, diff );
+  }
+  const __m128i vzero = _mm_setzero_si128();
+  const __m128i lo    = _mm_unpacklo_epi16( diff, vzero );
+  const __m128i hi    = _mm_unpackhi_epi16( diff, vzero );
+  return _mm_add_epi32( _mm_srli_epi32( _mm_madd_epi16( lo, lo ), shift ), _mm_srli_epi32( _mm_madd_epi16( hi, hi ), shift ) );
+}
 
-  const Torg* pSrc1     = (const Torg*)rcDtParam.org.buf;
-  const Tcur* pSrc2     = (const Tcur*)rcDtParam.cur.buf;
-  int  iRows            = rcDtParam.org.height;
-  int  iCols            = rcDtParam.org.width;
-  const int iStrideSrc1 = rcDtParam.org.stride;
-  const int iStrideSrc2 = rcDtParam.cur.stride;
+static inline __m128i xAccumulateRow_SSE( const __m128i& sum64, const __m128i& rowSum32 )
+{
+  return _mm_add_epi64( sum64, _mm_add_epi64( _mm_cvtepu32_epi64( rowSum32 ), _mm_cvtepu32_epi64( _mm_srli_si128( rowSum32, 8 ) ) ) );
+}
 
+static inline Distortion xHorizontalSum_SSE( const __m128i& sum64 )
+{
+  const __m128i sum = _mm_add_epi64( sum64, _mm_unpackhi_epi64( sum64, sum64 ) );
+#if defined( _MSC_VER ) && !defined( _WIN64 )
+  return Distortion( UInt64( UInt( _mm_cvtsi128_si32( sum ) ) ) | ( UInt64( UInt( _mm_cvtsi128_si32( _mm_srli_si128( sum, 4 ) ) ) ) << 32 ) );
+#else
+  return Distortion( _mm_cvtsi128_si64( sum ) );
+#endif
+}
 
-  const UInt uiShift = DISTORTION_PRECISION_ADJUSTMENT( ( rcDtParam.bitDepth-8 ) << 1 );
-  unsigned int uiRet = 0;
+#ifdef USE_AVX2
+static inline __m256i xSquaredDiff_AVX2( const __m256i& diff, const UInt shift )
+{
+  if( shift == 0 )
+  {
+    return _mm256_madd_epi16( diff, diff );
+  }
+  const __m256i vzero = _mm256_setzero_si256();
+  const __m256i lo    = _mm256_unpacklo_epi16( diff, vzero );
+  const __m256i hi    = _mm256_unpackhi_epi16( diff, vzero );
+  return _mm256_add_epi32( _mm256_srli_epi32( _mm256_madd_epi16( lo, lo ), shift ), _mm256_srli_epi32( _mm256_madd_epi16( hi, hi ), shift ) );
+}
 
-  if( vext >= AVX2 && ( iCols & 15 ) == 0 )
+static inline __m128i xAccumulateRow_AVX2( const __m128i& sum64, const __m256i& rowSum32 )
+{
+  return xAccumulateRow_SSE( sum64, _mm_add_epi32( _mm256_castsi256_si128( rowSum32 ), _mm256_extracti128_si256( rowSum32, 1 ) ) );
+}
+#endif
+
+template< typename Tsrc >
+static inline __m128i xLoad4_SSE( const Tsrc* pSrc )
+{
+  return ( sizeof( Tsrc ) > 1 ) ? ( _mm_loadl_epi64( ( const __m128i* )pSrc ) ) : ( _mm_unpacklo_epi8( _mm_cvtsi32_si128( *(const int*)pSrc ), _mm_setzero_si128() ) );
+}
+
+template< typename Tsrc >
+static inline __m128i xLoad8_SSE( const Tsrc* pSrc )
+{
+  return ( sizeof( Tsrc ) > 1 ) ? ( _mm_loadu_si128( ( const __m128i* )pSrc ) ) : ( _mm_unpacklo_epi8( _mm_loadl_epi64( ( const __m128i* )pSrc ), _mm_setzero_si128() ) );
+}
+
+#ifdef USE_AVX2
+template< typename Tsrc >
+static inline __m256i xLoad16_AVX2( const Tsrc* pSrc )
+{
+  return ( sizeof( Tsrc ) > 1 ) ? ( _mm256_lddqu_si256( ( const __m256i* )pSrc ) ) : ( _mm256_cvtepu8_epi16( _mm_lddqu_si128( ( const __m128i* )pSrc ) ) );
+}
+#endif
+
+template< typename Torg, typename Tcur, Int iWidth, X86_VEXT vext >
+static inline Distortion xGetSSE_Rows_SIMD( const Torg* pSrc1, const Tcur* pSrc2, const Int iCols, Int iRows, const Int iStrideSrc1, const Int iStrideSrc2, const UInt uiShift )
+{
+  // iWidth > 0 fixes the block width at compile time, iWidth == 0 takes it from iCols
+  const Int iW = iWidth > 0 ? iWidth : iCols;
+  __m128i Sum64 = _mm_setzero_si128();
+
+  if( vext >= AVX2 && ( iW & 15 ) == 0 )
   {
 #ifdef USE_AVX2
-    __m256i Sum = _mm256_setzero_si256();
-    for( int iY = 0; iY < iRows; iY++ )
+    for( ; iRows != 0; iRows-- )
     {
-      for( int iX = 0; iX < iCols; iX+=16 )
+      __m256i Sum = _mm256_setzero_si256();
+      for( Int iX = 0; iX < iW; iX += 16 )
       {
-        __m256i Src1 = ( sizeof( Torg ) > 1 ) ? ( _mm256_lddqu_si256( ( __m256i* )( &pSrc1[iX] ) ) ) : ( _mm256_unpacklo_epi8( _mm256_permute4x64_epi64( _mm256_castsi128_si256( _mm_lddqu_si128( ( __m128i* )( &pSrc1[iX] ) ) ), 0xD8 ), _mm256_setzero_si256() ) );
-        __m256i Src2 = ( sizeof( Tcur ) > 1 ) ? ( _mm256_lddqu_si256( ( __m256i* )( &pSrc2[iX] ) ) ) : ( _mm256_unpacklo_epi8( _mm256_permute4x64_epi64( _mm256_castsi128_si256( _mm_lddqu_si128( ( __m128i* )( &pSrc2[iX] ) ) ), 0xD8 ), _mm256_setzero_si256() ) );
-        __m256i Diff = _mm256_sub_epi16( Src1, Src2 );
-        __m256i Res = _mm256_madd_epi16( Diff, Diff );
-        Sum = _mm256_add_epi32( Sum, Res );
+        __m256i Diff = _mm256_sub_epi16( xLoad16_AVX2( &pSrc1[iX] ), xLoad16_AVX2( &pSrc2[iX] ) );
+        Sum = _mm256_add_epi32( Sum, xSquaredDiff_AVX2( Diff, uiShift ) );
       }
-      pSrc1   += iStrideSrc1;
-      pSrc2   += iStrideSrc2;
+      Sum64 = xAccumulateRow_AVX2( Sum64, Sum );
+      pSrc1 += iStrideSrc1;
+      pSrc2 += iStrideSrc2;
     }
-    Sum = _mm256_hadd_epi32( Sum, Sum );
-    Sum = _mm256_hadd_epi32( Sum, Sum );
-    uiRet = ( _mm_cvtsi128_si32( _mm256_castsi256_si128( Sum ) ) + _mm_cvtsi128_si32( _mm256_castsi256_si128( _mm256_permute2x128_si256( Sum, Sum, 0x11 ) ) ) ) >> uiShift;
 #endif
   }
-  else if( ( iCols & 7 ) == 0 )
+  else if( ( iW & 7 ) == 0 )
   {
-    __m128i Sum = _mm_setzero_si128();
-    for( int iY = 0; iY < iRows; iY++ )
+    for( ; iRows != 0; iRows-- )
     {
-      for( int iX = 0; iX < iCols; iX += 8 )
+      __m128i Sum = _mm_setzero_si128();
+      for( Int iX = 0; iX < iW; iX += 8 )
       {
-        __m128i Src1 = ( sizeof( Torg ) > 1 ) ? ( _mm_loadu_si128 ( ( const __m128i* )( &pSrc1[iX] ) ) ) : ( _mm_unpacklo_epi8( _mm_loadl_epi64( ( const __m128i* )( &pSrc1[iX] ) ), _mm_setzero_si128() ) );
-        __m128i Src2 = ( sizeof( Tcur ) > 1 ) ? ( _mm_lddqu_si128( ( const __m128i* )( &pSrc2[iX] ) ) ) : ( _mm_unpacklo_epi8( _mm_loadl_epi64( ( const __m128i* )( &pSrc2[iX] ) ), _mm_setzero_si128() ) );
-        __m128i Diff = _mm_sub_epi16( Src1, Src2 );
-        __m128i Res = _mm_madd_epi16( Diff, Diff );
-        Sum = _mm_add_epi32( Sum, Res );
+        __m128i Diff = _mm_sub_epi16( xLoad8_SSE( &pSrc1[iX] ), xLoad8_SSE( &pSrc2[iX] ) );
+        Sum = _mm_add_epi32( Sum, xSquaredDiff_SSE( Diff, uiShift ) );
       }
-      pSrc1   += iStrideSrc1;
-      pSrc2   += iStrideSrc2;
+      Sum64 = xAccumulateRow_SSE( Sum64, Sum );
+      pSrc1 += iStrideSrc1;
+      pSrc2 += iStrideSrc2;
     }
-    Sum = _mm_hadd_epi32( Sum, Sum );
-    Sum = _mm_hadd_epi32( Sum, Sum );
-    uiRet = _mm_cvtsi128_si32( Sum )>>uiShift;
   }
   else
   {
-    __m128i Sum = _mm_setzero_si128();
-    for( int iY = 0; iY < iRows; iY++ )
+    for( ; iRows != 0; iRows-- )
     {
-      for( int iX = 0; iX < iCols; iX += 4 )
+      __m128i Sum = _mm_setzero_si128();
+      for( Int iX = 0; iX < iW; iX += 4 )
       {
-        __m128i Src1 = ( sizeof( Torg ) > 1 ) ? ( _mm_loadl_epi64( ( const __m128i* )&pSrc1[iX] ) ) : ( _mm_unpacklo_epi8( _mm_cvtsi32_si128( *(const int*)&pSrc1[iX] ), _mm_setzero_si128() ) );
-        __m128i Src2 = ( sizeof( Tcur ) > 1 ) ? ( _mm_loadl_epi64( ( const __m128i* )&pSrc2[iX] ) ) : ( _mm_unpacklo_epi8( _mm_cvtsi32_si128( *(const int*)&pSrc2[iX] ), _mm_setzero_si128() ) );
-        __m128i Diff = _mm_sub_epi16( Src1, Src2 );
-        __m128i Res = _mm_madd_epi16( Diff, Diff );
-        Sum = _mm_add_epi32( Sum, Res );
+        __m128i Diff = _mm_sub_epi16( xLoad4_SSE( &pSrc1[iX] ), xLoad4_SSE( &pSrc2[iX] ) );
+        Sum = _mm_add_epi32( Sum, xSquaredDiff_SSE( Diff, uiShift ) );
       }
-      pSrc1   += iStrideSrc1;
-      pSrc2   += iStrideSrc2;
+      Sum64 = xAccumulateRow_SSE( Sum64, Sum );
+      pSrc1 += iStrideSrc1;
+      pSrc2 += iStrideSrc2;
     }
-    Sum = _mm_hadd_epi32( Sum, Sum );
-    uiRet = _mm_cvtsi128_si32( Sum )>>uiShift;
   }
 
-  return uiRet;
+  return xHorizontalSum_SSE( Sum64 );
+}
+
+template< typename Torg, typename Tcur, X86_VEXT vext >
+Distortion RdCost::xGetSSE_SIMD( const DistParam &rcDtParam )
+{
+  // differences of samples up to 10 bits fit into 16-bit lanes
+  if( rcDtParam.bitDepth > 10 || rcDtParam.applyWeight || ( rcDtParam.org.width & 3 ) != 0 )
+    return RdCost::xGetSSE( rcDtParam );
+
+  const UInt uiShift = DISTORTION_PRECISION_ADJUSTMENT( ( rcDtParam.bitDepth-8 ) << 1 );
+
+  return xGetSSE_Rows_SIMD<Torg, Tcur, 0, vext>( (const Torg*)rcDtParam.org.buf, (const Tcur*)rcDtParam.cur.buf, rcDtParam.org.width, rcDtParam.org.height,
+                                                 rcDtParam.org.stride, rcDtParam.cur.stride, uiShift );
 }
 
 
@@ -132,78 +190,11 @@ Distortion RdCost::xGetSSE_NxN_SIMD( const DistParam &rcDtParam )
   if( rcDtParam.bitDepth > 10 || rcDtParam.applyWeight )
     return RdCost::xGetSSE( rcDtParam );
 
-  const Torg* pSrc1     = (const Torg*)rcDtParam.org.buf;
-  const Tcur* pSrc2     = (const Tcur*)rcDtParam.cur.buf;
-  int  iRows            = rcDtParam.org.height;
-  const int iStrideSrc1 = rcDtParam.org.stride;
-  const int iStrideSrc2 = rcDtParam.cur.stride;
-
-
+  CHECK( rcDtParam.org.width != iWidth, "Invalid size" );
   const UInt uiShift = DISTORTION_PRECISION_ADJUSTMENT( ( rcDtParam.bitDepth-8 ) << 1 );
-  unsigned int uiRet = 0;
 
-  if( 4 == iWidth )
-  {
-    __m128i Sum = _mm_setzero_si128();
-    for( int iY = 0; iY < iRows; iY++ )
-    {
-      __m128i Src1 = ( sizeof( Torg ) > 1 ) ? ( _mm_loadl_epi64( ( const __m128i* )pSrc1 ) ) : ( _mm_unpacklo_epi8( _mm_cvtsi32_si128( *(const int*)pSrc1 ), _mm_setzero_si128() ) );
-      __m128i Src2 = ( sizeof( Tcur ) > 1 ) ? ( _mm_loadl_epi64( ( const __m128i* )pSrc2 ) ) : ( _mm_unpacklo_epi8( _mm_cvtsi32_si128( *(const int*)pSrc2 ), _mm_setzero_si128() ) );
-      pSrc1 += iStrideSrc1;
-      pSrc2 += iStrideSrc2;
-      __m128i Diff = _mm_sub_epi16( Src1, Src2 );
-      __m128i Res  = _mm_madd_epi16( Diff, Diff );
-      Sum = _mm_add_epi32( Sum, Res );
-    }
-    Sum = _mm_hadd_epi32( Sum, Sum );
-    uiRet = _mm_cvtsi128_si32( Sum )>>uiShift;
-  }
-  else
-  {
-    if( vext >= AVX2 && iWidth >= 16 )
-    {
-#ifdef USE_AVX2
-      __m256i Sum = _mm256_setzero_si256();
-      for( int iY = 0; iY < iRows; iY++ )
-      {
-        for( int iX = 0; iX < iWidth; iX+=16 )
-        {
-          __m256i Src1 = ( sizeof( Torg ) > 1 ) ? ( _mm256_lddqu_si256( ( __m256i* )( &pSrc1[iX] ) ) ) : ( _mm256_unpacklo_epi8( _mm256_permute4x64_epi64( _mm256_castsi128_si256( _mm_lddqu_si128( ( __m128i* )( &pSrc1[iX] ) ) ), 0xD8 ), _mm256_setzero_si256() ) );
-          __m256i Src2 = ( sizeof( Tcur ) > 1 ) ? ( _mm256_lddqu_si256( ( __m256i* )( &pSrc2[iX] ) ) ) : ( _mm256_unpacklo_epi8( _mm256_permute4x64_epi64( _mm256_castsi128_si256( _mm_lddqu_si128( ( __m128i* )( &pSrc2[iX] ) ) ), 0xD8 ), _mm256_setzero_si256() ) );
-          __m256i Diff = _mm256_sub_epi16( Src1, Src2 );
-          __m256i Res = _mm256_madd_epi16( Diff, Diff );
-          Sum = _mm256_add_epi32( Sum, Res );
-        }
-        pSrc1   += iStrideSrc1;
-        pSrc2   += iStrideSrc2;
-      }
-      Sum = _mm256_hadd_epi32( Sum, Sum );
-      Sum = _mm256_hadd_epi32( Sum, Sum );
-      uiRet = ( _mm_cvtsi128_si32( _mm256_castsi256_si128( Sum ) ) + _mm_cvtsi128_si32( _mm256_castsi256_si128( _mm256_permute2x128_si256( Sum, Sum, 0x11 ) ) ) ) >> uiShift;
-#endif
-    }
-    else
-    {
-      __m128i Sum = _mm_setzero_si128();
-      for( int iY = 0; iY < iRows; iY++ )
-      {
-        for( int iX = 0; iX < iWidth; iX+=8 )
-        {
-          __m128i Src1 = ( sizeof( Torg ) > 1 ) ? ( _mm_loadu_si128( ( const __m128i* )( &pSrc1[iX] ) ) ) : ( _mm_unpacklo_epi8( _mm_loadl_epi64( ( const __m128i* )( &pSrc1[iX] ) ), _mm_setzero_si128() ) );
-          __m128i Src2 = ( sizeof( Tcur ) > 1 ) ? ( _mm_lddqu_si128( ( const __m128i* )( &pSrc2[iX] ) ) ) : ( _mm_unpacklo_epi8( _mm_loadl_epi64( ( const __m128i* )( &pSrc2[iX] ) ), _mm_setzero_si128() ) );
-          __m128i Diff = _mm_sub_epi16( Src1, Src2 );
-          __m128i Res = _mm_madd_epi16( Diff, Diff );
-          Sum = _mm_add_epi32( Sum, Res );
-        }
-        pSrc1 += iStrideSrc1;
-        pSrc2 += iStrideSrc2;
-      }
-      Sum = _mm_hadd_epi32( Sum, Sum );
-      Sum = _mm_hadd_epi32( Sum, Sum );
-      uiRet = _mm_cvtsi128_si32( Sum )>>uiShift;
-    }
-  }
-  return uiRet;
+  return xGetSSE_Rows_SIMD<Torg, Tcur, iWidth, vext>( (const Torg*)rcDtParam.org.buf, (const Tcur*)rcDtParam.cur.buf, iWidth, rcDtParam.org.height,
+                                                      rcDtParam.org.stride, rcDtParam.cur.stride, uiShift );
 }
 
 template< X86_VEXT vext >
@@ -418,6 +409,286 @@ Distortion RdCost::xGetSAD_NxN_SIMD( const DistParam &rcDtParam )
 }
 
 
+// SAD of one original block against four candidate positions. Every original row is loaded once and compared
+// against all candidates while it is held in registers. Row sums stay within 16 bits for up to 10-bit input.
+template< X86_VEXT vext >
+static inline Void xGetSADx4_SIMD( const Pel* piOrg, const Pel* const* ppCur, const Int iCols, Int iRows, const Int iStrideOrg, const Int iStrideCur, UInt* puiSum )
+{
+  const Pel* piCur0 = ppCur[0];
+  const Pel* piCur1 = ppCur[1];
+  const Pel* piCur2 = ppCur[2];
+  const Pel* piCur3 = ppCur[3];
+  __m128i vsum;
+
+  if( vext >= AVX2 && ( iCols & 15 ) == 0 )
+  {
+#ifdef USE_AVX2
+    const __m256i vone = _mm256_set1_epi16( 1 );
+    __m256i vsum0 = _mm256_setzero_si256(), vsum1 = vsum0, vsum2 = vsum0, vsum3 = vsum0;
+    for( ; iRows > 0; iRows--, piOrg += iStrideOrg, piCur0 += iStrideCur, piCur1 += iStrideCur, piCur2 += iStrideCur, piCur3 += iStrideCur )
+    {
+      __m256i vrow0 = _mm256_setzero_si256(), vrow1 = vrow0, vrow2 = vrow0, vrow3 = vrow0;
+      for( Int iX = 0; iX < iCols; iX += 16 )
+      {
+        const __m256i vorg = _mm256_lddqu_si256( ( const __m256i* )&piOrg[iX] );
+        vrow0 = _mm256_add_epi16( vrow0, _mm256_abs_epi16( _mm256_sub_epi16( vorg, _mm256_lddqu_si256( ( const __m256i* )&piCur0[iX] ) ) ) );
+        vrow1 = _mm256_add_epi16( vrow1, _mm256_abs_epi16( _mm256_sub_epi16( vorg, _mm256_lddqu_si256( ( const __m256i* )&piCur1[iX] ) ) ) );
+        vrow2 = _mm256_add_epi16( vrow2, _mm256_abs_epi16( _mm256_sub_epi16( vorg, _mm256_lddqu_si256( ( const __m256i* )&piCur2[iX] ) ) ) );
+        vrow3 = _mm256_add_epi16( vrow3, _mm256_abs_epi16( _mm256_sub_epi16( vorg, _mm256_lddqu_si256( ( const __m256i* )&piCur3[iX] ) ) ) );
+      }
+      vsum0 = _mm256_add_epi32( vsum0, _mm256_madd_epi16( vrow0, vone ) );
+      vsum1 = _mm256_add_epi32( vsum1, _mm256_madd_epi16( vrow1, vone ) );
+      vsum2 = _mm256_add_epi32( vsum2, _mm256_madd_epi16( vrow2, vone ) );
+      vsum3 = _mm256_add_epi32( vsum3, _mm256_madd_epi16( vrow3, vone ) );
+    }
+    __m256i vsum256 = _mm256_hadd_epi32( _mm256_hadd_epi32( vsum0, vsum1 ), _mm256_hadd_epi32( vsum2, vsum3 ) );
+    vsum = _mm_add_epi32( _mm256_castsi256_si128( vsum256 ), _mm256_extracti128_si256( vsum256, 1 ) );
+#endif
+  }
+  else
+  {
+    const __m128i vone = _mm_set1_epi16( 1 );
+    __m128i vsum0 = _mm_setzero_si128(), vsum1 = vsum0, vsum2 = vsum0, vsum3 = vsum0;
+    for( ; iRows > 0; iRows--, piOrg += iStrideOrg, piCur0 += iStrideCur, piCur1 += iStrideCur, piCur2 += iStrideCur, piCur3 += iStrideCur )
+    {
+      __m128i vrow0 = _mm_setzero_si128(), vrow1 = vrow0, vrow2 = vrow0, vrow3 = vrow0;
+      Int iX = 0;
+      for( ; iX + 8 <= iCols; iX += 8 )
+      {
+        const __m128i vorg = _mm_loadu_si128( ( const __m128i* )&piOrg[iX] );
+        vrow0 = _mm_add_epi16( vrow0, _mm_abs_epi16( _mm_sub_epi16( vorg, _mm_loadu_si128( ( const __m128i* )&piCur0[iX] ) ) ) );
+        vrow1 = _mm_add_epi16( vrow1, _mm_abs_epi16( _mm_sub_epi16( vorg, _mm_loadu_si128( ( const __m128i* )&piCur1[iX] ) ) ) );
+        vrow2 = _mm_add_epi16( vrow2, _mm_abs_epi16( _mm_sub_epi16( vorg, _mm_loadu_si128( ( const __m128i* )&piCur2[iX] ) ) ) );
+        vrow3 = _mm_add_epi16( vrow3, _mm_abs_epi16( _mm_sub_epi16( vorg, _mm_loadu_si128( ( const __m128i* )&piCur3[iX] ) ) ) );
+      }
+      if( iX < iCols )
+      {
+        const __m128i vorg = _mm_loadl_epi64( ( const __m128i* )&piOrg[iX] );
+        vrow0 = _mm_add_epi16( vrow0, _mm_abs_epi16( _mm_sub_epi16( vorg, _mm_loadl_epi64( ( const __m128i* )&piCur0[iX] ) ) ) );
+        vrow1 = _mm_add_epi16( vrow1, _mm_abs_epi16( _mm_sub_epi16( vorg, _mm_loadl_epi64( ( const __m128i* )&piCur1[iX] ) ) ) );
+        vrow2 = _mm_add_epi16( vrow2, _mm_abs_epi16( _mm_sub_epi16( vorg, _mm_loadl_epi64( ( const __m128i* )&piCur2[iX] ) ) ) );
+        vrow3 = _mm_add_epi16( vrow3, _mm_abs_epi16( _mm_sub_epi16( vorg, _mm_loadl_epi64( ( const __m128i* )&piCur3[iX] ) ) ) );
+      }
+      vsum0 = _mm_add_epi32( vsum0, _mm_madd_epi16( vrow0, vone ) );
+      vsum1 = _mm_add_epi32( vsum1, _mm_madd_epi16( vrow1, vone ) );
+      vsum2 = _mm_add_epi32( vsum2, _mm_madd_epi16( vrow2, vone ) );
+      vsum3 = _mm_add_epi32( vsum3, _mm_madd_epi16( vrow3, vone ) );
+    }
+    vsum = _mm_hadd_epi32( _mm_hadd_epi32( vsum0, vsum1 ), _mm_hadd_epi32( vsum2, vsum3 ) );
+  }
+
+  _mm_storeu_si128( ( __m128i* )puiSum, vsum );
+}
+
+template< X86_VEXT vext >
+Void RdCost::xGetSADBatch_SIMD( const DistParam &rcDtParam, const Pel* const* ppCur, const Int iNum, Distortion* puiDist )
+{
+  if( rcDtParam.org.width < 4 || ( rcDtParam.org.width & 3 ) != 0 || rcDtParam.org.width > MAX_CU_SIZE || rcDtParam.bitDepth > 10 || rcDtParam.applyWeight )
+  {
+    RdCost::xGetSADBatch( rcDtParam, ppCur, iNum, puiDist );
+    return;
+  }
+
+  const Int  iSubShift   = rcDtParam.subShift;
+  const Int  iSubStep    = ( 1 << iSubShift );
+  const Int  iRows       = ( rcDtParam.org.height + iSubStep - 1 ) >> iSubShift;
+  const Int  iStrideOrg  = rcDtParam.org.stride * iSubStep;
+  const Int  iStrideCur  = rcDtParam.cur.stride * iSubStep;
+  const UInt uiShift     = DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth - 8 );
+
+  for( Int i = 0; i < iNum; i += 4 )
+  {
+    // a partial group repeats its last candidate
+    const Pel* apCur[4];
+    for( Int k = 0; k < 4; k++ )
+    {
+      apCur[k] = ppCur[std::min( i + k, iNum - 1 )];
+    }
+
+    UInt auiSum[4];
+    xGetSADx4_SIMD<vext>( rcDtParam.org.buf, apCur, rcDtParam.org.width, iRows, iStrideOrg, iStrideCur, auiSum );
+
+    for( Int k = 0; k < 4 && i + k < iNum; k++ )
+    {
+      puiDist[i + k] = Distortion( auiSum[k] << iSubShift ) >> uiShift;
+    }
+  }
+}
+
+// Mean-removed SAD: the first pass reads both sources once, stores the differences contiguously and sums them
+// for the DC offset, the second pass only has to run over the stored differences.
+template< X86_VEXT vext >
+static inline Int xMRSADDiff_SIMD( const Pel* piOrg, const Pel* piCur, const Int iCols, Int iRows, const Int iStrideOrg, const Int iStrideCur, Pel* piDiff )
+{
+  Int iDeltaSum = 0;
+
+  if( vext >= AVX2 && ( iCols & 15 ) == 0 )
+  {
+#ifdef USE_AVX2
+    const __m256i vone = _mm256_set1_epi16( 1 );
+    __m256i vsum32 = _mm256_setzero_si256();
+    for( ; iRows != 0; iRows--, piOrg += iStrideOrg, piCur += iStrideCur, piDiff += iCols )
+    {
+      for( Int iX = 0; iX < iCols; iX += 16 )
+      {
+        __m256i vdiff = _mm256_sub_epi16( _mm256_lddqu_si256( ( const __m256i* )&piOrg[iX] ), _mm256_lddqu_si256( ( const __m256i* )&piCur[iX] ) );
+        _mm256_storeu_si256( ( __m256i* )&piDiff[iX], vdiff );
+        vsum32 = _mm256_add_epi32( vsum32, _mm256_madd_epi16( vdiff, vone ) );
+      }
+    }
+    __m128i vsum = _mm_add_epi32( _mm256_castsi256_si128( vsum32 ), _mm256_extracti128_si256( vsum32, 1 ) );
+    vsum = _mm_hadd_epi32( vsum, vsum );
+    vsum = _mm_hadd_epi32( vsum, vsum );
+    iDeltaSum = _mm_cvtsi128_si32( vsum );
+#endif
+  }
+  else
+  {
+    const __m128i vone = _mm_set1_epi16( 1 );
+    __m128i vsum32 = _mm_setzero_si128();
+    for( ; iRows != 0; iRows--, piOrg += iStrideOrg, piCur += iStrideCur, piDiff += iCols )
+    {
+      Int iX = 0;
+      for( ; iX + 8 <= iCols; iX += 8 )
+      {
+        __m128i vdiff = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )&piOrg[iX] ), _mm_loadu_si128( ( const __m128i* )&piCur[iX] ) );
+        _mm_storeu_si128( ( __m128i* )&piDiff[iX], vdiff );
+        vsum32 = _mm_add_epi32( vsum32, _mm_madd_epi16( vdiff, vone ) );
+      }
+      if( iX < iCols )
+      {
+        __m128i vdiff = _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* )&piOrg[iX] ), _mm_loadl_epi64( ( const __m128i* )&piCur[iX] ) );
+        _mm_storel_epi64( ( __m128i* )&piDiff[iX], vdiff );
+        vsum32 = _mm_add_epi32( vsum32, _mm_madd_epi16( vdiff, vone ) );
+      }
+    }
+    vsum32 = _mm_hadd_epi32( vsum32, vsum32 );
+    vsum32 = _mm_hadd_epi32( vsum32, vsum32 );
+    iDeltaSum = _mm_cvtsi128_si32( vsum32 );
+  }
+
+  return iDeltaSum;
+}
+
+template< X86_VEXT vext >
+static inline UInt xMRSADAbsSum_SIMD( const Pel* piDiff, const Int iNum, const Pel offset )
+{
+  UInt uiSum = 0;
+  Int  i     = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && iNum >= 16 )
+  {
+    const __m256i vone    = _mm256_set1_epi16( 1 );
+    const __m256i voffset = _mm256_set1_epi16( offset );
+    __m256i vsum32 = _mm256_setzero_si256();
+    for( ; i + 16 <= iNum; i += 16 )
+    {
+      __m256i vabs = _mm256_abs_epi16( _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* )&piDiff[i] ), voffset ) );
+      vsum32 = _mm256_add_epi32( vsum32, _mm256_madd_epi16( vabs, vone ) );
+    }
+    __m128i vsum = _mm_add_epi32( _mm256_castsi256_si128( vsum32 ), _mm256_extracti128_si256( vsum32, 1 ) );
+    vsum = _mm_hadd_epi32( vsum, vsum );
+    vsum = _mm_hadd_epi32( vsum, vsum );
+    uiSum = _mm_cvtsi128_si32( vsum );
+  }
+#endif
+  if( i < iNum )
+  {
+    const __m128i vone    = _mm_set1_epi16( 1 );
+    const __m128i voffset = _mm_set1_epi16( offset );
+    __m128i vsum32 = _mm_setzero_si128();
+    for( ; i + 8 <= iNum; i += 8 )
+    {
+      __m128i vabs = _mm_abs_epi16( _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )&piDiff[i] ), voffset ) );
+      vsum32 = _mm_add_epi32( vsum32, _mm_madd_epi16( vabs, vone ) );
+    }
+    if( i < iNum )
+    {
+      __m128i vabs = _mm_abs_epi16( _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* )&piDiff[i] ), voffset ) );
+      vsum32 = _mm_add_epi32( vsum32, _mm_madd_epi16( _mm_unpacklo_epi64( vabs, _mm_setzero_si128() ), vone ) );
+    }
+    vsum32 = _mm_hadd_epi32( vsum32, vsum32 );
+    vsum32 = _mm_hadd_epi32( vsum32, vsum32 );
+    uiSum += _mm_cvtsi128_si32( vsum32 );
+  }
+
+  return uiSum;
+}
+
+template< X86_VEXT vext >
+Distortion RdCost::xGetMRSAD_SIMD( const DistParam &rcDtParam )
+{
+  if( rcDtParam.org.width < 4 || ( rcDtParam.org.width & 3 ) != 0 || rcDtParam.bitDepth > 10 )
+    return RdCost::xGetMRSAD( rcDtParam );
+
+  const Int  iCols           = rcDtParam.org.width;
+  const Int  iSubShift       = rcDtParam.subShift;
+  const Int  iSubStep        = ( 1 << iSubShift );
+  const Int  iRows           = rcDtParam.org.height >> iSubShift;
+  const UInt distortionShift = DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth - 8 );
+
+  Pel piDiff[MAX_CU_SIZE * MAX_CU_SIZE];
+  const Int  iDeltaSum = xMRSADDiff_SIMD<vext>( rcDtParam.org.buf, rcDtParam.cur.buf, iCols, iRows, rcDtParam.org.stride * iSubStep, rcDtParam.cur.stride * iSubStep, piDiff );
+  const Pel  offset    = Pel( iDeltaSum / ( iCols * iRows ) );
+
+  Distortion uiSum = 0;
+  if( rcDtParam.maximumDistortionForEarlyExit < std::numeric_limits<Distortion>::max() )
+  {
+    // same row-wise early termination as the scalar version
+    for( Int iY = 0; iY < iRows; iY++ )
+    {
+      uiSum += xMRSADAbsSum_SIMD<vext>( &piDiff[iY * iCols], iCols, offset );
+      if( rcDtParam.maximumDistortionForEarlyExit < ( uiSum >> distortionShift ) )
+      {
+        return ( uiSum >> distortionShift );
+      }
+    }
+  }
+  else
+  {
+    uiSum = xMRSADAbsSum_SIMD<vext>( piDiff, iCols * iRows, offset );
+  }
+
+  uiSum <<= iSubShift;
+  return ( uiSum >> distortionShift );
+}
+
+template< Int iWidth, X86_VEXT vext >
+Distortion RdCost::xGetMRSAD_NxN_SIMD( const DistParam &rcDtParam )
+{
+  // iWidth == 0 serves the 16NxM case with the width taken from the block
+  if( rcDtParam.bitDepth > 10 )
+  {
+    switch( iWidth )
+    {
+    case  4: return RdCost::xGetMRSAD4 ( rcDtParam );
+    case  8: return RdCost::xGetMRSAD8 ( rcDtParam );
+    case 12: return RdCost::xGetMRSAD12( rcDtParam );
+    case 16: return RdCost::xGetMRSAD16( rcDtParam );
+    case 24: return RdCost::xGetMRSAD24( rcDtParam );
+    case 32: return RdCost::xGetMRSAD32( rcDtParam );
+    case 48: return RdCost::xGetMRSAD48( rcDtParam );
+    case 64: return RdCost::xGetMRSAD64( rcDtParam );
+    default: return RdCost::xGetMRSAD16N( rcDtParam );
+    }
+  }
+
+  const Int iCols     = iWidth > 0 ? iWidth : rcDtParam.org.width;
+  const Int iSubShift = rcDtParam.subShift;
+  const Int iSubStep  = ( 1 << iSubShift );
+  const Int iRows     = rcDtParam.org.height >> iSubShift;
+
+  Pel piDiff[MAX_CU_SIZE * MAX_CU_SIZE];
+  const Int  iDeltaSum = xMRSADDiff_SIMD<vext>( rcDtParam.org.buf, rcDtParam.cur.buf, iCols, iRows, rcDtParam.org.stride * iSubStep, rcDtParam.cur.stride * iSubStep, piDiff );
+  const Pel  offset    = Pel( iDeltaSum / ( iCols * iRows ) );
+
+  Distortion uiSum = xMRSADAbsSum_SIMD<vext>( piDiff, iCols * iRows, offset );
+
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth - 8 ) );
+}
+
 template< typename Torg, typename Tcur >
 static UInt xCalcHAD4x4_SSE( const Torg *piOrg, const Tcur *piCur, const Int iStrideOrg, const Int iStrideCur )
 {
@@ -2252,6 +2523,289 @@ static UInt xCalcHAD8x16_AVX2( const Torg *piOrg, const Tcur *piCur, const Int i
 }
 
 
+// two horizontally adjacent 8x4 blocks, one per 128-bit lane, sharing a single transpose
+template< typename Torg, typename Tcur >
+static UInt xCalcHAD8x4x2_AVX2( const Torg *piOrg, const Tcur *piCur, const Int iStrideOrg, const Int iStrideCur, const Int iBitDepth )
+{
+  UInt sad = 0;
+
+#ifdef USE_AVX2
+  __m256i m1[8], m2[8];
+  __m256i vzero = _mm256_setzero_si256();
+
+  for( int k = 0; k < 4; k++ )
+  {
+    __m256i r0 = ( sizeof( Torg ) > 1 ) ? ( _mm256_lddqu_si256( ( __m256i* )piOrg ) ) : ( _mm256_unpacklo_epi8( _mm256_permute4x64_epi64( _mm256_castsi128_si256( _mm_lddqu_si128( ( __m128i* )piOrg ) ), 0xD8 ), _mm256_setzero_si256() ) );
+    __m256i r1 = ( sizeof( Tcur ) > 1 ) ? ( _mm256_lddqu_si256( ( __m256i* )piCur ) ) : ( _mm256_unpacklo_epi8( _mm256_permute4x64_epi64( _mm256_castsi128_si256( _mm_lddqu_si128( ( __m128i* )piCur ) ), 0xD8 ), _mm256_setzero_si256() ) );
+    m1[k] = _mm256_sub_epi16( r0, r1 );
+    piCur += iStrideCur;
+    piOrg += iStrideOrg;
+  }
+
+  //vertical
+  m2[0] = _mm256_add_epi16( m1[0], m1[2] );
+  m2[1] = _mm256_add_epi16( m1[1], m1[3] );
+  m2[2] = _mm256_sub_epi16( m1[0], m1[2] );
+  m2[3] = _mm256_sub_epi16( m1[1], m1[3] );
+
+  m1[0] = _mm256_add_epi16( m2[0], m2[1] );
+  m1[1] = _mm256_sub_epi16( m2[0], m2[1] );
+  m1[2] = _mm256_add_epi16( m2[2], m2[3] );
+  m1[3] = _mm256_sub_epi16( m2[2], m2[3] );
+
+  // transpose 2 8x4 blocks in parallel, partially
+  {
+    m2[0] = _mm256_unpacklo_epi16( m1[0], m1[1] );
+    m2[1] = _mm256_unpacklo_epi16( m1[2], m1[3] );
+    m2[2] = _mm256_unpackhi_epi16( m1[0], m1[1] );
+    m2[3] = _mm256_unpackhi_epi16( m1[2], m1[3] );
+
+    m1[0] = _mm256_unpacklo_epi32( m2[0], m2[1] );
+    m1[1] = _mm256_unpackhi_epi32( m2[0], m2[1] );
+    m1[2] = _mm256_unpacklo_epi32( m2[2], m2[3] );
+    m1[3] = _mm256_unpackhi_epi32( m2[2], m2[3] );
+  }
+
+  // horizontal
+  if( iBitDepth >= 10 )
+  {
+    // finish transpose, widening the low four samples of each lane
+    for( int i = 0; i < 4; i++ )
+    {
+      m2[2 * i    ] = _mm256_srai_epi32( _mm256_unpacklo_epi16( m1[i], m1[i] ), 16 );
+      m2[2 * i + 1] = _mm256_srai_epi32( _mm256_unpackhi_epi16( m1[i], m1[i] ), 16 );
+    }
+
+    m1[0] = _mm256_add_epi32( m2[0], m2[4] );
+    m1[1] = _mm256_add_epi32( m2[1], m2[5] );
+    m1[2] = _mm256_add_epi32( m2[2], m2[6] );
+    m1[3] = _mm256_add_epi32( m2[3], m2[7] );
+    m1[4] = _mm256_sub_epi32( m2[0], m2[4] );
+    m1[5] = _mm256_sub_epi32( m2[1], m2[5] );
+    m1[6] = _mm256_sub_epi32( m2[2], m2[6] );
+    m1[7] = _mm256_sub_epi32( m2[3], m2[7] );
+
+    m2[0] = _mm256_add_epi32( m1[0], m1[2] );
+    m2[1] = _mm256_add_epi32( m1[1], m1[3] );
+    m2[2] = _mm256_sub_epi32( m1[0], m1[2] );
+    m2[3] = _mm256_sub_epi32( m1[1], m1[3] );
+    m2[4] = _mm256_add_epi32( m1[4], m1[6] );
+    m2[5] = _mm256_add_epi32( m1[5], m1[7] );
+    m2[6] = _mm256_sub_epi32( m1[4], m1[6] );
+    m2[7] = _mm256_sub_epi32( m1[5], m1[7] );
+
+    m1[0] = _mm256_abs_epi32( _mm256_add_epi32( m2[0], m2[1] ) );
+    m1[1] = _mm256_abs_epi32( _mm256_sub_epi32( m2[0], m2[1] ) );
+    m1[2] = _mm256_abs_epi32( _mm256_add_epi32( m2[2], m2[3] ) );
+    m1[3] = _mm256_abs_epi32( _mm256_sub_epi32( m2[2], m2[3] ) );
+    m1[4] = _mm256_abs_epi32( _mm256_add_epi32( m2[4], m2[5] ) );
+    m1[5] = _mm256_abs_epi32( _mm256_sub_epi32( m2[4], m2[5] ) );
+    m1[6] = _mm256_abs_epi32( _mm256_add_epi32( m2[6], m2[7] ) );
+    m1[7] = _mm256_abs_epi32( _mm256_sub_epi32( m2[6], m2[7] ) );
+  }
+  else
+  {
+    m2[0] = _mm256_add_epi16( m1[0], m1[2] );
+    m2[1] = _mm256_add_epi16( m1[1], m1[3] );
+    m2[2] = _mm256_sub_epi16( m1[0], m1[2] );
+    m2[3] = _mm256_sub_epi16( m1[1], m1[3] );
+
+    m1[0] = _mm256_add_epi16( m2[0], m2[1] );
+    m1[1] = _mm256_sub_epi16( m2[0], m2[1] );
+    m1[2] = _mm256_add_epi16( m2[2], m2[3] );
+    m1[3] = _mm256_sub_epi16( m2[2], m2[3] );
+
+    // finish transpose
+    m2[0] = _mm256_unpacklo_epi64( m1[0], vzero );
+    m2[1] = _mm256_unpackhi_epi64( m1[0], vzero );
+    m2[2] = _mm256_unpacklo_epi64( m1[1], vzero );
+    m2[3] = _mm256_unpackhi_epi64( m1[1], vzero );
+    m2[4] = _mm256_unpacklo_epi64( m1[2], vzero );
+    m2[5] = _mm256_unpackhi_epi64( m1[2], vzero );
+    m2[6] = _mm256_unpacklo_epi64( m1[3], vzero );
+    m2[7] = _mm256_unpackhi_epi64( m1[3], vzero );
+
+    m1[0] = _mm256_abs_epi16( _mm256_add_epi16( m2[0], m2[1] ) );
+    m1[1] = _mm256_abs_epi16( _mm256_sub_epi16( m2[0], m2[1] ) );
+    m1[2] = _mm256_abs_epi16( _mm256_add_epi16( m2[2], m2[3] ) );
+    m1[3] = _mm256_abs_epi16( _mm256_sub_epi16( m2[2], m2[3] ) );
+    m1[4] = _mm256_abs_epi16( _mm256_add_epi16( m2[4], m2[5] ) );
+    m1[5] = _mm256_abs_epi16( _mm256_sub_epi16( m2[4], m2[5] ) );
+    m1[6] = _mm256_abs_epi16( _mm256_add_epi16( m2[6], m2[7] ) );
+    m1[7] = _mm256_abs_epi16( _mm256_sub_epi16( m2[6], m2[7] ) );
+
+    for( Int i = 0; i < 8; i++ )
+    {
+      m1[i] = _mm256_unpacklo_epi16( m1[i], vzero );
+    }
+  }
+
+  m1[0] = _mm256_add_epi32( m1[0], m1[1] );
+  m1[1] = _mm256_add_epi32( m1[2], m1[3] );
+  m1[2] = _mm256_add_epi32( m1[4], m1[5] );
+  m1[3] = _mm256_add_epi32( m1[6], m1[7] );
+
+  m1[0] = _mm256_add_epi32( m1[0], m1[1] );
+  m1[1] = _mm256_add_epi32( m1[2], m1[3] );
+
+  __m256i iSum = _mm256_add_epi32( m1[0], m1[1] );
+
+  iSum = _mm256_hadd_epi32( iSum, iSum );
+  iSum = _mm256_hadd_epi32( iSum, iSum );
+
+  // each block is normalised on its own, as in xCalcHAD8x4_SSE
+  UInt tmp;
+  tmp = _mm_cvtsi128_si32( _mm256_castsi256_si128( iSum ) );
+  sad += (Int)(tmp / sqrt( 4.0 * 8 ) * 2);
+
+  tmp = _mm_cvtsi128_si32( _mm256_castsi256_si128( _mm256_permute2x128_si256( iSum, iSum, 0x11 ) ) );
+  sad += (Int)(tmp / sqrt( 4.0 * 8 ) * 2);
+#endif //USE_AVX2
+
+  return (sad);
+}
+
+// two vertically adjacent 4x8 blocks, one per 128-bit lane, sharing a single transpose
+template< typename Torg, typename Tcur >
+static UInt xCalcHAD4x8x2_AVX2( const Torg *piOrg, const Tcur *piCur, const Int iStrideOrg, const Int iStrideCur, const Int iBitDepth )
+{
+  UInt sad = 0;
+
+#ifdef USE_AVX2
+  __m256i m1[8], m2[8];
+
+  for( int k = 0; k < 8; k++ )
+  {
+    const Torg *piOrg1 = piOrg + 8 * iStrideOrg;
+    const Tcur *piCur1 = piCur + 8 * iStrideCur;
+    __m128i r0 = ( sizeof( Torg ) > 1 ) ? ( _mm_loadl_epi64( ( __m128i* )piOrg  ) ) : ( _mm_unpacklo_epi8( _mm_cvtsi32_si128( *(const int*)piOrg  ), _mm_setzero_si128() ) );
+    __m128i r1 = ( sizeof( Torg ) > 1 ) ? ( _mm_loadl_epi64( ( __m128i* )piOrg1 ) ) : ( _mm_unpacklo_epi8( _mm_cvtsi32_si128( *(const int*)piOrg1 ), _mm_setzero_si128() ) );
+    __m128i r2 = ( sizeof( Tcur ) > 1 ) ? ( _mm_loadl_epi64( ( __m128i* )piCur  ) ) : ( _mm_unpacklo_epi8( _mm_cvtsi32_si128( *(const int*)piCur  ), _mm_setzero_si128() ) );
+    __m128i r3 = ( sizeof( Tcur ) > 1 ) ? ( _mm_loadl_epi64( ( __m128i* )piCur1 ) ) : ( _mm_unpacklo_epi8( _mm_cvtsi32_si128( *(const int*)piCur1 ), _mm_setzero_si128() ) );
+    m2[k] = _mm256_sub_epi16( _mm256_inserti128_si256( _mm256_castsi128_si256( r0 ), r1, 1 ), _mm256_inserti128_si256( _mm256_castsi128_si256( r2 ), r3, 1 ) );
+    piCur += iStrideCur;
+    piOrg += iStrideOrg;
+  }
+
+  // vertical
+
+  m1[0] = _mm256_add_epi16( m2[0], m2[4] );
+  m1[1] = _mm256_add_epi16( m2[1], m2[5] );
+  m1[2] = _mm256_add_epi16( m2[2], m2[6] );
+  m1[3] = _mm256_add_epi16( m2[3], m2[7] );
+  m1[4] = _mm256_sub_epi16( m2[0], m2[4] );
+  m1[5] = _mm256_sub_epi16( m2[1], m2[5] );
+  m1[6] = _mm256_sub_epi16( m2[2], m2[6] );
+  m1[7] = _mm256_sub_epi16( m2[3], m2[7] );
+
+  m2[0] = _mm256_add_epi16( m1[0], m1[2] );
+  m2[1] = _mm256_add_epi16( m1[1], m1[3] );
+  m2[2] = _mm256_sub_epi16( m1[0], m1[2] );
+  m2[3] = _mm256_sub_epi16( m1[1], m1[3] );
+  m2[4] = _mm256_add_epi16( m1[4], m1[6] );
+  m2[5] = _mm256_add_epi16( m1[5], m1[7] );
+  m2[6] = _mm256_sub_epi16( m1[4], m1[6] );
+  m2[7] = _mm256_sub_epi16( m1[5], m1[7] );
+
+  m1[0] = _mm256_add_epi16( m2[0], m2[1] );
+  m1[1] = _mm256_sub_epi16( m2[0], m2[1] );
+  m1[2] = _mm256_add_epi16( m2[2], m2[3] );
+  m1[3] = _mm256_sub_epi16( m2[2], m2[3] );
+  m1[4] = _mm256_add_epi16( m2[4], m2[5] );
+  m1[5] = _mm256_sub_epi16( m2[4], m2[5] );
+  m1[6] = _mm256_add_epi16( m2[6], m2[7] );
+  m1[7] = _mm256_sub_epi16( m2[6], m2[7] );
+
+  // horizontal
+  // transpose 2 4x8 blocks in parallel
+  {
+    m2[0] = _mm256_unpacklo_epi16( m1[0], m1[1] );
+    m2[1] = _mm256_unpacklo_epi16( m1[2], m1[3] );
+    m2[2] = _mm256_unpacklo_epi16( m1[4], m1[5] );
+    m2[3] = _mm256_unpacklo_epi16( m1[6], m1[7] );
+
+    m1[0] = _mm256_unpacklo_epi32( m2[0], m2[1] );
+    m1[1] = _mm256_unpackhi_epi32( m2[0], m2[1] );
+    m1[2] = _mm256_unpacklo_epi32( m2[2], m2[3] );
+    m1[3] = _mm256_unpackhi_epi32( m2[2], m2[3] );
+
+    m2[0] = _mm256_unpacklo_epi64( m1[0], m1[2] );
+    m2[1] = _mm256_unpackhi_epi64( m1[0], m1[2] );
+    m2[2] = _mm256_unpacklo_epi64( m1[1], m1[3] );
+    m2[3] = _mm256_unpackhi_epi64( m1[1], m1[3] );
+  }
+
+  if( iBitDepth >= 10 )
+  {
+    __m256i n1[4][2];
+    __m256i n2[4][2];
+
+    for( int i = 0; i < 4; i++ )
+    {
+      n1[i][0] = _mm256_srai_epi32( _mm256_unpacklo_epi16( m2[i], m2[i] ), 16 );
+      n1[i][1] = _mm256_srai_epi32( _mm256_unpackhi_epi16( m2[i], m2[i] ), 16 );
+    }
+
+    for( int i = 0; i < 2; i++ )
+    {
+      n2[0][i] = _mm256_add_epi32( n1[0][i], n1[2][i] );
+      n2[1][i] = _mm256_add_epi32( n1[1][i], n1[3][i] );
+      n2[2][i] = _mm256_sub_epi32( n1[0][i], n1[2][i] );
+      n2[3][i] = _mm256_sub_epi32( n1[1][i], n1[3][i] );
+
+      n1[0][i] = _mm256_abs_epi32( _mm256_add_epi32( n2[0][i], n2[1][i] ) );
+      n1[1][i] = _mm256_abs_epi32( _mm256_sub_epi32( n2[0][i], n2[1][i] ) );
+      n1[2][i] = _mm256_abs_epi32( _mm256_add_epi32( n2[2][i], n2[3][i] ) );
+      n1[3][i] = _mm256_abs_epi32( _mm256_sub_epi32( n2[2][i], n2[3][i] ) );
+    }
+    for( int i = 0; i < 4; i++ )
+    {
+      m1[i] = _mm256_add_epi32( n1[i][0], n1[i][1] );
+    }
+  }
+  else
+  {
+    m1[0] = _mm256_add_epi16( m2[0], m2[2] );
+    m1[1] = _mm256_add_epi16( m2[1], m2[3] );
+    m1[2] = _mm256_sub_epi16( m2[0], m2[2] );
+    m1[3] = _mm256_sub_epi16( m2[1], m2[3] );
+
+    m2[0] = _mm256_abs_epi16( _mm256_add_epi16( m1[0], m1[1] ) );
+    m2[1] = _mm256_abs_epi16( _mm256_sub_epi16( m1[0], m1[1] ) );
+    m2[2] = _mm256_abs_epi16( _mm256_add_epi16( m1[2], m1[3] ) );
+    m2[3] = _mm256_abs_epi16( _mm256_sub_epi16( m1[2], m1[3] ) );
+
+    __m256i ma1, ma2;
+    __m256i vzero = _mm256_setzero_si256();
+
+    for( Int i = 0; i < 4; i++ )
+    {
+      ma1 = _mm256_unpacklo_epi16( m2[i], vzero );
+      ma2 = _mm256_unpackhi_epi16( m2[i], vzero );
+      m1[i] = _mm256_add_epi32( ma1, ma2 );
+    }
+  }
+
+  m1[0] = _mm256_add_epi32( m1[0], m1[1] );
+  m1[2] = _mm256_add_epi32( m1[2], m1[3] );
+
+  __m256i iSum = _mm256_add_epi32( m1[0], m1[2] );
+
+  iSum = _mm256_hadd_epi32( iSum, iSum );
+  iSum = _mm256_hadd_epi32( iSum, iSum );
+
+  // each block is normalised on its own, as in xCalcHAD4x8_SSE
+  UInt tmp;
+  tmp = _mm_cvtsi128_si32( _mm256_castsi256_si128( iSum ) );
+  sad += (Int)(tmp / sqrt( 4.0 * 8 ) * 2);
+
+  tmp = _mm_cvtsi128_si32( _mm256_castsi256_si128( _mm256_permute2x128_si256( iSum, iSum, 0x11 ) ) );
+  sad += (Int)(tmp / sqrt( 4.0 * 8 ) * 2);
+#endif //USE_AVX2
+
+  return (sad);
+}
+
 template< typename Torg, typename Tcur, X86_VEXT vext >
 Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
 {
@@ -2390,19 +2944,160 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
   return uiSum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth - 8 );
 }
 
+template< typename Torg, typename Tcur, Int iWidth, X86_VEXT vext >
+Distortion RdCost::xGetHADs_NxM_SIMD( const DistParam &rcDtParam )
+{
+  const Int iRows = rcDtParam.org.height;
+
+  // the width is known at compile time, so the tile shape below resolves to the same choice
+  // xGetHADs_SIMD makes at run time; anything outside the QTBT shapes goes the generic way
+  if( rcDtParam.bitDepth > 10 || rcDtParam.applyWeight || !rcDtParam.isQtbt || ( iRows & 3 ) != 0 )
+  {
+    return xGetHADs_SIMD<Torg, Tcur, vext>( rcDtParam );
+  }
+
+  const Torg*  piOrg = (const Torg*)rcDtParam.org.buf;
+  const Tcur*  piCur = (const Tcur*)rcDtParam.cur.buf;
+  const Int iStrideCur = rcDtParam.cur.stride;
+  const Int iStrideOrg = rcDtParam.org.stride;
+  const Int iBitDepth  = rcDtParam.bitDepth;
+
+  Int  x, y;
+  UInt uiSum = 0;
+
+  if( iWidth == 4 )
+  {
+    if( iRows == 4 )
+    {
+      uiSum = xCalcHAD4x4_SSE( piOrg, piCur, iStrideOrg, iStrideCur );
+    }
+    else if( ( iRows & 7 ) == 0 )
+    {
+      for( y = 0; y < iRows; )
+      {
+        if( vext >= AVX2 && y + 16 <= iRows )
+        {
+          uiSum += xCalcHAD4x8x2_AVX2<Torg, Tcur>( piOrg, piCur, iStrideOrg, iStrideCur, iBitDepth );
+          piOrg += iStrideOrg * 16;
+          piCur += iStrideCur * 16;
+          y     += 16;
+        }
+        else
+        {
+          uiSum += xCalcHAD4x8_SSE( piOrg, piCur, iStrideOrg, iStrideCur, iBitDepth );
+          piOrg += iStrideOrg * 8;
+          piCur += iStrideCur * 8;
+          y     += 8;
+        }
+      }
+    }
+    else
+    {
+      return xGetHADs_SIMD<Torg, Tcur, vext>( rcDtParam );
+    }
+  }
+  else if( iWidth == 8 && iRows <= 8 )
+  {
+    if( iRows == 4 )
+    {
+      uiSum = xCalcHAD8x4_SSE<Torg, Tcur>( piOrg, piCur, iStrideOrg, iStrideCur, iBitDepth );
+    }
+    else
+    {
+      uiSum = xCalcHAD8x8_SSE<Torg, Tcur>( piOrg, piCur, iStrideOrg, iStrideCur, iBitDepth );
+    }
+  }
+  else if( iRows < iWidth && ( iRows & 7 ) == 0 )
+  {
+    for( y = 0; y < iRows; y += 8 )
+    {
+      for( x = 0; x < iWidth; x += 16 )
+      {
+        if( vext >= AVX2 )
+          uiSum += xCalcHAD16x8_AVX2<Torg, Tcur>( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+        else
+          uiSum += xCalcHAD16x8_SSE<Torg, Tcur>( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+      }
+      piOrg += iStrideOrg * 8;
+      piCur += iStrideCur * 8;
+    }
+  }
+  else if( iRows < iWidth )
+  {
+    for( y = 0; y < iRows; y += 4 )
+    {
+      for( x = 0; x < iWidth; x += 16 )
+      {
+        if( vext >= AVX2 )
+        {
+          uiSum += xCalcHAD8x4x2_AVX2<Torg, Tcur>( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+        }
+        else
+        {
+          uiSum += xCalcHAD8x4_SSE<Torg, Tcur>( &piOrg[x    ], &piCur[x    ], iStrideOrg, iStrideCur, iBitDepth );
+          uiSum += xCalcHAD8x4_SSE<Torg, Tcur>( &piOrg[x + 8], &piCur[x + 8], iStrideOrg, iStrideCur, iBitDepth );
+        }
+      }
+      piOrg += iStrideOrg * 4;
+      piCur += iStrideCur * 4;
+    }
+  }
+  else if( iRows == iWidth )
+  {
+    for( y = 0; y < iRows; y += 16 )
+    {
+      for( x = 0; x < iWidth; x += 16 )
+      {
+        if( vext >= AVX2 )
+        {
+          uiSum += xCalcHAD16x16_AVX2<Torg, Tcur>( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+        }
+        else
+        {
+          uiSum += xCalcHAD8x8_SSE<Torg, Tcur>( &piOrg[x                     ], &piCur[x                     ], iStrideOrg, iStrideCur, iBitDepth );
+          uiSum += xCalcHAD8x8_SSE<Torg, Tcur>( &piOrg[x                  + 8], &piCur[x                  + 8], iStrideOrg, iStrideCur, iBitDepth );
+          uiSum += xCalcHAD8x8_SSE<Torg, Tcur>( &piOrg[x + 8 * iStrideOrg    ], &piCur[x + 8 * iStrideCur    ], iStrideOrg, iStrideCur, iBitDepth );
+          uiSum += xCalcHAD8x8_SSE<Torg, Tcur>( &piOrg[x + 8 * iStrideOrg + 8], &piCur[x + 8 * iStrideCur + 8], iStrideOrg, iStrideCur, iBitDepth );
+        }
+      }
+      piOrg += iStrideOrg * 16;
+      piCur += iStrideCur * 16;
+    }
+  }
+  else if( ( iRows & 15 ) == 0 )
+  {
+    for( y = 0; y < iRows; y += 16 )
+    {
+      for( x = 0; x < iWidth; x += 8 )
+      {
+        if( vext >= AVX2 )
+          uiSum += xCalcHAD8x16_AVX2<Torg, Tcur>( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+        else
+          uiSum += xCalcHAD8x16_SSE<Torg, Tcur>( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+      }
+      piOrg += iStrideOrg * 16;
+      piCur += iStrideCur * 16;
+    }
+  }
+  else
+  {
+    return xGetHADs_SIMD<Torg, Tcur, vext>( rcDtParam );
+  }
+
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth - 8 );
+}
+
 template <X86_VEXT vext>
 Void RdCost::_initRdCostX86()
 {
-  /* SIMD SSE implementation shifts the final sum instead of every addend
-   * resulting in slightly different result compared to the scalar impl. */
-  //m_afpDistortFunc[DF_SSE    ] = xGetSSE_SIMD<Pel, Pel, vext>;
-  //m_afpDistortFunc[DF_SSE2   ] = xGetSSE_SIMD<Pel, Pel, vext>;
-  //m_afpDistortFunc[DF_SSE4   ] = xGetSSE_NxN_SIMD<Pel, Pel, 4,  vext>;
-  //m_afpDistortFunc[DF_SSE8   ] = xGetSSE_NxN_SIMD<Pel, Pel, 8,  vext>;
-  //m_afpDistortFunc[DF_SSE16  ] = xGetSSE_NxN_SIMD<Pel, Pel, 16, vext>;
-  //m_afpDistortFunc[DF_SSE32  ] = xGetSSE_NxN_SIMD<Pel, Pel, 32, vext>;
-  //m_afpDistortFunc[DF_SSE64  ] = xGetSSE_NxN_SIMD<Pel, Pel, 64, vext>;
-  //m_afpDistortFunc[DF_SSE16N ] = xGetSSE_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_SSE    ] = xGetSSE_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_SSE2   ] = xGetSSE_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_SSE4   ] = xGetSSE_NxN_SIMD<Pel, Pel, 4,  vext>;
+  m_afpDistortFunc[DF_SSE8   ] = xGetSSE_NxN_SIMD<Pel, Pel, 8,  vext>;
+  m_afpDistortFunc[DF_SSE16  ] = xGetSSE_NxN_SIMD<Pel, Pel, 16, vext>;
+  m_afpDistortFunc[DF_SSE32  ] = xGetSSE_NxN_SIMD<Pel, Pel, 32, vext>;
+  m_afpDistortFunc[DF_SSE64  ] = xGetSSE_NxN_SIMD<Pel, Pel, 64, vext>;
+  m_afpDistortFunc[DF_SSE16N ] = xGetSSE_SIMD<Pel, Pel, vext>;
 
   m_afpDistortFunc[DF_SAD    ] = xGetSAD_SIMD<vext>;
   m_afpDistortFunc[DF_SAD2   ] = xGetSAD_SIMD<vext>;
@@ -2417,13 +3112,28 @@ Void RdCost::_initRdCostX86()
   m_afpDistortFunc[DF_SAD24  ] = RdCost::xGetSAD_SIMD<vext>;
   m_afpDistortFunc[DF_SAD48  ] = RdCost::xGetSAD_SIMD<vext>;
 
+  m_fpDistortBatchFunc         = RdCost::xGetSADBatch_SIMD<vext>;
+
+  m_afpDistortFunc[DF_MRSAD    ] = RdCost::xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD2   ] = RdCost::xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD4   ] = RdCost::xGetMRSAD_NxN_SIMD<4,  vext>;
+  m_afpDistortFunc[DF_MRSAD8   ] = RdCost::xGetMRSAD_NxN_SIMD<8,  vext>;
+  m_afpDistortFunc[DF_MRSAD16  ] = RdCost::xGetMRSAD_NxN_SIMD<16, vext>;
+  m_afpDistortFunc[DF_MRSAD32  ] = RdCost::xGetMRSAD_NxN_SIMD<32, vext>;
+  m_afpDistortFunc[DF_MRSAD64  ] = RdCost::xGetMRSAD_NxN_SIMD<64, vext>;
+  m_afpDistortFunc[DF_MRSAD16N ] = RdCost::xGetMRSAD_NxN_SIMD<0,  vext>;
+
+  m_afpDistortFunc[DF_MRSAD12  ] = RdCost::xGetMRSAD_NxN_SIMD<12, vext>;
+  m_afpDistortFunc[DF_MRSAD24  ] = RdCost::xGetMRSAD_NxN_SIMD<24, vext>;
+  m_afpDistortFunc[DF_MRSAD48  ] = RdCost::xGetMRSAD_NxN_SIMD<48, vext>;
+
   m_afpDistortFunc[DF_HAD]     = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
   m_afpDistortFunc[DF_HAD2]    = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
-  m_afpDistortFunc[DF_HAD4]    = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
-  m_afpDistortFunc[DF_HAD8]    = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
-  m_afpDistortFunc[DF_HAD16]   = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
-  m_afpDistortFunc[DF_HAD32]   = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
-  m_afpDistortFunc[DF_HAD64]   = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_HAD4]    = RdCost::xGetHADs_NxM_SIMD<Pel, Pel, 4,  vext>;
+  m_afpDistortFunc[DF_HAD8]    = RdCost::xGetHADs_NxM_SIMD<Pel, Pel, 8,  vext>;
+  m_afpDistortFunc[DF_HAD16]   = RdCost::xGetHADs_NxM_SIMD<Pel, Pel, 16, vext>;
+  m_afpDistortFunc[DF_HAD32]   = RdCost::xGetHADs_NxM_SIMD<Pel, Pel, 32, vext>;
+  m_afpDistortFunc[DF_HAD64]   = RdCost::xGetHADs_NxM_SIMD<Pel, Pel, 64, vext>;
   m_afpDistortFunc[DF_HAD16N]  = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
 }
 
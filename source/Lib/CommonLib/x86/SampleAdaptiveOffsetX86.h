@@ -0,0 +1,310 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SampleAdaptiveOffsetX86.h
+    \brief    SIMD kernels for the SAO offset application and statistics
+*/
+
+#include "CommonDefX86.h"
+#include "../SampleAdaptiveOffset.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if ENABLE_SIMD_OPT_SAO
+
+// The offsets are held as 16 bit entries of byte shuffle tables, an index i is turned into the
+// shuffle control ( 2i, 2i+1 ) selecting the i-th entry of the table.
+
+static inline __m128i xShuffleIdx_SSE( const __m128i vidx )
+{
+  return _mm_add_epi16( _mm_mullo_epi16( vidx, _mm_set1_epi16( 0x0202 ) ), _mm_set1_epi16( 0x0100 ) );
+}
+
+#ifdef USE_AVX2
+static inline __m256i xShuffleIdx_AVX2( const __m256i vidx )
+{
+  return _mm256_add_epi16( _mm256_mullo_epi16( vidx, _mm256_set1_epi16( 0x0202 ) ), _mm256_set1_epi16( 0x0100 ) );
+}
+#endif
+
+template< X86_VEXT vext >
+static void offsetEO_SIMD( const Pel* src, Int srcStride, Pel* res, Int resStride, Int width, Int height, Int nbOffset, const Int* offset, const ClpRng& clpRng )
+{
+  const __m128i vtab = _mm_setr_epi16( offset[0], offset[1], offset[2], offset[3], offset[4], 0, 0, 0 );
+  const __m128i vone = _mm_set1_epi16( 1 );
+  const __m128i vtwo = _mm_set1_epi16( 2 );
+  const __m128i vmin = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax = _mm_set1_epi16( clpRng.max );
+
+  for( Int y = 0; y < height; y++ )
+  {
+    Int x = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vtab256 = _mm256_broadcastsi128_si256( vtab );
+      const __m256i vone256 = _mm256_set1_epi16( 1 );
+      const __m256i vtwo256 = _mm256_set1_epi16( 2 );
+      const __m256i vmin256 = _mm256_set1_epi16( clpRng.min );
+      const __m256i vmax256 = _mm256_set1_epi16( clpRng.max );
+
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vc = _mm256_loadu_si256( ( const __m256i* )&src[x] );
+        const __m256i va = _mm256_loadu_si256( ( const __m256i* )&src[x + nbOffset] );
+        const __m256i vb = _mm256_loadu_si256( ( const __m256i* )&src[x - nbOffset] );
+
+        __m256i vedge = _mm256_add_epi16( _mm256_sign_epi16( vone256, _mm256_sub_epi16( vc, va ) ), _mm256_sign_epi16( vone256, _mm256_sub_epi16( vc, vb ) ) );
+        vedge         = _mm256_add_epi16( vedge, vtwo256 );
+
+        const __m256i voff = _mm256_shuffle_epi8( vtab256, xShuffleIdx_AVX2( vedge ) );
+        const __m256i vres = _mm256_min_epi16( _mm256_max_epi16( _mm256_add_epi16( vc, voff ), vmin256 ), vmax256 );
+        _mm256_storeu_si256( ( __m256i* )&res[x], vres );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vc = _mm_loadu_si128( ( const __m128i* )&src[x] );
+      const __m128i va = _mm_loadu_si128( ( const __m128i* )&src[x + nbOffset] );
+      const __m128i vb = _mm_loadu_si128( ( const __m128i* )&src[x - nbOffset] );
+
+      __m128i vedge = _mm_add_epi16( _mm_sign_epi16( vone, _mm_sub_epi16( vc, va ) ), _mm_sign_epi16( vone, _mm_sub_epi16( vc, vb ) ) );
+      vedge         = _mm_add_epi16( vedge, vtwo );
+
+      const __m128i voff = _mm_shuffle_epi8( vtab, xShuffleIdx_SSE( vedge ) );
+      const __m128i vres = _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( vc, voff ), vmin ), vmax );
+      _mm_storeu_si128( ( __m128i* )&res[x], vres );
+    }
+    for( ; x < width; x++ )
+    {
+      const Int edgeType = sgn( src[x] - src[x + nbOffset] ) + sgn( src[x] - src[x - nbOffset] ) + 2;
+
+      res[x] = ClipPel<int>( src[x] + offset[edgeType], clpRng );
+    }
+
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+template< X86_VEXT vext >
+static void offsetBO_SIMD( const Pel* src, Int srcStride, Pel* res, Int resStride, Int width, Int height, Int shiftBits, const Int* offset, const ClpRng& clpRng )
+{
+  // the 32 band offsets as four tables of eight entries, bit 3 and bit 4 of the band index select the table
+  __m128i vtab[4];
+  for( Int k = 0; k < 4; k++ )
+  {
+    const Int* o = offset + 8 * k;
+    vtab[k] = _mm_setr_epi16( o[0], o[1], o[2], o[3], o[4], o[5], o[6], o[7] );
+  }
+
+  const __m128i vshift = _mm_cvtsi32_si128( shiftBits );
+  const __m128i vseven = _mm_set1_epi16( 7 );
+  const __m128i veight = _mm_set1_epi16( 8 );
+  const __m128i vsixtn = _mm_set1_epi16( 16 );
+  const __m128i vmin   = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax   = _mm_set1_epi16( clpRng.max );
+
+  for( Int y = 0; y < height; y++ )
+  {
+    Int x = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      __m256i vtab256[4];
+      for( Int k = 0; k < 4; k++ )
+      {
+        vtab256[k] = _mm256_broadcastsi128_si256( vtab[k] );
+      }
+      const __m256i vseven256 = _mm256_set1_epi16( 7 );
+      const __m256i veight256 = _mm256_set1_epi16( 8 );
+      const __m256i vsixtn256 = _mm256_set1_epi16( 16 );
+      const __m256i vmin256   = _mm256_set1_epi16( clpRng.min );
+      const __m256i vmax256   = _mm256_set1_epi16( clpRng.max );
+
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vc    = _mm256_loadu_si256( ( const __m256i* )&src[x] );
+        const __m256i vband = _mm256_srl_epi16( vc, vshift );
+        const __m256i vidx  = xShuffleIdx_AVX2( _mm256_and_si256( vband, vseven256 ) );
+        const __m256i vsel8 = _mm256_cmpeq_epi16( _mm256_and_si256( vband, veight256 ), veight256 );
+
+        const __m256i vlo  = _mm256_blendv_epi8( _mm256_shuffle_epi8( vtab256[0], vidx ), _mm256_shuffle_epi8( vtab256[1], vidx ), vsel8 );
+        const __m256i vhi  = _mm256_blendv_epi8( _mm256_shuffle_epi8( vtab256[2], vidx ), _mm256_shuffle_epi8( vtab256[3], vidx ), vsel8 );
+        const __m256i voff = _mm256_blendv_epi8( vlo, vhi, _mm256_cmpeq_epi16( _mm256_and_si256( vband, vsixtn256 ), vsixtn256 ) );
+
+        const __m256i vres = _mm256_min_epi16( _mm256_max_epi16( _mm256_add_epi16( vc, voff ), vmin256 ), vmax256 );
+        _mm256_storeu_si256( ( __m256i* )&res[x], vres );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vc    = _mm_loadu_si128( ( const __m128i* )&src[x] );
+      const __m128i vband = _mm_srl_epi16( vc, vshift );
+      const __m128i vidx  = xShuffleIdx_SSE( _mm_and_si128( vband, vseven ) );
+      const __m128i vsel8 = _mm_cmpeq_epi16( _mm_and_si128( vband, veight ), veight );
+
+      const __m128i vlo  = _mm_blendv_epi8( _mm_shuffle_epi8( vtab[0], vidx ), _mm_shuffle_epi8( vtab[1], vidx ), vsel8 );
+      const __m128i vhi  = _mm_blendv_epi8( _mm_shuffle_epi8( vtab[2], vidx ), _mm_shuffle_epi8( vtab[3], vidx ), vsel8 );
+      const __m128i voff = _mm_blendv_epi8( vlo, vhi, _mm_cmpeq_epi16( _mm_and_si128( vband, vsixtn ), vsixtn ) );
+
+      const __m128i vres = _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( vc, voff ), vmin ), vmax );
+      _mm_storeu_si128( ( __m128i* )&res[x], vres );
+    }
+    for( ; x < width; x++ )
+    {
+      res[x] = ClipPel<int>( src[x] + offset[src[x] >> shiftBits], clpRng );
+    }
+
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+template< X86_VEXT vext >
+static void statsEO_SIMD( const Pel* src, Int srcStride, const Pel* org, Int orgStride, Int width, Int height, Int nbOffset, Int64* diff, Int64* count )
+{
+  // per class sums of ( org - src ) and sample counts, 32 bit accumulators suffice for a CTU
+  __m128i vdiff [5];
+  __m128i vcount[5];
+  for( Int k = 0; k < 5; k++ )
+  {
+    vdiff [k] = _mm_setzero_si128();
+    vcount[k] = _mm_setzero_si128();
+  }
+
+  const __m128i vone = _mm_set1_epi16( 1 );
+
+#ifdef USE_AVX2
+  const __m256i vone256 = _mm256_set1_epi16( 1 );
+  __m256i vdiff256 [5];
+  __m256i vcount256[5];
+  for( Int k = 0; k < 5; k++ )
+  {
+    vdiff256 [k] = _mm256_setzero_si256();
+    vcount256[k] = _mm256_setzero_si256();
+  }
+#endif
+
+  for( Int y = 0; y < height; y++ )
+  {
+    Int x = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vc = _mm256_loadu_si256( ( const __m256i* )&src[x] );
+        const __m256i va = _mm256_loadu_si256( ( const __m256i* )&src[x + nbOffset] );
+        const __m256i vb = _mm256_loadu_si256( ( const __m256i* )&src[x - nbOffset] );
+        const __m256i vd = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* )&org[x] ), vc );
+
+        const __m256i vedge = _mm256_add_epi16( _mm256_sign_epi16( vone256, _mm256_sub_epi16( vc, va ) ), _mm256_sign_epi16( vone256, _mm256_sub_epi16( vc, vb ) ) );
+
+        for( Int k = 0; k < 5; k++ )
+        {
+          const __m256i vmask = _mm256_cmpeq_epi16( vedge, _mm256_set1_epi16( k - 2 ) );
+          vdiff256 [k] = _mm256_add_epi32( vdiff256 [k], _mm256_madd_epi16( _mm256_and_si256( vmask, vd ), vone256 ) );
+          vcount256[k] = _mm256_sub_epi32( vcount256[k], _mm256_madd_epi16( vmask, vone256 ) );
+        }
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vc = _mm_loadu_si128( ( const __m128i* )&src[x] );
+      const __m128i va = _mm_loadu_si128( ( const __m128i* )&src[x + nbOffset] );
+      const __m128i vb = _mm_loadu_si128( ( const __m128i* )&src[x - nbOffset] );
+      const __m128i vd = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )&org[x] ), vc );
+
+      const __m128i vedge = _mm_add_epi16( _mm_sign_epi16( vone, _mm_sub_epi16( vc, va ) ), _mm_sign_epi16( vone, _mm_sub_epi16( vc, vb ) ) );
+
+      for( Int k = 0; k < 5; k++ )
+      {
+        const __m128i vmask = _mm_cmpeq_epi16( vedge, _mm_set1_epi16( k - 2 ) );
+        vdiff [k] = _mm_add_epi32( vdiff [k], _mm_madd_epi16( _mm_and_si128( vmask, vd ), vone ) );
+        vcount[k] = _mm_sub_epi32( vcount[k], _mm_madd_epi16( vmask, vone ) );
+      }
+    }
+    for( ; x < width; x++ )
+    {
+      const Int edgeType = sgn( src[x] - src[x + nbOffset] ) + sgn( src[x] - src[x - nbOffset] ) + 2;
+
+      diff [edgeType] += ( org[x] - src[x] );
+      count[edgeType] ++;
+    }
+
+    src += srcStride;
+    org += orgStride;
+  }
+
+#ifdef USE_AVX2
+  for( Int k = 0; k < 5; k++ )
+  {
+    vdiff [k] = _mm_add_epi32( vdiff [k], _mm_add_epi32( _mm256_castsi256_si128( vdiff256 [k] ), _mm256_extracti128_si256( vdiff256 [k], 1 ) ) );
+    vcount[k] = _mm_add_epi32( vcount[k], _mm_add_epi32( _mm256_castsi256_si128( vcount256[k] ), _mm256_extracti128_si256( vcount256[k], 1 ) ) );
+  }
+#endif
+
+  for( Int k = 0; k < 5; k++ )
+  {
+    __m128i vsum = _mm_hadd_epi32( vdiff[k], vcount[k] );
+    vsum         = _mm_hadd_epi32( vsum, vsum );
+
+    diff [k] += _mm_cvtsi128_si32( vsum );
+    count[k] += _mm_extract_epi32( vsum, 1 );
+  }
+}
+
+template< X86_VEXT vext >
+void SaoOps::_initSaoOpsX86()
+{
+  offsetEO = offsetEO_SIMD<vext>;
+  offsetBO = offsetBO_SIMD<vext>;
+  statsEO  = statsEO_SIMD<vext>;
+}
+
+template void SaoOps::_initSaoOpsX86<SIMDX86>();
+
+#endif // ENABLE_SIMD_OPT_SAO
+
+#endif // TARGET_SIMD_X86
+//! \}
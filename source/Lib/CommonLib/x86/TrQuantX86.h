@@ -0,0 +1,512 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TrQuantX86.h
+    \brief    SIMD matrix multiplication kernels for the separable KLT
+*/
+
+#include "CommonDefX86.h"
+#include "../Rom.h"
+#include "../TrQuant.h"
+#include "../TrQuant_EMT.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if ENABLE_SIMD_OPT_TRAFO
+
+#if SEPARABLE_KLT
+
+template< Int uiTrSize >
+static inline const TMatrixCoeff* getKLTMatrix( const Int iTransType )
+{
+  const Int bIntra    = iTransType >> 1;
+  const Int bHighPrec = iTransType & 1;
+
+  switch( uiTrSize )
+  {
+  case  4: return bHighPrec ? g_aiKLT4HP [bIntra][0] : g_aiKLT4 [bIntra][0];
+  case  8: return bHighPrec ? g_aiKLT8HP [bIntra][0] : g_aiKLT8 [bIntra][0];
+  case 16: return bHighPrec ? g_aiKLT16HP[bIntra][0] : g_aiKLT16[bIntra][0];
+  case 32: return bHighPrec ? g_aiKLT32HP[bIntra][0] : g_aiKLT32[bIntra][0];
+  case 64: return bHighPrec ? g_aiKLT64HP[bIntra][0] : g_aiKLT64[bIntra][0];
+  default:
+    THROW( "Unsupported KLT size" );
+  }
+  return nullptr;
+}
+
+// load 4 or 8 consecutive samples widened to 32 bit, the residual is read as Pel directly
+static inline __m128i loadWide4( const TCoeff* p ) { return _mm_loadu_si128( ( const __m128i* ) p ); }
+static inline __m128i loadWide4( const Pel*    p ) { return _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) p ) ); }
+
+// store 4 samples, the values have been clipped to the range of the destination type already
+static inline void storeNarrow4( TCoeff* p, const __m128i& v ) { _mm_storeu_si128( ( __m128i* ) p, v ); }
+static inline void storeNarrow4( Pel*    p, const __m128i& v ) { _mm_storel_epi64( ( __m128i* ) p, _mm_packs_epi32( v, v ) ); }
+
+#ifdef USE_AVX2
+static inline __m256i loadWide8( const TCoeff* p ) { return _mm256_loadu_si256( ( const __m256i* ) p ); }
+static inline __m256i loadWide8( const Pel*    p ) { return _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) p ) ); }
+
+static inline void storeNarrow8( TCoeff* p, const __m256i& v ) { _mm256_storeu_si256( ( __m256i* ) p, v ); }
+static inline void storeNarrow8( Pel*    p, const __m256i& v ) { _mm_storeu_si128( ( __m128i* ) p, _mm256_castsi256_si128( _mm256_permute4x64_epi64( _mm256_packs_epi32( v, v ), 0x08 ) ) ); }
+#endif
+
+#ifdef USE_AVX512
+// the AVX-512 code uses the zero-masked intrinsics, the undefined pass-through operand of the unmasked ones trips
+// -Wmaybe-uninitialized in GCC 12
+static inline __m512i loadWide16( const TCoeff* p ) { return _mm512_loadu_si512( ( const void* ) p ); }
+static inline __m512i loadWide16( const Pel*    p ) { return _mm512_maskz_cvtepi16_epi32( 0xffff, _mm256_loadu_si256( ( const __m256i* ) p ) ); }
+
+static inline void storeNarrow16( TCoeff* p, const __m512i& v ) { _mm512_storeu_si512( ( void* ) p, v ); }
+static inline void storeNarrow16( Pel*    p, const __m512i& v ) { _mm256_storeu_si256( ( __m256i* ) p, _mm512_maskz_cvtsepi32_epi16( 0xffff, v ) ); }
+#endif
+
+/** forward matrix multiplication dst = tc * src^T
+*  The dot products are vectorized along the basis vectors, four lines are reduced at once. For the 4-point
+*  transform of many lines, the lines are transposed instead and every basis vector is applied to several lines at once.
+*  The products are accumulated in 32 bit, the results are bit-exact to the scalar _fastForwardMM.
+*  The lines of src are srcStride apart, so that the row transform can read the residual directly.
+*  With AVX-512, the 32 and 64-point transforms use 16 products per instruction.
+*/
+template< X86_VEXT vext, Int uiTrSize, typename TSrc >
+void fastForwardMM_SIMD( const TSrc *src, Int srcStride, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, const TMatrixCoeff* tc )
+{
+  const Int reducedLine = line - iSkipLine;
+  const Int cutoff      = uiTrSize - iSkipLine2;
+  const Int rnd_factor  = 1 << ( shift - 1 );
+
+  if( ( uiTrSize > 4 || line <= 16 ) && ( reducedLine & 3 ) == 0 )
+  {
+    // vectorize the dot products along the basis vectors and reduce four lines at once
+    const __m128i vrnd = _mm_set1_epi32( rnd_factor );
+
+    for( Int j = 0; j < cutoff; j++ )
+    {
+      const TMatrixCoeff* iT = tc + j * uiTrSize;
+      TCoeff* pCoef          = dst + j * line;
+
+      for( Int i = 0; i < reducedLine; i += 4 )
+      {
+        const TSrc* pSrc = src + i * srcStride;
+        __m128i vres;
+
+#ifdef USE_AVX512
+        if( vext >= AVX512 && uiTrSize >= 32 )
+        {
+          __m512i vsum0 = _mm512_setzero_si512();
+          __m512i vsum1 = _mm512_setzero_si512();
+          __m512i vsum2 = _mm512_setzero_si512();
+          __m512i vsum3 = _mm512_setzero_si512();
+
+          for( Int k = 0; k < uiTrSize; k += 16 )
+          {
+            const __m512i vcoef = _mm512_maskz_cvtepi16_epi32( 0xffff, _mm256_loadu_si256( ( const __m256i* ) &iT[k] ) );
+            vsum0 = _mm512_add_epi32( vsum0, _mm512_mullo_epi32( loadWide16( &pSrc[0 * srcStride + k] ), vcoef ) );
+            vsum1 = _mm512_add_epi32( vsum1, _mm512_mullo_epi32( loadWide16( &pSrc[1 * srcStride + k] ), vcoef ) );
+            vsum2 = _mm512_add_epi32( vsum2, _mm512_mullo_epi32( loadWide16( &pSrc[2 * srcStride + k] ), vcoef ) );
+            vsum3 = _mm512_add_epi32( vsum3, _mm512_mullo_epi32( loadWide16( &pSrc[3 * srcStride + k] ), vcoef ) );
+          }
+
+          // fold the upper halves in and reduce the four lines as in the AVX2 case
+          const __m256i vred0 = _mm256_add_epi32( _mm512_maskz_extracti64x4_epi64( 0xf, vsum0, 0 ), _mm512_maskz_extracti64x4_epi64( 0xf, vsum0, 1 ) );
+          const __m256i vred1 = _mm256_add_epi32( _mm512_maskz_extracti64x4_epi64( 0xf, vsum1, 0 ), _mm512_maskz_extracti64x4_epi64( 0xf, vsum1, 1 ) );
+          const __m256i vred2 = _mm256_add_epi32( _mm512_maskz_extracti64x4_epi64( 0xf, vsum2, 0 ), _mm512_maskz_extracti64x4_epi64( 0xf, vsum2, 1 ) );
+          const __m256i vred3 = _mm256_add_epi32( _mm512_maskz_extracti64x4_epi64( 0xf, vsum3, 0 ), _mm512_maskz_extracti64x4_epi64( 0xf, vsum3, 1 ) );
+
+          const __m256i vred  = _mm256_hadd_epi32( _mm256_hadd_epi32( vred0, vred1 ), _mm256_hadd_epi32( vred2, vred3 ) );
+          vres = _mm_add_epi32( _mm256_castsi256_si128( vred ), _mm256_extracti128_si256( vred, 1 ) );
+        }
+        else
+#endif
+        if( vext >= AVX2 && uiTrSize >= 8 )
+        {
+#ifdef USE_AVX2
+          __m256i vsum0 = _mm256_setzero_si256();
+          __m256i vsum1 = _mm256_setzero_si256();
+          __m256i vsum2 = _mm256_setzero_si256();
+          __m256i vsum3 = _mm256_setzero_si256();
+
+          for( Int k = 0; k < uiTrSize; k += 8 )
+          {
+            const __m256i vcoef = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &iT[k] ) );
+            vsum0 = _mm256_add_epi32( vsum0, _mm256_mullo_epi32( loadWide8( &pSrc[0 * srcStride + k] ), vcoef ) );
+            vsum1 = _mm256_add_epi32( vsum1, _mm256_mullo_epi32( loadWide8( &pSrc[1 * srcStride + k] ), vcoef ) );
+            vsum2 = _mm256_add_epi32( vsum2, _mm256_mullo_epi32( loadWide8( &pSrc[2 * srcStride + k] ), vcoef ) );
+            vsum3 = _mm256_add_epi32( vsum3, _mm256_mullo_epi32( loadWide8( &pSrc[3 * srcStride + k] ), vcoef ) );
+          }
+
+          vsum0 = _mm256_hadd_epi32( _mm256_hadd_epi32( vsum0, vsum1 ), _mm256_hadd_epi32( vsum2, vsum3 ) );
+          vres  = _mm_add_epi32( _mm256_castsi256_si128( vsum0 ), _mm256_extracti128_si256( vsum0, 1 ) );
+#else
+          vres  = _mm_setzero_si128();
+#endif
+        }
+        else
+        {
+          __m128i vsum0 = _mm_setzero_si128();
+          __m128i vsum1 = _mm_setzero_si128();
+          __m128i vsum2 = _mm_setzero_si128();
+          __m128i vsum3 = _mm_setzero_si128();
+
+          for( Int k = 0; k < uiTrSize; k += 4 )
+          {
+            const __m128i vcoef = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &iT[k] ) );
+            vsum0 = _mm_add_epi32( vsum0, _mm_mullo_epi32( loadWide4( &pSrc[0 * srcStride + k] ), vcoef ) );
+            vsum1 = _mm_add_epi32( vsum1, _mm_mullo_epi32( loadWide4( &pSrc[1 * srcStride + k] ), vcoef ) );
+            vsum2 = _mm_add_epi32( vsum2, _mm_mullo_epi32( loadWide4( &pSrc[2 * srcStride + k] ), vcoef ) );
+            vsum3 = _mm_add_epi32( vsum3, _mm_mullo_epi32( loadWide4( &pSrc[3 * srcStride + k] ), vcoef ) );
+          }
+
+          vres = _mm_hadd_epi32( _mm_hadd_epi32( vsum0, vsum1 ), _mm_hadd_epi32( vsum2, vsum3 ) );
+        }
+
+        _mm_storeu_si128( ( __m128i* ) &pCoef[i], _mm_srai_epi32( _mm_add_epi32( vres, vrnd ), shift ) );
+      }
+
+      if( iSkipLine )
+      {
+        ::memset( pCoef + reducedLine, 0, sizeof( TCoeff ) * iSkipLine );
+      }
+    }
+
+    if( iSkipLine2 )
+    {
+      ::memset( dst + line * cutoff, 0, sizeof( TCoeff ) * line * iSkipLine2 );
+    }
+    return;
+  }
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff srcT[uiTrSize * MAX_TU_SIZE] );
+
+  for( Int i = 0; i < reducedLine; i++ )
+  {
+    for( Int k = 0; k < uiTrSize; k++ )
+    {
+      srcT[k * line + i] = src[i * srcStride + k];
+    }
+  }
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff iT[uiTrSize] );
+
+  for( Int j = 0; j < cutoff; j++ )
+  {
+    TCoeff* pCoef          = dst + j * line;
+    Int i                  = 0;
+
+    // widen the basis vector once, such that the coefficients can be broadcast directly from memory
+    for( Int k = 0; k < uiTrSize; k += 4 )
+    {
+      _mm_store_si128( ( __m128i* ) &iT[k], _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &tc[j * uiTrSize + k] ) ) );
+    }
+
+    if( vext >= AVX2 )
+    {
+#ifdef USE_AVX2
+      const __m256i vrnd = _mm256_set1_epi32( rnd_factor );
+
+      for( ; i + 32 <= reducedLine; i += 32 )
+      {
+        __m256i vsum0 = _mm256_setzero_si256();
+        __m256i vsum1 = _mm256_setzero_si256();
+        __m256i vsum2 = _mm256_setzero_si256();
+        __m256i vsum3 = _mm256_setzero_si256();
+
+        for( Int k = 0; k < uiTrSize; k++ )
+        {
+          const TCoeff* pSrc   = &srcT[k * line + i];
+          const __m256i vcoef  = _mm256_set1_epi32( iT[k] );
+          vsum0 = _mm256_add_epi32( vsum0, _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i* ) &pSrc[ 0] ), vcoef ) );
+          vsum1 = _mm256_add_epi32( vsum1, _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i* ) &pSrc[ 8] ), vcoef ) );
+          vsum2 = _mm256_add_epi32( vsum2, _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i* ) &pSrc[16] ), vcoef ) );
+          vsum3 = _mm256_add_epi32( vsum3, _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i* ) &pSrc[24] ), vcoef ) );
+        }
+
+        _mm256_storeu_si256( ( __m256i* ) &pCoef[i     ], _mm256_srai_epi32( _mm256_add_epi32( vsum0, vrnd ), shift ) );
+        _mm256_storeu_si256( ( __m256i* ) &pCoef[i +  8], _mm256_srai_epi32( _mm256_add_epi32( vsum1, vrnd ), shift ) );
+        _mm256_storeu_si256( ( __m256i* ) &pCoef[i + 16], _mm256_srai_epi32( _mm256_add_epi32( vsum2, vrnd ), shift ) );
+        _mm256_storeu_si256( ( __m256i* ) &pCoef[i + 24], _mm256_srai_epi32( _mm256_add_epi32( vsum3, vrnd ), shift ) );
+      }
+
+      for( ; i + 8 <= reducedLine; i += 8 )
+      {
+        __m256i vsum = _mm256_setzero_si256();
+
+        for( Int k = 0; k < uiTrSize; k++ )
+        {
+          __m256i vsrc = _mm256_loadu_si256( ( const __m256i* ) &srcT[k * line + i] );
+          vsum = _mm256_add_epi32( vsum, _mm256_mullo_epi32( vsrc, _mm256_set1_epi32( iT[k] ) ) );
+        }
+
+        vsum = _mm256_srai_epi32( _mm256_add_epi32( vsum, vrnd ), shift );
+        _mm256_storeu_si256( ( __m256i* ) &pCoef[i], vsum );
+      }
+#endif
+    }
+
+    {
+      const __m128i vrnd = _mm_set1_epi32( rnd_factor );
+
+      for( ; i + 4 <= reducedLine; i += 4 )
+      {
+        __m128i vsum = _mm_setzero_si128();
+
+        for( Int k = 0; k < uiTrSize; k++ )
+        {
+          __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &srcT[k * line + i] );
+          vsum = _mm_add_epi32( vsum, _mm_mullo_epi32( vsrc, _mm_set1_epi32( iT[k] ) ) );
+        }
+
+        vsum = _mm_srai_epi32( _mm_add_epi32( vsum, vrnd ), shift );
+        _mm_storeu_si128( ( __m128i* ) &pCoef[i], vsum );
+      }
+    }
+
+    for( ; i < reducedLine; i++ )
+    {
+      Int iSum = 0;
+      for( Int k = 0; k < uiTrSize; k++ )
+      {
+        iSum += srcT[k * line + i] * iT[k];
+      }
+      pCoef[i] = ( iSum + rnd_factor ) >> shift;
+    }
+
+    if( iSkipLine )
+    {
+      ::memset( pCoef + reducedLine, 0, sizeof( TCoeff ) * iSkipLine );
+    }
+  }
+
+  if( iSkipLine2 )
+  {
+    ::memset( dst + line * cutoff, 0, sizeof( TCoeff ) * line * iSkipLine2 );
+  }
+}
+
+/** inverse matrix multiplication dst = src^T * iT, vectorized over the output samples of a line
+*  A whole output line is kept in registers, one coefficient is broadcast per basis vector.
+*  The lines of dst are dstStride apart, so that the row transform can write the residual directly.
+*  With AVX-512, the 32 and 64-point transforms keep the line in 16 sample vectors.
+*/
+template< X86_VEXT vext, Int uiTrSize, typename TDst >
+void fastInverseMM_SIMD( const TCoeff *src, TDst *dst, Int dstStride, Int shift, Int line, Int iSkipLine, Int iSkipLine2, const TCoeff outputMinimum, const TCoeff outputMaximum, const TMatrixCoeff* iT )
+{
+  const Int reducedLine = line - iSkipLine;
+  const Int cutoff      = uiTrSize - iSkipLine2;
+  const Int rnd_factor  = 1 << ( shift - 1 );
+
+#ifdef USE_AVX512
+  if( vext >= AVX512 && uiTrSize >= 32 )
+  {
+    const Int numVec   = uiTrSize >> 4;
+    const __m512i vrnd = _mm512_set1_epi32( rnd_factor );
+    const __m512i vmin = _mm512_set1_epi32( outputMinimum );
+    const __m512i vmax = _mm512_set1_epi32( outputMaximum );
+
+    __m512i vsum[numVec > 0 ? numVec : 1];
+
+    for( Int i = 0; i < reducedLine; i++ )
+    {
+      for( Int n = 0; n < numVec; n++ )
+      {
+        vsum[n] = _mm512_setzero_si512();
+      }
+
+      for( Int k = 0; k < cutoff; k++ )
+      {
+        const __m512i vsrc     = _mm512_set1_epi32( src[k * line + i] );
+        const TMatrixCoeff* pT = iT + k * uiTrSize;
+
+        for( Int n = 0; n < numVec; n++ )
+        {
+          __m512i vcoef = _mm512_maskz_cvtepi16_epi32( 0xffff, _mm256_loadu_si256( ( const __m256i* ) &pT[n << 4] ) );
+          vsum[n] = _mm512_add_epi32( vsum[n], _mm512_mullo_epi32( vsrc, vcoef ) );
+        }
+      }
+
+      for( Int n = 0; n < numVec; n++ )
+      {
+        __m512i vres = _mm512_maskz_sra_epi32( 0xffff, _mm512_add_epi32( vsum[n], vrnd ), _mm_cvtsi32_si128( shift ) );
+        vres = _mm512_maskz_min_epi32( 0xffff, vmax, _mm512_maskz_max_epi32( 0xffff, vmin, vres ) );
+        storeNarrow16( &dst[i * dstStride + ( n << 4 )], vres );
+      }
+    }
+  }
+  else
+#endif
+  if( vext >= AVX2 && uiTrSize >= 8 )
+  {
+#ifdef USE_AVX2
+    const Int numVec   = uiTrSize >> 3;
+    const __m256i vrnd = _mm256_set1_epi32( rnd_factor );
+    const __m256i vmin = _mm256_set1_epi32( outputMinimum );
+    const __m256i vmax = _mm256_set1_epi32( outputMaximum );
+
+    __m256i vsum[numVec > 0 ? numVec : 1];
+
+    for( Int i = 0; i < reducedLine; i++ )
+    {
+      for( Int n = 0; n < numVec; n++ )
+      {
+        vsum[n] = _mm256_setzero_si256();
+      }
+
+      for( Int k = 0; k < cutoff; k++ )
+      {
+        const __m256i vsrc     = _mm256_set1_epi32( src[k * line + i] );
+        const TMatrixCoeff* pT = iT + k * uiTrSize;
+
+        for( Int n = 0; n < numVec; n++ )
+        {
+          __m256i vcoef = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pT[n << 3] ) );
+          vsum[n] = _mm256_add_epi32( vsum[n], _mm256_mullo_epi32( vsrc, vcoef ) );
+        }
+      }
+
+      for( Int n = 0; n < numVec; n++ )
+      {
+        __m256i vres = _mm256_srai_epi32( _mm256_add_epi32( vsum[n], vrnd ), shift );
+        vres = _mm256_min_epi32( vmax, _mm256_max_epi32( vmin, vres ) );
+        storeNarrow8( &dst[i * dstStride + ( n << 3 )], vres );
+      }
+    }
+#endif
+  }
+  else
+  {
+    const Int numVec  = uiTrSize >> 2;
+    const __m128i vrnd = _mm_set1_epi32( rnd_factor );
+    const __m128i vmin = _mm_set1_epi32( outputMinimum );
+    const __m128i vmax = _mm_set1_epi32( outputMaximum );
+
+    __m128i vsum[numVec];
+
+    for( Int i = 0; i < reducedLine; i++ )
+    {
+      for( Int n = 0; n < numVec; n++ )
+      {
+        vsum[n] = _mm_setzero_si128();
+      }
+
+      for( Int k = 0; k < cutoff; k++ )
+      {
+        const __m128i vsrc     = _mm_set1_epi32( src[k * line + i] );
+        const TMatrixCoeff* pT = iT + k * uiTrSize;
+
+        for( Int n = 0; n < numVec; n++ )
+        {
+          __m128i vcoef = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pT[n << 2] ) );
+          vsum[n] = _mm_add_epi32( vsum[n], _mm_mullo_epi32( vsrc, vcoef ) );
+        }
+      }
+
+      for( Int n = 0; n < numVec; n++ )
+      {
+        __m128i vres = _mm_srai_epi32( _mm_add_epi32( vsum[n], vrnd ), shift );
+        vres = _mm_min_epi32( vmax, _mm_max_epi32( vmin, vres ) );
+        storeNarrow4( &dst[i * dstStride + ( n << 2 )], vres );
+      }
+    }
+  }
+
+  for( Int i = reducedLine; i < line; i++ )
+  {
+    ::memset( dst + i * dstStride, 0, sizeof( TDst ) * uiTrSize );
+  }
+}
+
+template< X86_VEXT vext, Int uiTrSize >
+void fastForwardKLT_SIMD( const TCoeff *src, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType )
+{
+  fastForwardMM_SIMD<vext, uiTrSize>( src, uiTrSize, dst, shift, line, iSkipLine, iSkipLine2, getKLTMatrix<uiTrSize>( iTransType ) );
+}
+
+template< X86_VEXT vext, Int uiTrSize >
+void fastInverseKLT_SIMD( const TCoeff *src, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  fastInverseMM_SIMD<vext, uiTrSize>( src, dst, uiTrSize, shift, line, iSkipLine, iSkipLine2, outputMinimum, outputMaximum, getKLTMatrix<uiTrSize>( iTransType ) );
+}
+
+template< X86_VEXT vext, Int uiTrSize >
+void fastForwardKLTPel_SIMD( const Pel *src, Int srcStride, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType )
+{
+  fastForwardMM_SIMD<vext, uiTrSize>( src, srcStride, dst, shift, line, iSkipLine, iSkipLine2, getKLTMatrix<uiTrSize>( iTransType ) );
+}
+
+template< X86_VEXT vext, Int uiTrSize >
+void fastInverseKLTPel_SIMD( const TCoeff *src, Pel *dst, Int dstStride, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int iTransType, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  fastInverseMM_SIMD<vext, uiTrSize>( src, dst, dstStride, shift, line, iSkipLine, iSkipLine2, outputMinimum, outputMaximum, getKLTMatrix<uiTrSize>( iTransType ) );
+}
+
+#endif // SEPARABLE_KLT
+
+template<X86_VEXT vext>
+void TrafoOps::_initTrafoOpsX86()
+{
+#if SEPARABLE_KLT
+  fastFwdTrans[TRAFO_KLT][1] = fastForwardKLT_SIMD<vext,  4>;
+  fastFwdTrans[TRAFO_KLT][2] = fastForwardKLT_SIMD<vext,  8>;
+  fastFwdTrans[TRAFO_KLT][3] = fastForwardKLT_SIMD<vext, 16>;
+  fastFwdTrans[TRAFO_KLT][4] = fastForwardKLT_SIMD<vext, 32>;
+  fastFwdTrans[TRAFO_KLT][5] = fastForwardKLT_SIMD<vext, 64>;
+
+  fastInvTrans[TRAFO_KLT][1] = fastInverseKLT_SIMD<vext,  4>;
+  fastInvTrans[TRAFO_KLT][2] = fastInverseKLT_SIMD<vext,  8>;
+  fastInvTrans[TRAFO_KLT][3] = fastInverseKLT_SIMD<vext, 16>;
+  fastInvTrans[TRAFO_KLT][4] = fastInverseKLT_SIMD<vext, 32>;
+  fastInvTrans[TRAFO_KLT][5] = fastInverseKLT_SIMD<vext, 64>;
+
+  fastFwdKLTPel[1] = fastForwardKLTPel_SIMD<vext,  4>;
+  fastFwdKLTPel[2] = fastForwardKLTPel_SIMD<vext,  8>;
+  fastFwdKLTPel[3] = fastForwardKLTPel_SIMD<vext, 16>;
+  fastFwdKLTPel[4] = fastForwardKLTPel_SIMD<vext, 32>;
+  fastFwdKLTPel[5] = fastForwardKLTPel_SIMD<vext, 64>;
+
+  fastInvKLTPel[1] = fastInverseKLTPel_SIMD<vext,  4>;
+  fastInvKLTPel[2] = fastInverseKLTPel_SIMD<vext,  8>;
+  fastInvKLTPel[3] = fastInverseKLTPel_SIMD<vext, 16>;
+  fastInvKLTPel[4] = fastInverseKLTPel_SIMD<vext, 32>;
+  fastInvKLTPel[5] = fastInverseKLTPel_SIMD<vext, 64>;
+#endif
+}
+
+template void TrafoOps::_initTrafoOpsX86<SIMDX86>();
+
+#endif // ENABLE_SIMD_OPT_TRAFO
+
+#endif // TARGET_SIMD_X86
+//! \}
@@ -0,0 +1 @@
+#include "../IntraPredX86.h"
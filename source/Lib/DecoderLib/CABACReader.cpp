@@ -381,7 +381,7 @@ bool CABACReader::coding_tree( CodingStructure& cs, Partitioner& partitioner, CU
 
       do
       {
-        if( !lastSegment && cs.area.blocks[partitioner.chType].contains( partitioner.currArea().blocks[partitioner.chType].pos() ) )
+        if( !lastSegment && cs.picture->blocks[partitioner.chType].contains( partitioner.currArea().blocks[partitioner.chType].pos() ) )
         {
           lastSegment = coding_tree( cs, partitioner, cuCtx );
         }
@@ -406,7 +406,7 @@ bool CABACReader::coding_tree( CodingStructure& cs, Partitioner& partitioner, CU
 
         do
         {
-          if( !lastSegment && cs.area.blocks[partitioner.chType].contains( partitioner.currArea().blocks[partitioner.chType].pos() ) )
+          if( !lastSegment && cs.picture->blocks[partitioner.chType].contains( partitioner.currArea().blocks[partitioner.chType].pos() ) )
           {
             lastSegment = coding_tree( cs, partitioner, cuCtx );
           }
@@ -1777,6 +1777,7 @@ void CABACReader::residual_coding( TransformUnit& tu, ComponentID compID )
 
   // parse last coeff position
   cctx.setScanPosLast( last_sig_coeff( cctx ) );
+  tu.lastPos[compID] = cctx.scanPosLast();
 
   // parse subblocks
   cctx.setGoRiceStats( GRStats );
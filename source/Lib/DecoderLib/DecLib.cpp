@@ -343,10 +343,20 @@ DecLib::DecLib()
   , m_numberOfChecksumErrorsDetected(0)
   , m_warningMessageSkipPicture(false)
   , m_prefixSEINALUs()
+  , m_numThreads(1)
+#if ENABLE_WPP_PARALLELISM
+  , m_numDecStacks(1)
+#endif
 {
 #if ENABLE_SIMD_OPT_BUFFER
   g_pelBufOP.initPelBufOpsX86();
 #endif
+#if ENABLE_SIMD_OPT_TRAFO
+  g_trafoOP.initTrafoOpsX86();
+#endif
+#if ENABLE_SIMD_OPT_SAO
+  g_saoOP.initSaoOpsX86();
+#endif
 }
 
 DecLib::~DecLib()
@@ -362,6 +372,25 @@ Void DecLib::create()
 {
   m_apcSlicePilot = new Slice;
   m_uiSliceSegmentIdx = 0;
+
+  int numThreads = m_numThreads;
+  if( numThreads == 0 )
+  {
+    numThreads = std::max<int>( std::thread::hardware_concurrency(), 1 );
+  }
+#if ENABLE_WPP_PARALLELISM
+  // one decoder stack per CTU line task, all line tasks have to be able to run at the same time
+  m_numDecStacks  = numThreads;
+
+  m_cIntraPred    = new IntraPrediction[m_numDecStacks];
+  m_cInterPred    = new InterPrediction[m_numDecStacks];
+  m_cTrQuant      = new TrQuant        [m_numDecStacks];
+  m_cCuDecoder    = new DecCu          [m_numDecStacks];
+  m_CABACDecoder  = new CABACDecoder   [m_numDecStacks];
+#endif
+
+  // the calling thread takes part in the work
+  m_threadPool.init( numThreads - 1 );
 }
 
 Void DecLib::destroy()
@@ -369,12 +398,30 @@ Void DecLib::destroy()
   delete m_apcSlicePilot;
   m_apcSlicePilot = NULL;
 
+  m_threadPool.destroy();
   m_cSliceDecoder.destroy();
+#if ENABLE_WPP_PARALLELISM
+
+  delete[] m_cIntraPred;
+  delete[] m_cInterPred;
+  delete[] m_cTrQuant;
+  delete[] m_cCuDecoder;
+  delete[] m_CABACDecoder;
+  m_cIntraPred   = nullptr;
+  m_cInterPred   = nullptr;
+  m_cTrQuant     = nullptr;
+  m_cCuDecoder   = nullptr;
+  m_CABACDecoder = nullptr;
+#endif
 }
 
 Void DecLib::init()
 {
-  m_cSliceDecoder.init( &m_CABACDecoder, &m_cCuDecoder );
+#if ENABLE_WPP_PARALLELISM
+  m_cSliceDecoder.init( m_CABACDecoder, m_cCuDecoder, &m_cLoopFilter, &m_cSAO, m_numDecStacks, &m_threadPool );
+#else
+  m_cSliceDecoder.init( &m_CABACDecoder, &m_cCuDecoder, &m_cLoopFilter, &m_cSAO );
+#endif
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "final", 1 ) );
 }
 
@@ -467,13 +514,8 @@ Void DecLib::executeLoopFilters()
 
   CodingStructure& cs = *m_pcPic->cs;
 
-  // deblocking filter
-  m_cLoopFilter.loopFilterPic( cs );
-
-  if( cs.sps->getUseSAO() )
-  {
-    m_cSAO.SAOProcess( cs, cs.picture->getSAO() );
-  }
+  // deblocking filter and SAO of the CTU lines not filtered while the slices were decoded
+  m_cSliceDecoder.finishLoopFilters( cs );
 }
 
 Void DecLib::finishPictureLight(Int& poc, PicList*& rpcListPic )
@@ -657,7 +699,12 @@ Void DecLib::xActivateParameterSets()
 
     m_pcPic->finalInit( *sps, *pps );
 
+#if ENABLE_WPP_PARALLELISM
+    // concurrently decoded CTU lines must not share the CTU sized prediction and residual buffers
+    m_pcPic->createTempBuffers( m_pcPic->cs->pps->pcv->maxCUWidth, m_numDecStacks > 1 );
+#else
     m_pcPic->createTempBuffers( m_pcPic->cs->pps->pcv->maxCUWidth );
+#endif
     m_pcPic->cs->createCoeffs();
 
     m_pcPic->allocateNewSlice();
@@ -684,8 +731,18 @@ Void DecLib::xActivateParameterSets()
     // Initialise the various objects for the new set of settings
     m_cSAO.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getMaxCodingDepth(), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_LUMA), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_CHROMA) );
     m_cLoopFilter.create( sps->getMaxCodingDepth() );
+    // the CTU lines of the new picture are in-loop filtered while they are reconstructed
+    m_cSliceDecoder.initLoopFilters( *m_pcPic->cs );
+#if ENABLE_WPP_PARALLELISM
+    for( int jId = 0; jId < m_numDecStacks; jId++ )
+    {
+      m_cIntraPred[jId].init( sps->getChromaFormatIdc(), sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
+      m_cInterPred[jId].init( &m_cRdCost, sps->getChromaFormatIdc() );
+    }
+#else
     m_cIntraPred.init( sps->getChromaFormatIdc(), sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
     m_cInterPred.init( &m_cRdCost, sps->getChromaFormatIdc() );
+#endif
 
 
     Bool isField = false;
@@ -712,8 +769,17 @@ Void DecLib::xActivateParameterSets()
     m_SEIs.clear();
 
     // Recursive structure
+#if ENABLE_WPP_PARALLELISM
+    for( int jId = 0; jId < m_numDecStacks; jId++ )
+    {
+      // the stacks share the scaling list tables of the first one
+      m_cCuDecoder[jId].init( &m_cTrQuant[jId], &m_cIntraPred[jId], &m_cInterPred[jId] );
+      m_cTrQuant  [jId].init( jId == 0 ? nullptr : m_cTrQuant[0].getQuant(), sps->getMaxTrSize(), false, false, false, false, false, pps->pcv->rectCUs );
+    }
+#else
     m_cCuDecoder.init( &m_cTrQuant, &m_cIntraPred, &m_cInterPred );
     m_cTrQuant  .init( nullptr, sps->getMaxTrSize(), false, false, false, false, false, pps->pcv->rectCUs );
+#endif
 
     // RdCost
     m_cRdCost.setCostMode ( COST_STANDARD_LOSSY ); // not used in decoder side RdCost stuff -> set to default
@@ -1059,7 +1125,11 @@ Bool DecLib::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDispl
 #endif
 
 #if HEVC_USE_SCALING_LISTS
+#if ENABLE_WPP_PARALLELISM
+  Quant *quant = m_cTrQuant[0].getQuant();
+#else
   Quant *quant = m_cTrQuant.getQuant();
+#endif
 
   if(pcSlice->getSPS()->getScalingListFlag())
   {
@@ -1083,6 +1153,12 @@ Bool DecLib::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDispl
   {
     quant->setUseScalingList(false);
   }
+#if ENABLE_WPP_PARALLELISM
+  for( int jId = 1; jId < m_numDecStacks; jId++ )
+  {
+    m_cTrQuant[jId].getQuant()->setUseScalingList( pcSlice->getSPS()->getScalingListFlag() );
+  }
+#endif
 #endif
 
 
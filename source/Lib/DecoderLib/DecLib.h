@@ -51,6 +51,7 @@
 #include "CommonLib/LoopFilter.h"
 #include "CommonLib/SEI.h"
 #include "CommonLib/Unit.h"
+#include "CommonLib/ThreadPool.h"
 
 class InputNALUnit;
 
@@ -81,13 +82,27 @@ private:
   SEIMessages             m_SEIs; ///< List of SEI messages that have been received before the first slice and between slices, excluding prefix SEIs...
 
   // functional classes
+#if ENABLE_WPP_PARALLELISM
+  IntraPrediction        *m_cIntraPred;                   ///< one per concurrently decoded CTU line
+  InterPrediction        *m_cInterPred;
+  TrQuant                *m_cTrQuant;
+#else
   IntraPrediction         m_cIntraPred;
   InterPrediction         m_cInterPred;
   TrQuant                 m_cTrQuant;
+#endif
   DecSlice                m_cSliceDecoder;
+#if ENABLE_WPP_PARALLELISM
+  DecCu                  *m_cCuDecoder;
+#else
   DecCu                   m_cCuDecoder;
+#endif
   HLSyntaxReader          m_HLSReader;
+#if ENABLE_WPP_PARALLELISM
+  CABACDecoder           *m_CABACDecoder;
+#else
   CABACDecoder            m_CABACDecoder;
+#endif
   SEIReader               m_seiReader;
   LoopFilter              m_cLoopFilter;
   SampleAdaptiveOffset    m_cSAO;
@@ -116,6 +131,12 @@ private:
   Bool                    m_warningMessageSkipPicture;
 
   std::list<InputNALUnit*> m_prefixSEINALUs; /// Buffered up prefix SEI NAL Units.
+
+  Int                     m_numThreads;                   ///< number of threads decoding a picture, 0: number of cores
+#if ENABLE_WPP_PARALLELISM
+  Int                     m_numDecStacks;
+#endif
+  ThreadPool              m_threadPool;                   ///< workers shared by the concurrently decoded CTU lines
 public:
   DecLib();
   virtual ~DecLib();
@@ -124,6 +145,7 @@ public:
   Void  destroy ();
 
   Void  setDecodedPictureHashSEIEnabled(Int enabled) { m_decodedPictureHashSEIEnabled=enabled; }
+  Void  setNumThreads   ( Int numThreads )  { m_numThreads = numThreads; }
 
   Void  init();
   Bool  decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay);
@@ -44,11 +44,59 @@
 //! \ingroup DecoderLib
 //! \{
 
+#if ENABLE_WPP_PARALLELISM && HEVC_TILES_WPP
+// adds the units parsed into a CTU level structure to the picture level structure, keeping their parsing order
+static Void addCtuUnits( CodingStructure& cs, const CodingStructure& ctuCS, const UnitArea& ctuArea )
+{
+  for( const auto &pcu : ctuCS.cus )
+  {
+    CodingUnit &cu = cs.addCU( *pcu, pcu->chType );
+
+    cu = *pcu;
+  }
+
+  for( const auto &ppu : ctuCS.pus )
+  {
+    PredictionUnit &pu = cs.addPU( *ppu, ppu->chType );
+
+    pu = *ppu;
+  }
+
+  for( const auto &ptu : ctuCS.tus )
+  {
+    TransformUnit &tu = cs.addTU( *ptu, ptu->chType );
+
+    tu = *ptu;
+  }
+
+  if( !cs.slice->isIntra() )
+  {
+    const UnitArea clippedArea = clipArea( ctuArea, *cs.picture );
+
+    cs.getMotionBuf( clippedArea ).copyFrom( ctuCS.getMotionBuf( clippedArea ) );
+  }
+}
+
+#endif
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
 DecSlice::DecSlice()
+  : m_pcLoopFilter         ( nullptr )
+  , m_pcSAO                ( nullptr )
+  , m_numReconstructedLines( 0 )
+  , m_numDeblockedLines    ( 0 )
+  , m_numSaoLines          ( 0 )
+#if ENABLE_WPP_PARALLELISM
+  , m_numDecStacks( 1 )
+  , m_threadPool  ( nullptr )
+  , m_ctuUnitCache( nullptr )
+  , m_parsedCtuTsAddr( 0 )
+  , m_parsingFinished( false )
+  , m_loopFilterBusy ( false )
+#endif
 {
 }
 
@@ -62,12 +110,44 @@ Void DecSlice::create()
 
 Void DecSlice::destroy()
 {
+#if ENABLE_WPP_PARALLELISM
+  for( auto &ctuCS : m_ctuCS )
+  {
+    if( ctuCS )
+    {
+      ctuCS->destroy();
+      delete ctuCS;
+      ctuCS = nullptr;
+    }
+  }
+  m_ctuCS.clear();
+
+  delete[] m_ctuUnitCache;
+  m_ctuUnitCache = nullptr;
+#endif
 }
 
-Void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder )
+#if ENABLE_WPP_PARALLELISM
+Void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder, LoopFilter* loopFilter, SampleAdaptiveOffset* sao, Int numDecStacks, ThreadPool* threadPool )
+#else
+Void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder, LoopFilter* loopFilter, SampleAdaptiveOffset* sao )
+#endif
 {
   m_CABACDecoder    = cabacDecoder;
   m_pcCuDecoder     = pcCuDecoder;
+  m_pcLoopFilter    = loopFilter;
+  m_pcSAO           = sao;
+#if ENABLE_WPP_PARALLELISM
+  m_numDecStacks    = numDecStacks;
+  m_threadPool      = threadPool;
+
+  if( m_numDecStacks > 1 )
+  {
+    // the CTU level structures are created with the first slice decoded in CTU line tasks, the CTU size is not known yet
+    m_ctuUnitCache  = new XUCache[m_numDecStacks];
+    m_ctuCS.resize( m_numDecStacks, nullptr );
+  }
+#endif
 }
 
 Void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream )
@@ -105,6 +185,21 @@ Void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream )
     ppcSubstreams[idx] = bitstream->extractSubstream( idx+1 < numSubstreams ? ( slice->getSubstreamSize(idx) << 3 ) : bitstream->getNumBitsLeft() );
   }
 
+#if ENABLE_WPP_PARALLELISM && HEVC_TILES_WPP
+  if( xUseSubstreamTasks( slice, numSubstreams ) )
+  {
+    xDecompressSubstreams( slice, ppcSubstreams );
+
+    for( auto substr: ppcSubstreams )
+    {
+      delete substr;
+    }
+    slice->stopProcessingTimer();
+    return;
+  }
+
+#endif
+
 #if HEVC_DEPENDENT_SLICES
   const int       startCtuTsAddr          = slice->getSliceSegmentCurStartCtuTsAddr();
 #else
@@ -165,117 +260,626 @@ Void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream )
       }
     }
   }
+#endif
+#if ENABLE_WPP_PARALLELISM
+#if HEVC_TILES_WPP
+  // the CTUs of the following tiles in the tile row may lie above the first CTU of the slice segment
+  const unsigned  startLine               = tileMap.tiles[ tileMap.getTileIdxMap( startCtuRsAddr ) ].getFirstCtuRsAddr() / widthInCtus;
+#else
+  const unsigned  startLine               = startCtuTsAddr / widthInCtus;
+#endif
+  // the calling thread parses, the remaining CU decoders reconstruct the CTU lines
+  const int       numLineTasks            = m_numDecStacks > 1 ? std::min<int>( m_numDecStacks - 1, cs.pcv->heightInCtus - startLine ) : 0;
+
 #endif
   // for every CTU in the slice segment...
-  bool isLastCtuOfSliceSegment = false;
-  for( unsigned ctuTsAddr = startCtuTsAddr; !isLastCtuOfSliceSegment && ctuTsAddr < numCtusInFrame; ctuTsAddr++ )
+  auto decodeCtus = [&]()
   {
+    bool isLastCtuOfSliceSegment = false;
+    for( unsigned ctuTsAddr = startCtuTsAddr; !isLastCtuOfSliceSegment && ctuTsAddr < numCtusInFrame; ctuTsAddr++ )
+    {
 #if HEVC_TILES_WPP
-    const unsigned  ctuRsAddr             = tileMap.getCtuTsToRsAddrMap(ctuTsAddr);
-    const Tile&     currentTile           = tileMap.tiles[ tileMap.getTileIdxMap(ctuRsAddr) ];
-    const unsigned  firstCtuRsAddrOfTile  = currentTile.getFirstCtuRsAddr();
-    const unsigned  tileXPosInCtus        = firstCtuRsAddrOfTile % widthInCtus;
-    const unsigned  tileYPosInCtus        = firstCtuRsAddrOfTile / widthInCtus;
+      const unsigned  ctuRsAddr             = tileMap.getCtuTsToRsAddrMap(ctuTsAddr);
+      const Tile&     currentTile           = tileMap.tiles[ tileMap.getTileIdxMap(ctuRsAddr) ];
+      const unsigned  firstCtuRsAddrOfTile  = currentTile.getFirstCtuRsAddr();
+      const unsigned  tileXPosInCtus        = firstCtuRsAddrOfTile % widthInCtus;
+      const unsigned  tileYPosInCtus        = firstCtuRsAddrOfTile / widthInCtus;
 #else
-    const unsigned  ctuRsAddr             = ctuTsAddr;
+      const unsigned  ctuRsAddr             = ctuTsAddr;
 #endif
-    const unsigned  ctuXPosInCtus         = ctuRsAddr % widthInCtus;
-    const unsigned  ctuYPosInCtus         = ctuRsAddr / widthInCtus;
+      const unsigned  ctuXPosInCtus         = ctuRsAddr % widthInCtus;
+      const unsigned  ctuYPosInCtus         = ctuRsAddr / widthInCtus;
 #if HEVC_TILES_WPP
-    const unsigned  subStrmId             = tileMap.getSubstreamForCtuAddr( ctuRsAddr, true, slice ) - subStreamOffset;
+      const unsigned  subStrmId             = tileMap.getSubstreamForCtuAddr( ctuRsAddr, true, slice ) - subStreamOffset;
 #else
-    const unsigned  subStrmId             = 0;
+      const unsigned  subStrmId             = 0;
 #endif
-    const unsigned  maxCUSize             = sps->getMaxCUWidth();
-    Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize) ;
-    UnitArea ctuArea(cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+      const unsigned  maxCUSize             = sps->getMaxCUWidth();
+      Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize) ;
+      UnitArea ctuArea(cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
 
-    DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
+      DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
 
-    cabacReader.initBitstream( ppcSubstreams[subStrmId] );
+      cabacReader.initBitstream( ppcSubstreams[subStrmId] );
 
 #if HEVC_TILES_WPP
-    // set up CABAC contexts' state for this CTU
-    if( ctuRsAddr == firstCtuRsAddrOfTile )
-    {
-      if( ctuTsAddr != startCtuTsAddr ) // if it is the first CTU, then the entropy coder has already been reset
+      // set up CABAC contexts' state for this CTU
+      if( ctuRsAddr == firstCtuRsAddrOfTile )
       {
-        cabacReader.initCtxModels( *slice );
+        if( ctuTsAddr != startCtuTsAddr ) // if it is the first CTU, then the entropy coder has already been reset
+        {
+          cabacReader.initCtxModels( *slice );
+        }
+        pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
       }
-      pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
-    }
-    else if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
-    {
-      // Synchronize cabac probabilities with upper-right CTU if it's available and at the start of a line.
-      if( ctuTsAddr != startCtuTsAddr ) // if it is the first CTU, then the entropy coder has already been reset
+      else if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
       {
-        cabacReader.initCtxModels( *slice );
+        // Synchronize cabac probabilities with upper-right CTU if it's available and at the start of a line.
+        if( ctuTsAddr != startCtuTsAddr ) // if it is the first CTU, then the entropy coder has already been reset
+        {
+          cabacReader.initCtxModels( *slice );
+        }
+        if( cs.getCURestricted( pos.offset(maxCUSize, -1), slice->getIndependentSliceIdx(), tileMap.getTileIdxMap( pos ), CH_L ) )
+        {
+          // Top-right is available, so use it.
+          cabacReader.getCtx() = m_entropyCodingSyncContextState;
+        }
+        pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
       }
-      if( cs.getCURestricted( pos.offset(maxCUSize, -1), slice->getIndependentSliceIdx(), tileMap.getTileIdxMap( pos ), CH_L ) )
+#endif
+
+
+      isLastCtuOfSliceSegment = cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+
+#if ENABLE_WPP_PARALLELISM
+      if( numLineTasks > 0 )
       {
-        // Top-right is available, so use it.
-        cabacReader.getCtx() = m_entropyCodingSyncContextState;
+        // reconstructed by the line tasks
+        xPublishParsedCtus( ctuTsAddr + 1, false );
       }
-      pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
-    }
+      else
 #endif
+      {
+        m_pcCuDecoder->decompressCtu( cs, ctuArea );
+        xCtuReconstructed( cs, ctuYPosInCtus );
+      }
 
+#if HEVC_TILES_WPP
+      if( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled )
+      {
+        m_entropyCodingSyncContextState = cabacReader.getCtx();
+      }
+#endif
 
-    isLastCtuOfSliceSegment = cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
-
-    m_pcCuDecoder->decompressCtu( cs, ctuArea );
 
+      if( isLastCtuOfSliceSegment )
+      {
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+        cabacReader.remaining_bytes( false );
+#endif
+#if HEVC_DEPENDENT_SLICES
+        if( !slice->getDependentSliceSegmentFlag() )
+        {
+#endif
+          slice->setSliceCurEndCtuTsAddr( ctuTsAddr+1 );
+#if HEVC_DEPENDENT_SLICES
+        }
+        slice->setSliceSegmentCurEndCtuTsAddr( ctuTsAddr+1 );
+#endif
+      }
 #if HEVC_TILES_WPP
-    if( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled )
+      else if( ( ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus () ) &&
+               ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled ) )
+      {
+        // The sub-stream/stream should be terminated after this CTU.
+        // (end of slice-segment, end of tile, end of wavefront-CTU-row)
+        unsigned binVal = cabacReader.terminating_bit();
+        CHECK( !binVal, "Expecting a terminating bit" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+        cabacReader.remaining_bytes( true );
+#endif
+      }
+#endif
+    }
+    CHECK( !isLastCtuOfSliceSegment, "Last CTU of slice segment not signalled as such" );
+
+#if HEVC_DEPENDENT_SLICES
+    if( depSliceSegmentsEnabled )
     {
-      m_entropyCodingSyncContextState = cabacReader.getCtx();
+      m_lastSliceSegmentEndContextState = cabacReader.getCtx();  //ctx end of dep.slice
     }
 #endif
+  };
+
+#if ENABLE_WPP_PARALLELISM
+  if( numLineTasks > 0 )
+  {
+    // the line tasks reconstruct the units added to the picture level structure while parsing goes on
+    cs.allocateVectorsAtPicLevel();
 
+    m_parsedCtuTsAddr = startCtuTsAddr;
+    m_parsingFinished = false;
+    pic->scheduler.init( cs.pcv->heightInCtus, widthInCtus, numLineTasks, 0, 1 );
 
-    if( isLastCtuOfSliceSegment )
+    // task 0 parses the slice segment in the calling thread, line task t reconstructs the CTU lines t, t + numLineTasks, ...
+    m_threadPool->run( numLineTasks + 1, [&]( int tId )
     {
-#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
-      cabacReader.remaining_bytes( false );
+      if( tId > 0 )
+      {
+        xReconstructCtuLines( slice, startLine, tId - 1, numLineTasks );
+        return;
+      }
+
+      try
+      {
+        decodeCtus();
+      }
+      catch( ... )
+      {
+        xPublishParsedCtus( m_parsedCtuTsAddr, true );
+        throw;
+      }
+      xPublishParsedCtus( m_parsedCtuTsAddr, true );
+    } );
+  }
+  else
 #endif
-#if HEVC_DEPENDENT_SLICES
-      if( !slice->getDependentSliceSegmentFlag() )
+  decodeCtus();
+
+  // deallocate all created substreams, including internal buffers.
+  for( auto substr: ppcSubstreams )
+  {
+    delete substr;
+  }
+  slice->stopProcessingTimer();
+}
+
+Void DecSlice::finishLoopFilters( CodingStructure& cs )
+{
+  xFilterCtuLines( cs, true );
+}
+
+Void DecSlice::initLoopFilters( const CodingStructure& cs )
+{
+  m_numReconstructedCtus.assign( cs.pcv->heightInCtus, 0 );
+  m_numReconstructedLines = 0;
+  m_numDeblockedLines     = 0;
+  m_numSaoLines           = 0;
+#if ENABLE_WPP_PARALLELISM
+  m_loopFilterBusy        = false;
+#endif
+}
+
+Void DecSlice::xCtuReconstructed( CodingStructure& cs, const unsigned ctuYPosInCtus )
+{
+  {
+#if ENABLE_WPP_PARALLELISM
+    std::lock_guard<std::mutex> lock( m_loopFilterMutex );
+
+#endif
+    const unsigned heightInCtus = cs.pcv->heightInCtus;
+    const unsigned widthInCtus  = cs.pcv->widthInCtus;
+
+    if( ++m_numReconstructedCtus[ctuYPosInCtus] < widthInCtus || ctuYPosInCtus != m_numReconstructedLines )
+    {
+      return;
+    }
+
+    // with tiles or line tasks the lines are not completed top to bottom
+    while( m_numReconstructedLines < heightInCtus && m_numReconstructedCtus[m_numReconstructedLines] == widthInCtus )
+    {
+      m_numReconstructedLines++;
+    }
+  }
+
+  xFilterCtuLines( cs, false );
+}
+
+// deblocking a CTU line modifies the line above and the intra prediction of the line below reads its unfiltered samples,
+// SAO of a CTU line reads the deblocked samples around it, so a line is deblocked once the line below is reconstructed
+// and SAO filtered once the line below is deblocked, which gives the same result as filtering the whole picture
+Void DecSlice::xFilterCtuLines( CodingStructure& cs, const Bool finishPicture )
+{
+  const unsigned heightInCtus = cs.pcv->heightInCtus;
+  const Bool     useSAO       = cs.sps->getUseSAO();
+
+  while( true )
+  {
+    Bool     filterSao = false;
+    unsigned ctuYPos;
+
+    {
+#if ENABLE_WPP_PARALLELISM
+      std::lock_guard<std::mutex> lock( m_loopFilterMutex );
+
+      // the task filtering a line picks up the lines completed in the meantime
+      if( m_loopFilterBusy )
       {
+        CHECK( finishPicture, "Filtering CTU lines while finishing the picture" );
+        return;
+      }
+
 #endif
-        slice->setSliceCurEndCtuTsAddr( ctuTsAddr+1 );
-#if HEVC_DEPENDENT_SLICES
+      const unsigned numReconstructedLines = finishPicture ? heightInCtus : m_numReconstructedLines;
+
+      if( useSAO && m_numSaoLines < heightInCtus && std::min( m_numSaoLines + 2, heightInCtus ) <= m_numDeblockedLines )
+      {
+        filterSao = true;
+        ctuYPos   = m_numSaoLines;
+      }
+      else if( m_numDeblockedLines < heightInCtus && std::min( m_numDeblockedLines + 2, heightInCtus ) <= numReconstructedLines )
+      {
+        ctuYPos   = m_numDeblockedLines;
       }
-      slice->setSliceSegmentCurEndCtuTsAddr( ctuTsAddr+1 );
+      else
+      {
+        return;
+      }
+#if ENABLE_WPP_PARALLELISM
+      m_loopFilterBusy = true;
 #endif
     }
-#if HEVC_TILES_WPP
-    else if( ( ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus () ) &&
-             ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled ) )
+
     {
-      // The sub-stream/stream should be terminated after this CTU.
-      // (end of slice-segment, end of tile, end of wavefront-CTU-row)
-      unsigned binVal = cabacReader.terminating_bit();
-      CHECK( !binVal, "Expecting a terminating bit" );
-#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
-      cabacReader.remaining_bytes( true );
+#if ENABLE_WPP_PARALLELISM
+      // the substream tasks add their units to the picture level structure, while the filters traverse it: the traversal
+      // of the line follows the links into the units added after it and the neighbour look-ups are spread over the whole
+      // line, so the lock is held for the line. The substream tasks only take it to add a parsed CTU and to reconstruct
+      // their last CTU, the reconstruction of the other CTUs goes on meanwhile. The serial parser of the line tasks does
+      // not take it, as a line is filtered only after the parser has passed the line below.
+      std::lock_guard<std::mutex> lock( m_picLevelMutex );
+
 #endif
+      if( filterSao )
+      {
+        m_pcSAO->SAOProcessCtuLine( cs, cs.picture->getSAO(), ctuYPos );
+      }
+      else
+      {
+        m_pcLoopFilter->loopFilterCtuLine( cs, ctuYPos );
+      }
     }
+
+    {
+#if ENABLE_WPP_PARALLELISM
+      std::lock_guard<std::mutex> lock( m_loopFilterMutex );
+
+      m_loopFilterBusy = false;
 #endif
+      if( filterSao )
+      {
+        m_numSaoLines++;
+      }
+      else
+      {
+        m_numDeblockedLines++;
+      }
+    }
+  }
+}
+
+#if ENABLE_WPP_PARALLELISM
+Void DecSlice::xPublishParsedCtus( const unsigned parsedCtuTsAddr, const Bool parsingFinished )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_parseMutex );
+
+    m_parsedCtuTsAddr = parsedCtuTsAddr;
+    m_parsingFinished = parsingFinished;
   }
-  CHECK( !isLastCtuOfSliceSegment, "Last CTU of slice segment not signalled as such" );
+  m_ctuParsed.notify_all();
+}
+
+Bool DecSlice::xWaitForParsedCtu( const unsigned ctuTsAddr, const unsigned lastTouchedCtuTsAddr )
+{
+  std::unique_lock<std::mutex> lock( m_parseMutex );
+
+  m_ctuParsed.wait( lock, [&]() { return m_parsedCtuTsAddr > lastTouchedCtuTsAddr || m_parsingFinished; } );
+
+  return m_parsedCtuTsAddr > ctuTsAddr;
+}
+
+Void DecSlice::xReconstructCtuLines( Slice* slice, const unsigned startLine, const int tId, const int numLineTasks )
+{
+  Picture*             pic          = slice->getPic();
+#if HEVC_TILES_WPP
+  const TileMap&       tileMap      = *pic->tileMap;
+#endif
+  CodingStructure&     cs           = *pic->cs;
+  const PreCalcValues& pcv          = *cs.pcv;
+  DecCu&               cuDecoder    = m_pcCuDecoder[tId];
 
 #if HEVC_DEPENDENT_SLICES
-  if( depSliceSegmentsEnabled )
+  const unsigned  startCtuTsAddr    = slice->getSliceSegmentCurStartCtuTsAddr();
+#else
+  const unsigned  startCtuTsAddr    = slice->getSliceCurStartCtuTsAddr();
+#endif
+  const unsigned  widthInCtus       = pcv.widthInCtus;
+  const unsigned  maxCUSize         = pcv.maxCUWidth;
+
+  unsigned ctuYPosInCtus = startLine + tId;
+
+  try
   {
-    m_lastSliceSegmentEndContextState = cabacReader.getCtx();  //ctx end of dep.slice
+    for( ; ctuYPosInCtus < pcv.heightInCtus; ctuYPosInCtus += numLineTasks )
+    {
+      for( unsigned ctuXPosInCtus = 0; ctuXPosInCtus < widthInCtus; ctuXPosInCtus++ )
+      {
+        const unsigned ctuRsAddr = ctuYPosInCtus * widthInCtus + ctuXPosInCtus;
+#if HEVC_TILES_WPP
+        const unsigned ctuTsAddr = tileMap.getCtuRsToTsAddrMap( ctuRsAddr );
+#else
+        const unsigned ctuTsAddr = ctuRsAddr;
+#endif
+
+        // the CTU is traversed up to the first unit of the following CTU and its PUs look up below left neighbours in the
+        // CTUs below, the parser must be done with all of them, otherwise the units are read while they are being added
+        unsigned lastTouchedCtuTsAddr = ctuTsAddr + 1;
+
+        if( ctuYPosInCtus + 1 < pcv.heightInCtus )
+        {
+#if HEVC_TILES_WPP
+          lastTouchedCtuTsAddr = std::max( lastTouchedCtuTsAddr, tileMap.getCtuRsToTsAddrMap( ctuRsAddr + widthInCtus ) );
+          if( ctuXPosInCtus > 0 )
+          {
+            lastTouchedCtuTsAddr = std::max( lastTouchedCtuTsAddr, tileMap.getCtuRsToTsAddrMap( ctuRsAddr + widthInCtus - 1 ) );
+          }
+#else
+          lastTouchedCtuTsAddr = ctuRsAddr + widthInCtus;
+#endif
+        }
+
+        // CTUs of other slice segments are passed over, but still mark the progress of the line
+        if( ctuTsAddr >= startCtuTsAddr && xWaitForParsedCtu( ctuTsAddr, lastTouchedCtuTsAddr ) )
+        {
+          if( ctuYPosInCtus > startLine )
+          {
+            pic->scheduler.wait( ctuXPosInCtus, ctuYPosInCtus );
+          }
+
+          const UnitArea ctuArea( cs.area.chromaFormat, Area( ctuXPosInCtus * maxCUSize, ctuYPosInCtus * maxCUSize, maxCUSize, maxCUSize ) );
+
+          cuDecoder.decompressCtu( cs, ctuArea );
+          xCtuReconstructed( cs, ctuYPosInCtus );
+        }
+
+        pic->scheduler.setReady( ctuXPosInCtus, ctuYPosInCtus );
+      }
+    }
+  }
+  catch( ... )
+  {
+    // release the lines waiting for this task
+    for( ; ctuYPosInCtus < pcv.heightInCtus; ctuYPosInCtus += numLineTasks )
+    {
+      pic->scheduler.setReady( widthInCtus - 1, ctuYPosInCtus );
+    }
+    throw;
   }
+}
+
+#if HEVC_TILES_WPP
+Bool DecSlice::xUseSubstreamTasks( const Slice* slice, const unsigned numSubstreams ) const
+{
+  const PPS& pps        = *slice->getPPS();
+  const bool multiTiles = pps.getNumTileColumnsMinus1() > 0 || pps.getNumTileRowsMinus1() > 0;
+
+  // the substreams are either the CTU lines of a single tile or whole tiles, dependent slice segments and chroma QP
+  // adjustments carry state from one substream to the next and are decoded serially, the chroma tree of a dual tree
+  // slice looks up its luma units in the picture level structure, which are not in place while the CTU is parsed
+  return m_numDecStacks > 1 && numSubstreams > 1
+      && ( pps.getEntropyCodingSyncEnabledFlag() ? !multiTiles && pps.pcv->widthInCtus > 1 : multiTiles )
+#if HEVC_DEPENDENT_SLICES
+      && !pps.getDependentSliceSegmentsEnabledFlag()
 #endif
-  // deallocate all created substreams, including internal buffers.
-  for( auto substr: ppcSubstreams )
+      && !slice->getUseChromaQpAdj()
+      && ( !slice->isIntra() || pps.pcv->ISingleTree );
+}
+
+Void DecSlice::xDecompressSubstreams( Slice* slice, std::vector<InputBitstream*>& substreams )
+{
+  Picture*             pic          = slice->getPic();
+  const TileMap&       tileMap      = *pic->tileMap;
+  CodingStructure&     cs           = *pic->cs;
+  const PreCalcValues& pcv          = *cs.pcv;
+
+#if HEVC_DEPENDENT_SLICES
+  const unsigned  startCtuTsAddr    = slice->getSliceSegmentCurStartCtuTsAddr();
+#else
+  const unsigned  startCtuTsAddr    = slice->getSliceCurStartCtuTsAddr();
+#endif
+  const unsigned  startCtuRsAddr    = tileMap.getCtuTsToRsAddrMap( startCtuTsAddr );
+  const unsigned  widthInCtus       = pcv.widthInCtus;
+  const unsigned  maxCUSize         = pcv.maxCUWidth;
+  const unsigned  startLine         = startCtuRsAddr / widthInCtus;
+  const unsigned  startTileIdx      = tileMap.getTileIdxMap( startCtuRsAddr );
+  const unsigned  sliceIdx          = slice->getIndependentSliceIdx();
+  const int       sliceQp           = slice->getSliceQp();
+  const bool      wavefronts        = slice->getPPS()->getEntropyCodingSyncEnabledFlag();
+  const int       numSubstreams     = (int) substreams.size();
+  const int       numTasks          = std::min( m_numDecStacks, numSubstreams );
+
+  if( wavefronts )
   {
-    delete substr;
+    CHECK( startLine + numSubstreams > pcv.heightInCtus, "More substreams than CTU lines in the slice" );
   }
-  slice->stopProcessingTimer();
+  else
+  {
+    CHECK( startTileIdx + numSubstreams > tileMap.numTiles, "More substreams than tiles in the slice" );
+  }
+
+  for( int tId = 0; tId < numTasks; tId++ )
+  {
+    CodingStructure*& ctuCS = m_ctuCS[tId];
+
+    if( ctuCS && ( ctuCS->area.chromaFormat != pcv.chrFormat || ctuCS->area.lwidth() != pcv.maxCUWidth || ctuCS->area.lheight() != pcv.maxCUHeight ) )
+    {
+      ctuCS->destroy();
+      delete ctuCS;
+      ctuCS = nullptr;
+    }
+    if( !ctuCS )
+    {
+      ctuCS = new CodingStructure( m_ctuUnitCache[tId].cuCache, m_ctuUnitCache[tId].puCache, m_ctuUnitCache[tId].tuCache );
+      ctuCS->create( pcv.chrFormat, Area( 0, 0, pcv.maxCUWidth, pcv.maxCUHeight ), false );
+    }
+    ctuCS->chromaQpAdj = 0;
+  }
+
+  // the substreams add their CTUs to the picture level structure concurrently, make sure its unit vectors are not reallocated
+  cs.allocateVectorsAtPicLevel();
+
+  if( wavefronts )
+  {
+    m_entropyCodingSyncContextStates.resize( pcv.heightInCtus );
+    pic->scheduler.init( pcv.heightInCtus, widthInCtus, numTasks, 0, 1 );
+  }
+
+  // task t decodes the substreams t, t + numTasks, ..., with wavefronts all tasks have to run concurrently
+  m_threadPool->run( numTasks, [&]( int tId )
+  {
+    CABACReader&     cabacReader = *m_CABACDecoder[tId].getCABACReader( 0 );
+    DecCu&           cuDecoder   = m_pcCuDecoder[tId];
+    CodingStructure& ctuCS       = *m_ctuCS[tId];
+
+    int              subStrmId   = tId;
+
+    try
+    {
+      for( ; subStrmId < numSubstreams; subStrmId += numTasks )
+      {
+        // a substream is a CTU line of the tile with wavefronts, a whole tile otherwise, the tile-scan addresses of its CTUs are consecutive
+        unsigned firstCtuTsAddr, endCtuTsAddr;
+
+        if( wavefronts )
+        {
+          // with a single tile, the tile-scan address equals the raster-scan address
+          firstCtuTsAddr = subStrmId == 0 ? startCtuTsAddr : ( startLine + subStrmId ) * widthInCtus;
+          endCtuTsAddr   = ( startLine + subStrmId + 1 ) * widthInCtus;
+        }
+        else
+        {
+          const Tile& tile = tileMap.tiles[startTileIdx + subStrmId];
+
+          endCtuTsAddr   = tileMap.getCtuRsToTsAddrMap( tile.getFirstCtuRsAddr() );
+          firstCtuTsAddr = subStrmId == 0 ? startCtuTsAddr : endCtuTsAddr;
+          endCtuTsAddr  += tile.getTileWidthInCtus() * tile.getTileHeightInCtus();
+        }
+
+        int prevQP[2] = { sliceQp, sliceQp };
+
+        cabacReader.initBitstream( substreams[subStrmId] );
+        cabacReader.initCtxModels( *slice );
+
+        UnitArea prevCtuArea;
+        unsigned prevCtuXPosInCtus       = 0;
+        unsigned prevCtuYPosInCtus       = 0;
+        bool     isLastCtuOfSliceSegment = false;
+        for( unsigned ctuTsAddr = firstCtuTsAddr; !isLastCtuOfSliceSegment && ctuTsAddr < endCtuTsAddr; ctuTsAddr++ )
+        {
+          const unsigned ctuRsAddr     = tileMap.getCtuTsToRsAddrMap( ctuTsAddr );
+          const unsigned ctuXPosInCtus = ctuRsAddr % widthInCtus;
+          const unsigned ctuYPosInCtus = ctuRsAddr / widthInCtus;
+          const Position pos( ctuXPosInCtus * maxCUSize, ctuYPosInCtus * maxCUSize );
+          const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+
+          if( wavefronts )
+          {
+            // the line above belongs to the same slice and is decoded by another task
+            if( subStrmId > 0 )
+            {
+              pic->scheduler.wait( ctuXPosInCtus, ctuYPosInCtus );
+            }
+
+            // synchronize the CABAC probabilities with the upper-right CTU if it's available and at the start of a line
+            if( ctuXPosInCtus == 0 && cs.getCURestricted( pos.offset( maxCUSize, -1 ), sliceIdx, tileMap.getTileIdxMap( pos ), CH_L ) )
+            {
+              cabacReader.getCtx() = m_entropyCodingSyncContextStates[ctuYPosInCtus - 1];
+            }
+          }
+
+          // parse into the CTU level structure, the neighbouring CTUs are found in its parent, the picture level structure
+          cs.initSubStructure( ctuCS, CH_L, ctuArea, false );
+
+          isLastCtuOfSliceSegment = cabacReader.coding_tree_unit( ctuCS, ctuArea, prevQP, ctuRsAddr );
+
+          {
+            std::lock_guard<std::mutex> lock( m_picLevelMutex );
+
+            addCtuUnits( cs, ctuCS, ctuArea );
+          }
+
+          // the units of a CTU are traversed up to the first unit following them, which is in place once the next CTU has been added
+          if( ctuTsAddr != firstCtuTsAddr )
+          {
+            cuDecoder.decompressCtu( cs, prevCtuArea );
+            if( wavefronts )
+            {
+              pic->scheduler.setReady( prevCtuXPosInCtus, ctuYPosInCtus );
+            }
+            xCtuReconstructed( cs, prevCtuYPosInCtus );
+          }
+          prevCtuArea       = ctuArea;
+          prevCtuXPosInCtus = ctuXPosInCtus;
+          prevCtuYPosInCtus = ctuYPosInCtus;
+
+          if( wavefronts && ctuXPosInCtus == 1 )
+          {
+            m_entropyCodingSyncContextStates[ctuYPosInCtus] = cabacReader.getCtx();
+          }
+
+          if( isLastCtuOfSliceSegment )
+          {
+            CHECK( subStrmId + 1 != numSubstreams, "Slice segment ends before its last substream" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+            cabacReader.remaining_bytes( false );
+#endif
+            slice->setSliceCurEndCtuTsAddr( ctuTsAddr+1 );
+#if HEVC_DEPENDENT_SLICES
+            slice->setSliceSegmentCurEndCtuTsAddr( ctuTsAddr+1 );
+#endif
+          }
+          else if( ctuTsAddr + 1 == endCtuTsAddr )
+          {
+            // The sub-stream should be terminated after this CTU (end of tile, end of wavefront-CTU-row)
+            unsigned binVal = cabacReader.terminating_bit();
+            CHECK( !binVal, "Expecting a terminating bit" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+            cabacReader.remaining_bytes( true );
+#endif
+          }
+
+          if( isLastCtuOfSliceSegment || ctuTsAddr + 1 == endCtuTsAddr )
+          {
+            // no further CTU of this substream is added, keep the other substreams from adding their units while the last one is traversed
+            {
+              std::lock_guard<std::mutex> lock( m_picLevelMutex );
+
+              cuDecoder.decompressCtu( cs, ctuArea );
+            }
+            if( wavefronts )
+            {
+              pic->scheduler.setReady( ctuXPosInCtus, ctuYPosInCtus );
+            }
+            xCtuReconstructed( cs, ctuYPosInCtus );
+          }
+        }
+
+        CHECK( subStrmId + 1 == numSubstreams && !isLastCtuOfSliceSegment, "Last CTU of slice segment not signalled as such" );
+      }
+    }
+    catch( ... )
+    {
+      // release the lines waiting for this task
+      for( ; wavefronts && subStrmId < numSubstreams; subStrmId += numTasks )
+      {
+        pic->scheduler.setReady( widthInCtus - 1, startLine + subStrmId );
+      }
+      throw;
+    }
+  } );
 }
+#endif
+#endif
 
 //! \}
@@ -44,9 +44,18 @@
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/BitStream.h"
+#include "CommonLib/LoopFilter.h"
+#include "CommonLib/SampleAdaptiveOffset.h"
 #include "DecCu.h"
 #include "CABACReader.h"
 
+#if ENABLE_WPP_PARALLELISM
+#include "CommonLib/ThreadPool.h"
+
+#include <mutex>
+#include <condition_variable>
+#endif
+
 //! \ingroup DecoderLib
 //! \{
 
@@ -61,6 +70,28 @@ private:
   // access channel
   CABACDecoder*   m_CABACDecoder;
   DecCu*          m_pcCuDecoder;
+  LoopFilter*     m_pcLoopFilter;
+  SampleAdaptiveOffset* m_pcSAO;
+
+  // the CTU lines are in-loop filtered while the following lines are reconstructed
+  std::vector<unsigned> m_numReconstructedCtus;         ///< reconstructed CTUs in each CTU line of the picture
+  unsigned              m_numReconstructedLines;        ///< completely reconstructed CTU lines at the top of the picture
+  unsigned              m_numDeblockedLines;            ///< deblocked CTU lines at the top of the picture
+  unsigned              m_numSaoLines;                  ///< SAO filtered CTU lines at the top of the picture
+#if ENABLE_WPP_PARALLELISM
+  Int                           m_numDecStacks;                     ///< number of CABAC decoders and CU decoders, one per concurrently decoded CTU line or tile
+  ThreadPool*                   m_threadPool;
+  XUCache*                      m_ctuUnitCache;                     ///< units of the CTU level coding structures
+  std::vector<CodingStructure*> m_ctuCS;                            ///< CTU level coding structures the concurrently decoded substreams parse into
+  std::vector<Ctx>              m_entropyCodingSyncContextStates;   ///< contexts at the second CTU of each CTU line, for the concurrently decoded lines
+  std::mutex                    m_picLevelMutex;                    ///< serializes adding the parsed CTUs to the picture level structure and filtering the CTU lines
+  std::mutex                    m_parseMutex;
+  std::condition_variable       m_ctuParsed;                        ///< signalled when the parsing of a slice segment advanced
+  unsigned                      m_parsedCtuTsAddr;                  ///< tile-scan address of the first CTU not parsed yet
+  Bool                          m_parsingFinished;
+  std::mutex                    m_loopFilterMutex;
+  Bool                          m_loopFilterBusy;                   ///< one of the tasks is filtering a CTU line
+#endif
 
 #if HEVC_DEPENDENT_SLICES
   Ctx             m_lastSliceSegmentEndContextState;    ///< context storage for state at the end of the previous slice-segment (used for dependent slices only).
@@ -73,11 +104,31 @@ public:
   DecSlice();
   virtual ~DecSlice();
 
-  Void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder );
+#if ENABLE_WPP_PARALLELISM
+  Void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder, LoopFilter* loopFilter, SampleAdaptiveOffset* sao, Int numDecStacks, ThreadPool* threadPool );
+#else
+  Void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder, LoopFilter* loopFilter, SampleAdaptiveOffset* sao );
+#endif
   Void  create            ();
   Void  destroy           ();
 
+  Void  initLoopFilters   ( const CodingStructure& cs );
   Void  decompressSlice   ( Slice* slice, InputBitstream* bitstream );
+  Void  finishLoopFilters ( CodingStructure& cs );
+
+private:
+  Void  xCtuReconstructed    ( CodingStructure& cs, const unsigned ctuYPosInCtus );
+  Void  xFilterCtuLines      ( CodingStructure& cs, const Bool finishPicture );
+
+#if ENABLE_WPP_PARALLELISM
+  Void  xPublishParsedCtus   ( const unsigned parsedCtuTsAddr, const Bool parsingFinished );
+  Bool  xWaitForParsedCtu    ( const unsigned ctuTsAddr, const unsigned lastTouchedCtuTsAddr );
+  Void  xReconstructCtuLines ( Slice* slice, const unsigned startLine, const int tId, const int numLineTasks );
+#if HEVC_TILES_WPP
+  Bool  xUseSubstreamTasks   ( const Slice* slice, const unsigned numSubstreams ) const;
+  Void  xDecompressSubstreams( Slice* slice, std::vector<InputBitstream*>& substreams );
+#endif
+#endif
 };
 
 //! \}
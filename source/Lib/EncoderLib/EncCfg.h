@@ -186,6 +186,8 @@ protected:
 #if SEPARABLE_KLT
   int       m_IntraKLT;
   int       m_InterKLT;
+  std::string m_kltMatrixFileName;
+  bool      m_useFastIntraKLT;
 #endif
 
   bool      m_LargeCTU;
@@ -275,6 +277,7 @@ protected:
 #if T0196_SELECTIVE_RDOQ
   Bool      m_useSelectiveRDOQ;
 #endif
+  Bool      m_useRDOQSkipZeroCG;
   UInt      m_rdPenalty;
   FastInterSearchMode m_fastInterSearchMode;
   Bool      m_bUseEarlyCU;
@@ -479,6 +482,8 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  UInt        m_residualCapture;                              ///< residual capture for transform training, 1: intra, 2: inter
+  std::string m_residualCaptureFileName;                      ///< output file of the residual capture
   std::string m_decodeBitstreams[2];                          ///< filename for decode bitstreams.
   bool        m_forceDecodeBitstream1;                        ///< guess what it means
   int         m_switchPOC;                                    ///< dbg poc.
@@ -488,7 +493,7 @@ protected:
   bool        m_bs2ModPOCAndType;
 
 
-
+  int         m_numThreads;                                   ///< total number of threads of the encoder, 0: derived from the parallelism settings
 #if ENABLE_SPLIT_PARALLELISM
   int         m_numSplitThreads;
   bool        m_forceSingleSplitThread;
@@ -498,6 +503,12 @@ protected:
   int         m_numWppExtraLines;
   bool        m_ensureWppBitEqual;
 #endif
+#if ENABLE_KLT_PARALLELISM
+  int         m_numKltThreads;
+#endif
+#if ENABLE_FRAME_PARALLELISM
+  int         m_numFrameThreads;                              ///< max. number of independent pictures of a GOP compressed concurrently
+#endif
 
 public:
   EncCfg()
@@ -581,6 +592,10 @@ public:
   bool      getIntraKLT                     ()         const { return m_IntraKLT; }
   void      setInterKLT                     ( bool b )       { m_InterKLT = b; }
   bool      getInterKLT                     ()         const { return m_InterKLT; }
+  void      setKLTMatrixFileName            ( const std::string &s ) { m_kltMatrixFileName = s; }
+  const std::string& getKLTMatrixFileName   ()         const { return m_kltMatrixFileName; }
+  void      setUseFastIntraKLT              ( bool b )       { m_useFastIntraKLT = b; }
+  bool      getUseFastIntraKLT              ()         const { return m_useFastIntraKLT; }
 #endif
 
   void      setLargeCTU                     ( bool b )       { m_LargeCTU = b; }
@@ -784,6 +799,7 @@ public:
 #if T0196_SELECTIVE_RDOQ
   Void      setUseSelectiveRDOQ             ( Bool b )      { m_useSelectiveRDOQ = b; }
 #endif
+  Void      setUseRDOQSkipZeroCG            ( Bool  b )     { m_useRDOQSkipZeroCG = b; }
   Void      setRDpenalty                    ( UInt  u )     { m_rdPenalty  = u; }
   Void      setFastInterSearchMode          ( FastInterSearchMode m ) { m_fastInterSearchMode = m; }
   Void      setUseEarlyCU                   ( Bool  b )     { m_bUseEarlyCU = b; }
@@ -812,6 +828,7 @@ public:
 #if T0196_SELECTIVE_RDOQ
   Bool      getUseSelectiveRDOQ             ()      { return m_useSelectiveRDOQ; }
 #endif
+  Bool      getUseRDOQSkipZeroCG            ()      { return m_useRDOQSkipZeroCG; }
   Int       getRDpenalty                    ()      { return m_rdPenalty;  }
   FastInterSearchMode getFastInterSearchMode() const{ return m_fastInterSearchMode;  }
   Bool      getUseEarlyCU                   () const{ return m_bUseEarlyCU; }
@@ -1219,6 +1236,10 @@ public:
 
   Void         setSummaryVerboseness(UInt v)                         { m_summaryVerboseness = v; }
   UInt         getSummaryVerboseness( ) const                        { return m_summaryVerboseness; }
+  Void         setResidualCapture(UInt u)                            { m_residualCapture = u; }
+  UInt         getResidualCapture() const                            { return m_residualCapture; }
+  Void         setResidualCaptureFileName(const std::string &s)      { m_residualCaptureFileName = s; }
+  const std::string& getResidualCaptureFileName() const              { return m_residualCaptureFileName; }
   Void         setDecodeBitstream( int i, const std::string& s )     { m_decodeBitstreams[i] = s; }
   const std::string& getDecodeBitstream( int i )               const { return m_decodeBitstreams[i]; }
   bool         getForceDecodeBitstream1()                      const { return m_forceDecodeBitstream1; }
@@ -1235,7 +1256,8 @@ public:
   Void         setBs2ModPOCAndType( bool b )                         { m_bs2ModPOCAndType = b; }
   bool         getBs2ModPOCAndType()                           const { return m_bs2ModPOCAndType; }
 
-
+  void         setNumThreads( int n )                                { m_numThreads = n; }
+  int          getNumThreads()                                 const { return m_numThreads; }
 #if ENABLE_SPLIT_PARALLELISM
   void         setNumSplitThreads( int n )                           { m_numSplitThreads = n; }
   int          getNumSplitThreads()                            const { return m_numSplitThreads; }
@@ -1250,6 +1272,14 @@ public:
   void         setEnsureWppBitEqual( bool b)                         { m_ensureWppBitEqual = b; }
   bool         getEnsureWppBitEqual()                          const { return m_ensureWppBitEqual; }
 #endif
+#if ENABLE_KLT_PARALLELISM
+  void         setNumKltThreads( int n )                             { m_numKltThreads = n; }
+  int          getNumKltThreads()                              const { return m_numKltThreads; }
+#endif
+#if ENABLE_FRAME_PARALLELISM
+  void         setNumFrameThreads( int n )                           { m_numFrameThreads = n; }
+  int          getNumFrameThreads()                            const { return m_numFrameThreads; }
+#endif
 };
 
 //! \}
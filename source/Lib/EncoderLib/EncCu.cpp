@@ -51,6 +51,9 @@
 #include <stdio.h>
 #include <cmath>
 #include <algorithm>
+#if ENABLE_SPLIT_PARALLELISM
+#include <atomic>
+#endif
 #if ENABLE_WPP_PARALLELISM
 #include <mutex>
 extern std::recursive_mutex g_cache_mutex;
@@ -77,6 +80,11 @@ void EncCu::create( EncCfg* encCfg )
   m_pTempCS = new CodingStructure**  [numWidths];
   m_pBestCS = new CodingStructure**  [numWidths];
 
+#if SEPARABLE_KLT
+  m_numIntraKltPasses        = 0;
+  m_numIntraKltPassesSkipped = 0;
+#endif
+
   for( unsigned w = 0; w < numWidths; w++ )
   {
     m_pTempCS[w] = new CodingStructure*  [numHeights];
@@ -191,7 +199,11 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int tId ) )
   m_CABACEstimator     = pcEncLib->getCABACEncoder( PARL_PARAM0( tId ) )->getCABACEstimator( &sps );
   m_CtxCache           = pcEncLib->getCtxCache( PARL_PARAM0( tId ) );
   m_pcRateCtrl         = pcEncLib->getRateCtrl();
+#if ENABLE_FRAME_PARALLELISM
+  m_pcSliceEncoder     = pcEncLib->getSliceEncoder( tId / pcEncLib->getNumPicCuEncStacks() );
+#else
   m_pcSliceEncoder     = pcEncLib->getSliceEncoder();
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   m_pcEncLib           = pcEncLib;
   m_dataId             = tId;
@@ -701,46 +713,49 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
   const int      wppTId   = picture->scheduler.getWppThreadId();
 #endif
   const bool doParallel   = !m_pcEncCfg->getForceSingleSplitThread();
-#if _MSC_VER && ENABLE_WPP_PARALLELISM
-#pragma omp parallel for schedule(dynamic,1) num_threads(NUM_SPLIT_THREADS_IF_MSVC) if(doParallel)
-#else
-  omp_set_num_threads( m_pcEncCfg->getNumSplitThreads() );
+  const int  numTasks     = doParallel ? std::min( numJobs, m_pcEncCfg->getNumSplitThreads() ) : 1;
 
-#pragma omp parallel for schedule(dynamic,1) if(doParallel)
-#endif
-  for( int jId = 1; jId <= numJobs; jId++ )
+  // split task t uses the picture buffers of split thread t and takes the next free job until all are done
+  std::atomic<int> nextJobId( 1 );
+
+  m_pcEncLib->getThreadPool()->run( numTasks, [&]( int tId )
   {
     // thread start
 #if ENABLE_WPP_PARALLELISM
     picture->scheduler.setWppThreadId( wppTId );
 #endif
-    picture->scheduler.setSplitThreadId();
-    picture->scheduler.setSplitJobId( jId );
+    picture->scheduler.setSplitThreadId( tId );
 
-    Partitioner* jobPartitioner = PartitionerFactory::get( *tempCS->slice );
-    EncCu*       jobCuEnc       = m_pcEncLib->getCuEncoder( picture->scheduler.getSplitDataId( jId ) );
-    auto*        jobBlkCache    = dynamic_cast<CacheBlkInfoCtrl*>( jobCuEnc->m_modeCtrl );
+    for( int jId = nextJobId++; jId <= numJobs; jId = nextJobId++ )
+    {
+      picture->scheduler.setSplitJobId( jId );
 
-    jobPartitioner->copyState( partitioner );
-    jobCuEnc      ->copyState( this, *jobPartitioner, currArea, true );
+      Partitioner* jobPartitioner = PartitionerFactory::get( *tempCS->slice );
+      EncCu*       jobCuEnc       = m_pcEncLib->getCuEncoder( picture->scheduler.getSplitDataId( jId ) );
+      auto*        jobBlkCache    = dynamic_cast<CacheBlkInfoCtrl*>( jobCuEnc->m_modeCtrl );
 
-    if( jobBlkCache )
-    {
-      jobBlkCache->tick();
-    }
+      jobPartitioner->copyState( partitioner );
+      jobCuEnc      ->copyState( this, *jobPartitioner, currArea, true );
 
-    CodingStructure *&jobBest = jobCuEnc->m_pBestCS[wIdx][hIdx];
-    CodingStructure *&jobTemp = jobCuEnc->m_pTempCS[wIdx][hIdx];
+      if( jobBlkCache )
+      {
+        jobBlkCache->tick();
+      }
+
+      CodingStructure *&jobBest = jobCuEnc->m_pBestCS[wIdx][hIdx];
+      CodingStructure *&jobTemp = jobCuEnc->m_pTempCS[wIdx][hIdx];
 
-    jobUsed[jId] = true;
+      jobUsed[jId] = true;
 
-    jobCuEnc->xCompressCU( jobTemp, jobBest, *jobPartitioner );
+      jobCuEnc->xCompressCU( jobTemp, jobBest, *jobPartitioner );
 
-    delete jobPartitioner;
+      delete jobPartitioner;
 
-    picture->scheduler.setSplitJobId( 0 );
+      picture->scheduler.setSplitJobId( 0 );
+    }
+    picture->scheduler.setSplitThreadId( 0 );
     // thread stop
-  }
+  } );
   picture->scheduler.setSplitThreadId( 0 );
 
   int    bestJId  = 0;
@@ -1002,12 +1017,21 @@ void EncCu::xCheckRDCostIntra( CodingStructure *&tempCS, CodingStructure *&bestC
   const SizeType height = partitioner.currArea().lheight();
   Bool isKLTSize = width <= KLT_INTRA_MAX_CU_WITH_QTBT && height <= KLT_INTRA_MAX_CU_WITH_QTBT;
   UChar considerKltSecondPass = (sps.getSpsNext().getUseIntraKLT() && isLuma(partitioner.chType) && isKLTSize) ? 1 : 0;
+  bool  skipKltSecondPass     = false;
+  double dctCost              = MAX_DOUBLE;
 
   for (UChar kltCuFlag = 0; kltCuFlag <= considerKltSecondPass; kltCuFlag++)
 #else
   for( UChar numPasses = 0; numPasses < 1; numPasses++ )
 #endif
   {
+#if SEPARABLE_KLT
+    if( kltCuFlag && skipKltSecondPass )
+    {
+      continue;
+    }
+
+#endif
     //3) if interHad is 0, only try further modes if some intra mode was already better than inter
     if( m_pcEncCfg->getUsePbIntraFast() && !tempCS->slice->isIntra() && bestCU && CU::isInter( *bestCS->getCU( partitioner.chType ) ) && interHad == 0 )
     {
@@ -1110,6 +1134,28 @@ void EncCu::xCheckRDCostIntra( CodingStructure *&tempCS, CodingStructure *&bestC
     DTRACE_MODE_COST( *tempCS, m_pcRdCost->getLambda( true ) );
 #else
     DTRACE_MODE_COST( *tempCS, m_pcRdCost->getLambda() );
+#endif
+#if SEPARABLE_KLT
+    if( considerKltSecondPass && !kltCuFlag )
+    {
+      m_numIntraKltPasses++;
+      dctCost = tempCS->cost;
+
+      if( m_pcEncCfg->getUseFastIntraKLT() && xSkipIntraKltPass( cu, *tempCS, bestCS->cost, partitioner ) )
+      {
+        skipKltSecondPass = true;
+        m_numIntraKltPassesSkipped++;
+      }
+    }
+    else if( kltCuFlag && m_pcEncCfg->getUseFastIntraKLT() )
+    {
+      CacheBlkInfoCtrl *blkCache = dynamic_cast<CacheBlkInfoCtrl*>( m_modeCtrl );
+
+      if( blkCache )
+      {
+        blkCache->countKltPass( partitioner.currArea(), tempCS->cost < dctCost );
+      }
+    }
 #endif
     xCheckBestMode( tempCS, bestCS, partitioner, encTestMode );
 
@@ -1117,6 +1163,74 @@ void EncCu::xCheckRDCostIntra( CodingStructure *&tempCS, CodingStructure *&bestC
   } //for kltCuFlag
 }
 
+#if SEPARABLE_KLT
+/** Fast decision whether the intra KLT pass of a CU can be skipped, evaluated after the DCT-II pass
+*  - the DCT-II pass did not code any luma residual, the KLT only changes the luma transform
+*  - the DCT-II pass is clearly worse than the best mode found so far
+*  - the DCT-II pass chose planar or DC with only a few luma levels, a smooth block the DCT-II already fits
+*  - neither the left nor the above CU uses the KLT and the KLT rarely won in the previous passes of the same
+*    area within other partitionings
+*/
+bool EncCu::xSkipIntraKltPass( const CodingUnit &cu, const CodingStructure &dctCS, const double bestCost, Partitioner &partitioner )
+{
+  bool   hasLumaResidual = false;
+  TCoeff lumaAbsSum      = 0;
+
+  for( const auto &tu : CU::traverseTUs( cu ) )
+  {
+    if( !TU::getCbf( tu, COMPONENT_Y ) )
+    {
+      continue;
+    }
+
+    hasLumaResidual = true;
+
+    const CCoeffBuf coeffs = tu.getCoeffs( COMPONENT_Y );
+
+    for( UInt y = 0; y < coeffs.height; y++ )
+    {
+      for( UInt x = 0; x < coeffs.width; x++ )
+      {
+        lumaAbsSum += abs( coeffs.at( x, y ) );
+      }
+    }
+  }
+
+  if( !hasLumaResidual )
+  {
+    return true;
+  }
+
+  if( bestCost != MAX_DOUBLE && dctCS.cost > KLT_FAST_COST_RATIO * bestCost )
+  {
+    return true;
+  }
+
+  const UInt lumaMode = cu.firstPU->intraDir[CHANNEL_TYPE_LUMA];
+
+  if( ( lumaMode == PLANAR_IDX || lumaMode == DC_IDX ) && lumaAbsSum * KLT_FAST_SMOOTH_SAMPLES_PER_LEVEL <= ( TCoeff ) cu.lumaSize().area() )
+  {
+    return true;
+  }
+
+  const CodingUnit *cuLeft  = dctCS.getCURestricted( cu.lumaPos().offset( -1, 0 ), cu, CHANNEL_TYPE_LUMA );
+  const CodingUnit *cuAbove = dctCS.getCURestricted( cu.lumaPos().offset( 0, -1 ), cu, CHANNEL_TYPE_LUMA );
+  const bool neighbourKlt   = ( cuLeft && cuLeft->kltFlag ) || ( cuAbove && cuAbove->kltFlag );
+
+  if( !neighbourKlt )
+  {
+    CacheBlkInfoCtrl *blkCache = dynamic_cast<CacheBlkInfoCtrl*>( m_modeCtrl );
+
+    if( blkCache && blkCache->isKltUnlikely( partitioner.currArea() ) )
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+#endif
+
 void EncCu::xCheckIntraPCM(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode )
 {
   tempCS->initStructData( encTestMode.qp, encTestMode.lossless );
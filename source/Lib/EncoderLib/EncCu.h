@@ -102,6 +102,10 @@ private:
 
   PelStorage            m_acMergeBuffer[MRG_MAX_NUM_CANDS];
 
+#if SEPARABLE_KLT
+  UInt64                m_numIntraKltPasses;          ///< intra KLT passes considered
+  UInt64                m_numIntraKltPassesSkipped;   ///< intra KLT passes skipped by the fast decision
+#endif
 
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncLib*               m_pcEncLib;
@@ -127,6 +131,10 @@ public:
   int   updateCtuDataISlice ( const CPelBuf buf );
 
   EncModeCtrl* getModeCtrl  () { return m_modeCtrl; }
+#if SEPARABLE_KLT
+  UInt64 getNumIntraKltPasses       () const { return m_numIntraKltPasses; }
+  UInt64 getNumIntraKltPassesSkipped() const { return m_numIntraKltPassesSkipped; }
+#endif
 
   ~EncCu();
 
@@ -144,6 +152,9 @@ protected:
 
   void xCheckRDCostIntra      ( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode );
   void xCheckIntraPCM         ( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode );
+#if SEPARABLE_KLT
+  bool xSkipIntraKltPass      ( const CodingUnit &cu, const CodingStructure &dctCS, const double bestCost, Partitioner &pm );
+#endif
 
   void xCheckDQP              ( CodingStructure& cs, Partitioner& partitioner, bool bKeepCtx = false);
   void xFillPCMBuffer         ( CodingUnit &cu);
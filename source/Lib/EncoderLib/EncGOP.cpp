@@ -50,6 +50,10 @@
 #include <math.h>
 #include <deque>
 #include <chrono>
+#if ENABLE_FRAME_PARALLELISM
+#include <condition_variable>
+#include <mutex>
+#endif
 
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/dtrace_codingstruct.h"
@@ -109,6 +113,9 @@ EncGOP::EncGOP()
 #endif
 
   m_bInitAMaxBT         = true;
+#if ENABLE_FRAME_PARALLELISM
+  m_numPicSetUp         = 0;
+#endif
 }
 
 EncGOP::~EncGOP()
@@ -1023,6 +1030,62 @@ Int EfficientFieldIRAPMapping::restoreGOPid(const Int GOPid)
   return GOPid;
 }
 
+#if ENABLE_FRAME_PARALLELISM
+/// orders the pictures of a GOP that are encoded concurrently: the pictures are set up one after the other in coding
+/// order, each one once the last picture it predicts from is written, compressed in parallel, and loop filtered and
+/// written in coding order
+class FrameParallelSync
+{
+  private:
+    const std::vector<Int>& m_lastRefIdx;
+    Int                     m_numSetUp;
+    Int                     m_numWritten;
+    Bool                    m_aborted;
+    std::mutex              m_mutex;
+    std::condition_variable m_cond;
+
+    template<typename TCond>
+    Void xWait( TCond cond )
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_cond.wait( lock, [&]() { return m_aborted || cond(); } );
+      if( m_aborted )
+      {
+        THROW( "another picture of the GOP failed" );
+      }
+    }
+
+    Void xStep( Int& counter )
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      counter++;
+      m_cond.notify_all();
+    }
+
+  public:
+    FrameParallelSync( const std::vector<Int>& lastRefIdx ) :
+      m_lastRefIdx   ( lastRefIdx ),
+      m_numSetUp     ( 0 ),
+      m_numWritten   ( 0 ),
+      m_aborted      ( false )
+    { }
+
+    Void startSetUp       ( const Int codingIdx ) { xWait( [&]() { return m_numSetUp == codingIdx && m_numWritten > m_lastRefIdx[codingIdx]; } ); }
+    Void finishSetUp      ()                      { xStep( m_numSetUp ); }
+    Void finishCompression( const Int codingIdx ) { xWait( [&]() { return m_numWritten == codingIdx; } ); }
+    Void finishWriting    ()                      { xStep( m_numWritten ); }
+
+    Void abort()
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_aborted = true;
+      m_cond.notify_all();
+    }
+};
+#else
+class FrameParallelSync;
+#endif
+
 
 #if X0038_LAMBDA_FROM_QP_CAPABILITY
 static UInt calculateCollocatedFromL0Flag(const Slice *pSlice)
@@ -1286,8 +1349,6 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 {
   // TODO: Split this function up.
 
-  Picture*        pcPic = NULL;
-  Slice*      pcSlice;
   OutputBitstream  *pcBitstreamRedirect;
   pcBitstreamRedirect = new OutputBitstream;
   AccessUnit::iterator  itLocationToPushSliceHeaderNALU; // used to store location where NALU containing slice header is to be inserted
@@ -1314,8 +1375,30 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
     m_pcCfg->setEncodedFlag(iGOPid, false);
   }
 
-  for ( Int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
+#if ENABLE_FRAME_PARALLELISM
+  std::vector<Int> frameGOPids;
+  std::vector<Int> frameLastRefIdx;
+  if( m_pcCfg->getNumFrameThreads() > 1 && iPOCLast != 0 )
   {
+    xGetFrameParallelOrder( iPOCLast, iNumPicRcvd, frameGOPids, frameLastRefIdx );
+  }
+
+#endif
+  // encodes the picture iGOPid, with frame parallelism as picture codingIdx of the GOP using the slice encoder picIdx
+  auto encodePicture = [&]( Int& iGOPid, const Int picIdx, const Int codingIdx, FrameParallelSync* sync )
+  {
+#if ENABLE_FRAME_PARALLELISM
+    if( sync )
+    {
+      sync->startSetUp( codingIdx );
+    }
+    EncSlice* pcSliceEncoder = m_pcEncLib->getSliceEncoder( picIdx );
+#else
+    EncSlice* pcSliceEncoder = m_pcSliceEncoder;
+#endif
+    Picture*  pcPic          = NULL;
+    Slice*    pcSlice;
+
     if (m_pcCfg->getEfficientFieldIRAPEnabled())
     {
       iGOPid=effFieldIRAPMap.adjustGOPid(iGOPid);
@@ -1354,7 +1437,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
       {
         iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
       }
-      continue;
+      return;
     }
 
     if( getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_W_RADL || getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_N_LP )
@@ -1386,6 +1469,9 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
     pcPic->scheduler.init( pcPic->cs->pcv->heightInCtus, pcPic->cs->pcv->widthInCtus, 1                          , 0                             , m_pcCfg->getNumSplitThreads() );
 #elif ENABLE_WPP_PARALLELISM
     pcPic->scheduler.init( pcPic->cs->pcv->heightInCtus, pcPic->cs->pcv->widthInCtus, m_pcCfg->getNumWppThreads(), m_pcCfg->getNumWppExtraLines(), 1                             );
+#endif
+#if ENABLE_FRAME_PARALLELISM
+    pcPic->scheduler.setFirstDataId( picIdx * m_pcEncLib->getNumPicCuEncStacks() );
 #endif
     pcPic->createTempBuffers( pcPic->cs->pps->pcv->maxCUWidth );
     pcPic->cs->createCoeffs();
@@ -1393,9 +1479,9 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
     //  Slice data initialization
     pcPic->clearSliceBuffer();
     pcPic->allocateNewSlice();
-    m_pcSliceEncoder->setSliceSegmentIdx(0);
+    pcSliceEncoder->setSliceSegmentIdx(0);
 
-    m_pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, pocCurr, iGOPid, pcSlice, isField );
+    pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, pocCurr, iGOPid, pcSlice, isField );
 
     DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "poc", pocCurr ) ) );
     DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "final", 0 ) ) );
@@ -1557,9 +1643,43 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 
     //  Set reference list
     pcSlice->setRefPicList ( rcListPic );
+#if ENABLE_FRAME_PARALLELISM
+
+    // the decisions taken from earlier pictures (CABAC table, adaptive max BT size) only use the pictures up to the last
+    // coded reference picture in coding order, which are written before this picture is set up also when the pictures
+    // are compressed concurrently, so the bitstream does not depend on the number of frame threads
+    const Picture* lastCodedRef = nullptr;
+    for( Int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+    {
+      for( Int refIdx = 0; refIdx < pcSlice->getNumRefIdx( RefPicList( refList ) ); refIdx++ )
+      {
+        const Picture* refPic = pcSlice->getRefPic( RefPicList( refList ), refIdx );
+        CHECK( sync && !refPic->reconstructed, "the picture is set up before one of its reference pictures is written" );
+
+        if( !lastCodedRef || refPic->encCodingIdx > lastCodedRef->encCodingIdx )
+        {
+          lastCodedRef = refPic;
+        }
+      }
+    }
+    pcPic->encCodingIdx = m_numPicSetUp++;
+#endif
 
     if( m_pcCfg->getUseAMaxBT() )
     {
+#if ENABLE_FRAME_PARALLELISM
+      {
+        std::lock_guard<std::mutex> lock( m_AMaxBTMutex );
+
+        while( lastCodedRef && !m_AMaxBTWritten.empty() && m_AMaxBTWritten.front().codingIdx <= lastCodedRef->encCodingIdx )
+        {
+          m_uiBlkSize[m_AMaxBTWritten.front().depth] += m_AMaxBTWritten.front().blkSize;
+          m_uiNumBlk [m_AMaxBTWritten.front().depth] += m_AMaxBTWritten.front().numBlk;
+          m_AMaxBTWritten.pop_front();
+        }
+      }
+
+#endif
       if( !pcSlice->isIntra() )
       {
         Int refLayer = pcSlice->getDepth();
@@ -1628,7 +1748,12 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
     }
     else
     {
+#if ENABLE_FRAME_PARALLELISM
+      // the table chosen for the last coded reference picture instead of the one of the previous picture in coding order
+      pcSlice->setEncCABACTableIdx( lastCodedRef ? lastCodedRef->encCABACTableIdx : pcSlice->getSliceType() );
+#else
       pcSlice->setEncCABACTableIdx( m_pcSliceEncoder->getEncCABACTableIdx() );
+#endif
     }
 
     if (pcSlice->getSliceType() == B_SLICE)
@@ -1699,7 +1824,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
     // set adaptive search range for non-intra-slices
     if (m_pcCfg->getUseASR() && pcSlice->getSliceType()!=I_SLICE)
     {
-      m_pcSliceEncoder->setSearchRange(pcSlice);
+      pcSliceEncoder->setSearchRange(pcSlice);
     }
 
     Bool bGPBcheck=false;
@@ -1789,7 +1914,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
       }
       else if ( frameLevel == 0 )   // intra case, but use the model
       {
-        m_pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
+        pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
 
         if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
         {
@@ -1845,7 +1970,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
       sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, sliceQP );
       m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
 
-      m_pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
+      pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
     }
 
     UInt uiNumSliceSegments = 1;
@@ -1881,6 +2006,12 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
     trySkipOrDecodePicture( decPic, encPic, *m_pcCfg, pcPic );
 
     pcPic->cs->slice = pcSlice; // please keep this
+#if ENABLE_FRAME_PARALLELISM
+    if( sync )
+    {
+      sync->finishSetUp();
+    }
+#endif
     if( encPic )
     // now compress (trial encode) the various slice segments (slices, and dependent slices)
     {
@@ -1893,8 +2024,8 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 
       for(UInt nextCtuTsAddr = 0; nextCtuTsAddr < numberOfCtusInFrame; )
       {
-        m_pcSliceEncoder->precompressSlice( pcPic );
-        m_pcSliceEncoder->compressSlice   ( pcPic, false, false );
+        pcSliceEncoder->precompressSlice( pcPic );
+        pcSliceEncoder->compressSlice   ( pcPic, false, false );
 
 #if HEVC_DEPENDENT_SLICES
         const UInt curSliceSegmentEnd = pcSlice->getSliceSegmentCurEndCtuTsAddr();
@@ -1905,7 +2036,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
           UInt independentSliceIdx                = pcSlice->getIndependentSliceIdx();
           pcPic->allocateNewSlice();
           // prepare for next slice
-          m_pcSliceEncoder->setSliceSegmentIdx      ( uiNumSliceSegments   );
+          pcSliceEncoder->setSliceSegmentIdx        ( uiNumSliceSegments   );
           pcSlice = pcPic->slices                   [ uiNumSliceSegments   ];
           CHECK(!(pcSlice->getPPS()!=0), "Unspecified error");
           pcSlice->copySliceInfo                    ( pcPic->slices[uiNumSliceSegments-1]  );
@@ -1934,7 +2065,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
         {
           UInt independentSliceIdx = pcSlice->getIndependentSliceIdx();
           pcPic->allocateNewSlice();
-          m_pcSliceEncoder->setSliceSegmentIdx      (uiNumSliceSegments);
+          pcSliceEncoder->setSliceSegmentIdx(uiNumSliceSegments);
           // prepare for next slice
           pcSlice = pcPic->slices[uiNumSliceSegments];
           CHECK(!(pcSlice->getPPS() != 0), "Unspecified error");
@@ -1948,7 +2079,17 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
         nextCtuTsAddr = curSliceEnd;
 #endif
       }
+    }
 
+#if ENABLE_FRAME_PARALLELISM
+    if( sync )
+    {
+      sync->finishCompression( codingIdx );
+    }
+
+#endif
+    if( encPic )
+    {
       duData.clear();
 
       CodingStructure& cs = *pcPic->cs;
@@ -2008,6 +2149,23 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 
     if( m_pcCfg->getUseAMaxBT() )
     {
+#if ENABLE_FRAME_PARALLELISM
+      AMaxBTStats stats = { pcPic->encCodingIdx, ( Int ) pcSlice->getDepth(), 0, 0 };
+      for( const CodingUnit *cu : pcPic->cs->cus )
+      {
+        if( !pcSlice->isIntra() )
+        {
+          stats.blkSize += cu->Y().area();
+          stats.numBlk++;
+        }
+      }
+
+      if( stats.numBlk )
+      {
+        std::lock_guard<std::mutex> lock( m_AMaxBTMutex );
+        m_AMaxBTWritten.push_back( stats );
+      }
+#else
       for( const CodingUnit *cu : pcPic->cs->cus )
       {
         if( !pcSlice->isIntra() )
@@ -2016,6 +2174,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
           m_uiNumBlk [pcSlice->getDepth()]++;
         }
       }
+#endif
     }
 
     if( encPic || decPic )
@@ -2060,7 +2219,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
         {
           pcSlice->checkColRefIdx(sliceSegmentIdxCount, pcPic);
         }
-        m_pcSliceEncoder->setSliceSegmentIdx(sliceSegmentIdxCount);
+        pcSliceEncoder->setSliceSegmentIdx(sliceSegmentIdxCount);
 
         pcSlice->setRPS   (pcPic->slices[0]->getRPS());
         pcSlice->setRPSidx(pcPic->slices[0]->getRPSidx());
@@ -2101,8 +2260,11 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
         pcSlice->clearSubstreamSizes(  );
         {
           UInt numBinsCoded = 0;
-          m_pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
+          pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
           binCountsInNalUnits+=numBinsCoded;
+#if ENABLE_FRAME_PARALLELISM
+          pcPic->encCABACTableIdx = pcSliceEncoder->getEncCABACTableIdx();
+#endif
         }
         {
           // Construct the final bitstream by concatenating substreams.
@@ -2262,6 +2424,47 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
     pcPic->destroyTempBuffers();
     pcPic->cs->destroyCoeffs();
     pcPic->cs->releaseIntermediateData();
+#if ENABLE_FRAME_PARALLELISM
+
+    if( sync )
+    {
+      sync->finishWriting();
+    }
+#endif
+  };
+
+#if ENABLE_FRAME_PARALLELISM
+  if( !frameGOPids.empty() )
+  {
+    // each task encodes every numSlots-th picture in coding order with its own slice encoder, so a picture starts as
+    // soon as the pictures it predicts from are written, while the pictures before it are still being compressed
+    const Int         numPics  = ( Int ) frameGOPids.size();
+    const Int         numSlots = std::min( m_pcCfg->getNumFrameThreads(), numPics );
+    FrameParallelSync sync( frameLastRefIdx );
+
+    m_pcEncLib->getThreadPool()->run( numSlots, [&]( int picIdx )
+    {
+      try
+      {
+        for( Int codingIdx = picIdx; codingIdx < numPics; codingIdx += numSlots )
+        {
+          Int iGOPid = frameGOPids[codingIdx];
+          encodePicture( iGOPid, picIdx, codingIdx, &sync );
+        }
+      }
+      catch( ... )
+      {
+        // release the other pictures waiting for this one
+        sync.abort();
+        throw;
+      }
+    } );
+  }
+  else
+#endif
+  for ( Int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
+  {
+    encodePicture( iGOPid, 0, 0, nullptr );
   } // iGOPid-loop
 
   delete pcBitstreamRedirect;
@@ -2456,6 +2659,49 @@ Void EncGOP::xGetBuffer( PicList&                  rcListPic,
   return;
 }
 
+#if ENABLE_FRAME_PARALLELISM
+/** lists the pictures of the GOP in coding order together with the last picture of the GOP each one predicts from
+ * \param iPOCLast    POC of the last received picture
+ * \param iNumPicRcvd number of received pictures
+ * \param GOPids      GOP indices of the pictures to encode in coding order
+ * \param lastRefIdx  for each picture the largest index in GOPids of the pictures it predicts from according to its
+ *                    reference picture set, -1 if it only predicts from earlier GOPs
+ */
+Void EncGOP::xGetFrameParallelOrder( Int iPOCLast, Int iNumPicRcvd, std::vector<Int>& GOPids, std::vector<Int>& lastRefIdx )
+{
+  std::vector<Int> codedPOCs;
+  GOPids    .clear();
+  lastRefIdx.clear();
+
+  for( Int iGOPid = 0; iGOPid < m_iGopSize; iGOPid++ )
+  {
+    const Int pocCurr = iPOCLast - iNumPicRcvd + m_pcCfg->getGOPEntry( iGOPid ).m_POC;
+
+    if( pocCurr >= m_pcCfg->getFramesToBeEncoded() )
+    {
+      continue;
+    }
+
+    const GOPEntry& rps = m_pcCfg->getGOPEntry( m_pcEncLib->getReferencePictureSetIdxForSOP( pocCurr, iGOPid ) );
+    Int lastRef         = -1;
+
+    for( Int i = 0; i < rps.m_numRefPics; i++ )
+    {
+      const auto refPOC = std::find( codedPOCs.begin(), codedPOCs.end(), pocCurr + rps.m_referencePics[i] );
+
+      if( rps.m_usedByCurrPic[i] && refPOC != codedPOCs.end() )
+      {
+        lastRef = std::max( lastRef, ( Int ) ( refPOC - codedPOCs.begin() ) );
+      }
+    }
+
+    GOPids    .push_back( iGOPid );
+    lastRefIdx.push_back( lastRef );
+    codedPOCs .push_back( pocCurr );
+  }
+}
+#endif
+
 #if ENABLE_QPA
 
 #ifndef BETA
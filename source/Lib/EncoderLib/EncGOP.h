@@ -39,6 +39,8 @@
 #define __ENCGOP__
 
 #include <list>
+#include <deque>
+#include <mutex>
 
 #include <stdlib.h>
 
@@ -145,6 +147,18 @@ private:
   UInt                    m_uiNumBlk[10];
   UInt                    m_uiPrevISlicePOC;
   Bool                    m_bInitAMaxBT;
+#if ENABLE_FRAME_PARALLELISM
+  struct AMaxBTStats
+  {
+    Int  codingIdx;
+    Int  depth;
+    UInt blkSize;
+    UInt numBlk;
+  };
+  std::deque<AMaxBTStats> m_AMaxBTWritten;   ///< block statistics of the written pictures in coding order, not yet taken into account
+  std::mutex              m_AMaxBTMutex;
+  Int                     m_numPicSetUp;     ///< number of pictures set up for encoding, gives the coding order index of a picture
+#endif
 
   AUWriterIf*             m_AUWriterIf;
 
@@ -181,6 +195,9 @@ protected:
   Void  xInitGOP          ( Int iPOCLast, Int iNumPicRcvd, Bool isField );
   Void  xGetBuffer        ( PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRecOut,
                             Int iNumPicRcvd, Int iTimeOffset, Picture*& rpcPic, Int pocCurr, Bool isField );
+#if ENABLE_FRAME_PARALLELISM
+  Void  xGetFrameParallelOrder( Int iPOCLast, Int iNumPicRcvd, std::vector<Int>& GOPids, std::vector<Int>& lastRefIdx );
+#endif
 
   Void  xCalculateAddPSNRs         ( const Bool isField, const Bool isFieldTopFieldFirst, const Int iGOPid, Picture* pcPic, const AccessUnit&accessUnit, PicList &rcListPic, int64_t dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE, Double* PSNR_Y );
   Void  xCalculateAddPSNR          ( Picture* pcPic, PelUnitBuf cPicD, const AccessUnit&, Double dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE, Double* PSNR_Y );
@@ -44,9 +44,9 @@
 #include "CommonLib/Picture.h"
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/ChromaFormat.h"
-#if ENABLE_SPLIT_PARALLELISM
-#include <omp.h>
-#endif
+#include "CommonLib/KLTMatrixFile.h"
+
+#include <thread>
 
 //! \ingroup EncoderLib
 //! \{
@@ -71,6 +71,12 @@ EncLib::EncLib()
 #if ENABLE_SIMD_OPT_BUFFER
   g_pelBufOP.initPelBufOpsX86();
 #endif
+#if ENABLE_SIMD_OPT_TRAFO
+  g_trafoOP.initTrafoOpsX86();
+#endif
+#if ENABLE_SIMD_OPT_SAO
+  g_saoOP.initSaoOpsX86();
+#endif
 }
 
 EncLib::~EncLib()
@@ -81,21 +87,44 @@ Void EncLib::create ()
 {
   // initialize global variables
   initROM();
+#if SEPARABLE_KLT
+  if( !m_kltMatrixFileName.empty() && loadKLTMatrixFile( m_kltMatrixFileName ) )
+  {
+    THROW( "load KLT matrix file" );
+  }
+#endif
 
+  if( m_residualCapture && m_cResidualCapture.open( m_residualCaptureFileName, m_residualCapture ) )
+  {
+    THROW( "open residual capture file" );
+  }
 
 
 
   // create processing unit classes
   m_cGOPEncoder.        create( );
+#if ENABLE_FRAME_PARALLELISM
+  m_cSliceEncoder   = new EncSlice           [m_numFrameThreads];
+
+  for( int fId = 0; fId < m_numFrameThreads; fId++ )
+  {
+    m_cSliceEncoder[fId].create( getSourceWidth(), getSourceHeight(), m_chromaFormatIDC, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth );
+  }
+#else
   m_cSliceEncoder.      create( getSourceWidth(), getSourceHeight(), m_chromaFormatIDC, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth );
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 #if ENABLE_SPLIT_PARALLELISM
-  m_numCuEncStacks  = m_numSplitThreads == 1 ? 1 : NUM_RESERVERD_SPLIT_JOBS;
+  m_numPicCuEncStacks  = m_numSplitThreads == 1 ? 1 : NUM_RESERVERD_SPLIT_JOBS;
 #else
-  m_numCuEncStacks  = 1;
+  m_numPicCuEncStacks  = 1;
 #endif
 #if ENABLE_WPP_PARALLELISM
-  m_numCuEncStacks *= ( m_numWppThreads + m_numWppExtraLines );
+  m_numPicCuEncStacks *= ( m_numWppThreads + m_numWppExtraLines );
+#endif
+  m_numCuEncStacks     = m_numPicCuEncStacks;
+#if ENABLE_FRAME_PARALLELISM
+  m_numCuEncStacks    *= m_numFrameThreads;
 #endif
 
   m_cCuEncoder      = new EncCu              [m_numCuEncStacks];
@@ -113,6 +142,30 @@ Void EncLib::create ()
 #else
   m_cCuEncoder.         create( this );
 #endif
+
+  // the calling thread takes part in the work, the concurrently compressed pictures and all their WPP row tasks have to be
+  // able to run at the same time
+  int numRowTasks   = 1;
+  int numInnerTasks = 1;
+#if ENABLE_WPP_PARALLELISM
+  numRowTasks       = m_numWppThreads > 1 ? m_numWppThreads + m_numWppExtraLines : 1;
+#endif
+#if ENABLE_FRAME_PARALLELISM
+  numRowTasks      *= m_numFrameThreads;
+#endif
+#if ENABLE_SPLIT_PARALLELISM
+  numInnerTasks     = std::max( numInnerTasks, m_forceSingleSplitThread ? 1 : m_numSplitThreads );
+#endif
+#if ENABLE_KLT_PARALLELISM
+  numInnerTasks     = std::max( numInnerTasks, m_numKltThreads );
+#endif
+  int numThreads    = m_numThreads;
+  if( numThreads == 0 )
+  {
+    numThreads      = std::min<int>( numRowTasks * numInnerTasks, std::max<int>( std::thread::hardware_concurrency(), 1 ) );
+  }
+  m_threadPool.init( std::max( numThreads, numRowTasks ) - 1 );
+
   const UInt widthInCtus   = (getSourceWidth()  + m_maxCUWidth  - 1)  / m_maxCUWidth;
   const UInt heightInCtus  = (getSourceHeight() + m_maxCUHeight - 1) / m_maxCUHeight;
   const UInt numCtuInFrame = widthInCtus * heightInCtus;
@@ -135,9 +188,19 @@ Void EncLib::create ()
 
 Void EncLib::destroy ()
 {
+  m_cResidualCapture.   close();
+
   // destroy processing unit classes
+  m_threadPool.        destroy();
   m_cGOPEncoder.        destroy();
+#if ENABLE_FRAME_PARALLELISM
+  for( int fId = 0; fId < m_numFrameThreads; fId++ )
+  {
+    m_cSliceEncoder[fId].destroy();
+  }
+#else
   m_cSliceEncoder.      destroy();
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
@@ -170,6 +233,9 @@ Void EncLib::destroy ()
   delete[] m_cRdCost;
   delete[] m_CtxCache;
 #endif
+#if ENABLE_FRAME_PARALLELISM
+  delete[] m_cSliceEncoder;
+#endif
 
 
 
@@ -192,14 +258,6 @@ Void EncLib::init( Bool isFieldCoding, AUWriterIf* auWriterIf )
   xInitVPS(m_cVPS, sps0);
 #endif
 
-#if ENABLE_SPLIT_PARALLELISM
-  if( omp_get_dynamic() )
-  {
-    omp_set_dynamic( false );
-  }
-  omp_set_nested( true );
-#endif
-
 
 #if U0132_TARGET_BITS_SATURATION
   if (m_RCCpbSaturationEnabled)
@@ -232,7 +290,14 @@ Void EncLib::init( Bool isFieldCoding, AUWriterIf* auWriterIf )
 
   // initialize processing unit classes
   m_cGOPEncoder.  init( this );
+#if ENABLE_FRAME_PARALLELISM
+  for( int fId = 0; fId < m_numFrameThreads; fId++ )
+  {
+    m_cSliceEncoder[fId].init( this, sps0, fId );
+  }
+#else
   m_cSliceEncoder.init( this, sps0 );
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
@@ -256,6 +321,7 @@ Void EncLib::init( Bool isFieldCoding, AUWriterIf* auWriterIf )
                           true,
                           m_useTransformSkipFast
                           , m_QTBT
+                          , m_useRDOQSkipZeroCG
     );
 
     // initialize encoder search class
@@ -274,6 +340,13 @@ Void EncLib::init( Bool isFieldCoding, AUWriterIf* auWriterIf )
 
     // link temporary buffets from intra search with inter search to avoid unnecessary memory overhead
     m_cInterSearch[jId].setTempBuffers( m_cIntraSearch[jId].getSplitCSBuf(), m_cIntraSearch[jId].getFullCSBuf(), m_cIntraSearch[jId].getSaveCSBuf() );
+
+    m_cIntraSearch[jId].setResidualCapture( m_residualCapture ? &m_cResidualCapture : nullptr );
+    m_cInterSearch[jId].setResidualCapture( m_residualCapture ? &m_cResidualCapture : nullptr );
+#if ENABLE_KLT_PARALLELISM
+    m_cIntraSearch[jId].setThreadPool( &m_threadPool );
+    m_cInterSearch[jId].setThreadPool( &m_threadPool );
+#endif
   }
 #else  // ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   m_cCuEncoder.   init( this, sps0 );
@@ -289,6 +362,7 @@ Void EncLib::init( Bool isFieldCoding, AUWriterIf* auWriterIf )
                    true,
                    m_useTransformSkipFast
                    , m_QTBT
+                   , m_useRDOQSkipZeroCG
   );
 
   // initialize encoder search class
@@ -307,6 +381,13 @@ Void EncLib::init( Bool isFieldCoding, AUWriterIf* auWriterIf )
 
   // link temporary buffets from intra search with inter search to avoid unneccessary memory overhead
   m_cInterSearch.setTempBuffers( m_cIntraSearch.getSplitCSBuf(), m_cIntraSearch.getFullCSBuf(), m_cIntraSearch.getSaveCSBuf() );
+
+  m_cIntraSearch.setResidualCapture( m_residualCapture ? &m_cResidualCapture : nullptr );
+  m_cInterSearch.setResidualCapture( m_residualCapture ? &m_cResidualCapture : nullptr );
+#if ENABLE_KLT_PARALLELISM
+  m_cIntraSearch.setThreadPool( &m_threadPool );
+  m_cInterSearch.setThreadPool( &m_threadPool );
+#endif
 #endif // ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 
   m_iMaxRefPicNum = 0;
@@ -324,9 +405,6 @@ Void EncLib::init( Bool isFieldCoding, AUWriterIf* auWriterIf )
     xInitScalingLists( sps0, pps0 );
   }
 #endif
-#if ENABLE_WPP_PARALLELISM
-  m_entropyCodingSyncContextStateVec.resize( pps0.pcv->heightInCtus );
-#endif
 }
 
 #if HEVC_USE_SCALING_LISTS
@@ -438,6 +516,34 @@ Void EncLib::deletePicBuffer()
   }
 }
 
+Void EncLib::printSummary( Bool isField )
+{
+  m_cGOPEncoder.printOutSummary( m_uiNumAllPicCoded, isField, m_printMSEBasedSequencePSNR, m_printSequenceMSE, m_spsMap.getFirstPS()->getBitDepths() );
+
+#if SEPARABLE_KLT
+  if( getUseFastIntraKLT() )
+  {
+    UInt64 numPasses = 0, numSkipped = 0;
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+    for( int jId = 0; jId < m_numCuEncStacks; jId++ )
+    {
+      numPasses  += m_cCuEncoder[jId].getNumIntraKltPasses();
+      numSkipped += m_cCuEncoder[jId].getNumIntraKltPassesSkipped();
+    }
+#else
+    numPasses  = m_cCuEncoder.getNumIntraKltPasses();
+    numSkipped = m_cCuEncoder.getNumIntraKltPassesSkipped();
+#endif
+    msg( INFO, "\nFastIntraKLT: %llu of %llu intra KLT passes skipped\n", ( unsigned long long ) numSkipped, ( unsigned long long ) numPasses );
+  }
+#endif
+
+  if( m_residualCapture )
+  {
+    msg( INFO, "\nResidualCapture: %llu residual blocks written to %s\n", ( unsigned long long ) m_cResidualCapture.getNumBlocks(), m_residualCaptureFileName.c_str() );
+  }
+}
+
 /**
  - Application has picture buffer list with size of GOP + 1
  - Picture buffer list acts like as ring buffer
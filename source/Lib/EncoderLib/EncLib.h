@@ -42,6 +42,7 @@
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/LoopFilter.h"
 #include "CommonLib/NAL.h"
+#include "CommonLib/ThreadPool.h"
 
 #include "Utilities/VideoIOYuv.h"
 
@@ -54,6 +55,7 @@
 #include "IntraSearch.h"
 #include "EncSampleAdaptiveOffset.h"
 #include "RateCtrl.h"
+#include "ResidualCapture.h"
 
 
 //! \ingroup EncoderLib
@@ -98,7 +100,11 @@ private:
 
   // processing unit
   EncGOP                    m_cGOPEncoder;                        ///< GOP encoder
+#if ENABLE_FRAME_PARALLELISM
+  EncSlice                 *m_cSliceEncoder;                      ///< slice encoder, one per concurrently compressed picture
+#else
   EncSlice                  m_cSliceEncoder;                      ///< slice encoder
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncCu                    *m_cCuEncoder;                         ///< CU encoder
 #else
@@ -117,19 +123,15 @@ private:
 #endif
   // quality control
   RateCtrl                  m_cRateCtrl;                          ///< Rate control class
+  ResidualCapture           m_cResidualCapture;                   ///< residual capture for transform training
 
   AUWriterIf*               m_AUWriterIf;
 
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   int                       m_numCuEncStacks;
+  int                       m_numPicCuEncStacks;                  ///< stacks used by one picture, the picture compressed by slice encoder f uses the f-th range
 #endif
-
-
-public:
-  Ctx                       m_entropyCodingSyncContextState;      ///< leave in addition to vector for compatibility
-#if ENABLE_WPP_PARALLELISM
-  std::vector<Ctx>          m_entropyCodingSyncContextStateVec;   ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
-#endif
+  ThreadPool                m_threadPool;                         ///< workers shared by the pictures, WPP rows, split jobs and KLT candidates
 
 protected:
   Void  xGetNewPicBuffer  ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Picture*& rpcPic, Int ppsId ); ///< get picture buffer which will be processed. If ppsId<0, then the ppsMap will be queried for the first match.
@@ -177,7 +179,11 @@ public:
   LoopFilter*             getLoopFilter         ()              { return  &m_cLoopFilter;          }
   EncSampleAdaptiveOffset* getSAO               ()              { return  &m_cEncSAO;              }
   EncGOP*                 getGOPEncoder         ()              { return  &m_cGOPEncoder;          }
+#if ENABLE_FRAME_PARALLELISM
+  EncSlice*               getSliceEncoder       ( int fId = 0 ) { return  &m_cSliceEncoder[fId];   }
+#else
   EncSlice*               getSliceEncoder       ()              { return  &m_cSliceEncoder;        }
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncCu*                  getCuEncoder          ( int jId = 0 ) { return  &m_cCuEncoder[jId];      }
 #else
@@ -196,6 +202,7 @@ public:
   CtxCache*               getCtxCache           ()              { return  &m_CtxCache;             }
 #endif
   RateCtrl*               getRateCtrl           ()              { return  &m_cRateCtrl;            }
+  ThreadPool*             getThreadPool         ()              { return  &m_threadPool;           }
 
   Void selectReferencePictureSet(Slice* slice, Int POCCurr, Int GOPid );
   Int getReferencePictureSetIdxForSOP(Int POCCurr, Int GOPid );
@@ -207,6 +214,7 @@ public:
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   void                   setNumCuEncStacks( int n )             { m_numCuEncStacks = n; }
   int                    getNumCuEncStacks()              const { return m_numCuEncStacks; }
+  int                    getNumPicCuEncStacks()           const { return m_numPicCuEncStacks; }
 #endif
 
   // -------------------------------------------------------------------------------------------------------------------
@@ -228,7 +236,7 @@ public:
                Int& iNumEncoded, Bool isTff );
 
 
-  Void printSummary(Bool isField) { m_cGOPEncoder.printOutSummary (m_uiNumAllPicCoded, isField, m_printMSEBasedSequencePSNR, m_printSequenceMSE, m_spsMap.getFirstPS()->getBitDepths()); }
+  Void printSummary(Bool isField);
 
 };
 
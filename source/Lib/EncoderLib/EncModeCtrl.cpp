@@ -48,6 +48,7 @@
 #include "CommonLib/dtrace_next.h"
 
 #include <cmath>
+#include <limits>
 
 Void EncModeCtrl::init( EncCfg *pCfg, RateCtrl *pRateCtrl, RdCost* pRdCost )
 {
@@ -487,6 +488,34 @@ bool CacheBlkInfoCtrl::isSkip( const UnitArea& area )
   return m_codedCUInfo[idx1][idx2][idx3][idx4]->isSkip;
 }
 
+#if SEPARABLE_KLT
+bool CacheBlkInfoCtrl::isKltUnlikely( const UnitArea& area )
+{
+  const CodedCUInfo& cuInfo = getBlkInfo( area );
+
+  return cuInfo.numKltPasses >= KLT_FAST_MIN_AREA_PASSES && cuInfo.numKltHits < KLT_FAST_MIN_AREA_HIT_RATE * cuInfo.numKltPasses;
+}
+
+void CacheBlkInfoCtrl::countKltPass( const UnitArea& area, const bool kltHit )
+{
+  CodedCUInfo& cuInfo = getBlkInfo( area );
+
+  if( cuInfo.numKltPasses == std::numeric_limits<uint8_t>::max() )
+  {
+    // keep the rate, drop half of the history
+    cuInfo.numKltPasses >>= 1;
+    cuInfo.numKltHits   >>= 1;
+  }
+
+  cuInfo.numKltPasses++;
+  cuInfo.numKltHits += kltHit ? 1 : 0;
+#if ENABLE_SPLIT_PARALLELISM
+
+  touch( area );
+#endif
+}
+#endif
+
 void CacheBlkInfoCtrl::setMv( const UnitArea& area, const RefPicList refPicList, const int iRefIdx, const Mv& rMv )
 {
   if( iRefIdx >= MAX_STORED_CU_INFO_REFS ) return;
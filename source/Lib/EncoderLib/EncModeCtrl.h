@@ -333,6 +333,10 @@ struct CodedCUInfo
   bool isInter;
   bool isIntra;
   bool isSkip;
+#if SEPARABLE_KLT
+  uint8_t numKltPasses;                                              // intra KLT passes run for the area
+  uint8_t numKltHits;                                                // passes in which the KLT beat the DCT-II
+#endif
 
   bool validMv[NUM_REF_PIC_LIST_01][MAX_STORED_CU_INFO_REFS];
   Mv   saveMv [NUM_REF_PIC_LIST_01][MAX_STORED_CU_INFO_REFS];
@@ -379,6 +383,10 @@ public:
   virtual ~CacheBlkInfoCtrl() {}
 
   bool isSkip ( const UnitArea& area );
+#if SEPARABLE_KLT
+  bool isKltUnlikely    ( const UnitArea& area );
+  void countKltPass     ( const UnitArea& area, const bool kltHit );
+#endif
 
   bool getMv  ( const UnitArea& area, const RefPicList refPicList, const int iRefIdx,       Mv& rMv ) const;
   void setMv  ( const UnitArea& area, const RefPicList refPicList, const int iRefIdx, const Mv& rMv );
@@ -260,13 +260,6 @@ Void EncSampleAdaptiveOffset::getStatistics(std::vector<SAOStatData**>& blkStats
   const PreCalcValues& pcv = *cs.pcv;
   const Int numberOfComponents = getNumberValidComponents(pcv.chrFormat);
 
-  size_t lineBufferSize = pcv.maxCUWidth + 1;
-  if (m_signLineBuf1.size() != lineBufferSize)
-  {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
-
   int ctuRsAddr = 0;
   for( UInt yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
   {
@@ -895,8 +888,7 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                         , Bool isCalculatePreDeblockSamples
                         )
 {
-  Int x,y, startX, startY, endX, endY, edgeType, firstLineStartX, firstLineEndX;
-  SChar signLeft, signRight, signDown;
+  Int x,y, startX, startY, endX, endY, firstLineStartX, firstLineEndX;
   Int64 *diff, *count;
   Pel *srcLine, *orgLine;
   Int* skipLinesR = m_skipLinesR[compIdx];
@@ -915,8 +907,6 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
     {
     case SAO_TYPE_EO_0:
       {
-        diff +=2;
-        count+=2;
         endY   = (isBelowAvail) ? (height - skipLinesB[typeIdx]) : height;
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
@@ -924,21 +914,8 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
         endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  : (isRightAvail ? width : (width - 1))
                                                  ;
-        for (y=0; y<endY; y++)
-        {
-          signLeft = (SChar)sgn(srcLine[startX] - srcLine[startX-1]);
-          for (x=startX; x<endX; x++)
-          {
-            signRight =  (SChar)sgn(srcLine[x] - srcLine[x+1]);
-            edgeType  =  signRight + signLeft;
-            signLeft  = -signRight;
+        g_saoOP.statsEO( srcLine + startX, srcStride, orgLine + startX, orgStride, endX - startX, endY, 1, diff, count );
 
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
@@ -946,31 +923,13 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
             startX = isLeftAvail  ? 0 : 1;
             endX   = isRightAvail ? width : (width -1);
 
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              signLeft = (SChar)sgn(srcLine[startX] - srcLine[startX-1]);
-              for (x=startX; x<endX; x++)
-              {
-                signRight =  (SChar)sgn(srcLine[x] - srcLine[x+1]);
-                edgeType  =  signRight + signLeft;
-                signLeft  = -signRight;
-
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            g_saoOP.statsEO( srcLine + endY * srcStride + startX, srcStride, orgLine + endY * orgStride + startX, orgStride, endX - startX, skipLinesB[typeIdx], 1, diff, count );
           }
         }
       }
       break;
     case SAO_TYPE_EO_90:
       {
-        diff +=2;
-        count+=2;
-        SChar *signUpLine = &m_signLineBuf1[0];
-
         startX = (!isCalculatePreDeblockSamples) ? 0
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : width)
                                                  ;
@@ -979,70 +938,20 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                                                  : width
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
-        if (!isAboveAvail)
-        {
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
 
-        Pel* srcLineAbove = srcLine - srcStride;
-        for (x=startX; x<endX; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLine[x] - srcLineAbove[x]);
-        }
+        g_saoOP.statsEO( srcLine + startY * srcStride + startX, srcStride, orgLine + startY * orgStride + startX, orgStride, endX - startX, endY - startY, srcStride, diff, count );
 
-        Pel* srcLineBelow;
-        for (y=startY; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for (x=startX; x<endX; x++)
-          {
-            signDown  = (SChar)sgn(srcLine[x] - srcLineBelow[x]);
-            edgeType  = signDown + signUpLine[x];
-            signUpLine[x]= -signDown;
-
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
           {
-            startX = 0;
-            endX   = width;
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x]) + sgn(srcLine[x] - srcLineAbove[x]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            g_saoOP.statsEO( srcLine + endY * srcStride, srcStride, orgLine + endY * orgStride, orgStride, width, skipLinesB[typeIdx], srcStride, diff, count );
           }
         }
-
       }
       break;
     case SAO_TYPE_EO_135:
       {
-        diff +=2;
-        count+=2;
-        SChar *signUpLine, *signDownLine, *signTmpLine;
-
-        signUpLine  = &m_signLineBuf1[0];
-        signDownLine= &m_signLineBuf2[0];
-
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  ;
@@ -1052,50 +961,14 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line's upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX; x<endX+1; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x-1]);
-        }
-
         //1st line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x-1]) - signUpLine[x+1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-        srcLine  += srcStride;
-        orgLine  += orgStride;
-
+        g_saoOP.statsEO( srcLine + firstLineStartX, srcStride, orgLine + firstLineStartX, orgStride, firstLineEndX - firstLineStartX, 1, srcStride + 1, diff, count );
 
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for (x=startX; x<endX; x++)
-          {
-            signDown = (SChar)sgn(srcLine[x] - srcLineBelow[x+1]);
-            edgeType = signDown + signUpLine[x];
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signDownLine[x+1] = -signDown;
-          }
-          signDownLine[startX] = (SChar)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-          signTmpLine  = signUpLine;
-          signUpLine   = signDownLine;
-          signDownLine = signTmpLine;
+        g_saoOP.statsEO( srcLine + srcStride + startX, srcStride, orgLine + orgStride + startX, orgStride, endX - startX, endY - 1, srcStride + 1, diff, count );
 
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
@@ -1103,30 +976,13 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
             startX = isLeftAvail  ? 0     : 1 ;
             endX   = isRightAvail ? width : (width -1);
 
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x< endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x+1]) + sgn(srcLine[x] - srcLineAbove[x-1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            g_saoOP.statsEO( srcLine + endY * srcStride + startX, srcStride, orgLine + endY * orgStride + startX, orgStride, endX - startX, skipLinesB[typeIdx], srcStride + 1, diff, count );
           }
         }
       }
       break;
     case SAO_TYPE_EO_45:
       {
-        diff +=2;
-        count+=2;
-        SChar *signUpLine = &m_signLineBuf1[1];
-
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  ;
@@ -1135,51 +991,18 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX-1; x<endX; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x+1]);
-        }
-
-
         //first line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveAvail ? startX : endX)
                                                           : startX
                                                           ;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? ((!isRightAvail && isAboveRightAvail) ? width : endX)
                                                           : endX
                                                           ;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) - signUpLine[x-1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-
-        srcLine += srcStride;
-        orgLine += orgStride;
+        g_saoOP.statsEO( srcLine + firstLineStartX, srcStride, orgLine + firstLineStartX, orgStride, firstLineEndX - firstLineStartX, 1, srcStride - 1, diff, count );
 
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for(x=startX; x<endX; x++)
-          {
-            signDown = (SChar)sgn(srcLine[x] - srcLineBelow[x-1]);
-            edgeType = signDown + signUpLine[x];
+        g_saoOP.statsEO( srcLine + srcStride + startX, srcStride, orgLine + orgStride + startX, orgStride, endX - startX, endY - 1, srcStride - 1, diff, count );
 
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signUpLine[x-1] = -signDown;
-          }
-          signUpLine[endX-1] = (SChar)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
@@ -1187,20 +1010,7 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
             startX = isLeftAvail  ? 0     : 1 ;
             endX   = isRightAvail ? width : (width -1);
 
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + sgn(srcLine[x] - srcLineAbove[x+1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            g_saoOP.statsEO( srcLine + endY * srcStride + startX, srcStride, orgLine + endY * orgStride + startX, orgStride, endX - startX, skipLinesB[typeIdx], srcStride - 1, diff, count );
           }
         }
       }
@@ -41,9 +41,11 @@
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/Picture.h"
 
-#if ENABLE_WPP_PARALLELISM
+#if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
 #include <mutex>
-extern recursive_mutex g_cache_mutex;
+
+// serializes the slice bit counting of concurrently encoded CTU rows
+static std::mutex s_sliceBitsMutex;
 #endif
 
 #include <math.h>
@@ -56,7 +58,12 @@ extern recursive_mutex g_cache_mutex;
 // ====================================================================================================================
 
 EncSlice::EncSlice()
+#if ENABLE_WPP_PARALLELISM && HEVC_TILES_WPP
+ : m_concurrentTiles(false)
+ , m_encCABACTableIdx(I_SLICE)
+#else
  : m_encCABACTableIdx(I_SLICE)
+#endif
 {
 }
 
@@ -77,19 +84,22 @@ Void EncSlice::destroy()
   m_viRdPicQp.clear();
 }
 
-Void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
+Void EncSlice::init( EncLib* pcEncLib, const SPS& sps, const Int frameId )
 {
   m_pcCfg             = pcEncLib;
   m_pcLib             = pcEncLib;
   m_pcListPic         = pcEncLib->getListPic();
 
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  m_firstCuEncStack   = frameId * pcEncLib->getNumPicCuEncStacks();
+#endif
   m_pcGOPEncoder      = pcEncLib->getGOPEncoder();
-  m_pcCuEncoder       = pcEncLib->getCuEncoder();
-  m_pcInterSearch     = pcEncLib->getInterSearch();
-  m_CABACWriter       = pcEncLib->getCABACEncoder()->getCABACWriter   (&sps);
-  m_CABACEstimator    = pcEncLib->getCABACEncoder()->getCABACEstimator(&sps);
-  m_pcTrQuant         = pcEncLib->getTrQuant();
-  m_pcRdCost          = pcEncLib->getRdCost();
+  m_pcCuEncoder       = pcEncLib->getCuEncoder   ( PARL_PARAM0( m_firstCuEncStack ) );
+  m_pcInterSearch     = pcEncLib->getInterSearch ( PARL_PARAM0( m_firstCuEncStack ) );
+  m_CABACWriter       = pcEncLib->getCABACEncoder( PARL_PARAM0( m_firstCuEncStack ) )->getCABACWriter   (&sps);
+  m_CABACEstimator    = pcEncLib->getCABACEncoder( PARL_PARAM0( m_firstCuEncStack ) )->getCABACEstimator(&sps);
+  m_pcTrQuant         = pcEncLib->getTrQuant     ( PARL_PARAM0( m_firstCuEncStack ) );
+  m_pcRdCost          = pcEncLib->getRdCost      ( PARL_PARAM0( m_firstCuEncStack ) );
 
   // create lambda and QP arrays
   m_vdRdPicLambda.resize(m_pcCfg->getDeltaQpRD() * 2 + 1 );
@@ -902,9 +912,9 @@ Void EncSlice::setSearchRange( Slice* pcSlice )
       Int newSearchRange = Clip3(m_pcCfg->getMinSearchWindow(), iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
       m_pcInterSearch->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
 #if ENABLE_WPP_PARALLELISM
-      for( int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++ )
+      for( int jId = 1; jId < m_pcLib->getNumPicCuEncStacks(); jId++ )
       {
-        m_pcLib->getInterSearch( jId )->setAdaptiveSearchRange( iDir, iRefIdx, newSearchRange );
+        m_pcLib->getInterSearch( m_firstCuEncStack + jId )->setAdaptiveSearchRange( iDir, iRefIdx, newSearchRange );
       }
 #endif
     }
@@ -1076,9 +1086,9 @@ Void EncSlice::compressSlice( Picture* pcPic, const Bool bCompressEntireSlice, c
   m_CABACEstimator->initCtxModels( *pcSlice );
 
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-  for( int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++ )
+  for( int jId = 1; jId < m_pcLib->getNumPicCuEncStacks(); jId++ )
   {
-    CABACWriter* cw = m_pcLib->getCABACEncoder( jId )->getCABACEstimator( pcSlice->getSPS() );
+    CABACWriter* cw = m_pcLib->getCABACEncoder( m_firstCuEncStack + jId )->getCABACEstimator( pcSlice->getSPS() );
     cw->initCtxModels( *pcSlice );
   }
 
@@ -1240,9 +1250,9 @@ Void EncSlice::compressSlice( Picture* pcPic, const Bool bCompressEntireSlice, c
     {
       m_CABACEstimator->initCtxModels (*pcSlice);
   #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-      for (int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++)
+      for (int jId = 1; jId < m_pcLib->getNumPicCuEncStacks(); jId++)
       {
-        CABACWriter* cw = m_pcLib->getCABACEncoder (jId)->getCABACEstimator (pcSlice->getSPS());
+        CABACWriter* cw = m_pcLib->getCABACEncoder (m_firstCuEncStack + jId)->getCABACEstimator (pcSlice->getSPS());
         cw->initCtxModels (*pcSlice);
       }
   #endif
@@ -1269,6 +1279,8 @@ Void EncSlice::compressSlice( Picture* pcPic, const Bool bCompressEntireSlice, c
 
 
 #if ENABLE_WPP_PARALLELISM
+  m_compressSyncContextStates.resize( pcv.heightInCtus );
+
   bool bUseThreads = m_pcCfg->getNumWppThreads() > 1;
   if( bUseThreads )
   {
@@ -1276,19 +1288,67 @@ Void EncSlice::compressSlice( Picture* pcPic, const Bool bCompressEntireSlice, c
 
     pcPic->cs->allocateVectorsAtPicLevel();
 
-    omp_set_num_threads( m_pcCfg->getNumWppThreads() + m_pcCfg->getNumWppExtraLines() );
+    // row task t encodes the CTU lines t, t + numRowTasks, ..., all row tasks have to run concurrently
+    const int numRowTasks = m_pcCfg->getNumWppThreads() + m_pcCfg->getNumWppExtraLines();
+
+#if HEVC_TILES_WPP
+    // without entropy coding sync, the tiles do not depend on each other and are compressed concurrently instead,
+    // each task using its own CU encoder stack, with the CTU lines crossing the tiles there is no wavefront to follow
+    m_concurrentTiles = tileMap.numTiles > 1 && !pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
+
+    if( m_concurrentTiles )
+    {
+      // tile task t encodes the tiles t, t + numTileTasks, ...
+      const int numTileTasks = std::min<int>( numRowTasks, tileMap.numTiles );
+
+      m_pcLib->getThreadPool()->run( numTileTasks, [&]( int tId )
+      {
+        pcPic->scheduler.setWppThreadId( tId );
+#if ENABLE_SPLIT_PARALLELISM
+        pcPic->scheduler.setSplitThreadId( 0 );
+#endif
+        for( unsigned tileIdx = tId; tileIdx < tileMap.numTiles; tileIdx += numTileTasks )
+        {
+          const Tile&    tile           = tileMap.tiles[tileIdx];
+          const unsigned firstCtuTsAddr = tileMap.getCtuRsToTsAddrMap( tile.getFirstCtuRsAddr() );
 
-    #pragma omp parallel for schedule(static,1) if(bUseThreads)
-    for( int ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr += widthInCtus )
+          encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, firstCtuTsAddr, firstCtuTsAddr + tile.getTileWidthInCtus() * tile.getTileHeightInCtus(), m_pcLib );
+        }
+        pcPic->scheduler.setWppThreadId( 0 );
+      } );
+
+      m_concurrentTiles = false;
+    }
+    else
+#endif
+    m_pcLib->getThreadPool()->run( numRowTasks, [&]( int tId )
     {
       // wpp thread start
-      pcPic->scheduler.setWppThreadId();
+      pcPic->scheduler.setWppThreadId( tId );
 #if ENABLE_SPLIT_PARALLELISM
       pcPic->scheduler.setSplitThreadId( 0 );
 #endif
-      encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, ctuTsAddr, ctuTsAddr + widthInCtus, m_pcLib );
+      int ctuTsAddr = startCtuTsAddr + tId * widthInCtus;
+      try
+      {
+        for( ; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr += numRowTasks * widthInCtus )
+        {
+          encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, ctuTsAddr, ctuTsAddr + widthInCtus, m_pcLib );
+        }
+      }
+      catch( ... )
+      {
+        // release the lines waiting for this task
+        for( ; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr += numRowTasks * widthInCtus )
+        {
+          pcPic->scheduler.setReady( widthInCtus - 1, ctuTsAddr / widthInCtus );
+        }
+        pcPic->scheduler.setWppThreadId( 0 );
+        throw;
+      }
+      pcPic->scheduler.setWppThreadId( 0 );
       // wpp thread stop
-    }
+    } );
   }
   else
 #endif
@@ -1380,6 +1440,9 @@ void EncSlice::encodeCtus( Picture* pcPic, const Bool bCompressEntireSlice, cons
     DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
 
 #if ENABLE_WPP_PARALLELISM
+#if HEVC_TILES_WPP
+    if( !m_concurrentTiles )
+#endif
     pcPic->scheduler.wait( ctuXPosInCtus, ctuYPosInCtus );
 #endif
 
@@ -1396,16 +1459,20 @@ void EncSlice::encodeCtus( Picture* pcPic, const Bool bCompressEntireSlice, cons
       if( cs.getCURestricted( pos.offset(pcv.maxCUWidth, -1), pcSlice->getIndependentSliceIdx(), tileMap.getTileIdxMap( pos ), CH_L ) )
       {
         // Top-right is available, we use it.
-        pCABACWriter->getCtx() = pEncLib->m_entropyCodingSyncContextState;
+        pCABACWriter->getCtx() = m_compressSyncContextState;
       }
       prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
     }
 #endif
 
 #if ENABLE_WPP_PARALLELISM
-    if( ctuXPosInCtus == 0 && ctuYPosInCtus > 0 && widthInCtus > 1 && ( pEncLib->getNumWppThreads() > 1 || pEncLib->getEnsureWppBitEqual() ) )
+    if( ctuXPosInCtus == 0 && ctuYPosInCtus > 0 && widthInCtus > 1 && ( pEncLib->getNumWppThreads() > 1 || pEncLib->getEnsureWppBitEqual() )
+#if HEVC_TILES_WPP
+        && !m_concurrentTiles
+#endif
+      )
     {
-      pCABACWriter->getCtx() = pEncLib->m_entropyCodingSyncContextStateVec[ctuYPosInCtus-1];  // last line
+      pCABACWriter->getCtx() = m_compressSyncContextStates[ctuYPosInCtus-1];  // last line
     }
 #else
 #endif
@@ -1506,28 +1573,31 @@ void EncSlice::encodeCtus( Picture* pcPic, const Bool bCompressEntireSlice, cons
       break;
     }
 
+    {
 #if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
-#pragma omp critical
-#endif
-    pcSlice->setSliceBits( ( UInt ) ( pcSlice->getSliceBits() + numberOfWrittenBits ) );
-#if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
-#pragma omp critical
+      std::lock_guard<std::mutex> lock( s_sliceBitsMutex );
 #endif
+      pcSlice->setSliceBits( ( UInt ) ( pcSlice->getSliceBits() + numberOfWrittenBits ) );
 #if HEVC_DEPENDENT_SLICES
-    pcSlice->setSliceSegmentBits( pcSlice->getSliceSegmentBits() + numberOfWrittenBits );
+      pcSlice->setSliceSegmentBits( pcSlice->getSliceSegmentBits() + numberOfWrittenBits );
 #endif
+    }
 
 #if HEVC_TILES_WPP
     // Store probabilities of second CTU in line into buffer - used only if wavefront-parallel-processing is enabled.
     if( ctuXPosInCtus == tileXPosInCtus + 1 && pEncLib->getEntropyCodingSyncEnabledFlag() )
     {
-      pEncLib->m_entropyCodingSyncContextState = pCABACWriter->getCtx();
+      m_compressSyncContextState = pCABACWriter->getCtx();
     }
 #endif
 #if ENABLE_WPP_PARALLELISM
-    if( ctuXPosInCtus == 1 && ( pEncLib->getNumWppThreads() > 1 || pEncLib->getEnsureWppBitEqual() ) )
+    if( ctuXPosInCtus == 1 && ( pEncLib->getNumWppThreads() > 1 || pEncLib->getEnsureWppBitEqual() )
+#if HEVC_TILES_WPP
+        && !m_concurrentTiles
+#endif
+      )
     {
-      pEncLib->m_entropyCodingSyncContextStateVec[ctuYPosInCtus] = pCABACWriter->getCtx();
+      m_compressSyncContextStates[ctuYPosInCtus] = pCABACWriter->getCtx();
     }
 #endif
 
@@ -1583,6 +1653,9 @@ void EncSlice::encodeCtus( Picture* pcPic, const Bool bCompressEntireSlice, cons
     m_uiPicDist       = cs.dist;
 #endif
 #if ENABLE_WPP_PARALLELISM
+#if HEVC_TILES_WPP
+    if( !m_concurrentTiles )
+#endif
     pcPic->scheduler.setReady( ctuXPosInCtus, ctuYPosInCtus );
 #endif
   }
@@ -95,6 +95,16 @@ private:
 #endif
 #if HEVC_TILES_WPP
   Ctx                     m_entropyCodingSyncContextState;      ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
+#endif
+  Ctx                     m_compressSyncContextState;           ///< estimator contexts at the second CTU of the previous tile-row, used while compressing
+#if ENABLE_WPP_PARALLELISM
+  std::vector<Ctx>        m_compressSyncContextStates;          ///< estimator contexts at the second CTU of each CTU line, for the concurrently compressed lines
+#if HEVC_TILES_WPP
+  bool                    m_concurrentTiles;                    ///< the tiles of the picture are compressed concurrently instead of its CTU lines
+#endif
+#endif
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  int                     m_firstCuEncStack;                    ///< first of the CU encoder stacks used by the pictures compressed with this slice encoder
 #endif
   SliceType               m_encCABACTableIdx;
 #if SHARP_LUMA_DELTA_QP
@@ -127,7 +137,7 @@ public:
 
   Void    create              ( Int iWidth, Int iHeight, ChromaFormat chromaFormat, UInt iMaxCUWidth, UInt iMaxCUHeight, UChar uhTotalDepth );
   Void    destroy             ();
-  Void    init                ( EncLib* pcEncLib, const SPS& sps );
+  Void    init                ( EncLib* pcEncLib, const SPS& sps, const Int frameId = 0 );
 
   /// preparation of slice encoding (reference marking, QP and lambda)
   Void    initEncSlice        ( Picture*  pcPic, const Int pocLast, const Int pocCurr,
@@ -140,9 +150,6 @@ public:
   Void    calCostSliceI       ( Picture* pcPic );
 
   Void    encodeSlice         ( Picture* pcPic, OutputBitstream* pcSubstreams, UInt &numBinsCoded );
-#if ENABLE_WPP_PARALLELISM
-  static
-#endif
   Void    encodeCtus          ( Picture* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP, UInt startCtuTsAddr, UInt boundingCtuTsAddr, EncLib* pcEncLib );
 
 
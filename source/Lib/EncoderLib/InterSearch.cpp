@@ -43,6 +43,7 @@
 #include "CommonLib/MotionInfo.h"
 #include "CommonLib/Picture.h"
 #include "CommonLib/UnitTools.h"
+#include "CommonLib/ThreadPool.h"
 #include "CommonLib/dtrace_next.h"
 #include "CommonLib/dtrace_buffer.h"
 
@@ -57,6 +58,19 @@
  //! \ingroup EncoderLib
  //! \{
 
+#if ENABLE_KLT_PARALLELISM
+struct InterKltJob
+{
+  TrQuant             trQuant;
+  CABACEncoder        cabacEncoder;
+  XUCache             unitCache;
+  CodingStructure  ***cs;                                            // one per CU size, holds the TU of the candidate
+};
+
+#endif
+
+static const Int TZ_SEARCH_BATCH_SIZE = 16; ///< maximum number of search positions evaluated by one batched SAD call
+
 static const Mv s_acMvRefineH[9] =
 {
   Mv(  0,  0 ), // 0
@@ -88,8 +102,14 @@ InterSearch::InterSearch()
   : m_modeCtrl                    (nullptr)
   , m_pSplitCS                    (nullptr)
   , m_pFullCS                     (nullptr)
+#if ENABLE_KLT_PARALLELISM
+  , m_kltJobs                     (nullptr)
+  , m_numKltThreads               (1)
+  , m_threadPool                  (nullptr)
+#endif
   , m_pcEncCfg                    (nullptr)
   , m_pcTrQuant                   (nullptr)
+  , m_pcResidualCapture           (nullptr)
   , m_iSearchRange                (0)
   , m_bipredSearchRange           (0)
   , m_motionEstimationSearchMethod(MESEARCH_FULL)
@@ -143,6 +163,33 @@ Void InterSearch::destroy()
   {
     delete[] m_tmpAffiDeri[1];
   }
+#if ENABLE_KLT_PARALLELISM
+
+  if( m_kltJobs )
+  {
+    const UInt numWidths  = gp_sizeIdxInfo->numWidths();
+    const UInt numHeights = gp_sizeIdxInfo->numHeights();
+
+    for( Int jId = 0; jId < PARL_KLT_MAX_NUM_JOBS; jId++ )
+    {
+      for( UInt width = 0; width < numWidths; width++ )
+      {
+        for( UInt height = 0; height < numHeights; height++ )
+        {
+          if( m_kltJobs[jId].cs[width][height] )
+          {
+            m_kltJobs[jId].cs[width][height]->destroy();
+          }
+          delete m_kltJobs[jId].cs[width][height];
+        }
+        delete[] m_kltJobs[jId].cs[width];
+      }
+      delete[] m_kltJobs[jId].cs;
+    }
+    delete[] m_kltJobs;
+    m_kltJobs = nullptr;
+  }
+#endif
   m_isInitialized = false;
 }
 
@@ -232,6 +279,56 @@ Void InterSearch::init( EncCfg*        pcEncCfg,
   m_tmpAffiDeri[0] = new Double[MAX_CU_SIZE * MAX_CU_SIZE];
   m_tmpAffiDeri[1] = new Double[MAX_CU_SIZE * MAX_CU_SIZE];
   m_pTempPel = new Pel[maxCUWidth*maxCUHeight];
+#if ENABLE_KLT_PARALLELISM
+
+  m_numKltThreads = pcEncCfg->getInterKLT() ? pcEncCfg->getNumKltThreads() : 1;
+
+  if( m_numKltThreads > 1 )
+  {
+    const UInt numWidths  = gp_sizeIdxInfo->numWidths();
+    const UInt numHeights = gp_sizeIdxInfo->numHeights();
+    const Bool BTnoRQT    = pcEncCfg->getQTBT();
+
+    m_kltJobs = new InterKltJob[PARL_KLT_MAX_NUM_JOBS];
+
+    for( Int jId = 0; jId < PARL_KLT_MAX_NUM_JOBS; jId++ )
+    {
+      InterKltJob &job = m_kltJobs[jId];
+
+      job.trQuant.init( pcTrQuant->getQuant(),
+                        1 << pcEncCfg->getQuadtreeTULog2MaxSize(),
+                        pcEncCfg->getUseRDOQ(),
+                        pcEncCfg->getUseRDOQTS(),
+#if T0196_SELECTIVE_RDOQ
+                        pcEncCfg->getUseSelectiveRDOQ(),
+#endif
+                        true,
+                        pcEncCfg->getUseTransformSkipFast(),
+                        pcEncCfg->getQTBT(),
+                        pcEncCfg->getUseRDOQSkipZeroCG() );
+
+      job.cs = new CodingStructure**[numWidths];
+
+      for( UInt width = 0; width < numWidths; width++ )
+      {
+        job.cs[width] = new CodingStructure*[numHeights];
+
+        for( UInt height = 0; height < numHeights; height++ )
+        {
+          if( ( BTnoRQT || width == height ) && gp_sizeIdxInfo->isCuSize( gp_sizeIdxInfo->sizeFrom( width ) ) && gp_sizeIdxInfo->isCuSize( gp_sizeIdxInfo->sizeFrom( height ) ) )
+          {
+            job.cs[width][height] = new CodingStructure( job.unitCache.cuCache, job.unitCache.puCache, job.unitCache.tuCache );
+            job.cs[width][height]->create( cform, Area( 0, 0, gp_sizeIdxInfo->sizeFrom( width ), gp_sizeIdxInfo->sizeFrom( height ) ), false );
+          }
+          else
+          {
+            job.cs[width][height] = nullptr;
+          }
+        }
+      }
+    }
+  }
+#endif
 
   m_isInitialized = true;
 }
@@ -306,25 +403,83 @@ inline Void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const Int i
   {
     uiSad = m_cDistParam.distFunc( m_cDistParam );
 
-    // only add motion cost if uiSad is smaller than best. Otherwise pointless
-    // to add motion cost.
+    xTZSearchCheckBest( rcStruct, uiSad, iSearchX, iSearchY, ucPointNr, uiDistance );
+  }
+}
+
+inline Void InterSearch::xTZSearchCheckBest( IntTZSearchStruct& rcStruct, Distortion uiSad, const Int iSearchX, const Int iSearchY, const UChar ucPointNr, const UInt uiDistance )
+{
+  // only add motion cost if uiSad is smaller than best. Otherwise pointless
+  // to add motion cost.
+  if( uiSad < rcStruct.uiBestSad )
+  {
+    // motion cost
+    uiSad += m_pcRdCost->getCostOfVectorWithPredictor( iSearchX, iSearchY );
+
     if( uiSad < rcStruct.uiBestSad )
     {
-      // motion cost
-      uiSad += m_pcRdCost->getCostOfVectorWithPredictor( iSearchX, iSearchY );
+      rcStruct.uiBestSad      = uiSad;
+      rcStruct.iBestX         = iSearchX;
+      rcStruct.iBestY         = iSearchY;
+      rcStruct.uiBestDistance = uiDistance;
+      rcStruct.uiBestRound    = 0;
+      rcStruct.ucPointNr      = ucPointNr;
+      m_cDistParam.maximumDistortionForEarlyExit = uiSad;
+    }
+  }
+}
 
-      if( uiSad < rcStruct.uiBestSad )
-      {
-        rcStruct.uiBestSad      = uiSad;
-        rcStruct.iBestX         = iSearchX;
-        rcStruct.iBestY         = iSearchY;
-        rcStruct.uiBestDistance = uiDistance;
-        rcStruct.uiBestRound    = 0;
-        rcStruct.ucPointNr      = ucPointNr;
-        m_cDistParam.maximumDistortionForEarlyExit = uiSad;
-      }
+inline Void InterSearch::xTZSearchHelpBatch( IntTZSearchStruct& rcStruct, const TZSearchPoint* pcPoints, const Int iNumPoints )
+{
+  // the sub-sampled SAD of subShiftMode 1 is refined per candidate, keep the sequential path for it
+  if( 1 == rcStruct.subShiftMode || m_cDistParam.distBatchFunc == nullptr )
+  {
+    for( Int i = 0; i < iNumPoints; i++ )
+    {
+      xTZSearchHelp( rcStruct, pcPoints[i].iSearchX, pcPoints[i].iSearchY, pcPoints[i].ucPointNr, pcPoints[i].uiDistance );
+    }
+    return;
+  }
+
+  CHECK( iNumPoints > TZ_SEARCH_BATCH_SIZE, "Too many search points in one batch" );
+
+  const Pel* apRefSrch[TZ_SEARCH_BATCH_SIZE] = {};
+  Distortion auiSad   [TZ_SEARCH_BATCH_SIZE];
+
+  for( Int i = 0; i < iNumPoints; i++ )
+  {
+    apRefSrch[i] = rcStruct.piRefY + pcPoints[i].iSearchY * rcStruct.iRefStride + pcPoints[i].iSearchX;
+  }
+
+  m_cDistParam.distBatchFunc( m_cDistParam, apRefSrch, iNumPoints, auiSad );
+
+  // the candidates are checked in the same order as with single evaluations, so the result is identical
+  for( Int i = 0; i < iNumPoints; i++ )
+  {
+    xTZSearchCheckBest( rcStruct, auiSad[i], pcPoints[i].iSearchX, pcPoints[i].iSearchY, pcPoints[i].ucPointNr, pcPoints[i].uiDistance );
+  }
+}
+
+inline Void InterSearch::xTZRasterSearchRow( IntTZSearchStruct& rcStruct, const Int iLeft, const Int iRight, const Int iSearchY, const Int iStep )
+{
+  TZSearchPoint acPoints[TZ_SEARCH_BATCH_SIZE];
+  Int           iNumPoints = 0;
+
+  for( Int iSearchX = iLeft; iSearchX <= iRight; iSearchX += iStep )
+  {
+    acPoints[iNumPoints++] = { iSearchX, iSearchY, 0, UInt( iStep ) };
+
+    if( iNumPoints == TZ_SEARCH_BATCH_SIZE )
+    {
+      xTZSearchHelpBatch( rcStruct, acPoints, iNumPoints );
+      iNumPoints = 0;
     }
   }
+
+  if( iNumPoints > 0 )
+  {
+    xTZSearchHelpBatch( rcStruct, acPoints, iNumPoints );
+  }
 }
 
 
@@ -619,14 +774,18 @@ inline Void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
       if (  iTop >= sr.top && iLeft >= sr.left &&
            iRight <= sr.right && iBottom <= sr.bottom ) // check border
       {
-        xTZSearchHelp( rcStruct, iStartX,  iTop,      2, iDist    );
-        xTZSearchHelp( rcStruct, iLeft_2,  iTop_2,    1, iDist>>1 );
-        xTZSearchHelp( rcStruct, iRight_2, iTop_2,    3, iDist>>1 );
-        xTZSearchHelp( rcStruct, iLeft,    iStartY,   4, iDist    );
-        xTZSearchHelp( rcStruct, iRight,   iStartY,   5, iDist    );
-        xTZSearchHelp( rcStruct, iLeft_2,  iBottom_2, 6, iDist>>1 );
-        xTZSearchHelp( rcStruct, iRight_2, iBottom_2, 8, iDist>>1 );
-        xTZSearchHelp( rcStruct, iStartX,  iBottom,   7, iDist    );
+        const TZSearchPoint acPoints[8] =
+        {
+          { iStartX,  iTop,      2, UInt( iDist    ) },
+          { iLeft_2,  iTop_2,    1, UInt( iDist>>1 ) },
+          { iRight_2, iTop_2,    3, UInt( iDist>>1 ) },
+          { iLeft,    iStartY,   4, UInt( iDist    ) },
+          { iRight,   iStartY,   5, UInt( iDist    ) },
+          { iLeft_2,  iBottom_2, 6, UInt( iDist>>1 ) },
+          { iRight_2, iBottom_2, 8, UInt( iDist>>1 ) },
+          { iStartX,  iBottom,   7, UInt( iDist    ) }
+        };
+        xTZSearchHelpBatch( rcStruct, acPoints, 8 );
       }
       else // check border
       {
@@ -675,21 +834,26 @@ inline Void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
       if ( iTop >= sr.top && iLeft >= sr.left &&
            iRight <= sr.right && iBottom <= sr.bottom ) // check border
       {
-        xTZSearchHelp( rcStruct, iStartX, iTop,    0, iDist );
-        xTZSearchHelp( rcStruct, iLeft,   iStartY, 0, iDist );
-        xTZSearchHelp( rcStruct, iRight,  iStartY, 0, iDist );
-        xTZSearchHelp( rcStruct, iStartX, iBottom, 0, iDist );
+        TZSearchPoint acPoints[16] =
+        {
+          { iStartX, iTop,    0, UInt( iDist ) },
+          { iLeft,   iStartY, 0, UInt( iDist ) },
+          { iRight,  iStartY, 0, UInt( iDist ) },
+          { iStartX, iBottom, 0, UInt( iDist ) }
+        };
+        Int iNumPoints = 4;
         for ( Int index = 1; index < 4; index++ )
         {
           const Int iPosYT = iTop    + ((iDist>>2) * index);
           const Int iPosYB = iBottom - ((iDist>>2) * index);
           const Int iPosXL = iStartX - ((iDist>>2) * index);
           const Int iPosXR = iStartX + ((iDist>>2) * index);
-          xTZSearchHelp( rcStruct, iPosXL, iPosYT, 0, iDist );
-          xTZSearchHelp( rcStruct, iPosXR, iPosYT, 0, iDist );
-          xTZSearchHelp( rcStruct, iPosXL, iPosYB, 0, iDist );
-          xTZSearchHelp( rcStruct, iPosXR, iPosYB, 0, iDist );
+          acPoints[iNumPoints++] = { iPosXL, iPosYT, 0, UInt( iDist ) };
+          acPoints[iNumPoints++] = { iPosXR, iPosYT, 0, UInt( iDist ) };
+          acPoints[iNumPoints++] = { iPosXL, iPosYB, 0, UInt( iDist ) };
+          acPoints[iNumPoints++] = { iPosXR, iPosYB, 0, UInt( iDist ) };
         }
+        xTZSearchHelpBatch( rcStruct, acPoints, iNumPoints );
       }
       else // check border
       {
@@ -758,6 +922,7 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
   m_pcRdCost->setDistParam( m_cDistParam, *pcPatternKey, m_filteredBlock[0][0][0], iRefStride, m_lumaClpRng.bd, COMPONENT_Y, 0, 1, m_pcEncCfg->getUseHADME() && bAllowUseOfHadamard );
 
   const Mv* pcMvRefine = (iFrac == 2 ? s_acMvRefineH : s_acMvRefineQ);
+  const Pel* apRefPos[9];
   for (UInt i = 0; i < 9; i++)
   {
     Mv cMvTest = pcMvRefine[i];
@@ -775,12 +940,31 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
     {
       piRefPos += iRefStride;
     }
-    cMvTest = pcMvRefine[i];
-    cMvTest += rcMvFrac;
+    apRefPos[i] = piRefPos;
+  }
+
+  // the SAD of all positions in one call, an early terminated SAD would exceed the best cost as well, so the
+  // choice is the same; the Hadamard cost has no batched version and is evaluated per position
+  Distortion auiDist[9];
+  if( m_cDistParam.distBatchFunc )
+  {
+    m_cDistParam.distBatchFunc( m_cDistParam, apRefPos, 9, auiDist );
+  }
 
+  for (UInt i = 0; i < 9; i++)
+  {
+    Mv cMvTest = pcMvRefine[i];
+    cMvTest += rcMvFrac;
 
-    m_cDistParam.cur.buf   = piRefPos;
-    uiDist = m_cDistParam.distFunc( m_cDistParam );
+    if( m_cDistParam.distBatchFunc )
+    {
+      uiDist = auiDist[i];
+    }
+    else
+    {
+      m_cDistParam.cur.buf = apRefPos[i];
+      uiDist = m_cDistParam.distFunc( m_cDistParam );
+    }
     uiDist += m_pcRdCost->getCostOfVectorWithPredictor( cMvTest.getHor(), cMvTest.getVer() );
 
     if ( uiDist < uiDistBest )
@@ -1761,24 +1945,47 @@ Void InterSearch::xPatternSearch( IntTZSearchStruct&    cStruct,
   const SearchRange& sr = cStruct.searchRange;
 
   const Pel* piRef = cStruct.piRefY + (sr.top * cStruct.iRefStride);
+  const Pel* apRef [TZ_SEARCH_BATCH_SIZE];
+  Distortion auiSad[TZ_SEARCH_BATCH_SIZE];
   for ( Int y = sr.top; y <= sr.bottom; y++ )
   {
-    for ( Int x = sr.left; x <= sr.right; x++ )
+    for ( Int x0 = sr.left; x0 <= sr.right; x0 += TZ_SEARCH_BATCH_SIZE )
     {
-      //  find min. distortion position
-      m_cDistParam.cur.buf = piRef + x;
-
-      uiSad = m_cDistParam.distFunc( m_cDistParam );
+      const Int iNum = std::min( TZ_SEARCH_BATCH_SIZE, sr.right - x0 + 1 );
 
-      // motion cost
-      uiSad += m_pcRdCost->getCostOfVectorWithPredictor( x, y );
+      if( m_cDistParam.distBatchFunc )
+      {
+        for( Int i = 0; i < iNum; i++ )
+        {
+          apRef[i] = piRef + x0 + i;
+        }
+        m_cDistParam.distBatchFunc( m_cDistParam, apRef, iNum, auiSad );
+      }
 
-      if ( uiSad < uiSadBest )
+      for ( Int x = x0; x < x0 + iNum; x++ )
       {
-        uiSadBest = uiSad;
-        iBestX    = x;
-        iBestY    = y;
-        m_cDistParam.maximumDistortionForEarlyExit = uiSad;
+        //  find min. distortion position
+        if( m_cDistParam.distBatchFunc )
+        {
+          uiSad = auiSad[x - x0];
+        }
+        else
+        {
+          m_cDistParam.cur.buf = piRef + x;
+
+          uiSad = m_cDistParam.distFunc( m_cDistParam );
+        }
+
+        // motion cost
+        uiSad += m_pcRdCost->getCostOfVectorWithPredictor( x, y );
+
+        if ( uiSad < uiSadBest )
+        {
+          uiSadBest = uiSad;
+          iBestX    = x;
+          iBestY    = y;
+          m_cDistParam.maximumDistortionForEarlyExit = uiSad;
+        }
       }
     }
     piRef += cStruct.iRefStride;
@@ -1997,10 +2204,7 @@ Void InterSearch::xTZSearch( const PredictionUnit& pu,
     cStruct.uiBestDistance = iWindowSize;
     for ( iStartY = localsr.top; iStartY <= localsr.bottom; iStartY += iWindowSize )
     {
-      for ( iStartX = localsr.left; iStartX <= localsr.right; iStartX += iWindowSize )
-      {
-        xTZSearchHelp( cStruct, iStartX, iStartY, 0, iWindowSize );
-      }
+      xTZRasterSearchRow( cStruct, localsr.left, localsr.right, iStartY, iWindowSize );
     }
   }
   else
@@ -2010,10 +2214,7 @@ Void InterSearch::xTZSearch( const PredictionUnit& pu,
       cStruct.uiBestDistance = iRaster;
       for ( iStartY = sr.top; iStartY <= sr.bottom; iStartY += iRaster )
       {
-        for ( iStartX = sr.left; iStartX <= sr.right; iStartX += iRaster )
-        {
-          xTZSearchHelp( cStruct, iStartX, iStartY, 0, iRaster );
-        }
+        xTZRasterSearchRow( cStruct, sr.left, sr.right, iStartY, iRaster );
       }
     }
   }
@@ -2873,21 +3074,10 @@ Void InterSearch::xEstimateInterResidualQT(CodingStructure &cs, Partitioner &par
       SChar preCalcAlpha = 0;
       const CPelBuf lumaResi = csFull->getResiBuf(tu.Y());
 
-#if INTER_RESI_OUTPUT
-      extern std::string statLogFileName;
-      extern ofstream fout;
-      if (compID == COMPONENT_Y && tu.lwidth() == KLT_SIZE && tu.lheight() == KLT_SIZE)
+      if( m_pcResidualCapture && m_pcResidualCapture->isActive( MODE_INTER ) )
       {
-        for (int y = 0, pos = 0; y < lumaResi.height; y++, pos += lumaResi.stride)
-        {
-          for (int x = 0; x < lumaResi.width; x++)
-          {
-            fout << lumaResi.buf[pos + x] << " ";
-          }
-        }
-        fout << endl;
+        m_pcResidualCapture->capture( cs.getOrgResiBuf( compArea ), compID, MODE_INTER, 0, tu.cu->qp );
       }
-#endif
 
       if (isCrossCPredictionAvailable)
       {
@@ -2901,6 +3091,13 @@ Void InterSearch::xEstimateInterResidualQT(CodingStructure &cs, Partitioner &par
       const int numTransformCandidates = checkTransformSkip[compID] ? (numKltTransformCandidates + 1) : numKltTransformCandidates;
 #else
       const int numTransformCandidates      = checkTransformSkip[compID] ? 2 : 1;
+#endif
+#if ENABLE_KLT_PARALLELISM
+      if( m_numKltThreads > 1 && numKltTransformCandidates > 1 && !checkTransformSkip[compID] && crossCPredictionModesToTest == 1 )
+      {
+        xInterKltCandsParallel( *csFull, tu, partitioner, ctxStart, numKltTransformCandidates, puiZeroDist, uiAbsSum[compID], uiSingleDistComp[compID], minCost[compID] );
+        continue;
+      }
 #endif
       int lastTransformModeIndex            = numTransformCandidates - 1; //lastTransformModeIndex is the mode for transformSkip (if transformSkip is active)
       const Bool isOneMode                  = crossCPredictionModesToTest == 1 && numTransformCandidates == 1;
@@ -3324,6 +3521,154 @@ Void InterSearch::xEstimateInterResidualQT(CodingStructure &cs, Partitioner &par
 #endif
 }
 
+#if ENABLE_KLT_PARALLELISM
+Void InterSearch::xInterKltCandsParallel( CodingStructure &cs, TransformUnit &tu, Partitioner &partitioner, const Ctx &ctxStart, const Int numCands, Distortion *puiZeroDist, TCoeff &absSum, Distortion &dist, Double &cost )
+{
+  CHECK( numCands > PARL_KLT_MAX_NUM_JOBS, "Too many KLT transform candidates" );
+
+  const CompArea &area = tu.Y();
+
+  // the zero residual is the same for all candidates, derive its cost once
+  m_CABACEstimator->getCtx() = ctxStart;
+  m_CABACEstimator->resetBits();
+#if HEVC_USE_RQT || ENABLE_BMS
+  m_CABACEstimator->cbf_comp( cs, false, area, partitioner.currTrDepth );
+#else
+  m_CABACEstimator->cbf_comp( cs, false, area );
+#endif
+
+  const UInt64     zeroFracBits = m_CABACEstimator->getEstFracBits();
+  const Distortion zeroDist     = m_pcRdCost->getDistPart( CPelBuf( m_pTempPel, area ), cs.getOrgResiBuf( area ), cs.sps->getBitDepth( CHANNEL_TYPE_LUMA ), COMPONENT_Y, DF_SSE );
+#if WCG_EXT
+  const Double     zeroCost     = m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() ? m_pcRdCost->calcRdCost( zeroFracBits, zeroDist, false ) : m_pcRdCost->calcRdCost( zeroFracBits, zeroDist );
+#else
+  const Double     zeroCost     = m_pcRdCost->calcRdCost( zeroFracBits, zeroDist );
+#endif
+
+  if( puiZeroDist )
+  {
+    *puiZeroDist += zeroDist;
+  }
+
+  TransformUnit* candTU    [PARL_KLT_MAX_NUM_JOBS];
+  TCoeff         candAbsSum[PARL_KLT_MAX_NUM_JOBS];
+  Distortion     candDist  [PARL_KLT_MAX_NUM_JOBS];
+  Double         candCost  [PARL_KLT_MAX_NUM_JOBS];
+
+  const Int numTasks = std::min( numCands, m_numKltThreads );
+
+  m_threadPool->run( numTasks, [&]( int tId )
+  {
+    for( Int i = tId; i < numCands; i += numTasks )
+    {
+      candTU[i] = &xInterKltCandJob( m_kltJobs[i], cs, partitioner, ctxStart, UChar( i ), candAbsSum[i], candDist[i], candCost[i] );
+    }
+  } );
+
+  // take the first best candidate as the sequential search does, a candidate without coefficients costs the zero residual
+  Int  bestId   = 0;
+  Bool zeroBest = candAbsSum[0] == 0 || ( !cs.isLossless && zeroCost < candCost[0] );
+  cost          = zeroBest ? zeroCost : candCost[0];
+
+  for( Int i = 1; i < numCands; i++ )
+  {
+    const Double currCost = candAbsSum[i] > 0 ? candCost[i] : zeroCost;
+
+    if( currCost < cost )
+    {
+      bestId   = i;
+      zeroBest = candAbsSum[i] == 0;
+      cost     = currCost;
+    }
+  }
+
+  const TransformUnit &bestTU = *candTU[bestId];
+
+  tu.copyComponentFrom( bestTU, COMPONENT_Y );
+
+  if( zeroBest )
+  {
+    tu.getCoeffs( COMPONENT_Y ).fill( 0 );
+    cs.getResiBuf( area ).fill( 0 );
+    tu.cbf[COMPONENT_Y] = 0;
+
+    absSum = 0;
+    dist   = zeroDist;
+  }
+  else
+  {
+    cs.getResiBuf( area ).copyFrom( bestTU.cs->getResiBuf( area ) );
+
+    absSum = candAbsSum[bestId];
+    dist   = candDist  [bestId];
+  }
+}
+
+TransformUnit& InterSearch::xInterKltCandJob( InterKltJob &job, CodingStructure &parentCS, Partitioner &partitioner, const Ctx &ctxStart, const UChar kltIdx, TCoeff &absSum, Distortion &dist, Double &cost )
+{
+  CodingStructure &cs = *job.cs[gp_sizeIdxInfo->idxFrom( parentCS.area.lwidth() )][gp_sizeIdxInfo->idxFrom( parentCS.area.lheight() )];
+
+  // own copy of the CU and PU, the units are taken from the cache of this job
+  parentCS.initSubStructure( cs, partitioner.chType, parentCS.area, true );
+
+  TransformUnit &tu = cs.addTU( partitioner.currArea(), partitioner.chType );
+#if HEVC_USE_RQT || ENABLE_BMS
+  tu.depth                      = partitioner.currTrDepth;
+#endif
+  tu.kltIdx                     = kltIdx;
+  tu.transformSkip[COMPONENT_Y] = false;
+  tu.compAlpha    [COMPONENT_Y] = 0;
+
+  const CompArea &area       = tu.Y();
+  PelBuf          resiBuf    = cs.getResiBuf( area );
+  const CPelBuf   orgResiBuf = parentCS.getOrgResiBuf( area );
+
+  resiBuf.copyFrom( orgResiBuf );
+
+  CABACWriter &cabacEstimator = *job.cabacEncoder.getCABACEstimator( cs.sps );
+
+  job.trQuant.copyState( *m_pcTrQuant );
+#if RDOQ_CHROMA_LAMBDA
+  job.trQuant.selectLambda( COMPONENT_Y );
+#endif
+  cabacEstimator.getCtx() = ctxStart;
+  cabacEstimator.resetBits();
+
+  const QpParam cQP( tu, COMPONENT_Y );
+
+  absSum = 0;
+  job.trQuant.transformNxN( tu, COMPONENT_Y, cQP, absSum, cabacEstimator.getCtx() );
+
+  if( absSum == 0 )
+  {
+    // the caller takes the zero residual cost
+    dist = 0;
+    cost = MAX_DOUBLE;
+    return tu;
+  }
+
+#if HEVC_USE_RQT || ENABLE_BMS
+  cabacEstimator.cbf_comp( cs, true, area, partitioner.currTrDepth );
+#else
+  cabacEstimator.cbf_comp( cs, true, area );
+#endif
+  cabacEstimator.residual_coding( tu, COMPONENT_Y );
+
+  const UInt64 fracBits = cabacEstimator.getEstFracBits();
+
+  job.trQuant.invTransformNxN( tu, COMPONENT_Y, resiBuf, cQP );
+
+  dist = m_pcRdCost->getDistPart( orgResiBuf, resiBuf, cs.sps->getBitDepth( CHANNEL_TYPE_LUMA ), COMPONENT_Y, DF_SSE );
+#if WCG_EXT
+  cost = m_pcRdCost->calcRdCost( fracBits, dist, false );
+#else
+  cost = m_pcRdCost->calcRdCost( fracBits, dist );
+#endif
+
+  return tu;
+}
+
+#endif
 Void InterSearch::encodeResAndCalcRdInterCU(CodingStructure &cs, Partitioner &partitioner, const Bool &skipResidual)
 {
   CodingUnit &cu = *cs.getCU( partitioner.chType );
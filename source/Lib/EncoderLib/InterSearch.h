@@ -41,6 +41,7 @@
 // Include files
 #include "CABACWriter.h"
 #include "EncCfg.h"
+#include "ResidualCapture.h"
 
 #include "CommonLib/MotionInfo.h"
 #include "CommonLib/InterPrediction.h"
@@ -62,6 +63,10 @@ static const UInt MAX_IDX_ADAPT_SR          = 33;
 static const UInt NUM_MV_PREDICTORS         = 3;
 
 class EncModeCtrl;
+#if ENABLE_KLT_PARALLELISM
+struct InterKltJob;
+class ThreadPool;
+#endif
 
 /// encoder search class
 class InterSearch : public InterPrediction, CrossComponentPrediction
@@ -82,6 +87,13 @@ private:
 
   ClpRng          m_lumaClpRng;
 
+#if ENABLE_KLT_PARALLELISM
+  // each job evaluates one inter KLT transform candidate with its own TrQuant and CABAC estimator
+  InterKltJob*    m_kltJobs;
+  Int             m_numKltThreads;
+  ThreadPool*     m_threadPool;
+#endif
+
 
 protected:
   // interface to option
@@ -89,6 +101,7 @@ protected:
 
   // interface to classes
   TrQuant*        m_pcTrQuant;
+  ResidualCapture* m_pcResidualCapture;
 
   // ME parameters
   Int             m_iSearchRange;
@@ -132,6 +145,10 @@ public:
   Void destroy                      ();
 
   Void setTempBuffers               (CodingStructure ****pSlitCS, CodingStructure ****pFullCS, CodingStructure **pSaveCS );
+  Void setResidualCapture           (ResidualCapture *residualCapture) { m_pcResidualCapture = residualCapture; }
+#if ENABLE_KLT_PARALLELISM
+  Void setThreadPool                (ThreadPool *threadPool) { m_threadPool = threadPool; }
+#endif
 
 #if ENABLE_SPLIT_PARALLELISM
   Void copyState                    ( const InterSearch& other );
@@ -165,8 +182,19 @@ protected:
     Int         subShiftMode;
   } IntTZSearchStruct;
 
+  typedef struct
+  {
+    Int         iSearchX;
+    Int         iSearchY;
+    UChar       ucPointNr;
+    UInt        uiDistance;
+  } TZSearchPoint;
+
   // sub-functions for ME
   inline Void xTZSearchHelp         ( IntTZSearchStruct& rcStruct, const Int iSearchX, const Int iSearchY, const UChar ucPointNr, const UInt uiDistance );
+  inline Void xTZSearchHelpBatch    ( IntTZSearchStruct& rcStruct, const TZSearchPoint* pcPoints, const Int iNumPoints );
+  inline Void xTZSearchCheckBest    ( IntTZSearchStruct& rcStruct, Distortion uiSad, const Int iSearchX, const Int iSearchY, const UChar ucPointNr, const UInt uiDistance );
+  inline Void xTZRasterSearchRow    ( IntTZSearchStruct& rcStruct, const Int iLeft, const Int iRight, const Int iSearchY, const Int iStep );
   inline Void xTZ2PointSearch       ( IntTZSearchStruct& rcStruct );
   inline Void xTZ8PointSquareSearch ( IntTZSearchStruct& rcStruct, const Int iStartX, const Int iStartY, const Int iDist );
   inline Void xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct, const Int iStartX, const Int iStartY, const Int iDist, const Bool bCheckCornersAtDist1 );
@@ -326,6 +354,11 @@ public:
   Void xEncodeInterResidualQT     (CodingStructure &cs, Partitioner &partitioner, const ComponentID &compID);
   Void xEstimateInterResidualQT   (CodingStructure &cs, Partitioner &partitioner, Distortion *puiZeroDist = NULL);
   UInt64 xGetSymbolFracBitsInter  (CodingStructure &cs, Partitioner &partitioner);
+#if ENABLE_KLT_PARALLELISM
+  Void xInterKltCandsParallel     (CodingStructure &cs, TransformUnit &tu, Partitioner &partitioner, const Ctx &ctxStart, const Int numCands, Distortion *puiZeroDist, TCoeff &absSum, Distortion &dist, Double &cost);
+  TransformUnit&
+       xInterKltCandJob           (InterKltJob &job, CodingStructure &parentCS, Partitioner &partitioner, const Ctx &ctxStart, const UChar kltIdx, TCoeff &absSum, Distortion &dist, Double &cost);
+#endif
 
 #if HM_REPRODUCE_4x4_BLOCK_ESTIMATION_ORDER
 private:
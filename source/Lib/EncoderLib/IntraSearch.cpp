@@ -43,6 +43,7 @@
 #include "CommonLib/Rom.h"
 #include "CommonLib/Picture.h"
 #include "CommonLib/UnitTools.h"
+#include "CommonLib/ThreadPool.h"
 
 #include "CommonLib/dtrace_next.h"
 #include "CommonLib/dtrace_buffer.h"
@@ -50,22 +51,40 @@
 #include <math.h>
 #include <limits>
 
-#if INTRA_RESI_OUTPUT
-#include <fstream>
-using namespace std;
-#endif
-
  //! \ingroup EncoderLib
  //! \{
 
+#if ENABLE_KLT_PARALLELISM
+struct IntraKltJob
+{
+  IntraSearch  search;
+  TrQuant      trQuant;
+  CABACEncoder cabacEncoder;
+  CtxCache     ctxCache;
+};
+
+#endif
+
 IntraSearch::IntraSearch()
   : m_modeCtrl      (nullptr)
   , m_pSplitCS      (nullptr)
   , m_pFullCS       (nullptr)
   , m_pBestCS       (nullptr)
+#if SEPARABLE_KLT
+  , m_pSavedPred    (nullptr)
+  , m_savedPredMode (-1)
+  , m_loadSavedPred (false)
+#endif
+#if ENABLE_KLT_PARALLELISM
+  , m_kltJobs       (nullptr)
+  , m_numKltThreads (1)
+  , m_isKltJob      (false)
+  , m_threadPool    (nullptr)
+#endif
   , m_pcEncCfg      (nullptr)
   , m_pcTrQuant     (nullptr)
   , m_pcRdCost      (nullptr)
+  , m_pcResidualCapture(nullptr)
   , m_CABACEstimator(nullptr)
   , m_CtxCache      (nullptr)
   , m_isInitialized (false)
@@ -157,6 +176,16 @@ Void IntraSearch::destroy()
     delete[] m_pSharedPredTransformSkip[ch];
     m_pSharedPredTransformSkip[ch] = nullptr;
   }
+#if SEPARABLE_KLT
+
+  delete[] m_pSavedPred;
+  m_pSavedPred = nullptr;
+#endif
+#if ENABLE_KLT_PARALLELISM
+
+  delete[] m_kltJobs;
+  m_kltJobs = nullptr;
+#endif
 
   m_isInitialized = false;
 }
@@ -194,6 +223,11 @@ Void IntraSearch::init( EncCfg*        pcEncCfg,
   {
     m_pSharedPredTransformSkip[ch] = new Pel[MAX_CU_SIZE * MAX_CU_SIZE];
   }
+#if SEPARABLE_KLT
+
+  m_pSavedPred = new Pel[NUM_LUMA_MODE * KLT_INTRA_MAX_CU_WITH_QTBT * KLT_INTRA_MAX_CU_WITH_QTBT];
+  memset( m_savedPredValid, 0, sizeof( m_savedPredValid ) );
+#endif
 
   UInt numWidths  = gp_sizeIdxInfo->numWidths();
   UInt numHeights = gp_sizeIdxInfo->numHeights();
@@ -264,6 +298,36 @@ Void IntraSearch::init( EncCfg*        pcEncCfg,
     m_pSaveCS[depth]->create( UnitArea( cform, Area( 0, 0, maxCUWidth, maxCUHeight ) ), false );
   }
 
+#if ENABLE_KLT_PARALLELISM
+  m_numKltThreads = m_isKltJob ? 1 : pcEncCfg->getNumKltThreads();
+
+  if( m_numKltThreads > 1 )
+  {
+    m_kltJobs = new IntraKltJob[PARL_KLT_MAX_NUM_JOBS];
+
+    for( Int jId = 0; jId < PARL_KLT_MAX_NUM_JOBS; jId++ )
+    {
+      IntraKltJob &job = m_kltJobs[jId];
+
+      job.trQuant.init( pcTrQuant->getQuant(),
+                        1 << pcEncCfg->getQuadtreeTULog2MaxSize(),
+                        pcEncCfg->getUseRDOQ(),
+                        pcEncCfg->getUseRDOQTS(),
+#if T0196_SELECTIVE_RDOQ
+                        pcEncCfg->getUseSelectiveRDOQ(),
+#endif
+                        true,
+                        pcEncCfg->getUseTransformSkipFast(),
+                        pcEncCfg->getQTBT(),
+                        pcEncCfg->getUseRDOQSkipZeroCG() );
+
+      // the RD cost functions are only read, the parent's instance is shared
+      job.search.m_isKltJob = true;
+      job.search.init( pcEncCfg, &job.trQuant, pcRdCost, job.cabacEncoder.getCABACEstimator( nullptr ), &job.ctxCache, maxCUWidth, maxCUHeight, maxTotalCUDepth );
+    }
+  }
+
+#endif
   m_isInitialized = true;
 }
 
@@ -457,6 +521,18 @@ Void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
         // Store the modes to be checked with RD
         m_savedNumRdModes[0] = numModesForFullRD;
         std::copy_n( uiRdModeList.begin(), numModesForFullRD, m_savedRdModeList[0] );
+
+        m_bestModeCostStore[0] = MAX_DOUBLE;
+        for( Int i = 0; i < numModesForFullRD; i++ )
+        {
+          m_modeCostStore[0][uiRdModeList[i]] = MAX_DOUBLE;
+        }
+        memset( m_savedPredValid, 0, sizeof( m_savedPredValid ) );
+        m_savedPredArea = pu.Y();
+        for( Int i = 0; i < NUM_LUMA_MODE; i++ )
+        {
+          m_savedHeaderCtx[i].reset();
+        }
       }
 #endif
     }
@@ -470,6 +546,20 @@ Void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
         uiRdModeList.resize( numModesForFullRD );
         std::copy_n( m_savedRdModeList[0], m_savedNumRdModes[0], uiRdModeList.begin() );
       }
+
+      // check the modes in the order of their DCT2 RD cost, dropping the ones far behind the best one
+      const Double *modeCost = m_modeCostStore[0];
+      const Double  maxCost  = m_bestModeCostStore[0] * KLT_RD_MODE_COST_RATIO;
+
+      std::stable_sort( uiRdModeList.begin(), uiRdModeList.end(), [modeCost]( const UInt a, const UInt b ) { return modeCost[a] < modeCost[b]; } );
+
+      const Int maxNumModes = std::min<Int>( numModesForFullRD, KLT_NUM_RD_MODES );
+      numModesForFullRD = 1;
+      while( numModesForFullRD < maxNumModes && modeCost[uiRdModeList[numModesForFullRD]] <= maxCost )
+      {
+        numModesForFullRD++;
+      }
+      uiRdModeList.resize( numModesForFullRD );
     }
 #endif
 
@@ -532,11 +622,25 @@ Void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
       // determine residual for partition
       cs.initSubStructure( *csTemp, partitioner.chType, cs.area, true );
 
+#if SEPARABLE_KLT
+      // the DCT2 pass saves the prediction of each mode for the KLT pass
+      m_savedPredMode = sps.getSpsNext().getUseIntraKLT() ? ( Int ) uiOrgMode : -1;
+      m_loadSavedPred = kltUsageFlag == 2;
+
+#endif
 #if ENABLE_RQT_INTRA_SPEEDUP
       xRecurIntraCodingLumaQT( *csTemp, partitioner, true );
 #else
       xRecurIntraCodingLumaQT( *csTemp, partitioner );
 #endif
+#if SEPARABLE_KLT
+
+      if( kltUsageFlag == 1 )
+      {
+        m_modeCostStore[0][uiOrgMode] = csTemp->cost;
+        m_bestModeCostStore[0]        = std::min( m_bestModeCostStore[0], csTemp->cost );
+      }
+#endif
 
 
 
@@ -555,15 +659,6 @@ Void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
         uiBestPUMode  = uiOrgMode;
 
       }
-#if SEPARABLE_KLT & INTRA_RESI_OUTPUT
-      if ( cu.kltFlag && partitioner.currArea().lwidth() == KLT_SIZE && partitioner.currArea().lheight() == KLT_SIZE )
-      {
-        extern ofstream fout;
-        const UnitArea&       area = partitioner.currArea();
-        const TransformUnit&  tu = *csBest->getTU(area.blocks[partitioner.chType].pos(), partitioner.chType);
-        fout << (Int)tu.kltIdx << endl;
-      }
-#endif
 
 #if ENABLE_RQT_INTRA_SPEEDUP_MOD
       else if( csTemp->cost < dSecondBestPUCost )
@@ -575,6 +670,10 @@ Void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
 
       csTemp->releaseIntermediateData();
     } // Mode loop
+#if SEPARABLE_KLT
+    m_savedPredMode = -1;
+    m_loadSavedPred = false;
+#endif
 #if HEVC_USE_RQT
     // don't need to run full depth search - with QTBT there is only tr depth 0
     if( !cs.pcv->noRQT && pu.lwidth() > MIN_TU_SIZE )
@@ -1194,10 +1293,44 @@ Void IntraSearch::xEncCoeffQT(CodingStructure &cs, Partitioner &partitioner, con
 }
 
 UInt64 IntraSearch::xGetIntraFracBitsQT( CodingStructure &cs, Partitioner &partitioner, const Bool &bLuma, const Bool &bChroma )
+{
+  const UInt64 headerBits = xGetIntraHeaderFracBits( cs, partitioner, bLuma, bChroma );
+
+  return headerBits + xGetIntraResiFracBitsQT( cs, partitioner, bLuma, bChroma );
+}
+
+UInt64 IntraSearch::xGetIntraHeaderFracBits( CodingStructure &cs, Partitioner &partitioner, const Bool &bLuma, const Bool &bChroma )
 {
   m_CABACEstimator->resetBits();
 
+#if SEPARABLE_KLT
+  // the luma header does not depend on the transform, the KLT pass takes its bits and contexts from the DCT2 pass
+  const Bool savedHeader = m_savedPredMode >= 0 && bLuma && !bChroma && partitioner.currArea().lumaPos() == cs.area.lumaPos();
+
+  if( savedHeader && m_loadSavedPred && m_savedHeaderCtx[m_savedPredMode].getIfValid( m_CABACEstimator->getCtx() ) )
+  {
+    return m_savedHeaderBits[m_savedPredMode];
+  }
+
+#endif
   xEncIntraHeader( cs, partitioner, bLuma, bChroma );
+
+  const UInt64 headerBits = m_CABACEstimator->getEstFracBits();
+  m_CABACEstimator->resetBits();
+
+#if SEPARABLE_KLT
+  if( savedHeader && !m_loadSavedPred )
+  {
+    m_savedHeaderBits[m_savedPredMode] = headerBits;
+    m_savedHeaderCtx [m_savedPredMode].store( m_CABACEstimator->getCtx() );
+  }
+
+#endif
+  return headerBits;
+}
+
+UInt64 IntraSearch::xGetIntraResiFracBitsQT( CodingStructure &cs, Partitioner &partitioner, const Bool &bLuma, const Bool &bChroma )
+{
   xEncSubdivCbfQT( cs, partitioner, bLuma, bChroma );
 
   if( bLuma )
@@ -1231,6 +1364,66 @@ UInt64 IntraSearch::xGetIntraFracBitsQTChroma(TransformUnit& currTU, const Compo
   return fracBits;
 }
 
+Void IntraSearch::xIntraPredTUBlock( TransformUnit &tu, const ComponentID &compID, const Int &default0Save1Load2 )
+{
+  CodingStructure &cs         = *tu.cs;
+  const CompArea  &area       = tu.blocks[compID];
+  const ChannelType chType    = toChannelType( compID );
+  PelBuf           piPred     = cs.getPredBuf( area );
+  const PredictionUnit &pu    = *cs.getPU( area.pos(), chType );
+
+  //===== init availability pattern =====
+  PelBuf sharedPredTS( m_pSharedPredTransformSkip[compID], area );
+  if( default0Save1Load2 != 2 )
+  {
+#if SEPARABLE_KLT
+    if( m_loadSavedPred && xUseSavedPred( tu, compID ) )
+    {
+      // the prediction does not depend on the transform, take the one of the DCT2 pass
+      piPred.copyFrom( xGetSavedPredBuf( m_savedPredMode, area ) );
+    }
+    else
+#endif
+    {
+      const bool bUseFilteredPredictions = IntraPrediction::useFilteredIntraRefSamples( compID, pu, true, tu );
+      initIntraPatternChType( *tu.cu, area, bUseFilteredPredictions );
+
+      //===== get prediction signal =====
+      predIntraAng( compID, piPred, pu, bUseFilteredPredictions );
+
+      // the KLT pass repeats the predictions of the DCT2 pass, capture them only once
+      if( m_pcResidualCapture && m_pcResidualCapture->isActive( MODE_INTRA )
+#if SEPARABLE_KLT
+          && !tu.cu->kltFlag
+#endif
+        )
+      {
+        m_pcResidualCapture->capture( cs.getOrgBuf( area ), piPred, compID, MODE_INTRA, PU::getFinalIntraMode( pu, chType ), tu.cu->qp );
+      }
+#if SEPARABLE_KLT
+
+      if( xUseSavedPred( tu, compID ) )
+      {
+        xGetSavedPredBuf( m_savedPredMode, area ).copyFrom( piPred );
+        m_savedPredValid[m_savedPredMode] = true;
+      }
+#endif
+    }
+
+
+    // save prediction
+    if( default0Save1Load2 == 1 )
+    {
+      sharedPredTS.copyFrom( piPred );
+    }
+  }
+  else
+  {
+    // load prediction
+    piPred.copyFrom( sharedPredTS );
+  }
+}
+
 Void IntraSearch::xIntraCodingTUBlock(TransformUnit &tu, const ComponentID &compID, const Bool &checkCrossCPrediction, Distortion& ruiDist, const Int &default0Save1Load2, UInt* numSig )
 {
   if (!tu.blocks[compID].valid())
@@ -1262,31 +1455,8 @@ Void IntraSearch::xIntraCodingTUBlock(TransformUnit &tu, const ComponentID &comp
   const Bool           ccUseRecoResi        = m_pcEncCfg->getUseReconBasedCrossCPredictionEstimate();
 
 
-  //===== init availability pattern =====
-  PelBuf sharedPredTS( m_pSharedPredTransformSkip[compID], area );
-  if( default0Save1Load2 != 2 )
-  {
-    const bool bUseFilteredPredictions = IntraPrediction::useFilteredIntraRefSamples( compID, pu, true, tu );
-    initIntraPatternChType( *tu.cu, area, bUseFilteredPredictions );
-
-    //===== get prediction signal =====
-    {
-      predIntraAng( compID, piPred, pu, bUseFilteredPredictions );
-    }
-
-
-    // save prediction
-    if( default0Save1Load2 == 1 )
-    {
-      sharedPredTS.copyFrom( piPred );
-    }
-  }
-  else
-  {
-    // load prediction
-    piPred.copyFrom( sharedPredTS );
-  }
-
+  //===== get prediction signal =====
+  xIntraPredTUBlock( tu, compID, default0Save1Load2 );
 
   DTRACE( g_trace_ctx, D_PRED, "@(%4d,%4d) [%2dx%2d] IMode=%d\n", tu.lx(), tu.ly(), tu.lwidth(), tu.lheight(), uiChFinalMode );
   //DTRACE_PEL_BUF( D_PRED, piPred, tu, tu.cu->predMode, COMPONENT_Y );
@@ -1295,34 +1465,6 @@ Void IntraSearch::xIntraCodingTUBlock(TransformUnit &tu, const ComponentID &comp
   piResi.copyFrom( piOrg  );
   piResi.subtract( piPred );
 
-#if INTRA_RESI_OUTPUT
-  extern std::string statLogFileName;
-  extern ofstream fout;
-  if (compID == COMPONENT_Y && tu.lwidth() == KLT_SIZE && tu.lheight() == KLT_SIZE)
-  {
-#if SEPARABLE_KLT
-    if (tu.kltIdx == 2)
-    {
-#endif
-      const UInt uiDirMode = PU::getFinalIntraMode(pu, toChannelType(compID));
-
-      fout << (int)g_intraMode65to33AngMapping[uiDirMode] << " ";
-      for (int y = 0, pos = 0; y < piResi.height; y++, pos += piResi.stride)
-      {
-        for (int x = 0; x < piResi.width; x++)
-        {
-          fout << piResi.buf[pos + x] << " ";
-        }
-      }
-#if !SEPARABLE_KLT
-      fout << endl;
-#endif
-#if SEPARABLE_KLT
-    }
-#endif
-  }
-#endif
-
   if (pps.getPpsRangeExtension().getCrossComponentPredictionEnabledFlag() && isLuma(compID))
   {
     piOrgResi.copyFrom (piResi);
@@ -1386,6 +1528,120 @@ Void IntraSearch::xIntraCodingTUBlock(TransformUnit &tu, const ComponentID &comp
   }
 }
 
+#if ENABLE_KLT_PARALLELISM
+Void IntraSearch::xIntraKltCandsParallel( CodingStructure &cs, TransformUnit &tu, Partitioner &partitioner, const Int firstCheckId, const Int lastCheckId, Double &cost, Distortion &dist, UInt64 &fracBits )
+{
+  const Int numCands = lastCheckId - firstCheckId + 1;
+
+  CHECK( numCands > PARL_KLT_MAX_NUM_JOBS, "Too many KLT transform candidates" );
+
+  // the prediction is the same for all candidates, derive it once
+  xIntraPredTUBlock( tu, COMPONENT_Y, 1 );
+
+  const CPelBuf  sharedPred( m_pSharedPredTransformSkip[COMPONENT_Y], tu.Y() );
+
+  // the header is the same for all candidates as well, the jobs start after it
+  const UInt64   headerBits = xGetIntraHeaderFracBits( cs, partitioner, true, false );
+  const Ctx     &ctxHeader  = m_CABACEstimator->getCtx();
+
+  TransformUnit* candTU      [PARL_KLT_MAX_NUM_JOBS];
+  Double         candCost    [PARL_KLT_MAX_NUM_JOBS];
+  Distortion     candDist    [PARL_KLT_MAX_NUM_JOBS];
+  UInt64         candFracBits[PARL_KLT_MAX_NUM_JOBS];
+
+  const Int numTasks = std::min( numCands, m_numKltThreads );
+
+  m_threadPool->run( numTasks, [&]( int tId )
+  {
+    for( Int i = tId; i < numCands; i += numTasks )
+    {
+      candTU[i] = &m_kltJobs[i].search.xIntraKltCandJob( cs, partitioner, *m_pcTrQuant, ctxHeader, headerBits, sharedPred, UChar( firstCheckId + i ), candCost[i], candDist[i], candFracBits[i] );
+    }
+  } );
+
+  // take the first best candidate, as the sequential search does
+  Int bestId = 0;
+  for( Int i = 1; i < numCands; i++ )
+  {
+    if( candCost[i] < candCost[bestId] )
+    {
+      bestId = i;
+    }
+  }
+
+  const TransformUnit   &bestTU = *candTU[bestId];
+  const CodingStructure &bestCS = *bestTU.cs;
+
+  cs.getRecoBuf( tu.Y() ).copyFrom( bestCS.getRecoBuf( tu.Y() ) );
+
+  if( cs.pps->getPpsRangeExtension().getCrossComponentPredictionEnabledFlag() || KEEP_PRED_AND_RESI_SIGNALS )
+  {
+    cs.getResiBuf   ( tu.Y() ).copyFrom( bestCS.getResiBuf   ( tu.Y() ) );
+    cs.getOrgResiBuf( tu.Y() ).copyFrom( bestCS.getOrgResiBuf( tu.Y() ) );
+  }
+
+  tu.copyComponentFrom( bestTU, COMPONENT_Y );
+
+  m_CABACEstimator->getCtx() = m_kltJobs[bestId].search.m_CABACEstimator->getCtx();
+
+  cost     = candCost    [bestId];
+  dist     = candDist    [bestId];
+  fracBits = candFracBits[bestId];
+}
+
+TransformUnit& IntraSearch::xIntraKltCandJob( CodingStructure &parentCS, Partitioner &partitioner, const TrQuant &parentTrQuant, const Ctx &ctxHeader, const UInt64 headerBits, const CPelBuf &pred, const UChar kltIdx, Double &cost, Distortion &dist, UInt64 &fracBits )
+{
+  const UnitArea &currArea = partitioner.currArea();
+  CodingStructure &cs      = *m_pTempCS[gp_sizeIdxInfo->idxFrom( currArea.lwidth() )][gp_sizeIdxInfo->idxFrom( currArea.lheight() )];
+
+  // own copy of the CU and PU, the units are taken from the cache of this job
+  parentCS.initSubStructure( cs, partitioner.chType, parentCS.area, true );
+
+  TransformUnit &tu = cs.addTU( CS::getArea( cs, currArea, partitioner.chType ), partitioner.chType );
+#if HEVC_USE_RQT || ENABLE_BMS
+  tu.depth                      = partitioner.currTrDepth;
+#endif
+  tu.kltIdx                     = kltIdx;
+  tu.transformSkip[COMPONENT_Y] = false;
+
+  PelBuf( m_pSharedPredTransformSkip[COMPONENT_Y], tu.Y() ).copyFrom( pred );
+
+  m_pcTrQuant->copyState( parentTrQuant );
+  m_CABACEstimator->getCtx() = ctxHeader;
+  m_CABACEstimator->resetBits();
+
+  dist = 0;
+  xIntraCodingTUBlock( tu, COMPONENT_Y, false, dist, 2 );
+
+  fracBits = headerBits + xGetIntraResiFracBitsQT( cs, partitioner, true, false );
+  cost     = m_pcRdCost->calcRdCost( fracBits, dist );
+
+  return tu;
+}
+
+#endif
+#if SEPARABLE_KLT
+Bool IntraSearch::xUseSavedPred( const TransformUnit &tu, const ComponentID &compID ) const
+{
+  // only a TU covering the whole CU has the same reference samples in both passes
+  if( m_savedPredMode < 0 || compID != COMPONENT_Y || tu.Y() != tu.cu->Y() )
+  {
+    return false;
+  }
+  if( tu.lwidth() > KLT_INTRA_MAX_CU_WITH_QTBT || tu.lheight() > KLT_INTRA_MAX_CU_WITH_QTBT )
+  {
+    return false;
+  }
+
+  return !m_loadSavedPred || ( m_savedPredValid[m_savedPredMode] && m_savedPredArea == tu.Y() );
+}
+
+PelBuf IntraSearch::xGetSavedPredBuf( const UInt uiMode, const CompArea &area )
+{
+  return PelBuf( m_pSavedPred + uiMode * KLT_INTRA_MAX_CU_WITH_QTBT * KLT_INTRA_MAX_CU_WITH_QTBT, area.width, area.height );
+}
+
+#endif
 #if ENABLE_RQT_INTRA_SPEEDUP
 Void IntraSearch::xRecurIntraCodingLumaQT( CodingStructure &cs, Partitioner &partitioner, const Bool &checkFirst )
 #else
@@ -1567,6 +1823,18 @@ Void IntraSearch::xRecurIntraCodingLumaQT( CodingStructure &cs, Partitioner &par
 
 
 
+#if ENABLE_KLT_PARALLELISM
+    const bool kltCandsParallel  = m_numKltThreads > 1 && cu.kltFlag && !checkTransformSkip && !bCheckSplit && lastCheckId > firstCheckId;
+
+    if( kltCandsParallel )
+    {
+      xIntraKltCandsParallel( *csFull, tu, partitioner, firstCheckId, lastCheckId, dSingleCost, uiSingleDistLuma, singleFracBits );
+
+      // the best candidate is already in place
+      bestModeId[COMPONENT_Y] = lastCheckId;
+    }
+    else
+#endif
     for( Int modeId = firstCheckId; modeId <= lastCheckId; modeId++ )
     {
       if( checkInitTrDepthTransformSkipWinner )
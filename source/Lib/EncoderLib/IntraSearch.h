@@ -42,6 +42,7 @@
 
 #include "CABACWriter.h"
 #include "EncCfg.h"
+#include "ResidualCapture.h"
 
 #include "CommonLib/IntraPrediction.h"
 #include "CommonLib/CrossCompPrediction.h"
@@ -57,6 +58,10 @@
 // ====================================================================================================================
 
 class EncModeCtrl;
+#if ENABLE_KLT_PARALLELISM
+struct IntraKltJob;
+class ThreadPool;
+#endif
 
 /// encoder search class
 class IntraSearch : public IntraPrediction, CrossComponentPrediction
@@ -80,6 +85,23 @@ private:
   Double m_bestModeCostStore[4];                                    // RD cost of the best mode for each PU using DCT2
   Double m_modeCostStore    [4][NUM_LUMA_MODE];                         // RD cost of each mode for each PU using DCT2
   UInt   m_savedRdModeList  [4][NUM_LUMA_MODE], m_savedNumRdModes[4];
+  // luma prediction of each mode of the DCT2 pass, reused by the KLT pass of the same CU
+  Pel*     m_pSavedPred;
+  Bool     m_savedPredValid   [NUM_LUMA_MODE];
+  CompArea m_savedPredArea;
+  Int      m_savedPredMode;                                          // mode whose prediction is saved/loaded, -1 if none
+  Bool     m_loadSavedPred;
+  // luma header bits of each mode and the contexts after coding them in the DCT2 pass
+  UInt64      m_savedHeaderBits[NUM_LUMA_MODE];
+  CtxStateBuf m_savedHeaderCtx [NUM_LUMA_MODE];
+
+#endif
+#if ENABLE_KLT_PARALLELISM
+  // each job evaluates one KLT transform candidate with its own TrQuant and CABAC estimator
+  IntraKltJob*    m_kltJobs;
+  Int             m_numKltThreads;
+  Bool            m_isKltJob;
+  ThreadPool*     m_threadPool;
 
 #endif
 protected:
@@ -89,6 +111,7 @@ protected:
   // interface to classes
   TrQuant*        m_pcTrQuant;
   RdCost*         m_pcRdCost;
+  ResidualCapture* m_pcResidualCapture;
 
   // RD computation
   CABACWriter*    m_CABACEstimator;
@@ -118,6 +141,10 @@ public:
   CodingStructure  **getSaveCSBuf () { return m_pSaveCS; }
 
   void setModeCtrl                (EncModeCtrl *modeCtrl) { m_modeCtrl = modeCtrl; }
+  void setResidualCapture         (ResidualCapture *residualCapture) { m_pcResidualCapture = residualCapture; }
+#if ENABLE_KLT_PARALLELISM
+  void setThreadPool              (ThreadPool *threadPool) { m_threadPool = threadPool; }
+#endif
 
 public:
 
@@ -140,13 +167,25 @@ protected:
   Void xEncIntraHeader            (CodingStructure &cs, Partitioner& pm, const Bool &bLuma, const Bool &bChroma);
   Void xEncSubdivCbfQT            (CodingStructure &cs, Partitioner& pm, const Bool &bLuma, const Bool &bChroma);
   UInt64 xGetIntraFracBitsQT      (CodingStructure &cs, Partitioner& pm, const Bool &bLuma, const Bool &bChroma);
+  UInt64 xGetIntraHeaderFracBits  (CodingStructure &cs, Partitioner& pm, const Bool &bLuma, const Bool &bChroma);
+  UInt64 xGetIntraResiFracBitsQT  (CodingStructure &cs, Partitioner& pm, const Bool &bLuma, const Bool &bChroma);
 
   UInt64 xGetIntraFracBitsQTChroma(TransformUnit& tu, const ComponentID &compID);
   Void xEncCoeffQT                (CodingStructure &cs, Partitioner& pm, const ComponentID &compID);
 
   UInt64 xFracModeBitsIntra       (PredictionUnit &pu, const UInt &uiMode, const ChannelType &compID);
 
+  Void xIntraPredTUBlock          (TransformUnit &tu, const ComponentID &compID, const Int &default0Save1Load2 = 0 );
   Void xIntraCodingTUBlock        (TransformUnit &tu, const ComponentID &compID, const Bool &checkCrossCPrediction, Distortion& ruiDist, const Int &default0Save1Load2 = 0, UInt* numSig = nullptr );
+#if ENABLE_KLT_PARALLELISM
+  Void xIntraKltCandsParallel     (CodingStructure &cs, TransformUnit &tu, Partitioner& pm, const Int firstCheckId, const Int lastCheckId, Double &cost, Distortion &dist, UInt64 &fracBits );
+  TransformUnit&
+       xIntraKltCandJob           (CodingStructure &parentCS, Partitioner& pm, const TrQuant &parentTrQuant, const Ctx &ctxHeader, const UInt64 headerBits, const CPelBuf &pred, const UChar kltIdx, Double &cost, Distortion &dist, UInt64 &fracBits );
+#endif
+#if SEPARABLE_KLT
+  Bool xUseSavedPred              (const TransformUnit &tu, const ComponentID &compID) const;
+  PelBuf xGetSavedPredBuf         (const UInt uiMode, const CompArea &area);
+#endif
 
   ChromaCbfs xRecurIntraChromaCodingQT  (CodingStructure &cs, Partitioner& pm);
 
@@ -0,0 +1,425 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ResidualCapture.cpp
+    \brief    streaming capture of prediction residuals for offline transform training
+*/
+
+#include "ResidualCapture.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//! \ingroup EncoderLib
+//! \{
+
+static const UInt RESIDUAL_CAPTURE_FLUSH_SIZE = 1 << 20;
+
+static inline Void putVarint( std::vector<UChar> &buf, UInt val )
+{
+  while( val >= 0x80 )
+  {
+    buf.push_back( UChar( val | 0x80 ) );
+    val >>= 7;
+  }
+  buf.push_back( UChar( val ) );
+}
+
+static inline Void putSigned( std::vector<UChar> &buf, const Int val )
+{
+  putVarint( buf, ( UInt( val ) << 1 ) ^ UInt( val >> 31 ) );
+}
+
+ResidualCapture::ResidualCapture()
+  : m_captureMode ( 0 )
+  , m_slots       ( nullptr )
+  , m_enqueuePos  ( 0 )
+  , m_dequeuePos  ( 0 )
+  , m_stop        ( false )
+  , m_writeError  ( false )
+  , m_file        ( nullptr )
+{
+}
+
+ResidualCapture::~ResidualCapture()
+{
+  xStop();
+}
+
+Bool ResidualCapture::open( const std::string &fileName, const UInt captureMode )
+{
+  CHECK( m_file, "Residual capture already opened" );
+
+  m_file = fopen( fileName.c_str(), "wb" );
+  if( m_file == nullptr )
+  {
+    msg( ERROR, "Error: cannot create residual capture file %s\n", fileName.c_str() );
+    return true;
+  }
+
+  m_slots = new Slot[RESIDUAL_CAPTURE_RING_SIZE];
+  for( size_t i = 0; i < RESIDUAL_CAPTURE_RING_SIZE; i++ )
+  {
+    m_slots[i].seq.store( i, std::memory_order_relaxed );
+  }
+  m_enqueuePos.store( 0, std::memory_order_relaxed );
+  m_dequeuePos = 0;
+  m_stop.store( false, std::memory_order_relaxed );
+  m_writeError.store( false, std::memory_order_relaxed );
+
+  m_outBuf.clear();
+  m_outBuf.reserve( RESIDUAL_CAPTURE_FLUSH_SIZE + sizeof( Block ) * 2 );
+  m_outBuf.push_back( 'R' ); m_outBuf.push_back( 'E' ); m_outBuf.push_back( 'S' ); m_outBuf.push_back( 'I' );
+  for( Int i = 0; i < 4; i++ )
+  {
+    m_outBuf.push_back( UChar( RESIDUAL_CAPTURE_VERSION >> ( 8 * i ) ) );
+  }
+
+  m_captureMode = captureMode;
+  m_writer      = std::thread( &ResidualCapture::xWriterLoop, this );
+
+  return false;
+}
+
+Void ResidualCapture::close()
+{
+  xStop();
+
+  CHECK( m_writeError.load( std::memory_order_relaxed ), "Writing the residual capture file failed" );
+}
+
+Void ResidualCapture::xStop()
+{
+  if( m_file == nullptr )
+  {
+    return;
+  }
+
+  m_captureMode = 0;
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_stop.store( true, std::memory_order_release );
+  }
+  m_cond.notify_one();
+  m_writer.join();
+
+  fclose( m_file );
+  m_file = nullptr;
+
+  delete[] m_slots;
+  m_slots = nullptr;
+}
+
+Void ResidualCapture::capture( const CPelBuf &resi, const ComponentID compID, const PredMode predMode, const UInt dir, const Int qp )
+{
+  CHECK( resi.area() > MAX_TU_SIZE * MAX_TU_SIZE, "Block too large for the residual capture" );
+  CHECK( m_writeError.load( std::memory_order_relaxed ), "Writing the residual capture file failed" );
+
+  const size_t pos = xAcquireSlot();
+  Block &block     = m_slots[pos & ( RESIDUAL_CAPTURE_RING_SIZE - 1 )].block;
+
+  block.compID   = UChar( compID );
+  block.predMode = UChar( predMode );
+  block.dir      = UChar( dir );
+  block.qp       = qp;
+  block.width    = resi.width;
+  block.height   = resi.height;
+
+  PelBuf( block.resi, resi.width, resi.height ).copyFrom( resi );
+
+  xCommitSlot( pos );
+}
+
+Void ResidualCapture::capture( const CPelBuf &org, const CPelBuf &pred, const ComponentID compID, const PredMode predMode, const UInt dir, const Int qp )
+{
+  CHECK( org.area() > MAX_TU_SIZE * MAX_TU_SIZE, "Block too large for the residual capture" );
+  CHECK( m_writeError.load( std::memory_order_relaxed ), "Writing the residual capture file failed" );
+
+  const size_t pos = xAcquireSlot();
+  Block &block     = m_slots[pos & ( RESIDUAL_CAPTURE_RING_SIZE - 1 )].block;
+
+  block.compID   = UChar( compID );
+  block.predMode = UChar( predMode );
+  block.dir      = UChar( dir );
+  block.qp       = qp;
+  block.width    = org.width;
+  block.height   = org.height;
+
+  PelBuf resi( block.resi, org.width, org.height );
+  resi.copyFrom( org );
+  resi.subtract( pred );
+
+  xCommitSlot( pos );
+}
+
+/// reserves the next free slot of the ring, multiple producers are supported (bounded MPMC queue scheme)
+size_t ResidualCapture::xAcquireSlot()
+{
+  size_t pos = m_enqueuePos.load( std::memory_order_relaxed );
+
+  while( true )
+  {
+    Slot &slot       = m_slots[pos & ( RESIDUAL_CAPTURE_RING_SIZE - 1 )];
+    const size_t seq = slot.seq.load( std::memory_order_acquire );
+
+    if( seq == pos )
+    {
+      if( m_enqueuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+      {
+        return pos;
+      }
+    }
+    else if( seq < pos )
+    {
+      // ring is full, wait for the writer
+      std::this_thread::yield();
+      pos = m_enqueuePos.load( std::memory_order_relaxed );
+    }
+    else
+    {
+      pos = m_enqueuePos.load( std::memory_order_relaxed );
+    }
+  }
+}
+
+Void ResidualCapture::xCommitSlot( const size_t pos )
+{
+  {
+    // publish under the lock, so that the writer cannot miss the wake-up between its check and its wait
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_slots[pos & ( RESIDUAL_CAPTURE_RING_SIZE - 1 )].seq.store( pos + 1, std::memory_order_release );
+  }
+  m_cond.notify_one();
+}
+
+/// serializes the oldest committed block, returns false if there is none
+Bool ResidualCapture::xWriteNext()
+{
+  Slot &slot = m_slots[m_dequeuePos & ( RESIDUAL_CAPTURE_RING_SIZE - 1 )];
+
+  if( slot.seq.load( std::memory_order_acquire ) != m_dequeuePos + 1 )
+  {
+    return false;
+  }
+
+  const Block &block = slot.block;
+
+  m_outBuf.push_back( UChar( block.compID | ( block.predMode << 2 ) ) );
+  m_outBuf.push_back( block.dir );
+  putSigned( m_outBuf, block.qp );
+  putVarint( m_outBuf, block.width );
+  putVarint( m_outBuf, block.height );
+
+  const UInt numSamples = block.width * block.height;
+  for( UInt i = 0; i < numSamples; i++ )
+  {
+    putSigned( m_outBuf, block.resi[i] );
+  }
+
+  slot.seq.store( m_dequeuePos + RESIDUAL_CAPTURE_RING_SIZE, std::memory_order_release );
+  m_dequeuePos++;
+
+  if( m_outBuf.size() >= RESIDUAL_CAPTURE_FLUSH_SIZE )
+  {
+    xFlush();
+  }
+
+  return true;
+}
+
+Void ResidualCapture::xWriterLoop()
+{
+  while( true )
+  {
+    if( xWriteNext() )
+    {
+      continue;
+    }
+
+    if( m_stop.load( std::memory_order_acquire ) )
+    {
+      // the producers are done, drain what is left
+      while( xWriteNext() );
+      break;
+    }
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_cond.wait( lock, [this]
+    {
+      return m_stop.load( std::memory_order_acquire )
+          || m_slots[m_dequeuePos & ( RESIDUAL_CAPTURE_RING_SIZE - 1 )].seq.load( std::memory_order_acquire ) == m_dequeuePos + 1;
+    } );
+  }
+
+  xFlush();
+}
+
+/// runs on the writer thread, an error is only recorded and raised on the encoder side by capture() or close()
+Void ResidualCapture::xFlush()
+{
+  if( !m_outBuf.empty() )
+  {
+    if( !m_writeError.load( std::memory_order_relaxed ) && fwrite( m_outBuf.data(), 1, m_outBuf.size(), m_file ) != m_outBuf.size() )
+    {
+      m_writeError.store( true, std::memory_order_relaxed );
+    }
+    m_outBuf.clear();
+  }
+}
+
+// ====================================================================================================================
+// ResidualCaptureReader
+// ====================================================================================================================
+
+static const UInt RESIDUAL_CAPTURE_MAX_RECORD = 2 + 3 * 5 + MAX_TU_SIZE * MAX_TU_SIZE * 5;
+
+ResidualCaptureReader::ResidualCaptureReader()
+  : m_file ( nullptr )
+  , m_pos  ( 0 )
+  , m_end  ( 0 )
+  , m_eof  ( false )
+{
+}
+
+ResidualCaptureReader::~ResidualCaptureReader()
+{
+  close();
+}
+
+Bool ResidualCaptureReader::open( const std::string &fileName )
+{
+  CHECK( m_file, "Residual capture reader already opened" );
+
+  m_file = fopen( fileName.c_str(), "rb" );
+  if( m_file == nullptr )
+  {
+    msg( ERROR, "Error: cannot open residual capture file %s\n", fileName.c_str() );
+    return true;
+  }
+
+  m_inBuf.resize( RESIDUAL_CAPTURE_FLUSH_SIZE + RESIDUAL_CAPTURE_MAX_RECORD );
+  m_pos = m_end = 0;
+  m_eof = false;
+  xFill();
+
+  const UInt version = m_end < 8 ? 0 : UInt( m_inBuf[4] ) | ( UInt( m_inBuf[5] ) << 8 ) | ( UInt( m_inBuf[6] ) << 16 ) | ( UInt( m_inBuf[7] ) << 24 );
+
+  if( m_end < 8 || memcmp( &m_inBuf[0], "RESI", 4 ) || version != RESIDUAL_CAPTURE_VERSION )
+  {
+    msg( ERROR, "Error: %s is not a supported residual capture file\n", fileName.c_str() );
+    close();
+    return true;
+  }
+  m_pos = 8;
+
+  return false;
+}
+
+Void ResidualCaptureReader::close()
+{
+  if( m_file )
+  {
+    fclose( m_file );
+    m_file = nullptr;
+  }
+}
+
+/// keeps at least one complete record in the buffer unless the end of the file is reached
+Bool ResidualCaptureReader::xFill()
+{
+  if( m_eof || m_end - m_pos >= RESIDUAL_CAPTURE_MAX_RECORD )
+  {
+    return m_end > m_pos;
+  }
+
+  memmove( &m_inBuf[0], &m_inBuf[m_pos], m_end - m_pos );
+  m_end -= m_pos;
+  m_pos  = 0;
+  m_end += fread( &m_inBuf[m_end], 1, m_inBuf.size() - m_end, m_file );
+  m_eof  = m_end < m_inBuf.size();
+
+  return m_end > m_pos;
+}
+
+UInt ResidualCaptureReader::xGetVarint()
+{
+  UInt val   = 0;
+  UInt shift = 0;
+
+  while( true )
+  {
+    CHECK( m_pos >= m_end || shift > 28, "Corrupt residual capture file" );
+    const UChar byte = m_inBuf[m_pos++];
+    val |= UInt( byte & 0x7f ) << shift;
+    if( byte < 0x80 )
+    {
+      return val;
+    }
+    shift += 7;
+  }
+}
+
+Int ResidualCaptureReader::xGetSigned()
+{
+  const UInt val = xGetVarint();
+  return Int( val >> 1 ) ^ -Int( val & 1 );
+}
+
+Bool ResidualCaptureReader::read( ComponentID &compID, PredMode &predMode, UInt &dir, Int &qp, UInt &width, UInt &height, Pel *resi )
+{
+  if( !xFill() )
+  {
+    return false;
+  }
+
+  CHECK( m_end - m_pos < 2, "Corrupt residual capture file" );
+  const UChar tag = m_inBuf[m_pos++];
+  compID   = ComponentID( tag & 3 );
+  predMode = PredMode( tag >> 2 );
+  dir      = m_inBuf[m_pos++];
+  qp       = xGetSigned();
+  width    = xGetVarint();
+  height   = xGetVarint();
+
+  CHECK( compID >= MAX_NUM_COMPONENT || predMode >= NUMBER_OF_PREDICTION_MODES || width > MAX_TU_SIZE || height > MAX_TU_SIZE, "Corrupt residual capture file" );
+
+  const UInt numSamples = width * height;
+  for( UInt i = 0; i < numSamples; i++ )
+  {
+    resi[i] = Pel( xGetSigned() );
+  }
+
+  return true;
+}
+
+//! \}
@@ -0,0 +1,155 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ResidualCapture.h
+    \brief    streaming capture of prediction residuals for offline transform training (header)
+*/
+
+#ifndef __RESIDUALCAPTURE__
+#define __RESIDUALCAPTURE__
+
+// Include files
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Unit.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+static const UInt RESIDUAL_CAPTURE_RING_SIZE   = 256;     ///< number of blocks buffered between the encoder and the writer thread, power of 2
+static const UInt RESIDUAL_CAPTURE_VERSION     = 1;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/**
+ * Collects residual blocks of all sizes from the RD search, tagged with component, prediction mode, intra direction and
+ * QP. The blocks are handed over to a background writer thread through a lock-free ring buffer and stored as a compact
+ * binary stream:
+ *   header : magic "RESI", UInt32 version (little-endian)
+ *   record : UChar compID | ( predMode << 2 ), UChar intra direction, then the QP, width, height and width * height
+ *            residual samples in raster order, each as a zigzag mapped LEB128 varint
+ * Producers only block if the writer falls behind by more than RESIDUAL_CAPTURE_RING_SIZE blocks. A write error of the
+ * writer thread is raised by the next capture() or by close().
+ */
+class ResidualCapture
+{
+public:
+  ResidualCapture();
+  ~ResidualCapture();
+
+  /// starts the writer thread, captureMode is a bit mask with 1: intra, 2: inter, returns true on error
+  Bool   open         ( const std::string &fileName, const UInt captureMode );
+  /// flushes all pending blocks and stops the writer thread, throws if writing the file failed
+  Void   close        ();
+
+  Bool   isActive     ( const PredMode predMode ) const { return ( m_captureMode >> ( predMode == MODE_INTRA ? 0 : 1 ) ) & 1; }
+  UInt64 getNumBlocks ()                          const { return m_enqueuePos.load( std::memory_order_relaxed ); }
+
+  Void   capture      ( const CPelBuf &resi, const ComponentID compID, const PredMode predMode, const UInt dir, const Int qp );
+  Void   capture      ( const CPelBuf &org, const CPelBuf &pred, const ComponentID compID, const PredMode predMode, const UInt dir, const Int qp );
+
+private:
+  struct Block
+  {
+    UChar  compID;
+    UChar  predMode;
+    UChar  dir;
+    Int    qp;
+    UInt   width;
+    UInt   height;
+    Pel    resi[MAX_TU_SIZE * MAX_TU_SIZE];
+  };
+
+  struct Slot
+  {
+    std::atomic<size_t> seq;
+    Block               block;
+  };
+
+  size_t xAcquireSlot ();
+  Void   xCommitSlot  ( const size_t pos );
+  Bool   xWriteNext   ();
+  Void   xWriterLoop  ();
+  Void   xFlush       ();
+  Void   xStop        ();
+
+  UInt                    m_captureMode;
+  Slot*                   m_slots;
+  std::atomic<size_t>     m_enqueuePos;
+  size_t                  m_dequeuePos;
+  std::atomic<bool>       m_stop;
+  std::atomic<bool>       m_writeError;
+  std::mutex              m_mutex;
+  std::condition_variable m_cond;
+  std::thread             m_writer;
+  FILE*                   m_file;
+  std::vector<UChar>      m_outBuf;
+};
+
+/// streaming reader of the blocks written by ResidualCapture, e.g. for offline transform training
+class ResidualCaptureReader
+{
+public:
+  ResidualCaptureReader();
+  ~ResidualCaptureReader();
+
+  /// returns true on error
+  Bool   open         ( const std::string &fileName );
+  Void   close        ();
+
+  /// reads the next block, resi has to hold MAX_TU_SIZE * MAX_TU_SIZE samples, returns false at the end of the file
+  Bool   read         ( ComponentID &compID, PredMode &predMode, UInt &dir, Int &qp, UInt &width, UInt &height, Pel *resi );
+
+private:
+  Bool   xFill        ();
+  UInt   xGetVarint   ();
+  Int    xGetSigned   ();
+
+  FILE*               m_file;
+  std::vector<UChar>  m_inBuf;
+  size_t              m_pos;
+  size_t              m_end;
+  Bool                m_eof;
+};
+
+//! \}
+
+#endif // __RESIDUALCAPTURE__
@@ -0,0 +1,125 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     CommonLibTest.cpp
+    \brief    unit tests of the CommonLib kernels, runs the tests named on the command line or all of them
+*/
+
+#include "CommonLibTest.h"
+
+#include <cstdio>
+#include <cstring>
+
+//! \ingroup CommonLibTest
+//! \{
+
+struct CommonLibTestCase
+{
+  const char* name;
+  Bool      ( *run )();
+};
+
+#ifdef TARGET_SIMD_X86
+Bool testSimdKernels( const char* name, SimdKernelTest testSSE41, SimdKernelTest testAVX2, SimdKernelTest testAVX512 )
+{
+  static const char* const extNames[] = { "SSE4.1", "AVX2", "AVX-512" };
+
+  const X86_VEXT       vext    = read_x86_extension_flags();
+  const X86_VEXT       exts[]  = { SSE41, AVX2, AVX512 };
+  const SimdKernelTest tests[] = { testSSE41, testAVX2, testAVX512 };
+  TestSampleGenerator  rng;
+  Bool                 passed  = true;
+
+  for( Int i = 0; i < 3 && passed; i++ )
+  {
+    if( !tests[i] )
+    {
+      continue;
+    }
+    if( vext < exts[i] )
+    {
+      printf( "%s: the %s kernels are not tested on this CPU\n", name, extNames[i] );
+      continue;
+    }
+    passed = tests[i]( rng );
+  }
+
+  return passed;
+}
+#endif
+
+static const CommonLibTestCase g_testCases[] =
+{
+  { "RdCostSSE",          testRdCostSSE },
+  { "RdCostMRSAD",        testRdCostMRSAD },
+  { "RdCostHAD",          testRdCostHAD },
+  { "IntraPred",          testIntraPred },
+  { "LoopFilterEdge",     testLoopFilterEdge },
+  { "Quant",              testQuant },
+  { "Sao",                testSao },
+  { "InterpFilter2D",     testInterpFilter2D },
+  { "TrafoKLT",           testTrafoKLT },
+};
+
+int main( int argc, char* argv[] )
+{
+  Int numFailed = 0;
+  Int numRun    = 0;
+
+  for( const auto &testCase : g_testCases )
+  {
+    Bool selected = argc < 2;
+    for( Int i = 1; i < argc; i++ )
+    {
+      selected |= !strcmp( argv[i], testCase.name );
+    }
+    if( !selected )
+    {
+      continue;
+    }
+
+    const Bool passed = testCase.run();
+    printf( "%-20s %s\n", testCase.name, passed ? "passed" : "FAILED" );
+    numFailed += passed ? 0 : 1;
+    numRun++;
+  }
+
+  if( numRun == 0 )
+  {
+    fprintf( stderr, "no test selected\n" );
+    return 1;
+  }
+  return numFailed > 0 ? 1 : 0;
+}
+
+//! \}
@@ -0,0 +1,86 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     CommonLibTest.h
+    \brief    unit tests of the CommonLib kernels (header)
+*/
+
+#ifndef __COMMONLIBTEST__
+#define __COMMONLIBTEST__
+
+#include "CommonLib/CommonDef.h"
+
+#include <random>
+
+//! \ingroup CommonLibTest
+//! \{
+
+/// fixed seed, so a failure can be reproduced
+static const UInt COMMON_LIB_TEST_SEED = 0x5eed;
+
+/// random sample values of the given bit depth
+class TestSampleGenerator
+{
+public:
+  TestSampleGenerator() : m_rng( COMMON_LIB_TEST_SEED ) {}
+
+  Int  operator() ( const Int minVal, const Int maxVal ) { return std::uniform_int_distribution<Int>( minVal, maxVal )( m_rng ); }
+  Void fill       ( Pel* buf, const Int size, const Int bitDepth ) { for( Int i = 0; i < size; i++ ) buf[i] = (Pel) ( *this )( 0, ( 1 << bitDepth ) - 1 ); }
+
+private:
+  std::mt19937 m_rng;
+};
+
+#ifdef TARGET_SIMD_X86
+/// compares the kernels of one SIMD extension with their scalar references, the failing case is reported on stderr
+typedef Bool ( *SimdKernelTest )( TestSampleGenerator& rng );
+
+/// runs the comparisons of the extensions the CPU supports, a null test stands for an extension without kernels,
+/// the extensions the CPU lacks are reported as not tested
+Bool testSimdKernels( const char* name, SimdKernelTest testSSE41, SimdKernelTest testAVX2, SimdKernelTest testAVX512 = nullptr );
+#endif
+
+// each test returns true on success and reports the failing case on stderr
+Bool testRdCostSSE();
+Bool testRdCostMRSAD();
+Bool testRdCostHAD();
+Bool testIntraPred();
+Bool testLoopFilterEdge();
+Bool testQuant();
+Bool testSao();
+Bool testInterpFilter2D();
+Bool testTrafoKLT();
+
+//! \}
+
+#endif // __COMMONLIBTEST__
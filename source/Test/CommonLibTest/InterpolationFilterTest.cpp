@@ -0,0 +1,224 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     InterpolationFilterTest.cpp
+    \brief    compares the fused 2D interpolation filters with the two pass scalar filtering
+*/
+
+#include "CommonLibTest.h"
+
+#include "CommonLib/InterpolationFilter.h"
+
+#include <cstdio>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+static const Int INTERPOLATION_FILTER_TEST_ITERATIONS = 100;
+
+class InterpolationFilterTest
+{
+public:
+  static Bool testFilter2D();
+
+private:
+  static Void xSetScalarKernels ( InterpolationFilter& filter );
+  static const TFilterCoeff* xRandomCoeffs ( const Int N, TestSampleGenerator& rng );
+  static Void xFilterTwoPass ( const InterpolationFilter& filter, const Int N, const Bool isLast, const ClpRng& clpRng, const Pel* src, Int srcStride, Pel* dst, Int dstStride,
+                               Int width, Int height, const TFilterCoeff* coeffH, const TFilterCoeff* coeffV );
+  static Bool xTestFilter2D  ( const InterpolationFilter& filter, const InterpolationFilter& scalarFilter, const Int vext, const Int bitDepth, TestSampleGenerator& rng );
+
+#ifdef TARGET_SIMD_X86
+  template<X86_VEXT vext>
+  static Bool xTestFilter2D  ( TestSampleGenerator& rng );
+#endif
+};
+
+// the constructor selects the SIMD kernels of the CPU, the reference uses the scalar ones
+Void InterpolationFilterTest::xSetScalarKernels( InterpolationFilter& filter )
+{
+  filter.m_filterHor[0][1][0] = InterpolationFilter::filter<8, false, true, false>;
+  filter.m_filterHor[1][1][0] = InterpolationFilter::filter<4, false, true, false>;
+  filter.m_filterHor[2][1][0] = InterpolationFilter::filter<2, false, true, false>;
+
+  filter.m_filterVer[0][0][0] = InterpolationFilter::filter<8, true, false, false>;
+  filter.m_filterVer[0][0][1] = InterpolationFilter::filter<8, true, false, true>;
+  filter.m_filterVer[1][0][0] = InterpolationFilter::filter<4, true, false, false>;
+  filter.m_filterVer[1][0][1] = InterpolationFilter::filter<4, true, false, true>;
+  filter.m_filterVer[2][0][0] = InterpolationFilter::filter<2, true, false, false>;
+  filter.m_filterVer[2][0][1] = InterpolationFilter::filter<2, true, false, true>;
+
+  filter.m_filter2D[0][0]     = InterpolationFilter::filter2D<8, false>;
+  filter.m_filter2D[0][1]     = InterpolationFilter::filter2D<8, true>;
+  filter.m_filter2D[1][0]     = InterpolationFilter::filter2D<4, false>;
+  filter.m_filter2D[1][1]     = InterpolationFilter::filter2D<4, true>;
+  filter.m_filter2D[2][0]     = InterpolationFilter::filter2D<2, false>;
+  filter.m_filter2D[2][1]     = InterpolationFilter::filter2D<2, true>;
+}
+
+static inline Int xTapIdx( const Int N )
+{
+  return N == 8 ? 0 : N == 4 ? 1 : 2;
+}
+
+// the luma and chroma taps of the fractional positions, the two tap filters are bilinear
+const TFilterCoeff* InterpolationFilterTest::xRandomCoeffs( const Int N, TestSampleGenerator& rng )
+{
+  static TFilterCoeff bilinear[8][2];
+
+  if( N == 8 )
+  {
+    return InterpolationFilter::m_lumaFilter[rng( 1, LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS - 1 )];
+  }
+  if( N == 4 )
+  {
+    return InterpolationFilter::m_chromaFilter[rng( 1, CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS - 1 )];
+  }
+
+  const Int frac = rng( 1, 7 );
+  bilinear[frac][0] = 64 - 8 * frac;
+  bilinear[frac][1] = 8 * frac;
+  return bilinear[frac];
+}
+
+// the horizontal pass writes the intermediate block with the N - 1 extra rows, the vertical pass filters it
+Void InterpolationFilterTest::xFilterTwoPass( const InterpolationFilter& filter, const Int N, const Bool isLast, const ClpRng& clpRng, const Pel* src, Int srcStride, Pel* dst, Int dstStride,
+                                              Int width, Int height, const TFilterCoeff* coeffH, const TFilterCoeff* coeffV )
+{
+  std::vector<Pel> tmp( width * ( height + N - 1 ) );
+
+  filter.m_filterHor[xTapIdx( N )][true][false] ( clpRng, src - ( N / 2 - 1 ) * srcStride, srcStride, tmp.data(), width, width, height + N - 1, coeffH );
+  filter.m_filterVer[xTapIdx( N )][false][isLast]( clpRng, tmp.data() + ( N / 2 - 1 ) * width, width, dst, dstStride, width, height, coeffV );
+}
+
+// compares the 2D filter of the given set of kernels with the two pass filtering of the scalar kernels, for all tap
+// numbers, so the fallback of the fused filter for two taps, bit depths above 10 and widths not a multiple of 4 is used too
+Bool InterpolationFilterTest::xTestFilter2D( const InterpolationFilter& filter, const InterpolationFilter& scalarFilter, const Int vext, const Int bitDepth, TestSampleGenerator& rng )
+{
+  static const Int taps[] = { 8, 4, 2 };
+
+  const ClpRng clpRng = { 0, ( 1 << bitDepth ) - 1, bitDepth, 0 };
+
+  for( Int N : taps )
+  {
+    for( Int i = 0; i < INTERPOLATION_FILTER_TEST_ITERATIONS; i++ )
+    {
+      const Bool isLast    = rng( 0, 1 );
+      const Int  width     = rng( 0, 1 ) ? 4 * rng( 1, MAX_CU_SIZE / 4 ) : rng( 1, MAX_CU_SIZE );
+      const Int  height    = rng( 1, MAX_CU_SIZE );
+      const Int  srcStride = width + NTAPS_LUMA + rng( 0, 16 );
+      const Int  dstStride = width + rng( 0, 16 );
+
+      const TFilterCoeff* coeffH = xRandomCoeffs( N, rng );
+      const TFilterCoeff* coeffV = xRandomCoeffs( N, rng );
+
+      // a margin of the luma filter length around the block
+      std::vector<Pel> src( srcStride * ( height + NTAPS_LUMA ) );
+      std::vector<Pel> ref( dstStride * height );
+      rng.fill( src.data(), (Int) src.size(), bitDepth );
+      rng.fill( ref.data(), (Int) ref.size(), bitDepth );
+
+      std::vector<Pel> cur = ref;
+
+      const Pel* srcBlk = src.data() + ( NTAPS_LUMA / 2 ) * ( srcStride + 1 );
+
+      xFilterTwoPass( scalarFilter, N, isLast, clpRng, srcBlk, srcStride, ref.data(), dstStride, width, height, coeffH, coeffV );
+      filter.m_filter2D[xTapIdx( N )][isLast]( clpRng, srcBlk, srcStride, cur.data(), dstStride, width, height, coeffH, coeffV );
+
+      if( cur != ref )
+      {
+        fprintf( stderr, "%d tap 2D filter%s, vext %d, %d bit, %dx%d block differs\n", N, isLast ? " (last)" : "", vext, bitDepth, width, height );
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+#ifdef TARGET_SIMD_X86
+template<X86_VEXT vext>
+Bool InterpolationFilterTest::xTestFilter2D( TestSampleGenerator& rng )
+{
+  InterpolationFilter scalarFilter;
+  InterpolationFilter filter;
+
+  xSetScalarKernels( scalarFilter );
+  filter._initInterpolationFilterX86<vext>();
+
+  for( Int bitDepth = 8; bitDepth <= 12; bitDepth += 2 )
+  {
+    if( !xTestFilter2D( filter, scalarFilter, (Int) vext, bitDepth, rng ) )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+#endif
+
+Bool InterpolationFilterTest::testFilter2D()
+{
+  InterpolationFilter scalarFilter;
+  TestSampleGenerator rng;
+
+  xSetScalarKernels( scalarFilter );
+
+  // the scalar fused filter first, it is the fallback of the SIMD ones
+  for( Int bitDepth = 8; bitDepth <= 12; bitDepth += 2 )
+  {
+    if( !xTestFilter2D( scalarFilter, scalarFilter, -1, bitDepth, rng ) )
+    {
+      return false;
+    }
+  }
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_AVX512
+  return testSimdKernels( "InterpFilter2D", xTestFilter2D<SSE41>, xTestFilter2D<AVX2>, xTestFilter2D<AVX512> );
+#else
+  return testSimdKernels( "InterpFilter2D", xTestFilter2D<SSE41>, xTestFilter2D<AVX2> );
+#endif
+#else
+  return true;
+#endif
+}
+
+Bool testInterpFilter2D()
+{
+  return InterpolationFilterTest::testFilter2D();
+}
+
+//! \}
@@ -0,0 +1,229 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IntraPredTest.cpp
+    \brief    compares the SIMD intra prediction kernels with the scalar ones
+*/
+
+#include "CommonLibTest.h"
+
+#include "CommonLib/IntraPrediction.h"
+#include "CommonLib/Rom.h"
+
+#include <cstdio>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+static const Int INTRA_PRED_TEST_MIN_SIZE = 2;
+static const Int INTRA_PRED_TEST_PADDING  = 8;
+
+class IntraPredTest
+{
+public:
+  static Bool testIntraPred();
+
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_INTRAPRED
+private:
+  template<X86_VEXT vext>
+  static Bool xTestKernels   ( TestSampleGenerator& rng );
+  static Bool xTestAngRows   ( const IntraPrediction& intraPred, const Int vext, const Int bitDepth, TestSampleGenerator& rng );
+  static Bool xTestPlanarDc  ( const IntraPrediction& intraPred, const Int vext, const Int bitDepth, TestSampleGenerator& rng );
+  static Bool xTestRefFilter ( const IntraPrediction& intraPred, const Int vext, const Int bitDepth, TestSampleGenerator& rng );
+#endif
+};
+
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_INTRAPRED
+template<X86_VEXT vext>
+Bool IntraPredTest::xTestKernels( TestSampleGenerator& rng )
+{
+  IntraPrediction intraPred;
+  intraPred._initIntraPredictionX86<vext>();
+
+  for( Int bitDepth = 8; bitDepth <= 10; bitDepth += 2 )
+  {
+    if( !xTestAngRows( intraPred, (Int) vext, bitDepth, rng ) || !xTestPlanarDc( intraPred, (Int) vext, bitDepth, rng ) || !xTestRefFilter( intraPred, (Int) vext, bitDepth, rng ) )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// the horizontal modes are predicted transposed, so the rows of all block shapes but 2x2 are predicted,
+// for every angle the SIMD kernel may specialise, not only the ones of the angle table
+Bool IntraPredTest::xTestAngRows( const IntraPrediction& intraPred, const Int vext, const Int bitDepth, TestSampleGenerator& rng )
+{
+  // row y reads the main reference from ( y + 1 ) * angle / 32 + 1 to width more samples, the margin covers
+  // the reads past the end of the block row the vector loads may do
+  std::vector<Pel> refMain( 4 * MAX_CU_SIZE + 2 * INTRA_PRED_TEST_PADDING );
+  std::vector<Pel> ref( ( MAX_CU_SIZE + INTRA_PRED_TEST_PADDING ) * MAX_CU_SIZE );
+  std::vector<Pel> cur( ref.size() );
+
+  for( Int width = INTRA_PRED_TEST_MIN_SIZE; width <= MAX_CU_SIZE; width <<= 1 )
+  {
+    for( Int height = INTRA_PRED_TEST_MIN_SIZE; height <= MAX_CU_SIZE; height <<= 1 )
+    {
+      if( width == 2 && height == 2 )
+      {
+        continue;
+      }
+
+      const Int  dstStride = width + rng( 0, INTRA_PRED_TEST_PADDING );
+      const Int  angle     = rng( -32, 32 );
+      const Pel* pRefMain  = refMain.data() + MAX_CU_SIZE + INTRA_PRED_TEST_PADDING;
+
+      rng.fill( refMain.data(), (Int) refMain.size(), bitDepth );
+      rng.fill( ref.data(), (Int) ref.size(), bitDepth );
+      cur = ref;
+
+      IntraPrediction::xPredIntraAngRows( ref.data(), dstStride, pRefMain, width, height, angle );
+      intraPred.m_predIntraAngRows      ( cur.data(), dstStride, pRefMain, width, height, angle );
+
+      // the samples outside the block are compared too, they have to stay untouched
+      if( cur != ref )
+      {
+        fprintf( stderr, "intra angle %d, vext %d, %d bit, %dx%d rows differ\n", angle, vext, bitDepth, width, height );
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+Bool IntraPredTest::xTestPlanarDc( const IntraPrediction& intraPred, const Int vext, const Int bitDepth, TestSampleGenerator& rng )
+{
+  // the reference samples are the first row and column of a ( width + height + 1 ) square
+  std::vector<Pel> src( ( 2 * MAX_CU_SIZE + 1 ) * ( 2 * MAX_CU_SIZE + 1 ) );
+  std::vector<Pel> ref( ( MAX_CU_SIZE + INTRA_PRED_TEST_PADDING ) * MAX_CU_SIZE );
+  std::vector<Pel> cur( ref.size() );
+
+  for( Int width = INTRA_PRED_TEST_MIN_SIZE; width <= MAX_CU_SIZE; width <<= 1 )
+  {
+    for( Int height = INTRA_PRED_TEST_MIN_SIZE; height <= MAX_CU_SIZE; height <<= 1 )
+    {
+      const Int     srcStride = width + height + 1;
+      const Int     dstStride = width + rng( 0, INTRA_PRED_TEST_PADDING );
+      const CPelBuf srcBuf( src.data(), srcStride, srcStride, srcStride );
+
+      for( Int planar = 0; planar < 2; planar++ )
+      {
+        rng.fill( src.data(), srcStride * srcStride, bitDepth );
+        rng.fill( ref.data(), (Int) ref.size(), bitDepth );
+        cur = ref;
+
+        PelBuf refBuf( ref.data(), dstStride, width, height );
+        PelBuf curBuf( cur.data(), dstStride, width, height );
+
+        if( planar )
+        {
+          IntraPrediction::xPredIntraPlanarCore( srcBuf, refBuf );
+          intraPred.m_predIntraPlanar          ( srcBuf, curBuf );
+        }
+        else
+        {
+          IntraPrediction::xPredIntraDcCore( srcBuf, refBuf );
+          intraPred.m_predIntraDc          ( srcBuf, curBuf );
+        }
+
+        if( cur != ref )
+        {
+          fprintf( stderr, "intra %s, vext %d, %d bit, %dx%d differs\n", planar ? "planar" : "DC", vext, bitDepth, width, height );
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+Bool IntraPredTest::xTestRefFilter( const IntraPrediction& intraPred, const Int vext, const Int bitDepth, TestSampleGenerator& rng )
+{
+  // the top row of the reference is smoothed after the corner sample, pSrc[-1] and pSrc[num] are read as neighbours
+  std::vector<Pel> src( 2 * ( 2 * MAX_CU_SIZE + 1 ) );
+  std::vector<Pel> ref( src.size() );
+  std::vector<Pel> cur( src.size() );
+
+  for( Int width = INTRA_PRED_TEST_MIN_SIZE; width <= MAX_CU_SIZE; width <<= 1 )
+  {
+    for( Int height = INTRA_PRED_TEST_MIN_SIZE; height <= MAX_CU_SIZE; height <<= 1 )
+    {
+      const Int num    = width + height - 1;
+      const Int offset = rng( 1, (Int) src.size() - num - 1 );
+
+      rng.fill( src.data(), (Int) src.size(), bitDepth );
+      rng.fill( ref.data(), (Int) ref.size(), bitDepth );
+      cur = ref;
+
+      IntraPrediction::xFilterRefSamplesRow( src.data() + offset, ref.data() + offset, num );
+      intraPred.m_filterRefSamplesRow      ( src.data() + offset, cur.data() + offset, num );
+
+      if( cur != ref )
+      {
+        fprintf( stderr, "reference filter, vext %d, %d bit, %d samples differ\n", vext, bitDepth, num );
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+#endif
+
+Bool IntraPredTest::testIntraPred()
+{
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_INTRAPRED
+  // the planar prediction takes the block size shifts from g_aucLog2
+  initROM();
+
+  const Bool passed = testSimdKernels( "IntraPred", xTestKernels<SSE41>, xTestKernels<AVX2> );
+
+  destroyROM();
+
+  return passed;
+#else
+  printf( "IntraPred: no SIMD kernels to test\n" );
+  return true;
+#endif
+}
+
+Bool testIntraPred()
+{
+  return IntraPredTest::testIntraPred();
+}
+
+//! \}
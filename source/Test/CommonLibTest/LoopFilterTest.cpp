@@ -0,0 +1,195 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     LoopFilterTest.cpp
+    \brief    compares the SIMD deblocking edge filters with the scalar ones
+*/
+
+#include "CommonLibTest.h"
+
+#include "CommonLib/LoopFilter.h"
+
+#include <cstdio>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+static const Int LOOP_FILTER_TEST_ITERATIONS = 400;
+
+class LoopFilterTest
+{
+public:
+  static Bool testEdgeFilter();
+
+private:
+  static Void xFillEdge        ( Pel* piSrc, const Int iSrcStep, const Int iOffset, const Int numLines, const Int bitDepth, TestSampleGenerator& rng );
+  static Void xRandomSegParams ( LFSegParam* pSegs, const Int numSegs, const Bool luma, const Int bitDepth, TestSampleGenerator& rng );
+
+#ifdef TARGET_SIMD_X86
+  template<X86_VEXT vext>
+  static Bool xTestEdgeFilter  ( TestSampleGenerator& rng );
+#endif
+};
+
+// the samples across the edge are a ramp with a step at the edge and some noise, so all filter decisions occur
+Void LoopFilterTest::xFillEdge( Pel* piSrc, const Int iSrcStep, const Int iOffset, const Int numLines, const Int bitDepth, TestSampleGenerator& rng )
+{
+  static const Int noiseAmp[] = { 0, 1, 2, 4, 16, 1 << 10 };
+
+  const Int maxVal = ( 1 << bitDepth ) - 1;
+  const Int scale  = 1 << ( bitDepth - 8 );
+
+  for( Int l = 0; l < numLines; l += 4 )
+  {
+    const Int base  = rng( 0, maxVal );
+    const Int slope = rng( -2, 2 ) * scale;
+    const Int step  = rng( 0, 1 ) ? 0 : rng( -32, 32 ) * scale;
+    const Int amp   = noiseAmp[rng( 0, 5 )] * scale;
+
+    for( Int k = l; k < std::min( l + 4, numLines ); k++ )
+    {
+      for( Int j = -4; j < 4; j++ )
+      {
+        piSrc[k * iSrcStep + j * iOffset] = (Pel) Clip3( 0, maxVal, base + slope * j + ( j >= 0 ? step : 0 ) + rng( -amp, amp ) );
+      }
+    }
+  }
+}
+
+Void LoopFilterTest::xRandomSegParams( LFSegParam* pSegs, const Int numSegs, const Bool luma, const Int bitDepth, TestSampleGenerator& rng )
+{
+  const Int scale = 1 << ( bitDepth - 8 );
+
+  for( Int i = 0; i < numSegs; i++ )
+  {
+    const Int qp    = rng( 0, MAX_QP );
+    const Int bs    = luma ? rng( 1, 2 ) : 2;
+    // the edges of intra blocks (bS 2) use a tc offset of 2
+    const Int tcIdx = Clip3( 0, MAX_QP + 2, qp + 2 * ( bs - 1 ) );
+
+    pSegs[i].iBeta          = luma ? LoopFilter::sm_betaTable[qp] * scale : 0;
+    pSegs[i].iTc            = rng( 0, 7 ) ? LoopFilter::sm_tcTable[tcIdx] * scale : 0;
+    pSegs[i].bPartPNoFilter = !rng( 0, 7 );
+    pSegs[i].bPartQNoFilter = !rng( 0, 7 );
+  }
+}
+
+#ifdef TARGET_SIMD_X86
+template<X86_VEXT vext>
+Bool LoopFilterTest::xTestEdgeFilter( TestSampleGenerator& rng )
+{
+  static const Int chromaLines[] = { 1, 2, 4 };
+
+  LoopFilter loopFilter;
+  loopFilter._initLoopFilterX86<vext>();
+
+  LFSegParam segs[MAX_CU_SIZE / 2];
+  Int        numFiltered = 0;
+
+  for( Int bitDepth = 8; bitDepth <= 10; bitDepth += 2 )
+  {
+    const ClpRng clpRng = { 0, ( 1 << bitDepth ) - 1, bitDepth, 0 };
+
+    for( Int i = 0; i < LOOP_FILTER_TEST_ITERATIONS; i++ )
+    {
+      const Bool luma      = rng( 0, 1 );
+      const Bool verEdge   = rng( 0, 1 );
+      const Int  numLines  = luma ? 4 : chromaLines[rng( 0, 2 )];
+      const Int  numSegs   = rng( 1, MAX_CU_SIZE / std::max( numLines, 2 ) );
+      const Int  edgeLines = numLines * numSegs;
+
+      // the edge runs along the lines, the samples across it are at iOffset steps
+      const Int  stride    = verEdge ? rng( 8, 24 ) : rng( edgeLines, edgeLines + 16 );
+      const Int  height    = verEdge ? edgeLines : 8;
+      const Int  iSrcStep  = verEdge ? stride : 1;
+      const Int  iOffset   = verEdge ? 1 : stride;
+      const Int  edgePos   = verEdge ? rng( 4, stride - 4 ) : 4 * stride + rng( 0, stride - edgeLines );
+
+      std::vector<Pel> ref( stride * height );
+      rng.fill( ref.data(), (Int) ref.size(), bitDepth );
+      xFillEdge( ref.data() + edgePos, iSrcStep, iOffset, edgeLines, bitDepth, rng );
+      xRandomSegParams( segs, numSegs, luma, bitDepth, rng );
+
+      std::vector<Pel> org = ref;
+      std::vector<Pel> cur = ref;
+
+      if( luma )
+      {
+        LoopFilter::xEdgeFilterLumaSegs( ref.data() + edgePos, iSrcStep, iOffset, segs, numSegs, clpRng );
+        loopFilter.m_edgeFilterLumaSegs( cur.data() + edgePos, iSrcStep, iOffset, segs, numSegs, clpRng );
+      }
+      else
+      {
+        LoopFilter::xEdgeFilterChromaSegs( ref.data() + edgePos, iSrcStep, iOffset, numLines, segs, numSegs, clpRng );
+        loopFilter.m_edgeFilterChromaSegs( cur.data() + edgePos, iSrcStep, iOffset, numLines, segs, numSegs, clpRng );
+      }
+
+      numFiltered += ref != org ? 1 : 0;
+
+      if( cur != ref )
+      {
+        fprintf( stderr, "%s %s edge, vext %d, %d bit, %d segments of %d lines differ\n", luma ? "luma" : "chroma", verEdge ? "vertical" : "horizontal",
+                 (Int) vext, bitDepth, numSegs, numLines );
+        return false;
+      }
+    }
+  }
+
+  // the edges have to be changed by the filters, otherwise the comparison is void
+  if( numFiltered == 0 )
+  {
+    fprintf( stderr, "no edge has been filtered\n" );
+    return false;
+  }
+
+  return true;
+}
+#endif
+
+Bool LoopFilterTest::testEdgeFilter()
+{
+#ifdef TARGET_SIMD_X86
+  return testSimdKernels( "LoopFilterEdge", xTestEdgeFilter<SSE41>, xTestEdgeFilter<AVX2> );
+#else
+  printf( "LoopFilterEdge: no SIMD kernels to test\n" );
+  return true;
+#endif
+}
+
+Bool testLoopFilterEdge()
+{
+  return LoopFilterTest::testEdgeFilter();
+}
+
+//! \}
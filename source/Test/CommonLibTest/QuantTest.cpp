@@ -0,0 +1,216 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     QuantTest.cpp
+    \brief    compares the SIMD quantisation and de-quantisation kernels with the scalar ones
+*/
+
+#include "CommonLibTest.h"
+
+#include "CommonLib/Quant.h"
+#include "CommonLib/Rom.h"
+
+#include <cstdio>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+static const Int QUANT_TEST_ITERATIONS    = 400;
+static const Int QUANT_TEST_MAX_COEFF     = MAX_TU_SIZE * MAX_TU_SIZE;
+static const Int QUANT_TEST_DYNAMIC_RANGE = 15;
+
+class QuantTest
+{
+public:
+  static Bool testQuant();
+
+private:
+  static Void xRandomCoeffs( std::vector<TCoeff>& coeffs, const Int numCoeff, const TCoeff maxVal, TestSampleGenerator& rng );
+
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_QUANT
+  template<X86_VEXT vext>
+  static Bool xTestKernels( TestSampleGenerator& rng );
+  template<X86_VEXT vext>
+  static Bool xTestQuant  ( Quant& quant, TestSampleGenerator& rng );
+  template<X86_VEXT vext>
+  static Bool xTestDequant( Quant& quant, TestSampleGenerator& rng );
+#endif
+};
+
+// mostly small levels with zeros in between, as left by the transform, and now and then the full range
+Void QuantTest::xRandomCoeffs( std::vector<TCoeff>& coeffs, const Int numCoeff, const TCoeff maxVal, TestSampleGenerator& rng )
+{
+  for( Int n = 0; n < numCoeff; n++ )
+  {
+    const TCoeff amp = rng( 0, 3 ) ? std::min<TCoeff>( maxVal, 1 << rng( 0, 10 ) ) : maxVal;
+    coeffs[n]        = rng( 0, 3 ) ? rng( -amp, amp ) : 0;
+  }
+}
+
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_QUANT
+template<X86_VEXT vext>
+Bool QuantTest::xTestKernels( TestSampleGenerator& rng )
+{
+  Quant quant( nullptr );
+  quant._initQuantX86<vext>();
+
+  return xTestQuant<vext>( quant, rng ) && xTestDequant<vext>( quant, rng );
+}
+
+template<X86_VEXT vext>
+Bool QuantTest::xTestQuant( Quant& quant, TestSampleGenerator& rng )
+{
+  const TCoeff clipMin = -( 1 << QUANT_TEST_DYNAMIC_RANGE );
+  const TCoeff clipMax =  ( 1 << QUANT_TEST_DYNAMIC_RANGE ) - 1;
+
+  std::vector<TCoeff> coef      ( QUANT_TEST_MAX_COEFF );
+  std::vector<Int>    quantCoeff( QUANT_TEST_MAX_COEFF );
+  std::vector<TCoeff> refQCoef  ( QUANT_TEST_MAX_COEFF );
+  std::vector<TCoeff> curQCoef  ( QUANT_TEST_MAX_COEFF );
+  std::vector<TCoeff> refDeltaU ( QUANT_TEST_MAX_COEFF );
+  std::vector<TCoeff> curDeltaU ( QUANT_TEST_MAX_COEFF );
+  std::vector<UInt>   scanPos   ( QUANT_TEST_MAX_COEFF );
+
+  for( Int i = 0; i < QUANT_TEST_ITERATIONS; i++ )
+  {
+    // any count, so the remainders of the vector loops are covered
+    const Int   numCoeff    = rng( 1, QUANT_TEST_MAX_COEFF );
+    const Int   qpRem       = rng( 0, SCALING_LIST_REM_NUM - 1 );
+    const Bool  scalingList = rng( 0, 1 );
+    const Bool  signHiding  = rng( 0, 1 );
+    const Bool  sqrt2Scale  = rng( 0, 1 );
+    const Int   iWHScale    = sqrt2Scale ? 181 : 1;
+    const Int   iQBits      = QUANT_SHIFT + rng( -4, 12 ) + ( sqrt2Scale ? ADJ_QUANT_SHIFT : 0 );
+    const Int64 iAdd        = Int64( rng( 0, 1 ) ? 171 : 85 ) << Int64( iQBits - 9 );
+
+    xRandomCoeffs( coef, numCoeff, clipMax, rng );
+
+    // the scaling list entries divide 16 times the flat quantisation coefficient
+    for( Int n = 0; n < numCoeff; n++ )
+    {
+      quantCoeff[n] = g_quantScales[qpRem] * 16 / rng( 1, 255 );
+    }
+
+    // any permutation serves as the scan order
+    for( Int n = 0; n < numCoeff; n++ )
+    {
+      const Int m = rng( 0, n );
+      scanPos[n]  = scanPos[m];
+      scanPos[m]  = n;
+    }
+
+    TCoeff refAbsSum = rng( 0, 1000 );
+    TCoeff curAbsSum = refAbsSum;
+    Int    refLast   = rng( -1, numCoeff - 1 );
+    Int    curLast   = refLast;
+
+    refDeltaU.assign( refDeltaU.size(), 0 );
+    curDeltaU.assign( curDeltaU.size(), 0 );
+
+    Quant::xQuantCore( coef.data(), refQCoef.data(), signHiding ? refDeltaU.data() : nullptr, numCoeff, scalingList ? quantCoeff.data() : nullptr, g_quantScales[qpRem], iWHScale, iQBits, iAdd, clipMin, clipMax, scanPos.data(), refAbsSum, refLast );
+    quant.m_quantCore( coef.data(), curQCoef.data(), signHiding ? curDeltaU.data() : nullptr, numCoeff, scalingList ? quantCoeff.data() : nullptr, g_quantScales[qpRem], iWHScale, iQBits, iAdd, clipMin, clipMax, scanPos.data(), curAbsSum, curLast );
+
+    if( !std::equal( refQCoef.begin(), refQCoef.begin() + numCoeff, curQCoef.begin() ) || curDeltaU != refDeltaU || curAbsSum != refAbsSum || curLast != refLast )
+    {
+      fprintf( stderr, "quant, vext %d, %d coefficients, %s, sign hiding %d, iQBits %d, iWHScale %d differ\n", (Int) vext, numCoeff, scalingList ? "scaling list" : "flat",
+               signHiding, iQBits, iWHScale );
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template<X86_VEXT vext>
+Bool QuantTest::xTestDequant( Quant& quant, TestSampleGenerator& rng )
+{
+  const TCoeff clipMin = -( 1 << QUANT_TEST_DYNAMIC_RANGE );
+  const TCoeff clipMax =  ( 1 << QUANT_TEST_DYNAMIC_RANGE ) - 1;
+
+  std::vector<TCoeff> qCoef       ( QUANT_TEST_MAX_COEFF );
+  std::vector<Int>    dequantCoeff( QUANT_TEST_MAX_COEFF );
+  std::vector<TCoeff> refCoef     ( QUANT_TEST_MAX_COEFF );
+  std::vector<TCoeff> curCoef     ( QUANT_TEST_MAX_COEFF );
+
+  for( Int i = 0; i < QUANT_TEST_ITERATIONS; i++ )
+  {
+    const Int  numCoeff    = rng( 1, QUANT_TEST_MAX_COEFF );
+    const Int  qpRem       = rng( 0, SCALING_LIST_REM_NUM - 1 );
+    const Bool scalingList = rng( 0, 1 );
+    const Int  scale       = scalingList ? ( rng( 0, 1 ) ? 181 : 1 ) : g_invQuantScales[qpRem] * ( rng( 0, 1 ) ? 181 : 1 );
+    const Int  rightShift  = rng( -8, 20 );
+
+    for( Int n = 0; n < numCoeff; n++ )
+    {
+      dequantCoeff[n] = g_invQuantScales[qpRem] * rng( 1, 255 );
+    }
+
+    // the input clipping keeps the products in 32 bits, as the bit depth derivation of Quant::dequant does
+    const Int    maxScale = scalingList ? g_invQuantScales[SCALING_LIST_REM_NUM - 1] * 255 * scale : scale;
+    const TCoeff inputMax = std::max<TCoeff>( 1, std::min<TCoeff>( clipMax, ( 1 << ( 30 - std::max( 0, -rightShift ) ) ) / maxScale ) );
+    const TCoeff inputMin = -inputMax - 1;
+
+    // levels beyond the input range exercise the input clipping
+    xRandomCoeffs( qCoef, numCoeff, 2 * inputMax, rng );
+
+    Quant::xDeQuantCore( qCoef.data(), refCoef.data(), numCoeff, scalingList ? dequantCoeff.data() : nullptr, scale, rightShift, inputMin, inputMax, clipMin, clipMax );
+    quant.m_dequantCore( qCoef.data(), curCoef.data(), numCoeff, scalingList ? dequantCoeff.data() : nullptr, scale, rightShift, inputMin, inputMax, clipMin, clipMax );
+
+    if( !std::equal( refCoef.begin(), refCoef.begin() + numCoeff, curCoef.begin() ) )
+    {
+      fprintf( stderr, "dequant, vext %d, %d coefficients, %s, scale %d, rightShift %d differ\n", (Int) vext, numCoeff, scalingList ? "scaling list" : "flat", scale, rightShift );
+      return false;
+    }
+  }
+
+  return true;
+}
+#endif
+
+Bool QuantTest::testQuant()
+{
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_QUANT
+  return testSimdKernels( "Quant", xTestKernels<SSE41>, xTestKernels<AVX2> );
+#else
+  printf( "Quant: no SIMD kernels to test\n" );
+  return true;
+#endif
+}
+
+Bool testQuant()
+{
+  return QuantTest::testQuant();
+}
+
+//! \}
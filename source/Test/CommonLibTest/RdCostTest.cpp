@@ -0,0 +1,334 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     RdCostTest.cpp
+    \brief    compares the SIMD distortion functions with the scalar ones
+*/
+
+#include "CommonLibTest.h"
+
+#include "CommonLib/RdCost.h"
+
+#include <cstdio>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+static const Int RD_COST_TEST_STRIDE     = MAX_CU_SIZE + 16;
+static const Int RD_COST_TEST_ITERATIONS = 200;
+
+class RdCostTest
+{
+public:
+  static Bool testSSE();
+  static Bool testMRSAD();
+  static Bool testHAD();
+
+private:
+  static Void xRandomBlocks( std::vector<Pel>& org, std::vector<Pel>& cur, DistParam& distParam, const Int width, const Int height, const Int bitDepth, TestSampleGenerator& rng );
+  static Bool xCompare     ( const DFunc dFunc, FpDistFunc scalarFunc, FpDistFunc simdFunc, const DistParam& distParam, const Int vext );
+
+#ifdef TARGET_SIMD_X86
+  template<X86_VEXT vext>
+  static Bool xTestSSE  ( TestSampleGenerator& rng );
+  template<X86_VEXT vext>
+  static Bool xTestMRSAD( TestSampleGenerator& rng );
+  template<X86_VEXT vext>
+  static Bool xTestHAD  ( TestSampleGenerator& rng );
+#endif
+};
+
+// unaligned blocks of random samples with random strides
+Void RdCostTest::xRandomBlocks( std::vector<Pel>& org, std::vector<Pel>& cur, DistParam& distParam, const Int width, const Int height, const Int bitDepth, TestSampleGenerator& rng )
+{
+  const Int orgStride = rng( width, RD_COST_TEST_STRIDE );
+  const Int curStride = rng( width, RD_COST_TEST_STRIDE );
+
+  // offsets keep the blocks unaligned
+  const Int orgOffset = rng( 0, RD_COST_TEST_STRIDE - orgStride );
+  const Int curOffset = rng( 0, RD_COST_TEST_STRIDE - curStride );
+
+  rng.fill( org.data(), (Int) org.size(), bitDepth );
+  rng.fill( cur.data(), (Int) cur.size(), bitDepth );
+
+  distParam.org      = CPelBuf( org.data() + orgOffset, orgStride, width, height );
+  distParam.cur      = CPelBuf( cur.data() + curOffset, curStride, width, height );
+  distParam.bitDepth = bitDepth;
+  distParam.compID   = COMPONENT_Y;
+}
+
+Bool RdCostTest::xCompare( const DFunc dFunc, FpDistFunc scalarFunc, FpDistFunc simdFunc, const DistParam& distParam, const Int vext )
+{
+  const Distortion expected = scalarFunc( distParam );
+  const Distortion actual   = simdFunc( distParam );
+
+  if( actual != expected )
+  {
+    fprintf( stderr, "DFunc %d, vext %d, %d bit, %dx%d: %llu instead of %llu\n", (Int) dFunc, vext, distParam.bitDepth, distParam.org.width, distParam.org.height,
+             (unsigned long long) actual, (unsigned long long) expected );
+    return false;
+  }
+  return true;
+}
+
+#ifdef TARGET_SIMD_X86
+template<X86_VEXT vext>
+Bool RdCostTest::xTestSSE( TestSampleGenerator& rng )
+{
+  // block width 0: any width, -16: a multiple of 16
+  static const struct { DFunc dFunc; FpDistFunc scalarFunc; Int width; } sseFuncs[] =
+  {
+    { DF_SSE,    RdCost::xGetSSE,     0 },
+    { DF_SSE2,   RdCost::xGetSSE,     0 },
+    { DF_SSE4,   RdCost::xGetSSE4,    4 },
+    { DF_SSE8,   RdCost::xGetSSE8,    8 },
+    { DF_SSE16,  RdCost::xGetSSE16,  16 },
+    { DF_SSE32,  RdCost::xGetSSE32,  32 },
+    { DF_SSE64,  RdCost::xGetSSE64,  64 },
+    { DF_SSE16N, RdCost::xGetSSE16N, -16 },
+  };
+
+  RdCost rdCost;
+  rdCost._initRdCostX86<vext>();
+
+  std::vector<Pel> org( RD_COST_TEST_STRIDE * MAX_CU_SIZE );
+  std::vector<Pel> cur( RD_COST_TEST_STRIDE * MAX_CU_SIZE );
+
+  for( Int bitDepth = 8; bitDepth <= 10; bitDepth += 2 )
+  {
+    for( const auto &sseFunc : sseFuncs )
+    {
+      const FpDistFunc simdFunc = RdCost::m_afpDistortFunc[sseFunc.dFunc];
+
+      for( Int i = 0; i < RD_COST_TEST_ITERATIONS; i++ )
+      {
+        const Int width  = sseFunc.width > 0 ? sseFunc.width : sseFunc.width < 0 ? 16 * rng( 1, MAX_CU_SIZE / 16 ) : rng( 1, MAX_CU_SIZE );
+        const Int height = rng( 1, MAX_CU_SIZE );
+
+        DistParam distParam;
+        xRandomBlocks( org, cur, distParam, width, height, bitDepth, rng );
+
+        if( !xCompare( sseFunc.dFunc, sseFunc.scalarFunc, simdFunc, distParam, vext ) )
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+template<X86_VEXT vext>
+Bool RdCostTest::xTestMRSAD( TestSampleGenerator& rng )
+{
+  // block width 0: any width, -16: a multiple of 16
+  static const struct { DFunc dFunc; FpDistFunc scalarFunc; Int width; } mrsadFuncs[] =
+  {
+    { DF_MRSAD,    RdCost::xGetMRSAD,     0 },
+    { DF_MRSAD2,   RdCost::xGetMRSAD,     0 },
+    { DF_MRSAD4,   RdCost::xGetMRSAD4,    4 },
+    { DF_MRSAD8,   RdCost::xGetMRSAD8,    8 },
+    { DF_MRSAD16,  RdCost::xGetMRSAD16,  16 },
+    { DF_MRSAD32,  RdCost::xGetMRSAD32,  32 },
+    { DF_MRSAD64,  RdCost::xGetMRSAD64,  64 },
+    { DF_MRSAD16N, RdCost::xGetMRSAD16N, -16 },
+    { DF_MRSAD12,  RdCost::xGetMRSAD12,  12 },
+    { DF_MRSAD24,  RdCost::xGetMRSAD24,  24 },
+    { DF_MRSAD48,  RdCost::xGetMRSAD48,  48 },
+  };
+
+  RdCost rdCost;
+  rdCost._initRdCostX86<vext>();
+
+  std::vector<Pel> org( RD_COST_TEST_STRIDE * MAX_CU_SIZE );
+  std::vector<Pel> cur( RD_COST_TEST_STRIDE * MAX_CU_SIZE );
+
+  for( Int bitDepth = 8; bitDepth <= 10; bitDepth += 2 )
+  {
+    const Int maxVal = ( 1 << bitDepth ) - 1;
+
+    for( const auto &mrsadFunc : mrsadFuncs )
+    {
+      const FpDistFunc simdFunc = RdCost::m_afpDistortFunc[mrsadFunc.dFunc];
+
+      for( Int i = 0; i < RD_COST_TEST_ITERATIONS; i++ )
+      {
+        // the row subsampling of the motion search needs an even height
+        const Int subShift = rng( 0, 1 );
+        const Int width    = mrsadFunc.width > 0 ? mrsadFunc.width : mrsadFunc.width < 0 ? 16 * rng( 1, MAX_CU_SIZE / 16 ) : rng( 1, MAX_CU_SIZE );
+        const Int height   = rng( 1, MAX_CU_SIZE >> subShift ) << subShift;
+
+        DistParam distParam;
+        xRandomBlocks( org, cur, distParam, width, height, bitDepth, rng );
+
+        // the current block is the original one with a brightness change and some noise, so the mean removal matters
+        const Int dc    = rng( -maxVal / 4, maxVal / 4 );
+        const Int amp   = rng( 0, maxVal );
+        Pel*      piCur = cur.data() + ( distParam.cur.buf - cur.data() );
+        for( Int y = 0; y < height; y++ )
+        {
+          for( Int x = 0; x < width; x++ )
+          {
+            piCur[y * distParam.cur.stride + x] = (Pel) Clip3( 0, maxVal, distParam.org.at( x, y ) + dc + rng( -amp, amp ) );
+          }
+        }
+
+        distParam.subShift = subShift;
+        if( rng( 0, 3 ) == 0 )
+        {
+          distParam.maximumDistortionForEarlyExit = rng( 0, width * height * 4 );
+        }
+
+        if( !xCompare( mrsadFunc.dFunc, mrsadFunc.scalarFunc, simdFunc, distParam, vext ) )
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+template<X86_VEXT vext>
+Bool RdCostTest::xTestHAD( TestSampleGenerator& rng )
+{
+  // block width 0: any width, -16: a multiple of 16
+  static const struct { DFunc dFunc; Int width; } hadFuncs[] =
+  {
+    { DF_HAD,     0 },
+    { DF_HAD2,    2 },
+    { DF_HAD4,    4 },
+    { DF_HAD8,    8 },
+    { DF_HAD16,  16 },
+    { DF_HAD32,  32 },
+    { DF_HAD64,  64 },
+    { DF_HAD16N, -16 },
+  };
+
+  RdCost rdCost;
+  rdCost._initRdCostX86<vext>();
+
+  std::vector<Pel> org( RD_COST_TEST_STRIDE * MAX_CU_SIZE );
+  std::vector<Pel> cur( RD_COST_TEST_STRIDE * MAX_CU_SIZE );
+
+  for( Int bitDepth = 8; bitDepth <= 10; bitDepth += 2 )
+  {
+    for( const auto &hadFunc : hadFuncs )
+    {
+      const FpDistFunc simdFunc = RdCost::m_afpDistortFunc[hadFunc.dFunc];
+
+      for( Int i = 0; i < RD_COST_TEST_ITERATIONS; i++ )
+      {
+        // the block sizes of the partitioning, down to 2, so the thin 4xN and Nx4 shapes occur
+        const Int width  = hadFunc.width > 0 ? hadFunc.width : hadFunc.width < 0 ? 16 << rng( 0, 3 ) : 2 << rng( 0, 6 );
+        const Int height = 2 << rng( 0, 6 );
+
+        DistParam distParam;
+        xRandomBlocks( org, cur, distParam, width, height, bitDepth, rng );
+        distParam.isQtbt = rng( 0, 3 ) != 0;
+
+        // the 16x16 AVX2 transform normalises each of its 8x8 quadrants, so it matches the 8x8 tiles of xGetHADs
+        if( !xCompare( hadFunc.dFunc, RdCost::xGetHADs, simdFunc, distParam, vext ) )
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+#endif
+
+Bool RdCostTest::testSSE()
+{
+#ifdef TARGET_SIMD_X86
+  const Bool passed = testSimdKernels( "RdCostSSE", xTestSSE<SSE41>, xTestSSE<AVX2> );
+
+  // restore the distortion functions of the detected extension
+  RdCost().init();
+
+  return passed;
+#else
+  printf( "RdCostSSE: no SIMD kernels to test\n" );
+  return true;
+#endif
+}
+
+Bool RdCostTest::testMRSAD()
+{
+#ifdef TARGET_SIMD_X86
+  const Bool passed = testSimdKernels( "RdCostMRSAD", xTestMRSAD<SSE41>, xTestMRSAD<AVX2> );
+
+  RdCost().init();
+
+  return passed;
+#else
+  printf( "RdCostMRSAD: no SIMD kernels to test\n" );
+  return true;
+#endif
+}
+
+Bool RdCostTest::testHAD()
+{
+#ifdef TARGET_SIMD_X86
+  const Bool passed = testSimdKernels( "RdCostHAD", xTestHAD<SSE41>, xTestHAD<AVX2> );
+
+  RdCost().init();
+
+  return passed;
+#else
+  printf( "RdCostHAD: no SIMD kernels to test\n" );
+  return true;
+#endif
+}
+
+Bool testRdCostSSE()
+{
+  return RdCostTest::testSSE();
+}
+
+Bool testRdCostMRSAD()
+{
+  return RdCostTest::testMRSAD();
+}
+
+Bool testRdCostHAD()
+{
+  return RdCostTest::testHAD();
+}
+
+//! \}
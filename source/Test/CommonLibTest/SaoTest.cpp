@@ -0,0 +1,259 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SaoTest.cpp
+    \brief    compares the SIMD SAO offset and statistics kernels with the scalar ones
+*/
+
+#include "CommonLibTest.h"
+
+#include "CommonLib/SampleAdaptiveOffset.h"
+
+#include <cstdio>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+static const Int SAO_TEST_ITERATIONS = 400;
+
+class SaoTest
+{
+public:
+  static Bool testSao();
+
+private:
+  static Void xFillBlock       ( Pel* buf, const Int size, const Int bitDepth, TestSampleGenerator& rng );
+  static Void xRandomOffsets   ( Int* offset, const Int typeIdx, const Int bandPos, const Int bitDepth, TestSampleGenerator& rng );
+
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_SAO
+  template<X86_VEXT vext>
+  static Bool xTestKernels     ( TestSampleGenerator& rng );
+  static Bool xTestOffset      ( const SaoOps& simdOps, const Int vext, const Int bitDepth, TestSampleGenerator& rng );
+  static Bool xTestStats       ( const SaoOps& simdOps, const Int vext, const Int bitDepth, TestSampleGenerator& rng );
+#endif
+};
+
+// a base level with noise of a random amplitude, small amplitudes give flat areas and all edge classes, the full one all bands
+Void SaoTest::xFillBlock( Pel* buf, const Int size, const Int bitDepth, TestSampleGenerator& rng )
+{
+  const Int maxVal = ( 1 << bitDepth ) - 1;
+  const Int amp    = rng( 0, 2 ) ? rng( 1, 4 ) : maxVal;
+  const Int base   = rng( 0, maxVal );
+
+  for( Int i = 0; i < size; i++ )
+  {
+    buf[i] = (Pel) Clip3( 0, maxVal, base + rng( -amp, amp ) );
+  }
+}
+
+// the EO offsets of the classes -2..2 and the four BO offsets from bandPos on, at the range a bitstream can signal
+Void SaoTest::xRandomOffsets( Int* offset, const Int typeIdx, const Int bandPos, const Int bitDepth, TestSampleGenerator& rng )
+{
+  const Int maxOffset = SampleAdaptiveOffset::getMaxOffsetQVal( bitDepth ) << std::max( bitDepth - MAX_SAO_TRUNCATED_BITDEPTH, 0 );
+
+  std::fill_n( offset, MAX_NUM_SAO_CLASSES, 0 );
+
+  if( typeIdx != SAO_TYPE_BO )
+  {
+    for( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+    {
+      offset[k] = rng( -maxOffset, maxOffset );
+    }
+  }
+  else if( bandPos < 0 )
+  {
+    // all 32 bands, so every table of the kernel is used
+    for( Int k = 0; k < NUM_SAO_BO_CLASSES; k++ )
+    {
+      offset[k] = rng( -maxOffset, maxOffset );
+    }
+  }
+  else
+  {
+    for( Int k = 0; k < 4; k++ )
+    {
+      offset[( bandPos + k ) % NUM_SAO_BO_CLASSES] = rng( -maxOffset, maxOffset );
+    }
+  }
+}
+
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_SAO
+template<X86_VEXT vext>
+Bool SaoTest::xTestKernels( TestSampleGenerator& rng )
+{
+  SaoOps simdOps;
+  simdOps._initSaoOpsX86<vext>();
+
+  for( Int bitDepth = 8; bitDepth <= 10; bitDepth += 2 )
+  {
+    if( !xTestOffset( simdOps, (Int) vext, bitDepth, rng ) || !xTestStats( simdOps, (Int) vext, bitDepth, rng ) )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Bool SaoTest::xTestOffset( const SaoOps& simdOps, const Int vext, const Int bitDepth, TestSampleGenerator& rng )
+{
+  const ClpRng clpRng = { 0, ( 1 << bitDepth ) - 1, bitDepth, 0 };
+  const SaoOps scalarOps;
+
+  Int offset[MAX_NUM_SAO_CLASSES];
+
+  for( Int i = 0; i < SAO_TEST_ITERATIONS; i++ )
+  {
+    // every type, and for BO every band position followed by a run with all bands set
+    const Int typeIdx = i % NUM_SAO_NEW_TYPES;
+    const Int bandPos = ( i / NUM_SAO_NEW_TYPES ) % ( NUM_SAO_BO_CLASSES + 1 ) - 1;
+
+    // the lines at the block boundaries are single rows or shortened ones, empty ones included
+    const Int width   = rng( 0, 3 ) ? rng( 1, MAX_CU_SIZE ) : rng( 0, 2 );
+    const Int height  = rng( 0, 3 ) ? rng( 1, MAX_CU_SIZE ) : rng( 0, 2 );
+
+    // the neighbours are read, so there is a one sample margin around the block
+    const Int srcStride   = width + rng( 2, 18 );
+    const Int resStride   = width + rng( 0, 16 );
+    const Int nbOffsets[] = { 1, srcStride, srcStride + 1, srcStride - 1 };
+
+    std::vector<Pel> src( srcStride * ( height + 2 ) );
+    std::vector<Pel> ref( resStride * height );
+    xFillBlock( src.data(), (Int) src.size(), bitDepth, rng );
+    rng.fill( ref.data(), (Int) ref.size(), bitDepth );
+    xRandomOffsets( offset, typeIdx, bandPos, bitDepth, rng );
+
+    std::vector<Pel> cur = ref;
+
+    const Pel* srcBlk = src.data() + srcStride + 1;
+
+    if( typeIdx == SAO_TYPE_BO )
+    {
+      const Int shiftBits = bitDepth - NUM_SAO_BO_CLASSES_LOG2;
+
+      scalarOps.offsetBO( srcBlk, srcStride, ref.data(), resStride, width, height, shiftBits, offset, clpRng );
+      simdOps  .offsetBO( srcBlk, srcStride, cur.data(), resStride, width, height, shiftBits, offset, clpRng );
+    }
+    else
+    {
+      scalarOps.offsetEO( srcBlk, srcStride, ref.data(), resStride, width, height, nbOffsets[typeIdx], offset, clpRng );
+      simdOps  .offsetEO( srcBlk, srcStride, cur.data(), resStride, width, height, nbOffsets[typeIdx], offset, clpRng );
+    }
+
+    if( cur != ref )
+    {
+      fprintf( stderr, "SAO type %d, band position %d, vext %d, %d bit, %dx%d block differs\n", typeIdx, bandPos, vext, bitDepth, width, height );
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Bool SaoTest::xTestStats( const SaoOps& simdOps, const Int vext, const Int bitDepth, TestSampleGenerator& rng )
+{
+  const SaoOps scalarOps;
+
+  const Int maxVal = ( 1 << bitDepth ) - 1;
+
+  for( Int i = 0; i < SAO_TEST_ITERATIONS; i++ )
+  {
+    // a quarter of the blocks is a whole CTU with the largest differences, to check the 32 bit per class sums
+    const Bool extreme   = !rng( 0, 3 );
+    const Int  width     = extreme ? MAX_CU_SIZE : rng( 1, MAX_CU_SIZE );
+    const Int  height    = extreme ? MAX_CU_SIZE : rng( 1, MAX_CU_SIZE );
+    const Int  srcStride = width + rng( 2, 18 );
+    const Int  orgStride = width + rng( 0, 16 );
+    const Int  nbOffsets[] = { 1, srcStride, srcStride + 1, srcStride - 1 };
+    const Int  nbOffset  = nbOffsets[i % 4];
+
+    std::vector<Pel> src( srcStride * ( height + 2 ) );
+    std::vector<Pel> org( orgStride * height );
+    xFillBlock( src.data(), (Int) src.size(), bitDepth, rng );
+
+    if( extreme )
+    {
+      const Bool up = rng( 0, 1 );
+      std::fill( src.begin(), src.end(), up ? 0 : maxVal );
+      std::fill( org.begin(), org.end(), up ? maxVal : 0 );
+    }
+    else
+    {
+      rng.fill( org.data(), (Int) org.size(), bitDepth );
+    }
+
+    // the kernels accumulate onto the given sums
+    Int64 refDiff[NUM_SAO_EO_CLASSES], refCount[NUM_SAO_EO_CLASSES];
+    for( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+    {
+      refDiff [k] = rng( -1000, 1000 );
+      refCount[k] = rng( 0, 1000 );
+    }
+
+    Int64 curDiff[NUM_SAO_EO_CLASSES], curCount[NUM_SAO_EO_CLASSES];
+    std::copy_n( refDiff,  NUM_SAO_EO_CLASSES, curDiff );
+    std::copy_n( refCount, NUM_SAO_EO_CLASSES, curCount );
+
+    const Pel* srcBlk = src.data() + srcStride + 1;
+
+    scalarOps.statsEO( srcBlk, srcStride, org.data(), orgStride, width, height, nbOffset, refDiff, refCount );
+    simdOps  .statsEO( srcBlk, srcStride, org.data(), orgStride, width, height, nbOffset, curDiff, curCount );
+
+    if( !std::equal( refDiff, refDiff + NUM_SAO_EO_CLASSES, curDiff ) || !std::equal( refCount, refCount + NUM_SAO_EO_CLASSES, curCount ) )
+    {
+      fprintf( stderr, "SAO EO statistics, neighbour offset %d, vext %d, %d bit, %dx%d block differ\n", nbOffset, vext, bitDepth, width, height );
+      return false;
+    }
+  }
+
+  return true;
+}
+#endif
+
+Bool SaoTest::testSao()
+{
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_SAO
+  return testSimdKernels( "Sao", xTestKernels<SSE41>, xTestKernels<AVX2> );
+#else
+  printf( "Sao: no SIMD kernels to test\n" );
+  return true;
+#endif
+}
+
+Bool testSao()
+{
+  return SaoTest::testSao();
+}
+
+//! \}
@@ -0,0 +1,215 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TrQuantTest.cpp
+    \brief    compares the SIMD KLT matrix multiplications with the scalar ones
+*/
+
+#include "CommonLibTest.h"
+
+#include "CommonLib/TrQuant.h"
+#include "CommonLib/Rom.h"
+
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+static const Int TRQUANT_TEST_ITERATIONS = 200;
+static const Int TRQUANT_TEST_MAX_LINES  = 64;
+
+class TrQuantTest
+{
+public:
+  static Bool testKLT();
+
+private:
+  static Int  xMaxInput       ( const Int trSize, const Int iTransType, const Int shift );
+  static Void xRandomSkip     ( const Int trSize, const Int line, Int& iSkipLine, Int& iSkipLine2, TestSampleGenerator& rng );
+
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_TRAFO && SEPARABLE_KLT
+  template<X86_VEXT vext>
+  static Bool xTestKLT        ( TestSampleGenerator& rng );
+#endif
+};
+
+// the largest input magnitude, for which the 32 bit sums of the scalar functions do not overflow
+Int TrQuantTest::xMaxInput( const Int trSize, const Int iTransType, const Int shift )
+{
+  const Int bIntra    = iTransType >> 1;
+  const Int bHighPrec = iTransType & 1;
+
+  const TMatrixCoeff* tc = nullptr;
+  switch( trSize )
+  {
+  case  4: tc = bHighPrec ? g_aiKLT4HP [bIntra][0] : g_aiKLT4 [bIntra][0]; break;
+  case  8: tc = bHighPrec ? g_aiKLT8HP [bIntra][0] : g_aiKLT8 [bIntra][0]; break;
+  case 16: tc = bHighPrec ? g_aiKLT16HP[bIntra][0] : g_aiKLT16[bIntra][0]; break;
+  case 32: tc = bHighPrec ? g_aiKLT32HP[bIntra][0] : g_aiKLT32[bIntra][0]; break;
+  default: tc = bHighPrec ? g_aiKLT64HP[bIntra][0] : g_aiKLT64[bIntra][0]; break;
+  }
+
+  Int maxCoeff = 1;
+  for( Int i = 0; i < trSize * trSize; i++ )
+  {
+    maxCoeff = std::max<Int>( maxCoeff, abs( tc[i] ) );
+  }
+
+  return std::min<Int64>( std::numeric_limits<Short>::max(), ( ( 1ll << 31 ) - ( 1ll << shift ) ) / ( trSize * maxCoeff ) );
+}
+
+// no skipped lines half of the time, otherwise a random part of the lines and of the basis vectors is skipped
+Void TrQuantTest::xRandomSkip( const Int trSize, const Int line, Int& iSkipLine, Int& iSkipLine2, TestSampleGenerator& rng )
+{
+  iSkipLine  = rng( 0, 1 ) ? 0 : rng( 0, line - 1 );
+  iSkipLine2 = rng( 0, 1 ) ? 0 : rng( 0, trSize - 1 );
+}
+
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_TRAFO && SEPARABLE_KLT
+template<X86_VEXT vext>
+Bool TrQuantTest::xTestKLT( TestSampleGenerator& rng )
+{
+  const TrafoOps scalarOps;
+  TrafoOps       simdOps;
+  simdOps._initTrafoOpsX86<vext>();
+
+  // all KLT sizes, 4 to 64
+  for( Int sizeIdx = 1; sizeIdx <= 5; sizeIdx++ )
+  {
+    const Int trSize = 1 << ( sizeIdx + 1 );
+
+    for( Int i = 0; i < TRQUANT_TEST_ITERATIONS; i++ )
+    {
+      // any line count, odd ones included
+      const Int line       = rng( 1, TRQUANT_TEST_MAX_LINES );
+      const Int iTransType = rng( 0, 3 );
+      const Int shift      = rng( 1, 16 );
+      const Int maxInput   = xMaxInput( trSize, iTransType, shift );
+      const Int stride     = trSize + rng( 0, 16 );
+      const Int clipBits   = rng( 8, 15 );
+      const TCoeff outputMinimum = -( 1 << clipBits );
+      const TCoeff outputMaximum =  ( 1 << clipBits ) - 1;
+
+      Int iSkipLine, iSkipLine2;
+      xRandomSkip( trSize, line, iSkipLine, iSkipLine2, rng );
+
+      std::vector<TCoeff> src( trSize * line );
+      std::vector<Pel>    srcPel( stride * line );
+      for( auto &v : src )
+      {
+        v = rng( -maxInput, maxInput );
+      }
+      for( auto &v : srcPel )
+      {
+        v = (Pel) rng( -maxInput, maxInput );
+      }
+
+      // the outputs are prefilled, so that the zeroed parts are compared too
+      std::vector<TCoeff> ref( trSize * line );
+      std::vector<Pel>    refPel( stride * line );
+      for( auto &v : ref )
+      {
+        v = rng( -maxInput, maxInput );
+      }
+      for( auto &v : refPel )
+      {
+        v = (Pel) rng( -maxInput, maxInput );
+      }
+
+      std::vector<TCoeff> cur    = ref;
+      std::vector<Pel>    curPel = refPel;
+
+      scalarOps.fastFwdTrans[TRAFO_KLT][sizeIdx]( src.data(), ref.data(), shift, line, iSkipLine, iSkipLine2, iTransType );
+      simdOps  .fastFwdTrans[TRAFO_KLT][sizeIdx]( src.data(), cur.data(), shift, line, iSkipLine, iSkipLine2, iTransType );
+
+      if( cur != ref )
+      {
+        fprintf( stderr, "forward KLT %d, type %d, vext %d, %d lines, skip %d/%d differs\n", trSize, iTransType, (Int) vext, line, iSkipLine, iSkipLine2 );
+        return false;
+      }
+
+      scalarOps.fastFwdKLTPel[sizeIdx]( srcPel.data(), stride, ref.data(), shift, line, iSkipLine, iSkipLine2, iTransType );
+      simdOps  .fastFwdKLTPel[sizeIdx]( srcPel.data(), stride, cur.data(), shift, line, iSkipLine, iSkipLine2, iTransType );
+
+      if( cur != ref )
+      {
+        fprintf( stderr, "forward KLT %d from the residual, type %d, vext %d, %d lines, skip %d/%d differs\n", trSize, iTransType, (Int) vext, line, iSkipLine, iSkipLine2 );
+        return false;
+      }
+
+      scalarOps.fastInvTrans[TRAFO_KLT][sizeIdx]( src.data(), ref.data(), shift, line, iSkipLine, iSkipLine2, iTransType, outputMinimum, outputMaximum );
+      simdOps  .fastInvTrans[TRAFO_KLT][sizeIdx]( src.data(), cur.data(), shift, line, iSkipLine, iSkipLine2, iTransType, outputMinimum, outputMaximum );
+
+      if( cur != ref )
+      {
+        fprintf( stderr, "inverse KLT %d, type %d, vext %d, %d lines, skip %d/%d differs\n", trSize, iTransType, (Int) vext, line, iSkipLine, iSkipLine2 );
+        return false;
+      }
+
+      scalarOps.fastInvKLTPel[sizeIdx]( src.data(), refPel.data(), stride, shift, line, iSkipLine, iSkipLine2, iTransType, outputMinimum, outputMaximum );
+      simdOps  .fastInvKLTPel[sizeIdx]( src.data(), curPel.data(), stride, shift, line, iSkipLine, iSkipLine2, iTransType, outputMinimum, outputMaximum );
+
+      if( curPel != refPel )
+      {
+        fprintf( stderr, "inverse KLT %d to the residual, type %d, vext %d, %d lines, skip %d/%d differs\n", trSize, iTransType, (Int) vext, line, iSkipLine, iSkipLine2 );
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+#endif
+
+Bool TrQuantTest::testKLT()
+{
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_TRAFO && SEPARABLE_KLT
+#if ENABLE_AVX512
+  return testSimdKernels( "TrafoKLT", xTestKLT<SSE41>, xTestKLT<AVX2>, xTestKLT<AVX512> );
+#else
+  return testSimdKernels( "TrafoKLT", xTestKLT<SSE41>, xTestKLT<AVX2> );
+#endif
+#else
+  printf( "TrafoKLT: no SIMD kernels to test\n" );
+  return true;
+#endif
+}
+
+Bool testTrafoKLT()
+{
+  return TrQuantTest::testKLT();
+}
+
+//! \}